@@ -99,12 +99,33 @@ typedef struct EbComponentType {
     void *   p_application_private;
 } EbComponentType;
 
+/* Parts of the library the memory of an instance is attributed to */
+typedef enum SvtAv1MemoryComponent {
+    SVT_AV1_MEMORY_OTHER = 0,
+    SVT_AV1_MEMORY_PICTURE_BUFFERS, /**< Input, reference and reconstructed pictures */
+    SVT_AV1_MEMORY_CONTEXTS,        /**< Per thread process contexts */
+    SVT_AV1_MEMORY_NEIGHBOR_ARRAYS, /**< Above and left neighbor arrays */
+    SVT_AV1_MEMORY_ME_BUFFERS,      /**< Motion estimation contexts and results */
+    SVT_AV1_MEMORY_COMPONENT_COUNT
+} SvtAv1MemoryComponent;
+
+/*!\brief Memory used by an encoder or decoder instance, in bytes
+ */
+typedef struct SvtAv1MemoryUsage {
+    uint64_t budget;   /**< Encoder memory_budget_mb in bytes, 0 when unbounded */
+    uint64_t estimate; /**< Encoder estimated footprint of the buffer configuration in use */
+    uint64_t current;  /**< Allocated now */
+    uint64_t peak;     /**< Most allocated at any time */
+    uint64_t component[SVT_AV1_MEMORY_COMPONENT_COUNT]; /**< current, per SvtAv1MemoryComponent */
+} SvtAv1MemoryUsage;
+
 typedef enum EbErrorType {
     EB_ErrorNone                   = 0,
     EB_DecUnsupportedBitstream     = (int32_t)0x40001000,
     EB_DecNoOutputPicture          = (int32_t)0x40001004,
     EB_DecDecodingError            = (int32_t)0x40001008,
     EB_Corrupt_Frame               = (int32_t)0x4000100C,
+    EB_DecInputQueueFull           = (int32_t)0x40001010,
     EB_ErrorInsufficientResources  = (int32_t)0x80001000,
     EB_ErrorUndefined              = (int32_t)0x80001001,
     EB_ErrorInvalidComponent       = (int32_t)0x80001004,
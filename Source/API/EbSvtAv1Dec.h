@@ -54,6 +54,15 @@ typedef struct EbAV1FrameInfo {
     uint64_t frame_presentation_time;
 } EbAV1FrameInfo;
 
+/* Frames a decoding step may be skipped for, from the least to the most
+ * aggressive level */
+typedef enum EbDecSkipLevel {
+    EB_DEC_SKIP_NONE   = 0, /* Skip nothing */
+    EB_DEC_SKIP_NONREF = 1, /* Frames that refresh no reference slot */
+    EB_DEC_SKIP_NONKEY = 2, /* All frames except key frames */
+    EB_DEC_SKIP_ALL    = 3 /* All frames */
+} EbDecSkipLevel;
+
 typedef struct EbSvtAv1DecConfiguration {
     /* Bitstream operating point to decode.
      *
@@ -129,6 +138,55 @@ typedef struct EbSvtAv1DecConfiguration {
  *
  * Default is 0. */
     EbBool is_16bit_pipeline;
+
+    /* Number of temporal units that can be queued for decoding. When non-zero,
+     * svt_av1_dec_frame() copies the data into the queue and returns
+     * immediately, and a library thread performs the decode.
+     *
+     * 0 = synchronous decode on the caller's thread.
+     *
+     * Default is 0. */
+    uint32_t input_queue_depth;
+
+    /* Number of decoded pictures that can be held for the application when
+     * input_queue_depth is non-zero. Ignored in synchronous mode.
+     *
+     * Default is 1. */
+    uint32_t output_queue_depth;
+
+    /* Region of interest in luma samples, e.g. the visible viewport of a
+     * 360 degree or video-wall stream. When roi_width and roi_height are
+     * non-zero, only the tiles intersecting the region grown by the extents
+     * of the in-loop filters (deblocking, CDEF, superres upscaling and loop
+     * restoration) are reconstructed and filtered, and output pictures are
+     * cropped to the region. All tiles are still parsed so that entropy
+     * contexts and motion vectors stay exact.
+     *
+     * Samples outside the reconstructed tiles are not updated, so the region
+     * is exact for intra-only streams, and otherwise only while the motion
+     * referencing it stays within the reconstructed tiles, e.g. for streams
+     * coded with motion-constrained tiles.
+     *
+     * Default is 0, the full frame is decoded. */
+    uint32_t roi_x;
+    uint32_t roi_y;
+    uint32_t roi_width;
+    uint32_t roi_height;
+
+    /* Frames for which deblocking, CDEF and loop restoration are bypassed,
+     * trading quality for speed, e.g. for fast scrubbing. Skipping them on
+     * reference frames lets the error propagate until the next key frame.
+     *
+     * Default is EB_DEC_SKIP_NONE. */
+    EbDecSkipLevel skip_loop_filter;
+
+    /* Frames that are parsed but neither reconstructed nor output, e.g.
+     * EB_DEC_SKIP_NONKEY to extract thumbnails from key frames only.
+     * Frame headers are still read so that the reference state stays in
+     * sync with the bitstream.
+     *
+     * Default is EB_DEC_SKIP_NONE. */
+    EbDecSkipLevel skip_frame;
 } EbSvtAv1DecConfiguration;
 
 /* STEP 1: Call the library to construct a Component Handle.
@@ -166,7 +224,15 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component);
      * @ *data                  Buffer with data
      * @ data_size              Data size in bytes
      *
-     *  Returns EB_ErrorNone if the coded data has been processed successfully. */
+     *  Returns EB_ErrorNone if the coded data has been processed successfully.
+     *
+     *  When input_queue_depth is non-zero the data is copied into the input
+     *  queue and the call returns without waiting for the decode.
+     *  Returns EB_DecInputQueueFull if the queue is full; the application
+     *  should retrieve pictures with svt_av1_dec_get_picture() and resubmit.
+     *  Passing data == NULL or data_size == 0 signals the end of the stream.
+     *  An error of a queued decode is returned by the following calls,
+     *  including the end of stream one. */
 EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data,
                                        const size_t data_size, uint32_t is_annexb);
 
@@ -184,7 +250,16 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
      *
      *  Returns EB_ErrorNone if the picture has been returned successfully.
      *  Returns EB_DecNoOutputPicture if the next output picture has not
-     *  been generated yet. Calling a decoding function is needed to generate more pictures. */
+     *  been generated yet. Calling a decoding function is needed to generate more pictures.
+     *
+     *  When input_queue_depth is non-zero the picture planes are handed over
+     *  from the output queue, so the planes of *p_buffer must be allocated with
+     *  malloc() and may be replaced by the library. The call only waits for
+     *  the decoder when the input queue is full or the end of the stream has
+     *  been signalled; after the end of the stream EB_DecNoOutputPicture means
+     *  that every queued picture has been returned. If a queued decode failed,
+     *  its error is returned instead once every decoded picture has been
+     *  returned. */
 EB_API EbErrorType svt_av1_dec_get_picture(EbComponentType *   svt_dec_component,
                                           EbBufferHeaderType *p_buffer,
                                           EbAV1StreamInfo *stream_info, EbAV1FrameInfo *frame_info);
@@ -195,6 +270,15 @@ EB_API EbErrorType svt_av1_dec_get_picture(EbComponentType *   svt_dec_component
      * @ *svt_dec_component     Decoder handle */
 EB_API EbErrorType svt_av1_dec_deinit(EbComponentType *svt_dec_component);
 
+/* Memory allocated by the decoder instance, it can be called at any time
+     * after svt_av1_dec_init_handle() and before svt_av1_dec_deinit().
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle
+     * @ *usage                 Filled with the memory usage, budget and estimate are 0 */
+EB_API EbErrorType svt_av1_dec_get_memory_usage(EbComponentType *  svt_dec_component,
+                                                SvtAv1MemoryUsage *usage);
+
 /* STEP 7: Deconstruct decoder handler.
      *
      * Parameter:
@@ -71,6 +71,19 @@ typedef enum {
     // 2. call this when you got EB_BUFFERFLAG_EOS
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
 
+    // The output is SvtAv1FixedBuf*, buf must point to caller storage of sz bytes
+    // Copies the first pass stats of the frames finished since the previous call,
+    // in display order, and sets sz to the number of bytes copied.
+    // It can be called at any time while encoding, the stats returned can be fed
+    // to svt_av1_enc_push_first_pass_stats() of a second pass encoder.
+    // This needs EbSvtAv1EncConfiguration.rc_firstpass_stats_out set to EB_TRUE
+    SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_STREAM,
+
+    // The output is SvtAv1MemoryUsage*
+    // Memory allocated by the encoder instance, it can be called at any time
+    // after svt_av1_enc_init()
+    SVT_AV1_STREAM_INFO_MEMORY_USAGE,
+
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
 
@@ -229,6 +242,14 @@ typedef struct EbSvtAv1EncConfiguration {
     EbBool use_qp_file;
     /* input buffer for the second pass */
     SvtAv1FixedBuf rc_twopass_stats_in;
+    /* Number of future frames of first pass stats the second pass looks at.
+    * When set, rc_twopass_stats_in must be empty and the first pass stats are
+    * streamed in with svt_av1_enc_push_first_pass_stats() while encoding. The
+    * key frame and GF group decisions are then made over a sliding window of
+    * this many frames instead of the whole file.
+    *
+    * Default is 0 (no streaming).*/
+    uint32_t rc_twopass_stats_window;
     /* generate first pass stats output.
     * when you set this to EB_TRUE, and you got the EB_BUFFERFLAG_EOS,
     * you can get the encoder stats using:
@@ -239,6 +260,26 @@ typedef struct EbSvtAv1EncConfiguration {
     *
     * Default is 0.*/
     EbBool rc_firstpass_stats_out;
+    /* Analysis-only first pass. When set together with rc_firstpass_stats_out,
+    * the first pass stats are derived from the picture analysis and open loop
+    * motion estimation data only, and the first pass mode decision is skipped.
+    * Much faster than the default first pass at the cost of less accurate
+    * intra/inter error estimates.
+    *
+    * Default is 0.*/
+    EbBool rc_firstpass_analysis_only;
+    /* Analysis cache file, shared by encodes of the same source that only
+    * differ in QP or rate control targets. With analysis_cache_mode 1 the
+    * motion estimation and open loop intra search results of every picture
+    * are written to it, with 2 they are read back instead of being computed.
+    * The path is only used by svt_av1_enc_init().
+    *
+    * Default is NULL.*/
+    const char *analysis_cache_path;
+    /* 0: off, 1: write the analysis cache, 2: read the analysis cache.
+    *
+    * Default is 0.*/
+    uint8_t analysis_cache_mode;
     /* Enable picture QP scaling between hierarchical levels
     *
     * Default is null.*/
@@ -325,6 +366,12 @@ typedef struct EbSvtAv1EncConfiguration {
     * -1: Default, 0: OFF in PD_PASS_2, 1: Fully ON in PD_PASS_2. */
     int spatial_sse_full_loop_level;
 
+    /* Inter prediction cache shared by the MD stages and the block shapes of
+    * an SB, it does not change the output
+    *
+    * -1: Default, 0: OFF, 1: ON. */
+    int enable_md_pred_cache;
+
     /* over boundry block
     *
     * Default is -1. */
@@ -469,9 +516,11 @@ typedef struct EbSvtAv1EncConfiguration {
      * 2 = Constrained Variable Bit Rate, achieve the target bitrate at each gop
      * Default is 0. */
     uint32_t rate_control_mode;
-    /* Flag to enable the scene change detection algorithm.
+    /* Flag to enable the scene change detection algorithm. Scene changes are
+     * detected by the scene lookahead, so it requires scene_lookahead_distance
+     * and is only supported with CQP.
      *
-     * Default is 1. */
+     * Default is 0. */
     uint32_t scene_change_detection;
     /* When RateControlMode is set to 1 it's best to set this parameter to be
      * equal to the Intra period value (such is the default set by the encoder).
@@ -479,6 +528,15 @@ typedef struct EbSvtAv1EncConfiguration {
      *
      * Default depends on rate control mode.*/
     uint32_t look_ahead_distance;
+    /* Number of future pictures analysed for scene changes, on top of the look
+     * ahead. These pictures only keep their input buffer and statistics of
+     * their 1/16 subsampled picture, so a long scene lookahead costs much less
+     * memory than the same look_ahead_distance. Scene changes found this way
+     * start a new intra period, and a periodic key frame just before one of
+     * them is moved to it. Only used with scene_change_detection, in CQP.
+     *
+     * Default is 0. */
+    uint32_t scene_lookahead_distance;
 
     /* Enable TPL in look ahead, only works when look_ahead_distance>0
      * 0 = disable TPL in look ahead
@@ -630,6 +688,15 @@ typedef struct EbSvtAv1EncConfiguration {
      * Default is -1. */
     int32_t target_socket;
 
+    /* Memory budget of the encoder instance in MB. The picture pools, the
+     * number of threads and segments and the look ahead distance are reduced
+     * until the estimated footprint fits in it, and svt_av1_enc_set_parameter()
+     * fails when even the smallest configuration does not fit. The memory
+     * actually used is reported by SVT_AV1_STREAM_INFO_MEMORY_USAGE.
+     *
+     * Default is 0 (unbounded). */
+    uint32_t memory_budget_mb;
+
     // Debug tools
 
     /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -797,6 +864,18 @@ EB_API EbErrorType svt_av1_get_recon(EbComponentType *   svt_enc_component,
 EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_component,
                                     uint32_t stream_info_id, void* info);
 
+/* OPTIONAL: feed first pass stats to an encoder using rc_twopass_stats_window.
+     * The stats must be pushed in display order, ahead of the pictures sent:
+     * a picture is rate controlled once the stats of the rc_twopass_stats_window
+     * frames following it have been pushed, or the end of the stats is signaled.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *stats              Stats as returned by SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_STREAM,
+     *                       NULL or an empty buffer signals the end of the first pass stats. */
+EB_API EbErrorType svt_av1_enc_push_first_pass_stats(EbComponentType *     svt_enc_component,
+                                                     const SvtAv1FixedBuf *stats);
+
 
 /* STEP 6: Deinitialize encoder library.
      *
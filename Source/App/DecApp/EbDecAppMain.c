@@ -21,6 +21,7 @@
 #include "EbDecParamParser.h"
 #include "EbMD5Utility.h"
 #include "EbDecTime.h"
+#include "EbDecBench.h"
 
 #ifdef _WIN32
 #include <io.h> /* _setmode() */
@@ -74,9 +75,59 @@ int read_input_frame(DecInputContext *input, uint8_t **buffer, size_t *bytes_rea
     }
 }
 
+/* Writes a plane downscaled by 'scale' in both directions, each output
+   sample being the rounded average of the covered input samples */
+static void write_plane_scaled(const uint8_t *buf, int stride, int w, int h,
+                               int bytes_per_sample, int scale, FILE *out_file) {
+    const int out_w = (w + scale - 1) / scale;
+    const int out_h = (h + scale - 1) / scale;
+    uint8_t * line  = (uint8_t *)malloc(out_w * bytes_per_sample);
+    if (!line) return;
+
+    for (int oy = 0; oy < out_h; oy++) {
+        const int y_end = DECAPP_MIN((oy + 1) * scale, h);
+        for (int ox = 0; ox < out_w; ox++) {
+            const int x_end = DECAPP_MIN((ox + 1) * scale, w);
+            uint32_t  sum = 0, count = 0;
+            for (int y = oy * scale; y < y_end; y++) {
+                for (int x = ox * scale; x < x_end; x++) {
+                    sum += bytes_per_sample == 1
+                        ? buf[y * stride + x]
+                        : ((const uint16_t *)buf)[y * stride + x];
+                }
+                count += x_end - ox * scale;
+            }
+            const uint32_t avg = (sum + (count >> 1)) / count;
+            if (bytes_per_sample == 1)
+                line[ox] = (uint8_t)avg;
+            else
+                ((uint16_t *)line)[ox] = (uint16_t)avg;
+        }
+        fwrite(line, bytes_per_sample, out_w, out_file);
+    }
+    free(line);
+}
+
 void write_frame(EbBufferHeaderType *recon_buffer, CliInput *cli) {
     EbSvtIOFormat *img = (EbSvtIOFormat *)recon_buffer->p_buffer;
 
+    if (cli->output_scale > 1) {
+        const int bps   = (img->bit_depth == EB_EIGHT_BIT) ? 1 : 2;
+        const int scale = cli->output_scale;
+        const int sx    = img->color_fmt == EB_YUV420 || img->color_fmt == EB_YUV422;
+        const int sy    = img->color_fmt == EB_YUV420;
+        write_plane_scaled(
+            img->luma, img->y_stride, img->width, img->height, bps, scale, cli->out_file);
+        if (img->color_fmt != EB_YUV400) {
+            const int cw = (img->width + sx) >> sx;
+            const int ch = (img->height + sy) >> sy;
+            write_plane_scaled(img->cb, img->cb_stride, cw, ch, bps, scale, cli->out_file);
+            write_plane_scaled(img->cr, img->cr_stride, cw, ch, bps, scale, cli->out_file);
+        }
+        fflush(cli->out_file);
+        return;
+    }
+
     const int bytes_per_sample = (img->bit_depth == EB_EIGHT_BIT) ? 1 : 2;
 
     // Write luma plane
@@ -146,6 +197,9 @@ int32_t main(int32_t argc, char *argv[]) {
     cli.fps_summary = 0;
     cli.width = 0;
     cli.height = 0;
+    cli.keyframes_only = 0;
+    cli.output_scale   = 1;
+    cli.bench_streams  = 0;
 
     DecInputContext    input   = {NULL, NULL};
     ObuDecInputContext obu_ctx = {NULL, 0, 0, 0, 0};
@@ -177,8 +231,11 @@ int32_t main(int32_t argc, char *argv[]) {
         goto fail;
     }
 
-    if (read_command_line(argc, argv, config_ptr, &cli, &obu_ctx) == 0 &&
-        !svt_av1_dec_set_parameter(p_handle, config_ptr)) {
+    int valid_cli = read_command_line(argc, argv, config_ptr, &cli, &obu_ctx) == 0 &&
+                    !svt_av1_dec_set_parameter(p_handle, config_ptr);
+    if (valid_cli && cli.bench_streams)
+        return_error |= dec_bench_run(&input, config_ptr, cli.bench_streams);
+    else if (valid_cli) {
         return_error = svt_av1_dec_init(p_handle);
         if (return_error != EB_ErrorNone) {
             return_error |= svt_av1_dec_deinit_handle(p_handle);
@@ -221,29 +278,64 @@ int32_t main(int32_t argc, char *argv[]) {
             }
             stop_after = config_ptr->frames_to_be_decoded;
             if (enable_md5) md5_init(&md5_ctx);
+            int reduced_still_picture_hdr = 0;
             // Input Loop Thread
             while (read_input_frame(&input, &buf, &bytes_in_buffer, &buffer_size, NULL)) {
+                /* Only the OBU headers of the temporal units in between
+                   random access points are read */
+                if (cli.keyframes_only &&
+                    !obudec_is_random_access_point(
+                        buf, bytes_in_buffer, obu_ctx.is_annexb, &reduced_still_picture_hdr))
+                    continue;
                 if (!stop_after || in_frame < stop_after) {
                     dec_timer_start(&timer);
 
-                    return_error |=
-                        svt_av1_dec_frame(p_handle, buf, bytes_in_buffer, obu_ctx.is_annexb);
+                    EbErrorType send_error;
+                    while ((send_error = svt_av1_dec_frame(
+                                p_handle, buf, bytes_in_buffer, obu_ctx.is_annexb)) ==
+                           EB_DecInputQueueFull) {
+                        /* Waits for the decoder to free an input slot */
+                        if (svt_av1_dec_get_picture(
+                                p_handle, recon_buffer, stream_info, frame_info) ==
+                            EB_ErrorNone) {
+                            if (enable_md5) write_md5(recon_buffer, &md5_ctx);
+                            if (cli.out_file != NULL) write_frame(recon_buffer, &cli);
+                        }
+                    }
+                    return_error |= send_error;
 
                     dec_timer_mark(&timer);
                     dx_time += dec_timer_elapsed(&timer);
 
                     in_frame++;
 
-                    if (svt_av1_dec_get_picture(p_handle, recon_buffer, stream_info, frame_info) !=
-                        EB_DecNoOutputPicture) {
+                    EbErrorType pic_error;
+                    while ((pic_error = svt_av1_dec_get_picture(
+                                p_handle, recon_buffer, stream_info, frame_info)) == EB_ErrorNone) {
                         if (fps_frm) show_progress(in_frame, dx_time);
 
                         if (enable_md5) write_md5(recon_buffer, &md5_ctx);
                         if (cli.out_file != NULL) write_frame(recon_buffer, &cli);
+                        if (!config_ptr->input_queue_depth) break;
                     }
+                    if (pic_error != EB_DecNoOutputPicture) return_error |= pic_error;
                 } else
                     break;
             }
+            if (config_ptr->input_queue_depth) {
+                /* Signal the end of the stream and drain the output queue */
+                dec_timer_start(&timer);
+                return_error |= svt_av1_dec_frame(p_handle, NULL, 0, obu_ctx.is_annexb);
+                EbErrorType pic_error;
+                while ((pic_error = svt_av1_dec_get_picture(
+                            p_handle, recon_buffer, stream_info, frame_info)) == EB_ErrorNone) {
+                    if (enable_md5) write_md5(recon_buffer, &md5_ctx);
+                    if (cli.out_file != NULL) write_frame(recon_buffer, &cli);
+                }
+                if (pic_error != EB_DecNoOutputPicture) return_error |= pic_error;
+                dec_timer_mark(&timer);
+                dx_time += dec_timer_elapsed(&timer);
+            }
             if (fps_summary || fps_frm) {
                 assert(dx_time > 0);
                 show_progress(in_frame, dx_time);
@@ -0,0 +1,355 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+// Multi-stream decode benchmark
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "EbDecBench.h"
+#include "EbDecTime.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+typedef struct DecBenchUnit {
+    uint8_t *data;
+    size_t   size;
+} DecBenchUnit;
+
+/* Outcome of one stream, written by the stream process */
+typedef struct DecBenchResult {
+    EbErrorType error;
+    uint32_t    units;
+    uint32_t    frames;
+    int64_t     elapsed_us;
+    int64_t     peak_rss_kb;
+} DecBenchResult;
+
+typedef struct DecBenchCtxt {
+    EbSvtAv1DecConfiguration *config;
+    uint32_t                  is_annexb;
+    DecBenchUnit *            units;
+    uint32_t                  num_units;
+    /* Shared with the stream processes */
+    DecBenchResult *results;
+    /* num_units latencies per stream, in us */
+    int64_t *latencies;
+} DecBenchCtxt;
+
+static void dec_bench_free_units(DecBenchCtxt *ctxt) {
+    for (uint32_t i = 0; i < ctxt->num_units; i++) free(ctxt->units[i].data);
+    free(ctxt->units);
+    ctxt->units     = NULL;
+    ctxt->num_units = 0;
+}
+
+/* Reads the temporal units to decode in memory, honouring -skip and -limit */
+static EbErrorType dec_bench_load(DecInputContext *input, DecBenchCtxt *ctxt) {
+    EbSvtAv1DecConfiguration *config          = ctxt->config;
+    uint8_t *                 buf             = NULL;
+    size_t                    bytes_in_buffer = 0, buffer_size = 0;
+    uint64_t                  skip_frame      = config->skip_frames;
+    uint32_t                  capacity        = 0;
+    EbErrorType               return_error    = EB_ErrorNone;
+
+    ctxt->units     = NULL;
+    ctxt->num_units = 0;
+    while (read_input_frame(input, &buf, &bytes_in_buffer, &buffer_size, NULL)) {
+        if (skip_frame) {
+            skip_frame--;
+            continue;
+        }
+        if (config->frames_to_be_decoded && ctxt->num_units >= config->frames_to_be_decoded)
+            break;
+        if (ctxt->num_units == capacity) {
+            capacity            = capacity ? 2 * capacity : 64;
+            DecBenchUnit *units = (DecBenchUnit *)realloc(ctxt->units, capacity * sizeof(*units));
+            if (!units) {
+                return_error = EB_ErrorInsufficientResources;
+                break;
+            }
+            ctxt->units = units;
+        }
+        DecBenchUnit *unit = &ctxt->units[ctxt->num_units];
+        unit->data         = (uint8_t *)malloc(bytes_in_buffer);
+        if (!unit->data) {
+            return_error = EB_ErrorInsufficientResources;
+            break;
+        }
+        memcpy(unit->data, buf, bytes_in_buffer);
+        unit->size = bytes_in_buffer;
+        ctxt->num_units++;
+    }
+    free(buf);
+    return return_error;
+}
+
+static int compare_latency(const void *a, const void *b) {
+    const int64_t x = *(const int64_t *)a;
+    const int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void dec_bench_report(DecBenchCtxt *ctxt, uint32_t num_streams) {
+    uint64_t total_frames = 0, total_units = 0;
+    int64_t  wall_us      = 0;
+    double   total_rss_mb = 0;
+
+    fprintf(stderr, "\n Stream   Frames   Time (s)        fps   Peak RSS (MB)\n");
+    for (uint32_t i = 0; i < num_streams; i++) {
+        const DecBenchResult *result  = &ctxt->results[i];
+        const double          seconds = (double)result->elapsed_us / 1000000.0;
+        const double          rss_mb  = (double)result->peak_rss_kb / 1024.0;
+        fprintf(stderr,
+                " %6u %8u %10.2f %10.2f %15.1f",
+                i,
+                result->frames,
+                seconds,
+                result->elapsed_us ? result->frames / seconds : 0.0,
+                rss_mb);
+        if (result->error != EB_ErrorNone) fprintf(stderr, "   error 0x%x", result->error);
+        fprintf(stderr, "\n");
+        total_frames += result->frames;
+        total_units += result->units;
+        total_rss_mb += rss_mb;
+        if (result->elapsed_us > wall_us) wall_us = result->elapsed_us;
+    }
+    /* The streams start together, the slowest one sets the wall time */
+    fprintf(stderr,
+            " Aggregate: %" PRIu64 " frames in %.2f s (%.2f fps), %.1f MB peak RSS\n",
+            total_frames,
+            (double)wall_us / 1000000.0,
+            wall_us ? (double)total_frames * 1000000.0 / (double)wall_us : 0.0,
+            total_rss_mb);
+
+    if (!total_units) return;
+    int64_t *latencies = (int64_t *)malloc(total_units * sizeof(*latencies));
+    if (!latencies) return;
+    uint64_t n = 0;
+    for (uint32_t i = 0; i < num_streams; i++) {
+        memcpy(latencies + n,
+               ctxt->latencies + (size_t)i * ctxt->num_units,
+               ctxt->results[i].units * sizeof(*latencies));
+        n += ctxt->results[i].units;
+    }
+    qsort(latencies, n, sizeof(*latencies), compare_latency);
+    fprintf(stderr,
+            " Temporal unit latency (ms): p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n",
+            latencies[(n - 1) * 50 / 100] / 1000.0,
+            latencies[(n - 1) * 90 / 100] / 1000.0,
+            latencies[(n - 1) * 99 / 100] / 1000.0,
+            latencies[n - 1] / 1000.0);
+    free(latencies);
+}
+
+#ifndef _WIN32
+static int64_t dec_bench_peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage)) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+/* Decodes all the units with a decoder of its own. A byte is written to
+   'ready_fd' once the decoder is set up, decoding starts when 'go_fd' is
+   closed. The latency of a unit is the time spent sending it and fetching
+   the pictures available afterwards. */
+static void dec_bench_stream(DecBenchCtxt *ctxt, uint32_t stream, int ready_fd, int go_fd) {
+    DecBenchResult *          result    = &ctxt->results[stream];
+    int64_t *                 latencies = ctxt->latencies + (size_t)stream * ctxt->num_units;
+    EbComponentType *         p_handle  = NULL;
+    EbSvtAv1DecConfiguration  config;
+    EbSvtIOFormat             out_img;
+    EbBufferHeaderType        out_buf;
+    EbAV1StreamInfo           stream_info;
+    EbAV1FrameInfo            frame_info;
+    struct EbDecTimer         timer, unit_timer;
+    char                      token = 0;
+
+    memset(&out_img, 0, sizeof(out_img));
+    out_img.bit_depth = ctxt->config->max_bit_depth;
+    out_buf.p_buffer  = (uint8_t *)&out_img;
+
+    result->error = svt_av1_dec_init_handle(&p_handle, NULL, &config);
+    if (result->error == EB_ErrorNone) {
+        config        = *ctxt->config;
+        result->error = svt_av1_dec_set_parameter(p_handle, &config);
+    }
+    int initialized = 0;
+    if (result->error == EB_ErrorNone) {
+        result->error = svt_av1_dec_init(p_handle);
+        initialized   = result->error == EB_ErrorNone;
+    }
+
+    /* The other streams wait for this one even if it failed */
+    if (write(ready_fd, &token, 1) != 1 && result->error == EB_ErrorNone)
+        result->error = EB_ErrorUndefined;
+    while (read(go_fd, &token, 1) > 0)
+        ;
+
+    if (initialized) {
+        dec_timer_start(&timer);
+        for (uint32_t i = 0; i < ctxt->num_units && result->error == EB_ErrorNone; i++) {
+            dec_timer_start(&unit_timer);
+            EbErrorType send_error;
+            while ((send_error = svt_av1_dec_frame(p_handle,
+                                                   ctxt->units[i].data,
+                                                   ctxt->units[i].size,
+                                                   ctxt->is_annexb)) == EB_DecInputQueueFull) {
+                if (svt_av1_dec_get_picture(p_handle, &out_buf, &stream_info, &frame_info) ==
+                    EB_ErrorNone)
+                    result->frames++;
+            }
+            result->error = send_error;
+            EbErrorType pic_error;
+            while ((pic_error = svt_av1_dec_get_picture(
+                        p_handle, &out_buf, &stream_info, &frame_info)) == EB_ErrorNone) {
+                result->frames++;
+                if (!config.input_queue_depth) break;
+            }
+            if (pic_error != EB_ErrorNone && pic_error != EB_DecNoOutputPicture)
+                result->error = pic_error;
+            dec_timer_mark(&unit_timer);
+            latencies[result->units++] = dec_timer_elapsed(&unit_timer);
+        }
+        if (config.input_queue_depth) {
+            /* Signal the end of the stream and drain the output queue */
+            EbErrorType pic_error = svt_av1_dec_frame(p_handle, NULL, 0, ctxt->is_annexb);
+            if (pic_error == EB_ErrorNone) {
+                while ((pic_error = svt_av1_dec_get_picture(
+                            p_handle, &out_buf, &stream_info, &frame_info)) == EB_ErrorNone)
+                    result->frames++;
+            }
+            if (pic_error != EB_DecNoOutputPicture && result->error == EB_ErrorNone)
+                result->error = pic_error;
+        }
+        dec_timer_mark(&timer);
+        result->elapsed_us  = dec_timer_elapsed(&timer);
+        result->peak_rss_kb = dec_bench_peak_rss_kb();
+        svt_av1_dec_deinit(p_handle);
+    }
+    if (p_handle) svt_av1_dec_deinit_handle(p_handle);
+
+    free(out_img.luma);
+    if (out_img.color_fmt != EB_YUV400) {
+        free(out_img.cb);
+        free(out_img.cr);
+    }
+}
+#endif
+
+EbErrorType dec_bench_run(DecInputContext *input, EbSvtAv1DecConfiguration *config,
+                          uint32_t num_streams) {
+#ifdef _WIN32
+    (void)input;
+    (void)config;
+    (void)num_streams;
+    fprintf(stderr, "Benchmark mode is not supported on this platform. \n");
+    return EB_ErrorBadParameter;
+#else
+    DecBenchCtxt ctxt;
+    ctxt.config    = config;
+    ctxt.is_annexb = input->obu_ctx->is_annexb;
+    if (dec_bench_load(input, &ctxt) != EB_ErrorNone || !ctxt.num_units) {
+        fprintf(stderr, "Nothing to decode. \n");
+        dec_bench_free_units(&ctxt);
+        return EB_ErrorBadParameter;
+    }
+
+    /* The library keeps its memory map in process globals, so each stream
+       decodes in a process of its own and reports through shared memory */
+    const size_t shared_size =
+        num_streams * (sizeof(DecBenchResult) + ctxt.num_units * sizeof(int64_t));
+    void *shared =
+        mmap(NULL, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    pid_t *pids = (pid_t *)calloc(num_streams, sizeof(*pids));
+    int    ready_pipe[2], go_pipe[2];
+    if (shared == MAP_FAILED || !pids || pipe(ready_pipe)) {
+        if (shared != MAP_FAILED) munmap(shared, shared_size);
+        free(pids);
+        dec_bench_free_units(&ctxt);
+        return EB_ErrorInsufficientResources;
+    }
+    if (pipe(go_pipe)) {
+        close(ready_pipe[0]);
+        close(ready_pipe[1]);
+        munmap(shared, shared_size);
+        free(pids);
+        dec_bench_free_units(&ctxt);
+        return EB_ErrorInsufficientResources;
+    }
+    memset(shared, 0, shared_size);
+    ctxt.results   = (DecBenchResult *)shared;
+    ctxt.latencies = (int64_t *)(ctxt.results + num_streams);
+
+    fprintf(stderr,
+            "Decoding %u temporal units in %u concurrent streams \n",
+            ctxt.num_units,
+            num_streams);
+    fflush(stderr);
+    fflush(stdout);
+
+    uint32_t started = 0;
+    for (; started < num_streams; started++) {
+        pid_t pid = fork();
+        if (pid < 0) break;
+        if (pid == 0) {
+            close(ready_pipe[0]);
+            close(go_pipe[1]);
+            dec_bench_stream(&ctxt, started, ready_pipe[1], go_pipe[0]);
+            _exit(0);
+        }
+        pids[started] = pid;
+    }
+    close(ready_pipe[1]);
+    close(go_pipe[0]);
+
+    /* Starts the streams together once all the decoders are set up */
+    char token;
+    for (uint32_t i = 0; i < started; i++)
+        if (read(ready_pipe[0], &token, 1) != 1) break;
+    close(go_pipe[1]);
+    close(ready_pipe[0]);
+
+    EbErrorType return_error = started < num_streams ? EB_ErrorInsufficientResources
+                                                     : EB_ErrorNone;
+    for (uint32_t i = 0; i < started; i++) {
+        int status = 0;
+        if (waitpid(pids[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status))
+            ctxt.results[i].error = EB_ErrorUndefined;
+        if (ctxt.results[i].error != EB_ErrorNone) return_error = ctxt.results[i].error;
+    }
+
+    dec_bench_report(&ctxt, started);
+
+    munmap(shared, shared_size);
+    free(pids);
+    dec_bench_free_units(&ctxt);
+    return return_error;
+#endif
+}
@@ -0,0 +1,27 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+// Multi-stream decode benchmark
+
+#ifndef EbDecBench_h
+#define EbDecBench_h
+
+#include "EbSvtAv1Dec.h"
+#include "EbFileUtils.h"
+
+/* Loads the input in memory and decodes it as 'num_streams' concurrent
+   sessions, each with its own decoder configured by 'config'. Nothing is
+   written out. Prints the per stream and aggregate frame rates, the
+   latency percentiles of the temporal units and the peak resident memory. */
+EbErrorType dec_bench_run(DecInputContext *input, EbSvtAv1DecConfiguration *config,
+                          uint32_t num_streams);
+
+#endif
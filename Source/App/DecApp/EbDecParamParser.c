@@ -65,6 +65,35 @@ static void set_num_pframes(const char *value, EbSvtAv1DecConfiguration *cfg) {
         cfg->num_p_frames = 1;
     }
 };
+static void set_async_depth(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->input_queue_depth  = strtoul(value, NULL, 0);
+    cfg->output_queue_depth = cfg->input_queue_depth ? cfg->input_queue_depth : 1;
+};
+static void set_roi(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    if (sscanf(value, "%u,%u,%u,%u", &cfg->roi_x, &cfg->roi_y, &cfg->roi_width,
+               &cfg->roi_height) != 4) {
+        fprintf(stderr, "Warning : Invalid region of interest, decoding the full frame. \n");
+        cfg->roi_width  = 0;
+        cfg->roi_height = 0;
+    }
+};
+static void set_stat_report(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->stat_report = strtoul(value, NULL, 0);
+};
+static EbDecSkipLevel parse_skip_level(const char *value, const char *name) {
+    uint32_t level = strtoul(value, NULL, 0);
+    if (level > EB_DEC_SKIP_ALL) {
+        fprintf(stderr, "Warning : Invalid value for %s, setting value to 0. \n", name);
+        level = EB_DEC_SKIP_NONE;
+    }
+    return (EbDecSkipLevel)level;
+}
+static void set_skip_loop_filter(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->skip_loop_filter = parse_skip_level(value, "skip_loop_filter");
+};
+static void set_skip_decode(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->skip_frame = parse_skip_level(value, "skip_frame");
+};
 
 /**********************************
   * Config Entry Array
@@ -81,6 +110,11 @@ ConfigEntry config_entry[] = {
     {COLOUR_SPACE_TOKEN, "InputColourSpace", 1, set_colour_space},
     {THREADS_TOKEN, "ThreadCount", 1, set_num_thread},
     {FRAME_PLL_TOKEN, "PllFrameCount", 1, set_num_pframes},
+    {ASYNC_DEPTH_TOKEN, "AsyncDepth", 1, set_async_depth},
+    {ROI_TOKEN, "RegionOfInterest", 1, set_roi},
+    {SKIP_LOOP_FILTER_TOKEN, "SkipLoopFilter", 1, set_skip_loop_filter},
+    {SKIP_DECODE_TOKEN, "SkipDecode", 1, set_skip_decode},
+    {STAT_REPORT_TOKEN, "StatReport", 0, set_stat_report},
     // Termination
     {NULL, NULL, 0, NULL}};
 
@@ -98,6 +132,14 @@ static void show_help() {
     H0( " -colour-space <arg>       Input picture colour space. [400, 420, 422, 444]\n");
     H0( " -threads <arg>            Number of threads to be launched \n");
     H0( " -parallel-frames <arg>    Number of frames to be processed in parallel \n");
+    H0( " -async-depth <arg>        Decode asynchronously with n queued input frames \n");
+    H0( " -roi <x,y,w,h>            Decode and output only the tiles covering this luma region \n");
+    H0( " -skip-loop-filter <arg>   Bypass in-loop filters on frames. [0 - none, 1 - non-ref, 2 - non-key, 3 - all]\n");
+    H0( " -skip-decode <arg>        Drop frames without output. [0 - none, 1 - non-ref, 2 - non-key, 3 - all]\n");
+    H0( " -keyframes-only           Decode only the temporal units holding a shown key frame \n");
+    H0( " -output-scale <arg>       Downscale the written frames by n, e.g. for thumbnails \n");
+    H0( " -stat-report              Print the decoder memory usage on exit \n");
+    H0( " -bench-streams <arg>      Benchmark n concurrent decodes of the input held in memory, no output \n");
     H0( " -md5                      MD5 support flag \n");
     H0( " -fps-frm                  Show fps after each frame decoded\n");
     H0( " -fps-summary              Show fps summary");
@@ -161,6 +203,23 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EbSvtAv1DecConfi
                 cli->skip_film_grain = 1;
             else if (EB_STRCMP(cmd_copy[token_index], ANNEX_B_TOKEN) == 0)
                 obu_ctx->is_annexb = 1;
+            else if (EB_STRCMP(cmd_copy[token_index], KEYFRAMES_ONLY_TOKEN) == 0)
+                cli->keyframes_only = 1;
+            else if (EB_STRCMP(cmd_copy[token_index], OUTPUT_SCALE_TOKEN) == 0) {
+                if (config_strings[token_index] == NULL) {
+                    fprintf(stderr, "Invalid CLI option: %s \n", cmd_copy[token_index]);
+                    return EB_ErrorBadParameter;
+                }
+                cli->output_scale = strtoul(config_strings[token_index], NULL, 0);
+                if (cli->output_scale < 1) cli->output_scale = 1;
+            }
+            else if (EB_STRCMP(cmd_copy[token_index], BENCH_STREAMS_TOKEN) == 0) {
+                if (config_strings[token_index] == NULL) {
+                    fprintf(stderr, "Invalid CLI option: %s \n", cmd_copy[token_index]);
+                    return EB_ErrorBadParameter;
+                }
+                cli->bench_streams = strtoul(config_strings[token_index], NULL, 0);
+            }
             else if (EB_STRCMP(cmd_copy[token_index], HELP_TOKEN) == 0)
                 show_help();
             else {
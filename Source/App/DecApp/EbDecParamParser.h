@@ -51,6 +51,14 @@
 #define FPS_SUMMARY_TOKEN "-fps-summary"
 #define FILM_GRAIN_TOKEN "-skip-film-grain"
 #define ANNEX_B_TOKEN "-annex-b"
+#define ASYNC_DEPTH_TOKEN "-async-depth"
+#define ROI_TOKEN "-roi"
+#define SKIP_LOOP_FILTER_TOKEN "-skip-loop-filter"
+#define SKIP_DECODE_TOKEN "-skip-decode"
+#define KEYFRAMES_ONLY_TOKEN "-keyframes-only"
+#define OUTPUT_SCALE_TOKEN "-output-scale"
+#define STAT_REPORT_TOKEN "-stat-report"
+#define BENCH_STREAMS_TOKEN "-bench-streams"
 #define MAX_NUM_TOKENS 200
 
 #define EB_STRCMP(target, token) strcmp(target, token)
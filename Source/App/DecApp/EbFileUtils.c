@@ -199,6 +199,68 @@ int svt_read_obu_header(uint8_t *buffer, size_t buffer_length, size_t *consumed,
     return parse_result;
 }
 
+// Returns 1 when the temporal unit in 'data' holds a shown key frame, from
+// which decoding can start without any reference frame, and 0 otherwise.
+// Only the OBU headers and the first bits of the frame headers are read.
+// 'reduced_still_picture_hdr' carries the flag of the last sequence header
+// seen across calls.
+int obudec_is_random_access_point(const uint8_t *data, size_t size, uint32_t is_annexb,
+                                  int *reduced_still_picture_hdr) {
+    while (size) {
+        uint64_t obu_length = 0;
+        size_t   length_size = 0;
+        if (is_annexb) {
+            if (uleb_decode(data, size, &obu_length, &length_size) != 0) return 0;
+            data += length_size;
+            size -= length_size;
+            if (obu_length > size) return 0;
+        }
+
+        ObuHeader obu_header;
+        size_t    header_size = 0;
+        uint64_t  payload_size;
+        memset(&obu_header, 0, sizeof(obu_header));
+        if (svt_read_obu_header((uint8_t *)data, size, &header_size, &obu_header, is_annexb) != 0)
+            return 0;
+        if (obu_header.has_size_field) {
+            if (uleb_decode(data + header_size, size - header_size, &payload_size, &length_size) !=
+                0)
+                return 0;
+            header_size += length_size;
+        } else {
+            if (obu_length < header_size) return 0;
+            payload_size = obu_length - header_size;
+        }
+        if (payload_size > size - header_size) return 0;
+        if (is_annexb && header_size + payload_size > obu_length) return 0;
+
+        ReadBitBuffer rb = {data + header_size, data + header_size + payload_size, 0};
+        switch (obu_header.type) {
+        case OBU_SEQUENCE_HEADER:
+            rb_read_literal(&rb, 3); // seq_profile
+            rb_read_bit(&rb); // still_picture
+            *reduced_still_picture_hdr = rb_read_bit(&rb);
+            break;
+        case OBU_FRAME_HEADER:
+        case OBU_FRAME:
+            if (*reduced_still_picture_hdr) return 1;
+            if (rb_read_bit(&rb)) return 0; // show_existing_frame
+            {
+                const int frame_type = rb_read_literal(&rb, 2);
+                const int show_frame = rb_read_bit(&rb);
+                return frame_type == 0 /* KEY_FRAME */ && show_frame;
+            }
+        default: break;
+        }
+
+        const size_t obu_size = is_annexb ? (size_t)obu_length
+                                          : header_size + (size_t)payload_size;
+        data += obu_size;
+        size -= obu_size;
+    }
+    return 0;
+}
+
 // Reads OBU header from 'f'. The 'buffer_capacity' passed in must be large
 // enough to store an OBU header with extension (2 bytes). Raw OBU data is
 // written to 'obu_data', parsed OBU header values are written to 'obu_header',
@@ -67,6 +67,9 @@ typedef struct CliInput {
     uint32_t                       fps_frm;
     uint32_t                       fps_summary;
     uint32_t                       skip_film_grain;
+    uint32_t                       keyframes_only;
+    uint32_t                       output_scale;
+    uint32_t                       bench_streams;
 } CliInput;
 
 typedef struct ObuDecInputContext {
@@ -108,9 +111,14 @@ typedef struct {
 } ObuHeader;
 
 int file_is_obu(CliInput *cli, ObuDecInputContext *obu_ctx);
+int obudec_is_random_access_point(const uint8_t *data, size_t size, uint32_t is_annexb,
+                                  int *reduced_still_picture_hdr);
 int obudec_read_temporal_unit(DecInputContext *input, uint8_t **buffer, size_t *bytes_read,
                               size_t *buffer_size);
 
+int read_input_frame(DecInputContext *input, uint8_t **buffer, size_t *bytes_read,
+                     size_t *buffer_size, int64_t *pts);
+
 int file_is_ivf(CliInput *cli);
 int read_ivf_frame(FILE *infile, uint8_t **buffer, size_t *bytes_read, size_t *buffer_size,
                    int64_t *pts);
@@ -44,6 +44,9 @@
 #define PASS_TOKEN "--pass"
 #define TWO_PASS_STATS_TOKEN "--stats"
 #define PASSES_TOKEN "--passes"
+#define FAST_FIRST_PASS_TOKEN "--fast-first-pass"
+#define ANALYSIS_CACHE_OUT_TOKEN "--analysis-cache-out"
+#define ANALYSIS_CACHE_IN_TOKEN "--analysis-cache-in"
 #define INPUT_STAT_FILE_TOKEN "-input-stat-file"
 #define OUTPUT_STAT_FILE_TOKEN "-output-stat-file"
 #define STAT_FILE_TOKEN "-stat-file"
@@ -138,6 +141,7 @@
 #define OVER_SHOOT_PCT_TOKEN "-overshoot-pct"
 #define ADAPTIVE_QP_ENABLE_TOKEN "-adaptive-quantization"
 #define LOOK_AHEAD_DIST_TOKEN "-lad"
+#define SCENE_LOOK_AHEAD_DIST_TOKEN "--scene-lookahead"
 #define ENABLE_TPL_LA_TOKEN "-enable-tpl-la"
 #define SUPER_BLOCK_SIZE_TOKEN "-sb-size"
 #define TILE_ROW_TOKEN "-tile-rows"
@@ -155,6 +159,7 @@
 #define THREAD_MGMNT "-lp"
 #define UNPIN_TOKEN "-unpin"
 #define TARGET_SOCKET "-ss"
+#define MEMORY_BUDGET_TOKEN "--mem-budget"
 #define UNRESTRICTED_MOTION_VECTOR "-umv"
 #define CONFIG_FILE_COMMENT_CHAR '#'
 #define CONFIG_FILE_NEWLINE_CHAR '\n'
@@ -189,6 +194,7 @@
 #define MFMV_ENABLE_NEW_TOKEN "--enable-mfmv"
 #define REDUNDANT_BLK_NEW_TOKEN "--enable-redundant-blk"
 #define SPATIAL_SSE_FL_NEW_TOKEN "--enable-spatial-sse-full-loop-level"
+#define MD_PRED_CACHE_NEW_TOKEN "--enable-md-pred-cache"
 #define OVR_BNDRY_BLK_NEW_TOKEN "--enable-over-bndry-blk"
 #define NEW_NEAREST_COMB_INJECT_NEW_TOKEN "--enable-new-nrst-near-comb"
 #define NX4_4XN_MV_INJECT_NEW_TOKEN "--enable-nx4-4xn-mv-inject"
@@ -322,6 +328,28 @@ static void set_two_pass_stats(const char* value, EbConfig *cfg) {
 #endif
 }
 
+static void set_fast_first_pass(const char* value, EbConfig *cfg) {
+    cfg->fast_first_pass = (EbBool)strtol(value, NULL, 0);
+}
+
+static void set_analysis_cache(const char* value, EbConfig *cfg, uint8_t mode) {
+    free((void*)cfg->analysis_cache_path);
+#ifndef _WIN32
+    cfg->analysis_cache_path = strdup(value);
+#else
+    cfg->analysis_cache_path = _strdup(value);
+#endif
+    cfg->analysis_cache_mode = mode;
+}
+
+static void set_analysis_cache_out(const char* value, EbConfig *cfg) {
+    set_analysis_cache(value, cfg, 1);
+}
+
+static void set_analysis_cache_in(const char* value, EbConfig *cfg) {
+    set_analysis_cache(value, cfg, 2);
+}
+
 static void set_passes(const char* value, EbConfig *cfg) {
     (void)value;
     (void)cfg;
@@ -452,6 +480,9 @@ static void set_enable_redundant_blk_flag(const char *value, EbConfig *cfg) {
 static void set_spatial_sse_full_loop_level_flag(const char *value, EbConfig *cfg) {
     cfg->spatial_sse_full_loop_level = strtol(value, NULL, 0);
 };
+static void set_enable_md_pred_cache_flag(const char *value, EbConfig *cfg) {
+    cfg->enable_md_pred_cache = strtol(value, NULL, 0);
+};
 static void set_over_bndry_blk_flag(const char *value, EbConfig *cfg) {
     cfg->over_bndry_blk = strtol(value, NULL, 0);
 };
@@ -512,6 +543,9 @@ static void set_scene_change_detection(const char *value, EbConfig *cfg) {
 static void set_look_ahead_distance(const char *value, EbConfig *cfg) {
     cfg->look_ahead_distance = strtoul(value, NULL, 0);
 };
+static void set_scene_look_ahead_distance(const char *value, EbConfig *cfg) {
+    cfg->scene_look_ahead_distance = strtoul(value, NULL, 0);
+};
 static void set_enable_tpl_la(const char *value, EbConfig *cfg) {
     cfg->enable_tpl_la = strtoul(value, NULL, 0);
 };
@@ -681,6 +715,9 @@ static void set_unpin_execution(const char *value, EbConfig *cfg) {
 static void set_target_socket(const char *value, EbConfig *cfg) {
     cfg->target_socket = (int32_t)strtol(value, NULL, 0);
 };
+static void set_memory_budget(const char *value, EbConfig *cfg) {
+    cfg->memory_budget_mb = (uint32_t)strtoul(value, NULL, 0);
+};
 static void set_unrestricted_motion_vector(const char *value, EbConfig *cfg) {
     cfg->unrestricted_motion_vector = (EbBool)strtol(value, NULL, 0);
 };
@@ -811,6 +848,11 @@ ConfigEntry config_entry_global_options[] = {
      "Specify  which socket the encoder runs on"
      "--unpin is overwritten to 0 when --ss is set to 0 or 1",
      set_target_socket},
+    {SINGLE_INPUT,
+     MEMORY_BUDGET_TOKEN,
+     "Memory budget of the encoder in MB, buffer pools, lookahead and threads are reduced to fit "
+     "(0: unbounded [default])",
+     set_memory_budget},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -847,6 +889,9 @@ ConfigEntry config_entry_2p[] = {
     {SINGLE_INPUT, PASS_TOKEN, "Multipass bitrate control (1: first pass, generates stats file , 2: second pass, uses stats file)", set_pass},
     {SINGLE_INPUT, TWO_PASS_STATS_TOKEN, "Filename for 2 pass stats(\"svtav1_2pass.log\" : [Default])", set_two_pass_stats},
     {SINGLE_INPUT, PASSES_TOKEN, "Number of passes (1: one pass encode, 2: two passes encode)", set_passes},
+    {SINGLE_INPUT, FAST_FIRST_PASS_TOKEN, "Derive the first pass stats from analysis data only, skipping first pass mode decision (0: OFF[default], 1: ON)", set_fast_first_pass},
+    {SINGLE_INPUT, ANALYSIS_CACHE_OUT_TOKEN, "Write the motion estimation results to an analysis cache file for later encodes of the same source", set_analysis_cache_out},
+    {SINGLE_INPUT, ANALYSIS_CACHE_IN_TOKEN, "Reuse the motion estimation results of an analysis cache file written with the same settings but another QP or rate", set_analysis_cache_in},
     {SINGLE_INPUT, VBR_BIAS_PCT_TOKEN, "CBR/VBR bias (0=CBR, 100=VBR)", set_vbr_bias_pct},
     {SINGLE_INPUT, VBR_MIN_SECTION_PCT_TOKEN, "GOP min bitrate (% of target)", set_vbr_min_section_pct},
     {SINGLE_INPUT, VBR_MAX_SECTION_PCT_TOKEN, "GOP max bitrate (% of target)", set_vbr_max_section_pct},
@@ -916,6 +961,9 @@ ConfigEntry config_entry_specific[] = {
     {SINGLE_INPUT, LOOK_AHEAD_DIST_TOKEN,
     "Set look ahead distance",
     set_look_ahead_distance},
+    {SINGLE_INPUT, SCENE_LOOK_AHEAD_DIST_TOKEN,
+    "Number of future pictures scanned for scene changes at 1/16 resolution, with -scd 1 in CQP only (0: OFF[default], [1 - 240])",
+    set_scene_look_ahead_distance},
     {SINGLE_INPUT,
     ENABLE_TPL_LA_TOKEN,
     "RDO based on frame temporal dependency (0: off, 1: backward source based)",
@@ -933,6 +981,11 @@ ConfigEntry config_entry_specific[] = {
       SPATIAL_SSE_FL_NEW_TOKEN,
       "Enable spatial sse full loop(0: OFF, 1: ON, -1: DEFAULT)",
       set_spatial_sse_full_loop_level_flag},
+    {SINGLE_INPUT,
+     MD_PRED_CACHE_NEW_TOKEN,
+     "Reuse the MD inter predictions across MD stages and block shapes, the output is unchanged "
+     "(0: OFF, 1: ON, -1: DEFAULT)",
+     set_enable_md_pred_cache_flag},
     {SINGLE_INPUT,
      OVR_BNDRY_BLK_NEW_TOKEN,
      "Enable over boundary block mode (0: OFF, 1: ON, -1: DEFAULT)",
@@ -1144,6 +1197,9 @@ ConfigEntry config_entry[] = {
     // two pass
     {SINGLE_INPUT, PASS_TOKEN, "Pass", set_pass},
     {SINGLE_INPUT, TWO_PASS_STATS_TOKEN, "Two pass stat", set_two_pass_stats},
+    {SINGLE_INPUT, FAST_FIRST_PASS_TOKEN, "FastFirstPass", set_fast_first_pass},
+    {SINGLE_INPUT, ANALYSIS_CACHE_OUT_TOKEN, "AnalysisCacheOut", set_analysis_cache_out},
+    {SINGLE_INPUT, ANALYSIS_CACHE_IN_TOKEN, "AnalysisCacheIn", set_analysis_cache_in},
 
     {SINGLE_INPUT, INPUT_PREDSTRUCT_FILE_TOKEN, "PredStructFile", set_pred_struct_file},
     // Picture Dimensions
@@ -1184,6 +1240,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, STAT_REPORT_TOKEN, "StatReport", set_stat_report},
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_rate_control_mode},
     {SINGLE_INPUT, LOOK_AHEAD_DIST_TOKEN, "LookAheadDistance", set_look_ahead_distance},
+    {SINGLE_INPUT, SCENE_LOOK_AHEAD_DIST_TOKEN, "SceneLookAheadDistance", set_scene_look_ahead_distance},
     {SINGLE_INPUT, ENABLE_TPL_LA_TOKEN, "EnableTplLA", set_enable_tpl_la},
     {SINGLE_INPUT, TARGET_BIT_RATE_TOKEN, "TargetBitRate", set_target_bit_rate},
     {SINGLE_INPUT, MAX_QP_TOKEN, "MaxQpAllowed", set_max_qp_allowed},
@@ -1213,6 +1270,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, MFMV_ENABLE_TOKEN, "Mfmv", set_enable_mfmv_flag},
     {SINGLE_INPUT, REDUNDANT_BLK_TOKEN, "RedundantBlock", set_enable_redundant_blk_flag},
     {SINGLE_INPUT, SPATIAL_SSE_FL_TOKEN, "SpatialSSEfl", set_spatial_sse_full_loop_level_flag},
+    {SINGLE_INPUT, MD_PRED_CACHE_NEW_TOKEN, "MdPredCache", set_enable_md_pred_cache_flag},
     {SINGLE_INPUT, OVR_BNDRY_BLK_TOKEN, "OverBoundryBlock", set_over_bndry_blk_flag},
     {SINGLE_INPUT,
      NEW_NEAREST_COMB_INJECT_TOKEN,
@@ -1281,6 +1339,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_logical_processors},
     {SINGLE_INPUT, UNPIN_TOKEN, "UnpinExecution", set_unpin_execution},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_target_socket},
+    {SINGLE_INPUT, MEMORY_BUDGET_TOKEN, "MemoryBudget", set_memory_budget},
     // Optional Features
     {SINGLE_INPUT,
      UNRESTRICTED_MOTION_VECTOR,
@@ -1415,6 +1474,7 @@ void eb_config_ctor(EbConfig *config_ptr) {
     config_ptr->qp                  = 50;
     config_ptr->use_qp_file         = EB_FALSE;
     config_ptr->look_ahead_distance = (uint32_t)~0;
+    config_ptr->scene_look_ahead_distance = 0;
     config_ptr->enable_tpl_la       = 1;
     config_ptr->target_bit_rate     = 7000000;
     config_ptr->max_qp_allowed      = 63;
@@ -1446,6 +1506,7 @@ void eb_config_ctor(EbConfig *config_ptr) {
     config_ptr->enable_mfmv                               = DEFAULT;
     config_ptr->enable_redundant_blk                      = DEFAULT;
     config_ptr->spatial_sse_full_loop_level               = DEFAULT;
+    config_ptr->enable_md_pred_cache                      = DEFAULT;
     config_ptr->over_bndry_blk                            = DEFAULT;
     config_ptr->new_nearest_comb_inject                   = DEFAULT;
     config_ptr->nsq_table                                 = DEFAULT;
@@ -1492,6 +1553,7 @@ void eb_config_ctor(EbConfig *config_ptr) {
 
     config_ptr->unpin     = 1;
     config_ptr->target_socket = -1;
+    config_ptr->memory_budget_mb = 0;
 
     config_ptr->unrestricted_motion_vector = EB_TRUE;
 
@@ -1509,6 +1571,9 @@ void eb_config_ctor(EbConfig *config_ptr) {
     // end - super-resolution support
 
     config_ptr->pass = DEFAULT;
+    config_ptr->fast_first_pass = EB_FALSE;
+    config_ptr->analysis_cache_path = NULL;
+    config_ptr->analysis_cache_mode = 0;
 
     return;
 }
@@ -1563,6 +1628,7 @@ void eb_config_dtor(EbConfig *config_ptr) {
         config_ptr->stat_file = (FILE *)NULL;
     }
     free((void*)config_ptr->stats);
+    free((void*)config_ptr->analysis_cache_path);
     return;
 }
 
@@ -177,6 +177,9 @@ typedef struct EbConfig {
     FILE *        input_stat_file;
     FILE *        output_stat_file;
     EbBool        rc_firstpass_stats_out;
+    EbBool        fast_first_pass;
+    const char*   analysis_cache_path;
+    uint8_t       analysis_cache_mode;
     SvtAv1FixedBuf rc_twopass_stats_in;
 
     FILE *        input_pred_struct_file;
@@ -287,6 +290,10 @@ typedef struct EbConfig {
       * spatial sse in full loop
      ****************************************/
     int spatial_sse_full_loop_level;
+    /****************************************
+     * MD inter prediction cache
+     ****************************************/
+    int enable_md_pred_cache;
     /****************************************
       * over boundry block
      ****************************************/
@@ -403,6 +410,7 @@ typedef struct EbConfig {
     uint32_t scene_change_detection;
     uint32_t rate_control_mode;
     uint32_t look_ahead_distance;
+    uint32_t scene_look_ahead_distance;
     uint32_t enable_tpl_la;
     uint32_t target_bit_rate;
     uint32_t max_qp_allowed;
@@ -455,6 +463,7 @@ typedef struct EbConfig {
     uint32_t logical_processors;
     uint32_t unpin;
     int32_t  target_socket;
+    uint32_t memory_budget_mb;
     EbBool   stop_encoder; // to signal CTRL+C Event, need to stop encoding.
 
     uint64_t processed_frame_count;
@@ -99,6 +99,7 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.tile_columns           = config->tile_columns;
     callback_data->eb_enc_parameters.scene_change_detection = config->scene_change_detection;
     callback_data->eb_enc_parameters.look_ahead_distance    = config->look_ahead_distance;
+    callback_data->eb_enc_parameters.scene_lookahead_distance = config->scene_look_ahead_distance;
     callback_data->eb_enc_parameters.enable_tpl_la          = config->enable_tpl_la;
     callback_data->eb_enc_parameters.rate_control_mode      = config->rate_control_mode;
     callback_data->eb_enc_parameters.target_bit_rate        = config->target_bit_rate;
@@ -116,6 +117,10 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.use_qp_file          = (EbBool)config->use_qp_file;
     callback_data->eb_enc_parameters.rc_twopass_stats_in  = config->rc_twopass_stats_in;
     callback_data->eb_enc_parameters.rc_firstpass_stats_out = config->rc_firstpass_stats_out;
+    callback_data->eb_enc_parameters.rc_firstpass_analysis_only =
+        config->rc_firstpass_stats_out && config->fast_first_pass;
+    callback_data->eb_enc_parameters.analysis_cache_path = config->analysis_cache_path;
+    callback_data->eb_enc_parameters.analysis_cache_mode = config->analysis_cache_mode;
     callback_data->eb_enc_parameters.stat_report          = (EbBool)config->stat_report;
     callback_data->eb_enc_parameters.disable_dlf_flag     = (EbBool)config->disable_dlf_flag;
     callback_data->eb_enc_parameters.enable_warped_motion = config->enable_warped_motion;
@@ -132,6 +137,7 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.enable_mfmv              = config->enable_mfmv;
     callback_data->eb_enc_parameters.enable_redundant_blk     = config->enable_redundant_blk;
     callback_data->eb_enc_parameters.spatial_sse_full_loop_level = config->spatial_sse_full_loop_level;
+    callback_data->eb_enc_parameters.enable_md_pred_cache     = config->enable_md_pred_cache;
     callback_data->eb_enc_parameters.over_bndry_blk           = config->over_bndry_blk;
     callback_data->eb_enc_parameters.new_nearest_comb_inject  = config->new_nearest_comb_inject;
     callback_data->eb_enc_parameters.nsq_table                = config->nsq_table;
@@ -186,6 +192,7 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.logical_processors        = config->logical_processors;
     callback_data->eb_enc_parameters.unpin                 = config->unpin;
     callback_data->eb_enc_parameters.target_socket             = config->target_socket;
+    callback_data->eb_enc_parameters.memory_budget_mb          = config->memory_budget_mb;
     callback_data->eb_enc_parameters.unrestricted_motion_vector =
         config->unrestricted_motion_vector;
     callback_data->eb_enc_parameters.recon_enabled = config->recon_file ? EB_TRUE : EB_FALSE;
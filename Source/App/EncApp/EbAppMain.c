@@ -425,6 +425,27 @@ static EbErrorType encode(EncApp* enc_app, int32_t argc, char *argv[], EncodePas
                             configs[inst_cnt]->performance_context.total_execution_time * 1000,
                             configs[inst_cnt]->performance_context.average_latency,
                             (uint32_t)(configs[inst_cnt]->performance_context.max_latency));
+                    if (configs[inst_cnt]->memory_budget_mb) {
+                        SvtAv1MemoryUsage usage;
+                        if (svt_av1_enc_get_stream_info(
+                                app_callbacks[inst_cnt]->svt_encoder_handle,
+                                SVT_AV1_STREAM_INFO_MEMORY_USAGE,
+                                &usage) == EB_ErrorNone) {
+                            fprintf(stderr,
+                                    "Memory Budget:\t\t%u MB\nEstimated Memory:\t%u MB\nPeak "
+                                    "Memory:\t\t%u MB\n",
+                                    (uint32_t)(usage.budget >> 20),
+                                    (uint32_t)(usage.estimate >> 20),
+                                    (uint32_t)(usage.peak >> 20));
+                            fprintf(stderr,
+                                    "Picture Buffers:\t%u MB\nContexts:\t\t%u MB\nNeighbor "
+                                    "Arrays:\t%u MB\nME Buffers:\t\t%u MB\n",
+                                    (uint32_t)(usage.component[SVT_AV1_MEMORY_PICTURE_BUFFERS] >> 20),
+                                    (uint32_t)(usage.component[SVT_AV1_MEMORY_CONTEXTS] >> 20),
+                                    (uint32_t)(usage.component[SVT_AV1_MEMORY_NEIGHBOR_ARRAYS] >> 20),
+                                    (uint32_t)(usage.component[SVT_AV1_MEMORY_ME_BUFFERS] >> 20));
+                        }
+                    }
                 } else
                     fprintf(
                         stderr, "\nChannel %u Encoding Interrupted\n", (uint32_t)(inst_cnt + 1));
@@ -0,0 +1,269 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+
+static INLINE __m256i clamp_epi32(__m256i v, __m256i low, __m256i high) {
+    return _mm256_min_epi32(_mm256_max_epi32(v, low), high);
+}
+
+static INLINE __m256i load_u8_8x32(const uint8_t *src) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE __m256i load_u16_8x32(const uint16_t *src) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+/* Packs 8 values in [0, 255] */
+static INLINE void store_u8_8x32(uint8_t *dst, __m256i v) {
+    const __m256i v16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(v, v), 0x08);
+    const __m128i v8  = _mm_packus_epi16(_mm256_castsi256_si128(v16), _mm256_castsi256_si128(v16));
+    _mm_storel_epi64((__m128i *)dst, v8);
+}
+
+/* Packs 8 values in [0, 65535] */
+static INLINE void store_u16_8x32(uint16_t *dst, __m256i v) {
+    const __m256i v16 = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08);
+    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(v16));
+}
+
+/* Same as scale_lut() for bit_depth > 8: linear interpolation between the
+   two nearest entries. Clamping x + 1 to 255 gives a zero slope at the end
+   of the table, which matches the scalar special case. */
+static INLINE __m256i scale_lut_hbd_avx2(const int32_t *scaling_lut, __m256i index,
+                                         int32_t bit_depth) {
+    const __m128i shift    = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m256i mask     = _mm256_set1_epi32((1 << (bit_depth - 8)) - 1);
+    const __m256i rounding = _mm256_set1_epi32(1 << (bit_depth - 9));
+    const __m256i x        = _mm256_srl_epi32(index, shift);
+    const __m256i x1       = _mm256_min_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)),
+                                        _mm256_set1_epi32(255));
+    const __m256i start    = _mm256_i32gather_epi32(scaling_lut, x, 4);
+    const __m256i end      = _mm256_i32gather_epi32(scaling_lut, x1, 4);
+    const __m256i delta    = _mm256_mullo_epi32(_mm256_sub_epi32(end, start),
+                                             _mm256_and_si256(index, mask));
+    return _mm256_add_epi32(start, _mm256_sra_epi32(_mm256_add_epi32(delta, rounding), shift));
+}
+
+/* pix + ((scale * grain + rounding) >> scaling_shift), clamped */
+static INLINE __m256i add_noise_avx2(__m256i pix, __m256i scale, const int32_t *grain,
+                                     __m256i rounding, __m128i scaling_shift, __m256i low,
+                                     __m256i high) {
+    const __m256i g     = _mm256_loadu_si256((const __m256i *)grain);
+    const __m256i noise = _mm256_sra_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi32(scale, g), rounding), scaling_shift);
+    return clamp_epi32(_mm256_add_epi32(pix, noise), low, high);
+}
+
+void eb_av1_add_luma_noise_avx2(const int32_t *scaling_lut, uint8_t *luma, int32_t luma_stride,
+                                const int32_t *luma_grain, int32_t luma_grain_stride,
+                                int32_t width, int32_t height, int32_t scaling_shift,
+                                int32_t min_luma, int32_t max_luma) {
+    const int32_t width8   = width & ~7;
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i low      = _mm256_set1_epi32(min_luma);
+    const __m256i high     = _mm256_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t *      row       = luma + i * luma_stride;
+        const int32_t *grain_row = luma_grain + i * luma_grain_stride;
+        for (int32_t j = 0; j < width8; j += 8) {
+            const __m256i pix   = load_u8_8x32(row + j);
+            const __m256i scale = _mm256_i32gather_epi32(scaling_lut, pix, 4);
+            store_u8_8x32(row + j,
+                          add_noise_avx2(pix, scale, grain_row + j, rounding, shift, low, high));
+        }
+    }
+    if (width8 < width)
+        eb_av1_add_luma_noise_c(scaling_lut,
+                                luma + width8,
+                                luma_stride,
+                                luma_grain + width8,
+                                luma_grain_stride,
+                                width - width8,
+                                height,
+                                scaling_shift,
+                                min_luma,
+                                max_luma);
+}
+
+void eb_av1_add_luma_noise_hbd_avx2(const int32_t *scaling_lut, uint16_t *luma,
+                                    int32_t luma_stride, const int32_t *luma_grain,
+                                    int32_t luma_grain_stride, int32_t width, int32_t height,
+                                    int32_t scaling_shift, int32_t min_luma, int32_t max_luma,
+                                    int32_t bit_depth) {
+    const int32_t width8 = bit_depth > 8 ? width & ~7 : 0;
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i low      = _mm256_set1_epi32(min_luma);
+    const __m256i high     = _mm256_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t *     row       = luma + i * luma_stride;
+        const int32_t *grain_row = luma_grain + i * luma_grain_stride;
+        for (int32_t j = 0; j < width8; j += 8) {
+            const __m256i pix   = load_u16_8x32(row + j);
+            const __m256i scale = scale_lut_hbd_avx2(scaling_lut, pix, bit_depth);
+            store_u16_8x32(row + j,
+                           add_noise_avx2(pix, scale, grain_row + j, rounding, shift, low, high));
+        }
+    }
+    if (width8 < width)
+        eb_av1_add_luma_noise_hbd_c(scaling_lut,
+                                    luma + width8,
+                                    luma_stride,
+                                    luma_grain + width8,
+                                    luma_grain_stride,
+                                    width - width8,
+                                    height,
+                                    scaling_shift,
+                                    min_luma,
+                                    max_luma,
+                                    bit_depth);
+}
+
+/* ((average_luma * luma_mult + chroma * mult) >> 6) + offset, clamped to the table index range */
+static INLINE __m256i chroma_index_avx2(__m256i average_luma, __m256i chroma, __m256i luma_mult,
+                                        __m256i mult, __m256i offset, __m256i max_index) {
+    const __m256i merged = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, luma_mult),
+                                            _mm256_mullo_epi32(chroma, mult));
+    return clamp_epi32(_mm256_add_epi32(_mm256_srai_epi32(merged, 6), offset),
+                       _mm256_setzero_si256(),
+                       max_index);
+}
+
+void eb_av1_add_chroma_noise_avx2(const int32_t *scaling_lut, uint8_t *chroma,
+                                  int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride,
+                                  const int32_t *chroma_grain, int32_t chroma_grain_stride,
+                                  int32_t width, int32_t height, int32_t mult, int32_t luma_mult,
+                                  int32_t offset, int32_t scaling_shift, int32_t min_chroma,
+                                  int32_t max_chroma, int32_t chroma_subsamp_y,
+                                  int32_t chroma_subsamp_x) {
+    const int32_t width8    = width & ~7;
+    const __m256i rounding  = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift     = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i low       = _mm256_set1_epi32(min_chroma);
+    const __m256i high      = _mm256_set1_epi32(max_chroma);
+    const __m256i mult_v    = _mm256_set1_epi32(mult);
+    const __m256i lmult_v   = _mm256_set1_epi32(luma_mult);
+    const __m256i offset_v  = _mm256_set1_epi32(offset);
+    const __m256i max_index = _mm256_set1_epi32(255);
+    const __m256i ones      = _mm256_set1_epi16(1);
+    const __m256i one       = _mm256_set1_epi32(1);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t *      row       = chroma + i * chroma_stride;
+        const uint8_t *luma_row  = luma + (i << chroma_subsamp_y) * luma_stride;
+        const int32_t *grain_row = chroma_grain + i * chroma_grain_stride;
+        for (int32_t j = 0; j < width8; j += 8) {
+            __m256i average_luma;
+            if (chroma_subsamp_x) {
+                const __m256i l = _mm256_cvtepu8_epi16(
+                    _mm_loadu_si128((const __m128i *)(luma_row + (j << 1))));
+                average_luma =
+                    _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(l, ones), one), 1);
+            } else
+                average_luma = load_u8_8x32(luma_row + j);
+            const __m256i pix   = load_u8_8x32(row + j);
+            const __m256i index = chroma_index_avx2(
+                average_luma, pix, lmult_v, mult_v, offset_v, max_index);
+            const __m256i scale = _mm256_i32gather_epi32(scaling_lut, index, 4);
+            store_u8_8x32(row + j,
+                          add_noise_avx2(pix, scale, grain_row + j, rounding, shift, low, high));
+        }
+    }
+    if (width8 < width)
+        eb_av1_add_chroma_noise_c(scaling_lut,
+                                  chroma + width8,
+                                  chroma_stride,
+                                  luma + (width8 << chroma_subsamp_x),
+                                  luma_stride,
+                                  chroma_grain + width8,
+                                  chroma_grain_stride,
+                                  width - width8,
+                                  height,
+                                  mult,
+                                  luma_mult,
+                                  offset,
+                                  scaling_shift,
+                                  min_chroma,
+                                  max_chroma,
+                                  chroma_subsamp_y,
+                                  chroma_subsamp_x);
+}
+
+void eb_av1_add_chroma_noise_hbd_avx2(const int32_t *scaling_lut, uint16_t *chroma,
+                                      int32_t chroma_stride, const uint16_t *luma,
+                                      int32_t luma_stride, const int32_t *chroma_grain,
+                                      int32_t chroma_grain_stride, int32_t width, int32_t height,
+                                      int32_t mult, int32_t luma_mult, int32_t offset,
+                                      int32_t scaling_shift, int32_t min_chroma,
+                                      int32_t max_chroma, int32_t chroma_subsamp_y,
+                                      int32_t chroma_subsamp_x, int32_t bit_depth) {
+    const int32_t width8 = bit_depth > 8 ? width & ~7 : 0;
+    const __m256i rounding  = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift     = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i low       = _mm256_set1_epi32(min_chroma);
+    const __m256i high      = _mm256_set1_epi32(max_chroma);
+    const __m256i mult_v    = _mm256_set1_epi32(mult);
+    const __m256i lmult_v   = _mm256_set1_epi32(luma_mult);
+    const __m256i offset_v  = _mm256_set1_epi32(offset);
+    const __m256i max_index = _mm256_set1_epi32((256 << (bit_depth - 8)) - 1);
+    const __m256i ones      = _mm256_set1_epi16(1);
+    const __m256i one       = _mm256_set1_epi32(1);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t *      row       = chroma + i * chroma_stride;
+        const uint16_t *luma_row  = luma + (i << chroma_subsamp_y) * luma_stride;
+        const int32_t * grain_row = chroma_grain + i * chroma_grain_stride;
+        for (int32_t j = 0; j < width8; j += 8) {
+            __m256i average_luma;
+            if (chroma_subsamp_x) {
+                /* Samples are at most 12 bits, so the signed pairwise add is exact */
+                const __m256i l = _mm256_loadu_si256((const __m256i *)(luma_row + (j << 1)));
+                average_luma =
+                    _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(l, ones), one), 1);
+            } else
+                average_luma = load_u16_8x32(luma_row + j);
+            const __m256i pix   = load_u16_8x32(row + j);
+            const __m256i index = chroma_index_avx2(
+                average_luma, pix, lmult_v, mult_v, offset_v, max_index);
+            const __m256i scale = scale_lut_hbd_avx2(scaling_lut, index, bit_depth);
+            store_u16_8x32(row + j,
+                           add_noise_avx2(pix, scale, grain_row + j, rounding, shift, low, high));
+        }
+    }
+    if (width8 < width)
+        eb_av1_add_chroma_noise_hbd_c(scaling_lut,
+                                      chroma + width8,
+                                      chroma_stride,
+                                      luma + (width8 << chroma_subsamp_x),
+                                      luma_stride,
+                                      chroma_grain + width8,
+                                      chroma_grain_stride,
+                                      width - width8,
+                                      height,
+                                      mult,
+                                      luma_mult,
+                                      offset,
+                                      scaling_shift,
+                                      min_chroma,
+                                      max_chroma,
+                                      chroma_subsamp_y,
+                                      chroma_subsamp_x,
+                                      bit_depth);
+}
@@ -154,6 +154,7 @@ enum {
     (MAX_NFL + CAND_CLASS_TOTAL) //need one extra temp buffer for each fast loop call
 #define MAX_NFL_BUFF (MAX_NFL_BUFF_Y + 84) //need one extra temp buffer for each fast loop call
 #define MAX_LAD 120 // max lookahead-distance 2x60fps
+#define MAX_SCENE_LAD 240 // max scene lookahead-distance 4x60fps
 #define ROUND_UV(x) (((x) >> 3) << 3)
 #define AV1_PROB_COST_SHIFT 9
 #define AOMINNERBORDERINPIXELS 160
@@ -2104,6 +2105,7 @@ typedef struct EbMemoryMapEntry
     EbPtr                    ptr;            // points to a memory pointer
     EbPtrType                ptr_type;       // pointer type
     EbPtr                    prev_entry;     // pointer to the prev entry
+    SvtAv1MemoryComponent    component;      // component the pointer is charged to
 } EbMemoryMapEntry;
 
 // Rate Control
@@ -10,6 +10,11 @@
 */
 #include <stdint.h>
 #include <limits.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#endif
 
 #include "EbMalloc.h"
 #include "EbThreads.h"
@@ -21,6 +26,107 @@ void eb_print_alloc_fail(const char* file, int line)
     SVT_FATAL("allocate memory failed, at %s, L%d\n", file, line);
 }
 
+#if defined(_MSC_VER)
+#define EB_THREAD_LOCAL __declspec(thread)
+#else
+#define EB_THREAD_LOCAL __thread
+#endif
+
+static EB_THREAD_LOCAL EbMemoryCounter*      g_memory_counter;
+static EB_THREAD_LOCAL SvtAv1MemoryComponent g_memory_component;
+
+EbMemoryCounter* eb_memory_counter_attach(EbMemoryCounter* counter) {
+    EbMemoryCounter* prev = g_memory_counter;
+    g_memory_counter      = counter;
+    return prev;
+}
+
+EbMemoryCounter* eb_memory_counter_get(void) { return g_memory_counter; }
+
+SvtAv1MemoryComponent eb_memory_component_set(SvtAv1MemoryComponent component) {
+    SvtAv1MemoryComponent prev = g_memory_component;
+    g_memory_component         = component;
+    return prev;
+}
+
+SvtAv1MemoryComponent eb_memory_component_get(void) { return g_memory_component; }
+
+// Size of a live allocation as seen by the allocator, at least what was asked for
+static size_t allocation_size(void* ptr, EbPtrType type) {
+#if defined(_WIN32)
+    return type == EB_A_PTR ? _aligned_msize(ptr, ALVALUE, 0) : _msize(ptr);
+#elif defined(__APPLE__)
+    (void)type;
+    return malloc_size(ptr);
+#elif defined(__linux__)
+    (void)type;
+    return malloc_usable_size(ptr);
+#else
+    (void)ptr;
+    (void)type;
+    return 0;
+#endif
+}
+
+static int64_t memory_counter_add(volatile int64_t* v, int64_t delta) {
+#ifdef _MSC_VER
+    return InterlockedExchangeAdd64((volatile LONG64*)v, delta) + delta;
+#else
+    return __atomic_add_fetch(v, delta, __ATOMIC_RELAXED);
+#endif
+}
+
+static void memory_counter_max(volatile int64_t* v, int64_t value) {
+    int64_t cur = *v;
+    while (value > cur) {
+#ifdef _MSC_VER
+        const int64_t prev = InterlockedCompareExchange64((volatile LONG64*)v, value, cur);
+        if (prev == cur)
+            break;
+        cur = prev;
+#else
+        if (__atomic_compare_exchange_n(
+                v, &cur, value, EB_FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            break;
+#endif
+    }
+}
+
+void eb_memory_count_add(void* ptr, EbPtrType type) {
+    EbMemoryCounter* counter = g_memory_counter;
+    if (!counter || !ptr || type > EB_A_PTR)
+        return;
+    const int64_t size    = (int64_t)allocation_size(ptr, type);
+    const int64_t current = memory_counter_add(&counter->current, size);
+    memory_counter_add(&counter->component[g_memory_component], size);
+    memory_counter_max(&counter->peak, current);
+}
+
+void eb_memory_count_remove_from(void* ptr, EbPtrType type, SvtAv1MemoryComponent component) {
+    EbMemoryCounter* counter = g_memory_counter;
+    if (!counter || !ptr || type > EB_A_PTR)
+        return;
+    const int64_t size = (int64_t)allocation_size(ptr, type);
+    memory_counter_add(&counter->current, -size);
+    memory_counter_add(&counter->component[component], -size);
+}
+
+void eb_memory_count_remove(void* ptr, EbPtrType type) {
+    eb_memory_count_remove_from(ptr, type, g_memory_component);
+}
+
+void eb_memory_counter_get_usage(const EbMemoryCounter* counter, SvtAv1MemoryUsage* usage) {
+    // A component goes below 0 when an object is freed outside of the
+    // component it was allocated in
+    const int64_t current = counter->current;
+    usage->current        = current > 0 ? (uint64_t)current : 0;
+    usage->peak           = (uint64_t)counter->peak;
+    for (int i = 0; i < SVT_AV1_MEMORY_COMPONENT_COUNT; i++) {
+        const int64_t size  = counter->component[i];
+        usage->component[i] = size > 0 ? (uint64_t)size : 0;
+    }
+}
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static EbHandle g_malloc_mutex;
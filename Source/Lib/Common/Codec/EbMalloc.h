@@ -22,6 +22,35 @@
 
 void eb_print_alloc_fail(const char* file, int line);
 
+/**************************************
+     * Memory accounting
+     **************************************/
+// Always on, unlike DEBUG_MEMORY_USAGE: the allocations of a thread are
+// charged to the counter the thread is attached to, if any. Nothing is kept
+// per allocation, the size is read back from the allocator when freeing.
+// Within the counter, the allocations go to the component the thread is
+// currently in, so an object must be freed in the component it was
+// allocated in: tagged objects set it in both their ctor and dctor.
+typedef struct EbMemoryCounter {
+    volatile int64_t current;
+    volatile int64_t peak;
+    volatile int64_t component[SVT_AV1_MEMORY_COMPONENT_COUNT];
+} EbMemoryCounter;
+
+// Attach the calling thread to counter, NULL detaches it. Returns the counter
+// it was attached to. Threads start attached to the counter of their creator.
+EbMemoryCounter* eb_memory_counter_attach(EbMemoryCounter* counter);
+EbMemoryCounter* eb_memory_counter_get(void);
+// Set the component the calling thread allocates in, returns the previous one.
+// Threads start in SVT_AV1_MEMORY_OTHER.
+SvtAv1MemoryComponent eb_memory_component_set(SvtAv1MemoryComponent component);
+SvtAv1MemoryComponent eb_memory_component_get(void);
+void                  eb_memory_count_add(void* ptr, EbPtrType type);
+void                  eb_memory_count_remove(void* ptr, EbPtrType type);
+// Remove an allocation made in component, for owners that keep track of it
+void eb_memory_count_remove_from(void* ptr, EbPtrType type, SvtAv1MemoryComponent component);
+void eb_memory_counter_get_usage(const EbMemoryCounter* counter, SvtAv1MemoryUsage* usage);
+
 #ifdef DEBUG_MEMORY_USAGE
 void eb_print_memory_usage(void);
 void eb_increase_component_count(void);
@@ -56,8 +85,10 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
     do {                                                                                 \
         if (!p)                                                                          \
             eb_print_alloc_fail(__FILE__, __LINE__);                                     \
-        else                                                                             \
+        else {                                                                           \
             EB_ADD_MEM_ENTRY(p, type, size);                                             \
+            eb_memory_count_add(p, type);                                                \
+        }                                                                                \
     } while (0)
 
 #define EB_CHECK_MEM(p)                           \
@@ -97,11 +128,12 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
         EB_CHECK_MEM(pointer);                    \
     } while (0)
 
-#define EB_FREE(pointer)                        \
-    do {                                        \
-        EB_REMOVE_MEM_ENTRY(pointer, EB_N_PTR); \
-        free(pointer);                          \
-        pointer = NULL;                         \
+#define EB_FREE(pointer)                           \
+    do {                                           \
+        EB_REMOVE_MEM_ENTRY(pointer, EB_N_PTR);    \
+        eb_memory_count_remove(pointer, EB_N_PTR); \
+        free(pointer);                             \
+        pointer = NULL;                            \
     } while (0)
 
 #define EB_MALLOC_ARRAY(pa, count) \
@@ -110,10 +142,12 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
 #define EB_REALLOC_ARRAY(pa, count)             \
     do {                                        \
         size_t size = sizeof(*(pa)) * (count);  \
+        eb_memory_count_remove(pa, EB_N_PTR);   \
         void* p = realloc(pa, size);            \
         if (p) {                                \
             EB_REMOVE_MEM_ENTRY(pa, EB_N_PTR);  \
-        }                                       \
+        } else                                  \
+            eb_memory_count_add(pa, EB_N_PTR);  \
         EB_ADD_MEM(p, size, EB_N_PTR);          \
         pa = p;                                 \
     } while (0)
@@ -162,11 +196,12 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
         EB_ADD_MEM(pointer, size, EB_A_PTR);      \
     } while (0)
 
-#define EB_FREE_ALIGNED(pointer)                \
-    do {                                        \
-        EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
-        _aligned_free(pointer);                 \
-        pointer = NULL;                         \
+#define EB_FREE_ALIGNED(pointer)                   \
+    do {                                           \
+        EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR);    \
+        eb_memory_count_remove(pointer, EB_A_PTR); \
+        _aligned_free(pointer);                    \
+        pointer = NULL;                            \
     } while (0)
 #else
 #define EB_MALLOC_ALIGNED(pointer, size)                            \
@@ -176,11 +211,12 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
         EB_ADD_MEM(pointer, size, EB_A_PTR);                        \
     } while (0)
 
-#define EB_FREE_ALIGNED(pointer)                \
-    do {                                        \
-        EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
-        free(pointer);                          \
-        pointer = NULL;                         \
+#define EB_FREE_ALIGNED(pointer)                   \
+    do {                                           \
+        EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR);    \
+        eb_memory_count_remove(pointer, EB_A_PTR); \
+        free(pointer);                             \
+        pointer = NULL;                            \
     } while (0)
 #endif
 
@@ -15,7 +15,8 @@
 #include "EbPictureBufferDesc.h"
 
 static void eb_picture_buffer_desc_dctor(EbPtr p) {
-    EbPictureBufferDesc *obj = (EbPictureBufferDesc *)p;
+    EbPictureBufferDesc *       obj  = (EbPictureBufferDesc *)p;
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_PICTURE_BUFFERS);
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) {
         EB_FREE_ALIGNED_ARRAY(obj->buffer_y);
         EB_FREE_ALIGNED_ARRAY(obj->buffer_bit_inc_y);
@@ -28,16 +29,17 @@ static void eb_picture_buffer_desc_dctor(EbPtr p) {
         EB_FREE_ALIGNED_ARRAY(obj->buffer_cr);
         EB_FREE_ALIGNED_ARRAY(obj->buffer_bit_inc_cr);
     }
+    eb_memory_component_set(prev);
 }
 
 /*****************************************
- * eb_picture_buffer_desc_ctor
+ * picture_buffer_desc_ctor
  *  Initializes the Buffer Descriptor's
  *  values that are fixed for the life of
  *  the descriptor.
  *****************************************/
-EbErrorType eb_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPtr,
-                                        const EbPtr          object_init_data_ptr) {
+static EbErrorType picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPtr,
+                                            const EbPtr          object_init_data_ptr) {
     const EbPictureBufferDescInitData *picture_buffer_desc_init_data_ptr =
         (EbPictureBufferDescInitData *)object_init_data_ptr;
 
@@ -124,22 +126,33 @@ EbErrorType eb_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPt
     return EB_ErrorNone;
 }
 
+// The planes are charged to SVT_AV1_MEMORY_PICTURE_BUFFERS
+EbErrorType eb_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPtr,
+                                        const EbPtr          object_init_data_ptr) {
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_PICTURE_BUFFERS);
+    EbErrorType return_error = picture_buffer_desc_ctor(pictureBufferDescPtr, object_init_data_ptr);
+    eb_memory_component_set(prev);
+    return return_error;
+}
+
 static void eb_recon_picture_buffer_desc_dctor(EbPtr p) {
-    EbPictureBufferDesc *obj = (EbPictureBufferDesc *)p;
+    EbPictureBufferDesc *       obj  = (EbPictureBufferDesc *)p;
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_PICTURE_BUFFERS);
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) EB_FREE_ALIGNED_ARRAY(obj->buffer_y);
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG)
         EB_FREE_ALIGNED_ARRAY(obj->buffer_cb);
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG)
         EB_FREE_ALIGNED_ARRAY(obj->buffer_cr);
+    eb_memory_component_set(prev);
 }
 /*****************************************
- * eb_recon_picture_buffer_desc_ctor
+ * recon_picture_buffer_desc_ctor
  *  Initializes the Buffer Descriptor's
  *  values that are fixed for the life of
  *  the descriptor.
  *****************************************/
-EbErrorType eb_recon_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPtr,
-                                              EbPtr                object_init_data_ptr) {
+static EbErrorType recon_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPtr,
+                                                  EbPtr                object_init_data_ptr) {
     EbPictureBufferDescInitData *picture_buffer_desc_init_data_ptr =
         (EbPictureBufferDescInitData *)object_init_data_ptr;
     const uint16_t subsampling_x =
@@ -191,6 +204,15 @@ EbErrorType eb_recon_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBuffer
     }
     return EB_ErrorNone;
 }
+
+EbErrorType eb_recon_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPtr,
+                                              EbPtr                object_init_data_ptr) {
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_PICTURE_BUFFERS);
+    EbErrorType return_error =
+        recon_picture_buffer_desc_ctor(pictureBufferDescPtr, object_init_data_ptr);
+    eb_memory_component_set(prev);
+    return return_error;
+}
 void link_eb_to_aom_buffer_desc_8bit(EbPictureBufferDesc *picBuffDsc,
                                      Yv12BufferConfig *   aomBuffDsc) {
     //forces an 8 bit version
@@ -26,6 +26,7 @@
  ****************************************/
 #include <stdlib.h>
 #include "EbThreads.h"
+#include "EbMalloc.h"
 #include "EbLog.h"
 /****************************************
   * Win32 Includes
@@ -56,21 +57,54 @@ void printfTime(const char *fmt, ...) {
 #endif
 #endif
 
+/****************************************
+ * Thread start
+ ****************************************/
+// A new thread is attached to the memory counter of the thread creating it,
+// so the allocations of an encoder's threads are charged to that encoder
+typedef struct EbThreadStart {
+    void *(*thread_function)(void *);
+    void *           thread_context;
+    EbMemoryCounter *memory_counter;
+} EbThreadStart;
+
+static void *thread_start(void *p) {
+    EbThreadStart start = *(EbThreadStart *)p;
+    free(p);
+    eb_memory_counter_attach(start.memory_counter);
+    return start.thread_function(start.thread_context);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI thread_start_win32(LPVOID p) {
+    thread_start(p);
+    return 0;
+}
+#endif
+
 /****************************************
  * eb_create_thread
  ****************************************/
 EbHandle eb_create_thread(void *thread_function(void *), void *thread_context) {
     EbHandle thread_handle = NULL;
+    EbThreadStart *start = malloc(sizeof(*start));
+    if (start == NULL)
+        return NULL;
+    start->thread_function = thread_function;
+    start->thread_context  = thread_context;
+    start->memory_counter  = eb_memory_counter_get();
 
 #ifdef _WIN32
 
     thread_handle = (EbHandle)CreateThread(
         NULL, // default security attributes
         0, // default stack size
-        (LPTHREAD_START_ROUTINE)thread_function, // function to be tied to the new thread
-        thread_context, // context to be tied to the new thread
+        thread_start_win32, // function to be tied to the new thread
+        start, // context to be tied to the new thread
         0, // thread active when created
         NULL); // new thread ID
+    if (thread_handle == NULL)
+        free(start);
 
 #else
 
@@ -79,8 +113,10 @@ EbHandle eb_create_thread(void *thread_function(void *), void *thread_context) {
     pthread_attr_t attr;
 
     th = malloc(sizeof(pthread_t));
-    if (th == NULL)
+    if (th == NULL) {
+        free(start);
         return NULL;
+    }
 
 #ifndef EB_THREAD_SANITIZER_ENABLED
     pthread_attr_init(&attr);
@@ -90,13 +126,13 @@ EbHandle eb_create_thread(void *thread_function(void *), void *thread_context) {
     struct sched_param param = {.sched_priority = 99};
     pthread_attr_setschedparam(&attr, &param);
 
-    ret = pthread_create(th, &attr, thread_function, thread_context);
+    ret = pthread_create(th, &attr, thread_start, start);
     pthread_attr_destroy(&attr);
 
     if (ret == EPERM) {
         // When creating the thread failed because setting scheduling
         // parameters failed, retry creating the thread without them.
-        ret = pthread_create(th, NULL, thread_function, thread_context);
+        ret = pthread_create(th, NULL, thread_start, start);
     }
 #else
     // When running with thread sanitizer, we are not running as root
@@ -105,11 +141,12 @@ EbHandle eb_create_thread(void *thread_function(void *), void *thread_context) {
     // See https://github.com/google/sanitizers/issues/1088
     // Therefore we never try this, with the thread sanitizer
     // and just create a normal thread here.
-    ret = pthread_create(th, NULL, thread_function, thread_context);
+    ret = pthread_create(th, NULL, thread_start, start);
 #endif
 
     if (ret != 0) {
         free(th);
+        free(start);
         return NULL;
     }
     thread_handle = th;
@@ -54,6 +54,31 @@ extern EbHandle eb_create_mutex(void);
 extern EbErrorType eb_release_mutex(EbHandle mutex_handle);
 extern EbErrorType eb_block_on_mutex(EbHandle mutex_handle);
 extern EbErrorType eb_destroy_mutex(EbHandle mutex_handle);
+
+/**************************************
+     * Memory ordering
+     **************************************/
+// Full memory barrier : loads and stores are not reordered across it,
+// neither by the compiler nor by the CPU
+#ifdef _MSC_VER
+#define EB_MEMORY_BARRIER() MemoryBarrier()
+#else
+#define EB_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+// Spin loop hint to the CPU
+#ifdef _MSC_VER
+#define EB_CPU_PAUSE() YieldProcessor()
+#elif defined(__x86_64__) || defined(__i386__)
+#define EB_CPU_PAUSE() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define EB_CPU_PAUSE() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define EB_CPU_PAUSE() \
+    do {               \
+    } while (0)
+#endif
+
 extern EbMemoryMapEntry *memory_map; // library Memory table
 extern uint32_t *        memory_map_index; // library memory index
 extern uint64_t *        total_lib_memory; // library Memory malloc'd
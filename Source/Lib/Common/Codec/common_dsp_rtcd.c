@@ -809,6 +809,10 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     eb_aom_highbd_h_predictor_16x32 = eb_aom_highbd_h_predictor_16x32_c;
     eb_log2f = log2f_32;
     eb_memcpy = eb_memcpy_c;
+    eb_av1_add_luma_noise = eb_av1_add_luma_noise_c;
+    eb_av1_add_luma_noise_hbd = eb_av1_add_luma_noise_hbd_c;
+    eb_av1_add_chroma_noise = eb_av1_add_chroma_noise_c;
+    eb_av1_add_chroma_noise_hbd = eb_av1_add_chroma_noise_hbd_c;
 #ifdef ARCH_X86
     flags &= get_cpu_flags_to_use();
     if (flags & HAS_SSE4_1) eb_aom_blend_a64_mask = eb_aom_blend_a64_mask_sse4_1;
@@ -893,6 +897,14 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
         SET_AVX2(full_distortion_kernel16_bits,
             full_distortion_kernel16_bits_c,
             full_distortion_kernel16_bits_avx2);
+        SET_AVX2(eb_av1_add_luma_noise, eb_av1_add_luma_noise_c, eb_av1_add_luma_noise_avx2);
+        SET_AVX2(eb_av1_add_luma_noise_hbd,
+            eb_av1_add_luma_noise_hbd_c,
+            eb_av1_add_luma_noise_hbd_avx2);
+        SET_AVX2(eb_av1_add_chroma_noise, eb_av1_add_chroma_noise_c, eb_av1_add_chroma_noise_avx2);
+        SET_AVX2(eb_av1_add_chroma_noise_hbd,
+            eb_av1_add_chroma_noise_hbd_c,
+            eb_av1_add_chroma_noise_hbd_avx2);
         SET_AVX2_AVX512(residual_kernel8bit,
             residual_kernel8bit_c,
             residual_kernel8bit_avx2,
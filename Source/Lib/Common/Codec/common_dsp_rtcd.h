@@ -175,6 +175,10 @@ extern "C" {
     void convert_8bit_to_16bit_avx2(uint8_t* src, uint32_t src_stride, uint16_t* dst,uint32_t dst_stride, uint32_t width, uint32_t height);
     RTCD_EXTERN void(*convert_16bit_to_8bit)(uint16_t *src, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height);
     void convert_16bit_to_8bit_avx2(uint16_t *src, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height);
+    void eb_av1_add_luma_noise_avx2(const int32_t *scaling_lut, uint8_t *luma, int32_t luma_stride, const int32_t *luma_grain, int32_t luma_grain_stride, int32_t width, int32_t height, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    void eb_av1_add_luma_noise_hbd_avx2(const int32_t *scaling_lut, uint16_t *luma, int32_t luma_stride, const int32_t *luma_grain, int32_t luma_grain_stride, int32_t width, int32_t height, int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth);
+    void eb_av1_add_chroma_noise_avx2(const int32_t *scaling_lut, uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *chroma_grain, int32_t chroma_grain_stride, int32_t width, int32_t height, int32_t mult, int32_t luma_mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+    void eb_av1_add_chroma_noise_hbd_avx2(const int32_t *scaling_lut, uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *chroma_grain, int32_t chroma_grain_stride, int32_t width, int32_t height, int32_t mult, int32_t luma_mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t bit_depth);
     RTCD_EXTERN void(*pack2d_16_bit_src_mul4)(uint8_t *in8_bit_buffer, uint32_t in8_stride, uint8_t *inn_bit_buffer, uint16_t *out16_bit_buffer, uint32_t inn_stride, uint32_t out_stride, uint32_t width, uint32_t height);
     RTCD_EXTERN void(*un_pack2d_16_bit_src_mul4)(uint16_t *in16_bit_buffer, uint32_t in_stride, uint8_t *out8_bit_buffer, uint8_t *outn_bit_buffer, uint32_t out8_stride, uint32_t outn_stride, uint32_t width, uint32_t height);
     void residual_kernel8bit_c(uint8_t *input, uint32_t input_stride, uint8_t *pred, uint32_t pred_stride, int16_t *residual, uint32_t residual_stride, uint32_t area_width, uint32_t area_height);
@@ -1087,6 +1091,14 @@ extern "C" {
     RTCD_EXTERN uint32_t(*eb_log2f)(uint32_t x);
     void eb_memcpy_c(void  *dst_ptr, void  const*src_ptr, size_t size);
     RTCD_EXTERN void (*eb_memcpy)(void  *dst_ptr, void  const*src_ptr, size_t size);
+    void eb_av1_add_luma_noise_c(const int32_t *scaling_lut, uint8_t *luma, int32_t luma_stride, const int32_t *luma_grain, int32_t luma_grain_stride, int32_t width, int32_t height, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    RTCD_EXTERN void(*eb_av1_add_luma_noise)(const int32_t *scaling_lut, uint8_t *luma, int32_t luma_stride, const int32_t *luma_grain, int32_t luma_grain_stride, int32_t width, int32_t height, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    void eb_av1_add_luma_noise_hbd_c(const int32_t *scaling_lut, uint16_t *luma, int32_t luma_stride, const int32_t *luma_grain, int32_t luma_grain_stride, int32_t width, int32_t height, int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth);
+    RTCD_EXTERN void(*eb_av1_add_luma_noise_hbd)(const int32_t *scaling_lut, uint16_t *luma, int32_t luma_stride, const int32_t *luma_grain, int32_t luma_grain_stride, int32_t width, int32_t height, int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth);
+    void eb_av1_add_chroma_noise_c(const int32_t *scaling_lut, uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *chroma_grain, int32_t chroma_grain_stride, int32_t width, int32_t height, int32_t mult, int32_t luma_mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+    RTCD_EXTERN void(*eb_av1_add_chroma_noise)(const int32_t *scaling_lut, uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *chroma_grain, int32_t chroma_grain_stride, int32_t width, int32_t height, int32_t mult, int32_t luma_mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+    void eb_av1_add_chroma_noise_hbd_c(const int32_t *scaling_lut, uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *chroma_grain, int32_t chroma_grain_stride, int32_t width, int32_t height, int32_t mult, int32_t luma_mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t bit_depth);
+    RTCD_EXTERN void(*eb_av1_add_chroma_noise_hbd)(const int32_t *scaling_lut, uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *chroma_grain, int32_t chroma_grain_stride, int32_t width, int32_t height, int32_t mult, int32_t luma_mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t bit_depth);
 #ifdef ARCH_X86
 
     void eb_aom_blend_a64_vmask_sse4_1(uint8_t *dst, uint32_t dst_stride, const uint8_t *src0, uint32_t src0_stride, const uint8_t *src1, uint32_t src1_stride, const uint8_t *mask, int w, int h);
@@ -584,12 +584,133 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
                 (bit_depth - 8));
 }
 
+void eb_av1_add_luma_noise_c(const int32_t *scaling_lut, uint8_t *luma, int32_t luma_stride,
+                             const int32_t *luma_grain, int32_t luma_grain_stride, int32_t width,
+                             int32_t height, int32_t scaling_shift, int32_t min_luma,
+                             int32_t max_luma) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] =
+                clamp(luma[i * luma_stride + j] +
+                          ((scale_lut((int32_t *)scaling_lut, luma[i * luma_stride + j], 8) *
+                                luma_grain[i * luma_grain_stride + j] +
+                            rounding_offset) >>
+                           scaling_shift),
+                      min_luma,
+                      max_luma);
+        }
+    }
+}
+
+void eb_av1_add_luma_noise_hbd_c(const int32_t *scaling_lut, uint16_t *luma, int32_t luma_stride,
+                                 const int32_t *luma_grain, int32_t luma_grain_stride,
+                                 int32_t width, int32_t height, int32_t scaling_shift,
+                                 int32_t min_luma, int32_t max_luma, int32_t bit_depth) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] = clamp(
+                luma[i * luma_stride + j] +
+                    ((scale_lut((int32_t *)scaling_lut, luma[i * luma_stride + j], bit_depth) *
+                          luma_grain[i * luma_grain_stride + j] +
+                      rounding_offset) >>
+                     scaling_shift),
+                min_luma,
+                max_luma);
+        }
+    }
+}
+
+/* width and height are in chroma samples, luma points to the co-located luma samples */
+void eb_av1_add_chroma_noise_c(const int32_t *scaling_lut, uint8_t *chroma, int32_t chroma_stride,
+                               const uint8_t *luma, int32_t luma_stride,
+                               const int32_t *chroma_grain, int32_t chroma_grain_stride,
+                               int32_t width, int32_t height, int32_t mult, int32_t luma_mult,
+                               int32_t offset, int32_t scaling_shift, int32_t min_chroma,
+                               int32_t max_chroma, int32_t chroma_subsamp_y,
+                               int32_t chroma_subsamp_x) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma =
+                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
+                     1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] =
+                clamp(chroma[i * chroma_stride + j] +
+                          ((scale_lut((int32_t *)scaling_lut,
+                                      clamp(((average_luma * luma_mult +
+                                              mult * chroma[i * chroma_stride + j]) >>
+                                             6) +
+                                                offset,
+                                            0,
+                                            255),
+                                      8) *
+                                chroma_grain[i * chroma_grain_stride + j] +
+                            rounding_offset) >>
+                           scaling_shift),
+                      min_chroma,
+                      max_chroma);
+        }
+    }
+}
+
+void eb_av1_add_chroma_noise_hbd_c(const int32_t *scaling_lut, uint16_t *chroma,
+                                   int32_t chroma_stride, const uint16_t *luma,
+                                   int32_t luma_stride, const int32_t *chroma_grain,
+                                   int32_t chroma_grain_stride, int32_t width, int32_t height,
+                                   int32_t mult, int32_t luma_mult, int32_t offset,
+                                   int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma,
+                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+                                   int32_t bit_depth) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma =
+                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
+                     1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] =
+                clamp(chroma[i * chroma_stride + j] +
+                          ((scale_lut((int32_t *)scaling_lut,
+                                      clamp(((average_luma * luma_mult +
+                                              mult * chroma[i * chroma_stride + j]) >>
+                                             6) +
+                                                offset,
+                                            0,
+                                            (256 << (bit_depth - 8)) - 1),
+                                      bit_depth) *
+                                chroma_grain[i * chroma_grain_stride + j] +
+                            rounding_offset) >>
+                           scaling_shift),
+                      min_chroma,
+                      max_chroma);
+        }
+    }
+}
+
 static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
                                int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
                                int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
                                int32_t chroma_grain_stride, int32_t half_luma_height,
                                int32_t half_luma_width, int32_t bit_depth, int32_t chroma_subsamp_y,
                                int32_t chroma_subsamp_x) {
+    (void)bit_depth;
     int32_t cb_mult      = params->cb_mult - 128; // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
     int32_t cb_offset    = params->cb_offset - 256;
@@ -598,8 +719,6 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
     int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
     int32_t cr_offset    = params->cr_offset - 256;
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = (params->num_cb_points > 0 ||
                         params->chroma_scaling_from_luma) ? 1 : 0;
@@ -629,69 +748,24 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
         max_luma = max_chroma = 255;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] =
-                    clamp(cb[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cb,
-                                          clamp(((average_luma * cb_luma_mult +
-                                                  cb_mult * cb[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cb_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          8) *
-                                    cb_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-
-            if (apply_cr) {
-                cr[i * chroma_stride + j] =
-                    clamp(cr[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cr,
-                                          clamp(((average_luma * cr_luma_mult +
-                                                  cr_mult * cr[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cr_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          8) *
-                                    cr_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-        }
-    }
-
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                              ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                                    luma_grain[i * luma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_luma,
-                          max_luma);
-            }
-        }
-    }
+    int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+
+    /* Chroma reads the luma samples before the luma noise is added */
+    if (apply_cb)
+        eb_av1_add_chroma_noise(scaling_lut_cb, cb, chroma_stride, luma, luma_stride, cb_grain,
+                                chroma_grain_stride, chroma_width, chroma_height, cb_mult,
+                                cb_luma_mult, cb_offset, params->scaling_shift, min_chroma,
+                                max_chroma, chroma_subsamp_y, chroma_subsamp_x);
+    if (apply_cr)
+        eb_av1_add_chroma_noise(scaling_lut_cr, cr, chroma_stride, luma, luma_stride, cr_grain,
+                                chroma_grain_stride, chroma_width, chroma_height, cr_mult,
+                                cr_luma_mult, cr_offset, params->scaling_shift, min_chroma,
+                                max_chroma, chroma_subsamp_y, chroma_subsamp_x);
+    if (apply_y)
+        eb_av1_add_luma_noise(scaling_lut_y, luma, luma_stride, luma_grain, luma_grain_stride,
+                              half_luma_width << 1, half_luma_height << 1, params->scaling_shift,
+                              min_luma, max_luma);
 }
 
 static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
@@ -710,8 +784,6 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
     // offset value depends on the bit depth
     int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
@@ -739,68 +811,26 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
         max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] =
-                    clamp(cb[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cb,
-                                          clamp(((average_luma * cb_luma_mult +
-                                                  cb_mult * cb[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cb_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          bit_depth) *
-                                    cb_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] =
-                    clamp(cr[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cr,
-                                          clamp(((average_luma * cr_luma_mult +
-                                                  cr_mult * cr[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cr_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          bit_depth) *
-                                    cr_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-        }
-    }
-
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                              ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], bit_depth) *
-                                    luma_grain[i * luma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_luma,
-                          max_luma);
-            }
-        }
-    }
+    int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+
+    /* Chroma reads the luma samples before the luma noise is added */
+    if (apply_cb)
+        eb_av1_add_chroma_noise_hbd(scaling_lut_cb, cb, chroma_stride, luma, luma_stride,
+                                    cb_grain, chroma_grain_stride, chroma_width, chroma_height,
+                                    cb_mult, cb_luma_mult, cb_offset, params->scaling_shift,
+                                    min_chroma, max_chroma, chroma_subsamp_y, chroma_subsamp_x,
+                                    bit_depth);
+    if (apply_cr)
+        eb_av1_add_chroma_noise_hbd(scaling_lut_cr, cr, chroma_stride, luma, luma_stride,
+                                    cr_grain, chroma_grain_stride, chroma_width, chroma_height,
+                                    cr_mult, cr_luma_mult, cr_offset, params->scaling_shift,
+                                    min_chroma, max_chroma, chroma_subsamp_y, chroma_subsamp_x,
+                                    bit_depth);
+    if (apply_y)
+        eb_av1_add_luma_noise_hbd(scaling_lut_y, luma, luma_stride, luma_grain,
+                                  luma_grain_stride, half_luma_width << 1, half_luma_height << 1,
+                                  params->scaling_shift, min_luma, max_luma, bit_depth);
 }
 
 int32_t film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b) {
@@ -933,10 +963,90 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t
     }
 }
 
-void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
-                               int32_t height, int32_t width, int32_t luma_stride,
-                               int32_t chroma_stride, int32_t use_high_bit_depth,
-                               int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+/* Part of the image the grain is added to, the planes point to its top-left
+   sample */
+typedef struct GrainRegion {
+    uint8_t *luma;
+    uint8_t *cb;
+    uint8_t *cr;
+    int32_t  luma_stride;
+    int32_t  chroma_stride;
+    int32_t  x;
+    int32_t  y;
+    int32_t  width;
+    int32_t  height;
+    int32_t  use_high_bit_depth;
+    int32_t  chroma_subsamp_y;
+    int32_t  chroma_subsamp_x;
+} GrainRegion;
+
+/* Adds the noise of the block at luma position (x, y) of the image to its part
+   inside the region. Positions and sizes are even, as the noise is added in
+   2x2 luma units */
+static void add_noise_to_region(AomFilmGrain *params, const GrainRegion *region, int32_t x,
+                                int32_t y, int32_t *luma_grain, int32_t *cb_grain,
+                                int32_t *cr_grain, int32_t luma_grain_stride,
+                                int32_t chroma_grain_stride, int32_t half_luma_height,
+                                int32_t half_luma_width, int32_t bit_depth) {
+    const int32_t ss_x = region->chroma_subsamp_x;
+    const int32_t ss_y = region->chroma_subsamp_y;
+    const int32_t x0   = AOMMAX(x, region->x);
+    const int32_t y0   = AOMMAX(y, region->y);
+    const int32_t x1   = AOMMIN(x + (half_luma_width << 1), region->x + region->width);
+    const int32_t y1   = AOMMIN(y + (half_luma_height << 1), region->y + region->height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const int32_t chroma_grain_offset =
+        ((y0 - y) >> ss_y) * chroma_grain_stride + ((x0 - x) >> ss_x);
+    const int32_t luma_offset = (y0 - region->y) * region->luma_stride + x0 - region->x;
+    const int32_t chroma_offset =
+        ((y0 - region->y) >> ss_y) * region->chroma_stride + ((x0 - region->x) >> ss_x);
+    luma_grain += (y0 - y) * luma_grain_stride + x0 - x;
+    cb_grain += chroma_grain_offset;
+    cr_grain += chroma_grain_offset;
+
+    if (region->use_high_bit_depth)
+        add_noise_to_block_hbd(params,
+                               (uint16_t *)region->luma + luma_offset,
+                               (uint16_t *)region->cb + chroma_offset,
+                               (uint16_t *)region->cr + chroma_offset,
+                               region->luma_stride,
+                               region->chroma_stride,
+                               luma_grain,
+                               cb_grain,
+                               cr_grain,
+                               luma_grain_stride,
+                               chroma_grain_stride,
+                               (y1 - y0) >> 1,
+                               (x1 - x0) >> 1,
+                               bit_depth,
+                               ss_y,
+                               ss_x);
+    else
+        add_noise_to_block(params,
+                           region->luma + luma_offset,
+                           region->cb + chroma_offset,
+                           region->cr + chroma_offset,
+                           region->luma_stride,
+                           region->chroma_stride,
+                           luma_grain,
+                           cb_grain,
+                           cr_grain,
+                           luma_grain_stride,
+                           chroma_grain_stride,
+                           (y1 - y0) >> 1,
+                           (x1 - x0) >> 1,
+                           bit_depth,
+                           ss_y,
+                           ss_x);
+}
+
+void eb_av1_add_film_grain_region(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                                  int32_t height, int32_t width, int32_t luma_stride,
+                                  int32_t chroma_stride, int32_t use_high_bit_depth,
+                                  int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+                                  int32_t region_x, int32_t region_y, int32_t region_width,
+                                  int32_t region_height) {
     int32_t **pred_pos_luma;
     int32_t **pred_pos_chroma;
     int32_t * luma_grain_block;
@@ -953,6 +1063,22 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
 
     random_register = params->random_seed;
 
+    GrainRegion region = {luma,
+                          cb,
+                          cr,
+                          luma_stride,
+                          chroma_stride,
+                          region_x,
+                          region_y,
+                          region_width,
+                          region_height,
+                          use_high_bit_depth,
+                          chroma_subsamp_y,
+                          chroma_subsamp_x};
+    // The line buffers keep the grain of a whole row of blocks of the image
+    int32_t luma_line_stride   = width;
+    int32_t chroma_line_stride = width >> chroma_subsamp_x;
+
     int32_t left_pad   = 3;
     int32_t right_pad  = 3; // padding to offset for AR coefficients
     int32_t top_pad    = 3;
@@ -992,8 +1118,8 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
     grain_max    = (256 << (bit_depth - 8)) - 1 - grain_center;
 
     init_arrays(params,
-                luma_stride,
-                chroma_stride,
+                luma_line_stride,
+                chroma_line_stride,
                 &pred_pos_luma,
                 &pred_pos_chroma,
                 &luma_grain_block,
@@ -1047,10 +1173,13 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
         init_scaling_function(params->scaling_points_cb, params->num_cb_points, scaling_lut_cb);
         init_scaling_function(params->scaling_points_cr, params->num_cr_points, scaling_lut_cr);
     }
-    for (int32_t y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
+    // Blocks below or right of the region don't add grain to it
+    for (int32_t y = 0; y < height / 2 && (y << 1) < region_y + region_height;
+         y += (luma_subblock_size_y >> 1)) {
         init_random_generator(y * 2, params->random_seed);
 
-        for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
+        for (int32_t x = 0; x < width / 2 && (x << 1) < region_x + region_width;
+             x += (luma_subblock_size_x >> 1)) {
             int32_t offset_y = get_random_number(8);
             int32_t offset_x = (offset_y >> 4) & 15;
             offset_y &= 15;
@@ -1098,211 +1227,123 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
 
                 int32_t i = y ? 1 : 0;
 
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(
-                        params,
-                        luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                }
+                add_noise_to_region(
+                    params,
+                    &region,
+                    x << 1,
+                    (y + i) << 1,
+                    y_col_buf + i * 4,
+                    cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                    cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                    2,
+                    (2 - chroma_subsamp_x),
+                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                    1,
+                    bit_depth);
             }
 
             if (overlap && y) {
                 if (x) {
                     ASSERT(y_col_buf != NULL);
                     hor_boundary_overlap(y_line_buf + (x << 1),
-                                         luma_stride,
+                                         luma_line_stride,
                                          y_col_buf,
                                          2,
                                          y_line_buf + (x << 1),
-                                         luma_stride,
+                                         luma_line_stride,
                                          2,
                                          2);
 
                     hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
+                                         chroma_line_stride,
                                          cb_col_buf,
                                          2 >> chroma_subsamp_x,
                                          cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
+                                         chroma_line_stride,
                                          2 >> chroma_subsamp_x,
                                          2 >> chroma_subsamp_y);
 
                     hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
+                                         chroma_line_stride,
                                          cr_col_buf,
                                          2 >> chroma_subsamp_x,
                                          cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
+                                         chroma_line_stride,
                                          2 >> chroma_subsamp_x,
                                          2 >> chroma_subsamp_y);
                 }
 
                 hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
+                                     luma_line_stride,
                                      luma_grain_block + luma_offset_y * luma_grain_stride +
                                          luma_offset_x + (x ? 2 : 0),
                                      luma_grain_stride,
                                      y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
+                                     luma_line_stride,
                                      AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
                                             width - ((x ? x + 1 : 0) << 1)),
                                      2);
 
                 hor_boundary_overlap(
                     cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
+                    chroma_line_stride,
                     cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
                         ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
                     chroma_grain_stride,
                     cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
+                    chroma_line_stride,
                     AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
                            (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
                     2 >> chroma_subsamp_y);
 
                 hor_boundary_overlap(
                     cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
+                    chroma_line_stride,
                     cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
                         ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
                     chroma_grain_stride,
                     cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
+                    chroma_line_stride,
                     AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
                            (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
                     2 >> chroma_subsamp_y);
 
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        (uint16_t *)cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        luma_stride,
-                        chroma_stride,
-                        y_line_buf + (x << 1),
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(params,
-                                       luma + (y << 1) * luma_stride + (x << 1),
-                                       cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       luma_stride,
-                                       chroma_stride,
-                                       y_line_buf + (x << 1),
-                                       cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       luma_stride,
-                                       chroma_stride,
-                                       1,
-                                       AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                                       bit_depth,
-                                       chroma_subsamp_y,
-                                       chroma_subsamp_x);
-                }
+                add_noise_to_region(
+                    params,
+                    &region,
+                    x << 1,
+                    y << 1,
+                    y_line_buf + (x << 1),
+                    cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                    cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                    luma_line_stride,
+                    chroma_line_stride,
+                    1,
+                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
+                    bit_depth);
             }
 
             int32_t i = overlap && y ? 1 : 0;
             int32_t j = overlap && x ? 1 : 0;
 
-            if (use_high_bit_depth) {
-                add_noise_to_block_hbd(
-                    params,
-                    (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            } else {
-                add_noise_to_block(
-                    params,
-                    luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            }
+            add_noise_to_region(
+                params,
+                &region,
+                (x + j) << 1,
+                (y + i) << 1,
+                luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
+                    luma_offset_x + (j << 1),
+                cb_grain_block +
+                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                cr_grain_block +
+                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                luma_grain_stride,
+                chroma_grain_stride,
+                AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
+                bit_depth);
 
             if (overlap) {
                 if (x) {
@@ -1310,21 +1351,21 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
                     copy_area(y_col_buf + (luma_subblock_size_y << 1),
                               2,
                               y_line_buf + (x << 1),
-                              luma_stride,
+                              luma_line_stride,
                               2,
                               2);
 
                     copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
                               2 >> chroma_subsamp_x,
                               cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
+                              chroma_line_stride,
                               2 >> chroma_subsamp_x,
                               2 >> chroma_subsamp_y);
 
                     copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
                               2 >> chroma_subsamp_x,
                               cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
+                              chroma_line_stride,
                               2 >> chroma_subsamp_x,
                               2 >> chroma_subsamp_y);
                 }
@@ -1335,7 +1376,7 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
                               luma_offset_x + ((x ? 2 : 0)),
                           luma_grain_stride,
                           y_line_buf + ((x ? x + 1 : 0) << 1),
-                          luma_stride,
+                          luma_line_stride,
                           AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
                           2);
 
@@ -1344,7 +1385,7 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
                               chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
                           chroma_grain_stride,
                           cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
+                          chroma_line_stride,
                           AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
                               (x ? 2 >> chroma_subsamp_x : 0),
                           2 >> chroma_subsamp_y);
@@ -1354,7 +1395,7 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
                               chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
                           chroma_grain_stride,
                           cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
+                          chroma_line_stride,
                           AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
                               (x ? 2 >> chroma_subsamp_x : 0),
                           2 >> chroma_subsamp_y);
@@ -1405,6 +1446,27 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
                    &cr_col_buf);
 }
 
+void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                               int32_t height, int32_t width, int32_t luma_stride,
+                               int32_t chroma_stride, int32_t use_high_bit_depth,
+                               int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    eb_av1_add_film_grain_region(params,
+                                 luma,
+                                 cb,
+                                 cr,
+                                 height,
+                                 width,
+                                 luma_stride,
+                                 chroma_stride,
+                                 use_high_bit_depth,
+                                 chroma_subsamp_y,
+                                 chroma_subsamp_x,
+                                 0,
+                                 0,
+                                 width,
+                                 height);
+}
+
 /*
 void av1_film_grain_write_updated(const AomFilmGrain *pars,
                                   int32_t monochrome,
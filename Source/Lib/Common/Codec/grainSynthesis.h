@@ -102,6 +102,31 @@ void eb_av1_add_film_grain_run(AomFilmGrain *grain_params, uint8_t *luma, uint8_
                                int32_t chroma_stride, int32_t use_high_bit_depth,
                                int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
 
+/*!\brief Add film grain to a region of an image
+     *
+     * The grain is generated for the whole image, so the region gets the same
+     * grain as when the whole image is processed
+     *
+     * \param[in]    grain_params     Grain parameters
+     * \param[in]    luma             luma plane, at the top-left sample of the region
+     * \param[in]    cb               cb plane, at the top-left sample of the region
+     * \param[in]    cr               cr plane, at the top-left sample of the region
+     * \param[in]    height           luma image height
+     * \param[in]    width            luma image width
+     * \param[in]    luma_stride      luma plane stride
+     * \param[in]    chroma_stride    chroma plane stride
+     * \param[in]    region_x         luma column of the region in the image, even
+     * \param[in]    region_y         luma row of the region in the image, even
+     * \param[in]    region_width     luma width of the region, even
+     * \param[in]    region_height    luma height of the region, even
+     */
+void eb_av1_add_film_grain_region(AomFilmGrain *grain_params, uint8_t *luma, uint8_t *cb,
+                                  uint8_t *cr, int32_t height, int32_t width, int32_t luma_stride,
+                                  int32_t chroma_stride, int32_t use_high_bit_depth,
+                                  int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+                                  int32_t region_x, int32_t region_y, int32_t region_width,
+                                  int32_t region_height);
+
 /*!\brief Add film grain
      *
      * Add film grain to an image
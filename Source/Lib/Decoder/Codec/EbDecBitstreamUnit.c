@@ -68,6 +68,9 @@
 // Commented it because it is included in EbDecBitstreamUnit.h file.
 //#include "EbBitstreamUnit.h"
 #include "EbDecBitstreamUnit.h"
+#ifdef ARCH_X86
+#include <emmintrin.h>
+#endif
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -84,7 +87,7 @@
    call.*/
 static void od_ec_dec_refill(OdEcDec *dec) {
     int                  s;
-    OdEcWindow           dif;
+    OdEcDecWindow        dif;
     int16_t              cnt;
     const unsigned char *bptr;
     const unsigned char *end;
@@ -92,13 +95,27 @@ static void od_ec_dec_refill(OdEcDec *dec) {
     cnt  = dec->cnt;
     bptr = dec->bptr;
     end  = dec->end;
-    s    = OD_EC_WINDOW_SIZE - 9 - (cnt + 15);
+    s    = OD_EC_DEC_WINDOW_SIZE - 9 - (cnt + 15);
+    if (s >= 0 && end - bptr >= 8) {
+        /*Fast path: insert every whole byte that fits in the window at once.
+       The n bytes land at shifts s, s - 8, ..., s & 7, exactly as the bytewise
+       loop below would place them, which leaves s negative afterwards.*/
+        const int      n     = (s >> 3) + 1;
+        const uint64_t bytes = ((uint64_t)bptr[0] << 56) | ((uint64_t)bptr[1] << 48) |
+            ((uint64_t)bptr[2] << 40) | ((uint64_t)bptr[3] << 32) | ((uint64_t)bptr[4] << 24) |
+            ((uint64_t)bptr[5] << 16) | ((uint64_t)bptr[6] << 8) | (uint64_t)bptr[7];
+        assert(n < 8);
+        dif ^= (OdEcDecWindow)(bytes >> (64 - 8 * n)) << (s & 7);
+        cnt += 8 * n;
+        bptr += n;
+        s -= 8 * n;
+    }
     for (; s >= 0 && bptr < end; s -= 8, bptr++) {
         /*Each time a byte is inserted into the window (dif), bptr advances and cnt
        is incremented by 8, so the total number of consumed bits (the return
        value of od_ec_dec_tell) does not change.*/
-        assert(s <= OD_EC_WINDOW_SIZE - 8);
-        dif ^= (OdEcWindow)bptr[0] << s;
+        assert(s <= OD_EC_DEC_WINDOW_SIZE - 8);
+        dif ^= (OdEcDecWindow)bptr[0] << s;
         cnt += 8;
     }
     if (bptr >= end) {
@@ -129,7 +146,7 @@ static void od_ec_dec_refill(OdEcDec *dec) {
   ret: The value to return.
   Return: ret.
           This allows the compiler to jump to this function via a tail-call.*/
-static int od_ec_dec_normalize(OdEcDec *dec, OdEcWindow dif, unsigned rng, int ret) {
+static int od_ec_dec_normalize(OdEcDec *dec, OdEcDecWindow dif, unsigned rng, int ret) {
     int d;
     assert(rng <= 65535U);
     /*The number of leading zeros in the 16-bit binary representation of rng.*/
@@ -148,10 +165,10 @@ static int od_ec_dec_normalize(OdEcDec *dec, OdEcWindow dif, unsigned rng, int r
   storage: The size in bytes of the input buffer.*/
 static void od_ec_dec_init(OdEcDec *dec, const unsigned char *buf, uint32_t storage) {
     dec->buf       = buf;
-    dec->tell_offs = 10 - (OD_EC_WINDOW_SIZE - 8);
+    dec->tell_offs = 10 - (OD_EC_DEC_WINDOW_SIZE - 8);
     dec->end       = buf + storage;
     dec->bptr      = buf;
-    dec->dif       = ((OdEcWindow)1 << (OD_EC_WINDOW_SIZE - 1)) - 1;
+    dec->dif       = ((OdEcDecWindow)1 << (OD_EC_DEC_WINDOW_SIZE - 1)) - 1;
     dec->rng       = 0x8000;
     dec->cnt       = -15;
     od_ec_dec_refill(dec);
@@ -161,21 +178,21 @@ static void od_ec_dec_init(OdEcDec *dec, const unsigned char *buf, uint32_t stor
   f: The probability that the bit is one, scaled by 32768.
   Return: The value decoded (0 or 1).*/
 int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
-    OdEcWindow dif;
-    OdEcWindow vw;
-    unsigned   r;
-    unsigned   r_new;
-    unsigned   v;
-    int        ret;
+    OdEcDecWindow dif;
+    OdEcDecWindow vw;
+    unsigned      r;
+    unsigned      r_new;
+    unsigned      v;
+    int           ret;
     assert(0 < f);
     assert(f < 32768U);
     dif = dec->dif;
     r   = dec->rng;
-    assert(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+    assert(dif >> (OD_EC_DEC_WINDOW_SIZE - 16) < r);
     assert(32768U <= r);
     v = ((r >> 8) * (uint32_t)(f >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT));
     v += EC_MIN_PROB;
-    vw    = (OdEcWindow)v << (OD_EC_WINDOW_SIZE - 16);
+    vw    = (OdEcDecWindow)v << (OD_EC_DEC_WINDOW_SIZE - 16);
     ret   = 1;
     r_new = v;
     if (dif >= vw) {
@@ -186,6 +203,98 @@ int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
     return od_ec_dec_normalize(dec, dif, r_new, ret);
 }
 
+#ifdef ARCH_X86
+/*Computes the scaled thresholds
+   v = ((r >> 8) * (icdf >> EC_PROB_SHIFT) >> 1) + min_prob for 8 CDF entries.
+  The product fits in 17 bits, so it is rebuilt from the 16-bit low and high
+   halves; after the shift it fits in 16 bits again.*/
+static INLINE __m128i od_ec_cdf_thresholds_sse2(__m128i icdf, __m128i r8, __m128i min_prob) {
+    const __m128i p  = _mm_srli_epi16(icdf, EC_PROB_SHIFT);
+    const __m128i lo = _mm_mullo_epi16(p, r8);
+    const __m128i hi = _mm_mulhi_epu16(p, r8);
+    const __m128i v  = _mm_or_si128(_mm_srli_epi16(lo, 7 - EC_PROB_SHIFT - CDF_SHIFT),
+                                   _mm_slli_epi16(hi, 16 - (7 - EC_PROB_SHIFT - CDF_SHIFT)));
+    return _mm_add_epi16(v, min_prob);
+}
+
+/*Returns a movemask (2 bits per lane) of the thresholds v <= c.*/
+static INLINE unsigned od_ec_le_mask_sse2(__m128i v, __m128i c) {
+    /*v <= c (unsigned) <=> saturate(v - c) == 0.*/
+    return (unsigned)_mm_movemask_epi8(
+        _mm_cmpeq_epi16(_mm_subs_epu16(v, c), _mm_setzero_si128()));
+}
+
+/*Finds the first symbol s with c >= v[s] by comparing all the thresholds at
+   once instead of walking the CDF one entry at a time, see find_symbol_c.
+   nsyms must be at least 8.
+  The CDF arrays hold nsyms + 1 entries (the last one is the adaptation
+   counter), so they are covered with two overlapping 8-entry loads that end
+   no later than the counter rather than reading past the array.*/
+static INLINE int find_symbol_sse2(const uint16_t *icdf, int nsyms, unsigned r, unsigned c,
+                                   unsigned *u, unsigned *v) {
+    DECLARE_ALIGNED(16, uint16_t, vs[16]);
+    const int     start = AOMMIN(nsyms - 7, 8);
+    const __m128i step  = _mm_setr_epi16(0, 4, 8, 12, 16, 20, 24, 28);
+    const __m128i r8    = _mm_set1_epi16((int16_t)(r >> 8));
+    const __m128i c16   = _mm_set1_epi16((int16_t)c);
+    const __m128i min_a =
+        _mm_sub_epi16(_mm_set1_epi16((int16_t)(EC_MIN_PROB * (nsyms - 1))), step);
+    const __m128i min_b =
+        _mm_sub_epi16(_mm_set1_epi16((int16_t)(EC_MIN_PROB * (nsyms - 1 - start))), step);
+    const __m128i va =
+        od_ec_cdf_thresholds_sse2(_mm_loadu_si128((const __m128i *)icdf), r8, min_a);
+    const __m128i vb = od_ec_cdf_thresholds_sse2(
+        _mm_loadu_si128((const __m128i *)(icdf + start)), r8, min_b);
+    /*Lanes past the last symbol (the counter) are masked off; the overlapping
+       lanes of both loads agree.*/
+    const unsigned mask = od_ec_le_mask_sse2(va, c16) |
+        ((od_ec_le_mask_sse2(vb, c16) & ((1u << (2 * (nsyms - start))) - 1)) << (2 * start));
+    assert(nsyms >= 8);
+    assert(mask);
+    const int ret = get_msb(mask & (0u - mask)) >> 1;
+    _mm_store_si128((__m128i *)vs, va);
+    _mm_storeu_si128((__m128i *)(vs + start), vb);
+    *v = vs[ret];
+    *u = ret ? vs[ret - 1] : r;
+    return ret;
+}
+#endif
+
+/*Finds the symbol s whose range [v, u) holds the coded value c, walking the
+   scaled thresholds v = ((r >> 8) * (icdf[s] >> EC_PROB_SHIFT) >> 1) +
+   EC_MIN_PROB * (nsyms - 1 - s) until c >= v.
+  u: Returns the threshold of the previous symbol, r for the first one.
+  v: Returns the threshold of the symbol.
+  Return: The symbol s.*/
+static INLINE int find_symbol_c(const uint16_t *icdf, int nsyms, unsigned r, unsigned c,
+                                unsigned *u, unsigned *v) {
+    const int N   = nsyms - 1;
+    int       ret = -1;
+    unsigned  t   = r;
+    do {
+        *u = t;
+        t  = ((r >> 8) * (uint32_t)(icdf[++ret] >> EC_PROB_SHIFT) >>
+             (7 - EC_PROB_SHIFT - CDF_SHIFT));
+        t += EC_MIN_PROB * (N - ret);
+    } while (c < t);
+    *v = t;
+    return ret;
+}
+
+/*The symbol searches are inlined in od_ec_decode_cdf_q15, these are for the
+   unit tests.*/
+int od_ec_find_symbol_c(const uint16_t *icdf, int nsyms, unsigned r, unsigned c, unsigned *u,
+                        unsigned *v) {
+    return find_symbol_c(icdf, nsyms, r, c, u, v);
+}
+
+#ifdef ARCH_X86
+int od_ec_find_symbol_sse2(const uint16_t *icdf, int nsyms, unsigned r, unsigned c, unsigned *u,
+                           unsigned *v) {
+    return find_symbol_sse2(icdf, nsyms, r, c, u, v);
+}
+#endif
+
 /*Decodes a symbol given an inverse cumulative distribution function (CDF)
    table in Q15.
   icdf: CDF_PROB_TOP minus the CDF, such that symbol s falls in the range
@@ -196,34 +305,32 @@ int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
          This should be at most 16.
   Return: The decoded symbol s.*/
 int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
-    OdEcWindow dif;
-    unsigned   r;
-    unsigned   c;
-    unsigned   u;
-    unsigned   v;
-    int        ret;
-    (void)nsyms;
-    dif         = dec->dif;
-    r           = dec->rng;
-    const int N = nsyms - 1;
-
-    assert(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+    OdEcDecWindow dif;
+    unsigned      r;
+    unsigned      c;
+    unsigned      u;
+    unsigned      v;
+    int           ret;
+    dif = dec->dif;
+    r   = dec->rng;
+
+    assert(dif >> (OD_EC_DEC_WINDOW_SIZE - 16) < r);
     assert(icdf[nsyms - 1] == OD_ICDF(CDF_PROB_TOP));
     assert(32768U <= r);
     assert(7 - EC_PROB_SHIFT - CDF_SHIFT >= 0);
-    c   = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
-    v   = r;
-    ret = -1;
-    do {
-        u = v;
-        v = ((r >> 8) * (uint32_t)(icdf[++ret] >> EC_PROB_SHIFT) >>
-             (7 - EC_PROB_SHIFT - CDF_SHIFT));
-        v += EC_MIN_PROB * (N - ret);
-    } while (c < v);
+    c   = (unsigned)(dif >> (OD_EC_DEC_WINDOW_SIZE - 16));
+#ifdef ARCH_X86
+    /*Small alphabets usually resolve within the first compare or two, where the
+       scalar walk is cheaper than setting up the vectors.*/
+    if (nsyms >= 8)
+        ret = find_symbol_sse2(icdf, nsyms, r, c, &u, &v);
+    else
+#endif
+        ret = find_symbol_c(icdf, nsyms, r, c, &u, &v);
     assert(v < u);
     assert(u <= r);
     r = u - v;
-    dif -= (OdEcWindow)v << (OD_EC_WINDOW_SIZE - 16);
+    dif -= (OdEcDecWindow)v << (OD_EC_DEC_WINDOW_SIZE - 16);
     return od_ec_dec_normalize(dec, dif, r, ret);
 }
 
@@ -38,11 +38,13 @@ extern "C" {
 #define EC_MIN_PROB 4 // must be <= (1<<EC_PROB_SHIFT)/16
 
 /*OPT: OdEcWindow must be at least 32 bits, but if you have fast arithmetic
-   on a larger type, you can speed up the decoder by using it here.*/
-//typedef uint32_t OdEcWindow;
+   on a larger type, you can speed up the decoder by using it here.
+  The encoder keeps the 32-bit OdEcWindow from EbBitstreamUnit.h; the decoder
+   uses a 64-bit window so that a single refill covers many more symbols.*/
+typedef uint64_t OdEcDecWindow;
 
-/*The size in bits of OdEcWindow.*/
-//#define OD_EC_WINDOW_SIZE ((int)sizeof(OdEcWindow) * CHAR_BIT)
+/*The size in bits of OdEcDecWindow.*/
+#define OD_EC_DEC_WINDOW_SIZE ((int)sizeof(OdEcDecWindow) * CHAR_BIT)
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -114,12 +116,12 @@ typedef struct OdEcDec {
 
     /*The difference between the high end of the current range, (low + rng), and
     the coded value, minus 1.
-    This stores up to OD_EC_WINDOW_SIZE bits of that difference, but the
+    This stores up to OD_EC_DEC_WINDOW_SIZE bits of that difference, but the
     decoder only uses the top 16 bits of the window to decode the next symbol.
     As we shift up during renormalization, if we don't have enough bits left in
     the window to fill the top 16, we'll read in more bits of the coded
     value.*/
-    OdEcWindow dif;
+    OdEcDecWindow dif;
     /*The number of values in the current range.*/
     uint16_t rng;
     /*The number of bits of data in the current value.*/
@@ -128,6 +130,12 @@ typedef struct OdEcDec {
 
 int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f);
 int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *cdf, int nsyms);
+int od_ec_find_symbol_c(const uint16_t *icdf, int nsyms, unsigned r, unsigned c, unsigned *u,
+                        unsigned *v);
+#ifdef ARCH_X86
+int od_ec_find_symbol_sse2(const uint16_t *icdf, int nsyms, unsigned r, unsigned c, unsigned *u,
+                           unsigned *v);
+#endif
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -100,6 +100,34 @@ typedef struct SBInfo {
 
 } SBInfo;
 
+/* Storage chunk of a DecSbPool, the data follows the header */
+typedef struct DecSbPoolChunk {
+    struct DecSbPoolChunk *next;
+} DecSbPoolChunk;
+
+/* Frame lifetime storage handed out superblock by superblock. A superblock
+   reserves its worst case and returns the unused part once parsed, so the
+   chunks only grow with what the stream actually codes. Chunks are kept
+   and reused from one frame to the next. */
+typedef struct DecSbPool {
+    DecSbPoolChunk *first_chunk;
+    DecSbPoolChunk *last_chunk;
+    /* First chunk not handed out yet in the current frame */
+    DecSbPoolChunk *next_chunk;
+    size_t          chunk_size;
+    int32_t         num_chunks;
+    int32_t         used_chunks;
+    int32_t         peak_chunks;
+    /* Shared by the pools of a frame, NULL when a single thread parses it */
+    EbHandle mutex;
+} DecSbPool;
+
+/* Position of a tile in a DecSbPool chunk */
+typedef struct DecSbPoolCursor {
+    uint8_t *cur;
+    uint8_t *end;
+} DecSbPoolCursor;
+
 typedef struct PartitionInfo {
     /*!< Specifies the vertical location of the block in units of 4x4 luma samples. */
     uint16_t mi_row;
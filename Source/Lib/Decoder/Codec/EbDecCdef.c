@@ -116,7 +116,13 @@ void svt_cdef_block(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *mi_hi
     int32_t nhb, nvb;
     int32_t cstart     = 0;
     curr_row_cdef[fbc] = 0;
-    if (sb_info == NULL || sb_info->sb_cdef_strength[index] == -1) {
+    /* Blocks outside the region of interest are skipped like unfiltered ones */
+    if (sb_info == NULL || sb_info->sb_cdef_strength[index] == -1 ||
+        !dec_roi_is_active(dec_handle,
+                           MI_SIZE_64X64 * fbr,
+                           MI_SIZE_64X64 * fbc,
+                           MI_SIZE_64X64,
+                           MI_SIZE_64X64)) {
         *cdef_left = 0;
         return;
     }
@@ -490,17 +496,18 @@ void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *m
     }
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
-    volatile uint32_t *cdef_completed_in_prev_row = NULL;
-    uint32_t *         cdef_completed_in_row, nsync = 1;
+    volatile int32_t *cdef_completed_in_prev_row = NULL;
+    volatile int32_t *cdef_completed_in_row;
+    int32_t           nsync = 1;
 
     uint8_t *curr_row_cdef_map = dec_mt_frame_data->row_cdef_map;
     uint32_t cdef_map_stride   = dec_mt_frame_data->cdef_map_stride;
 
     if (sb_fbr) {
         cdef_completed_in_prev_row =
-            (volatile uint32_t *)&dec_mt_frame_data->cdef_completed_in_row[sb_fbr - 1];
+            (volatile int32_t *)&dec_mt_frame_data->cdef_completed_in_row[sb_fbr - 1];
     }
-    cdef_completed_in_row = &dec_mt_frame_data->cdef_completed_in_row[sb_fbr];
+    cdef_completed_in_row = (volatile int32_t *)&dec_mt_frame_data->cdef_completed_in_row[sb_fbr];
 
     int32_t fbc_64, fbr_64;
     int32_t cnt_64           = sb_128 ? 4 : 1;
@@ -520,9 +527,7 @@ void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *m
         /* Top-Right Sync*/
         if (sb_fbr) {
             if (sb_fbc == pic_width_in_sb - 1) nsync = 0;
-            while (*cdef_completed_in_prev_row < (sb_fbc + nsync))
-                ;
-            //Sleep(5); /* ToDo : Change */
+            dec_mt_wait_progress(dec_mt_frame_data, cdef_completed_in_prev_row, sb_fbc + nsync);
         }
         /*Curr multi thread implementation of cdef goes through every SB SIZE row*/
         /*If SB SIZE is 128x128, as cdef excepts top right sync,
@@ -579,7 +584,7 @@ void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *m
                 dec_mt_frame_data->cdef_linebuf_stride);
         }
         /* Update Top-Right Sync*/
-        *cdef_completed_in_row = sb_fbc;
+        dec_mt_set_progress(dec_mt_frame_data, cdef_completed_in_row, sb_fbc);
     }
 }
 
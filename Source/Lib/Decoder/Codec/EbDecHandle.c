@@ -82,6 +82,7 @@ void        dec_sync_all_threads(EbDecHandle *dec_handle_ptr);
 
 EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
                                 uint32_t is_annexb);
+static EbErrorType dec_async_ctor(EbDecHandle *dec_handle_ptr);
 
 static void dec_switch_to_real_time() {
 #ifndef _WIN32
@@ -117,8 +118,15 @@ static EbErrorType eb_dec_handle_ctor(EbDecHandle **decHandleDblPtr, EbComponent
     svt_dec_lib_malloc_count = 0;
 
     dec_handle_ptr->start_thread_process = EB_FALSE;
+    dec_handle_ptr->async_ctxt           = NULL;
+    dec_handle_ptr->thread_ctxt_pa       = NULL;
+    dec_handle_ptr->roi_region.enabled   = EB_FALSE;
+    dec_handle_ptr->frame_dropped        = EB_FALSE;
+    dec_handle_ptr->skip_loop_filters    = EB_FALSE;
+    dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.num_parked = 0;
     memory_map_start_address = NULL;
     memory_map_end_address = NULL;
+    memset(&dec_handle_ptr->memory_counter, 0, sizeof(dec_handle_ptr->memory_counter));
 
     return return_error;
 }
@@ -139,6 +147,21 @@ static void copy_even(uint8_t *luma, uint32_t wd,
             sizeof(*luma) * (wd << use_hbd));
     }
 }
+/* Copies one plane of the recon to the output buffer. Strides are in
+   pixels. A 16 bit source is narrowed when the output is 8 bit */
+static void dec_copy_plane(uint8_t *src, uint32_t src_stride, int32_t src_hbd, uint8_t *dst,
+                           uint32_t dst_stride, int32_t dst_hbd, uint32_t wd, uint32_t ht) {
+    if (src_hbd && !dst_hbd) {
+        convert_16bit_to_8bit((uint16_t *)src, src_stride, dst, dst_stride, wd, ht);
+        return;
+    }
+    for (uint32_t i = 0; i < ht; i++) {
+        eb_memcpy(dst, src, wd << dst_hbd);
+        dst += dst_stride << dst_hbd;
+        src += src_stride << src_hbd;
+    }
+}
+
 /* Copy from recon buffer to out buffer! */
 int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
     EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
@@ -154,12 +177,44 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
         return 0;
     }
 
+    /* Dropped frames have not been reconstructed */
+    if (dec_handle_ptr->frame_dropped) return 0;
+
     uint32_t wd = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
     uint32_t ht = dec_handle_ptr->frame_header.frame_size.frame_height;
     int      sx = 0, sy = 0;
+
     /* FilmGrain module req. even dim. for internal operation */
+    int frame_even_w = (wd & 1) ? (wd + 1) : wd;
+    int frame_even_h = (ht & 1) ? (ht + 1) : ht;
+
+    /* Crop to the region of interest, aligned to the 2x2 luma units of the
+       chroma sampling grid and of the film grain */
+    EbSvtAv1DecConfiguration *config = &dec_handle_ptr->dec_config;
+    uint32_t                  frame_wd = wd, frame_ht = ht;
+    uint32_t                  crop_x = 0, crop_y = 0;
+    if (config->roi_width && config->roi_height && config->roi_x < wd && config->roi_y < ht) {
+        uint32_t x1 = config->roi_width < wd - config->roi_x ? config->roi_x + config->roi_width
+                                                             : wd;
+        uint32_t y1 = config->roi_height < ht - config->roi_y ? config->roi_y + config->roi_height
+                                                              : ht;
+        crop_x      = config->roi_x & ~1;
+        crop_y      = config->roi_y & ~1;
+        wd          = x1 - crop_x;
+        ht          = y1 - crop_y;
+    }
+    uint32_t src_origin_x = recon_picture_buf->origin_x + crop_x;
+    uint32_t src_origin_y = recon_picture_buf->origin_y + crop_y;
+
     int even_w = (wd & 1) ? (wd + 1) : wd;
     int even_h = (ht & 1) ? (ht + 1) : ht;
+    /* The chroma grain reads the luma samples past an odd last column or row,
+       which are part of the frame inside it */
+    AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+    EbBool        apply_grain =
+        !dec_handle_ptr->dec_config.skip_film_grain && film_grain_ptr->apply_grain;
+    uint32_t luma_wd = apply_grain ? AOMMIN((uint32_t)even_w, frame_wd - crop_x) : wd;
+    uint32_t luma_ht = apply_grain ? AOMMIN((uint32_t)even_h, frame_ht - crop_y) : ht;
 
     if (out_img->height != ht || out_img->width != wd ||
         out_img->color_fmt != recon_picture_buf->color_format ||
@@ -253,158 +308,62 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
              << use_high_bit_depth);
     }
 
-    /* Memcpy to dst buffer */
+    /* Copy to dst buffer. A 16 bit pipeline recon of an 8 bit stream is
+       narrowed to 8 bit output on the way */
     {
-        if (recon_picture_buf->bit_depth == EB_8BIT) {
-
-            if (dec_handle_ptr->is_16bit_pipeline) {
-                uint8_t *dst;
-                uint16_t *pu2_src;
-                uint32_t  j;
-                ASSERT(recon_picture_buf->is_16bit_pipeline);
-                ASSERT(luma != NULL);
-                /* Luma */
-                dst = luma;
-                pu2_src = (uint16_t *)recon_picture_buf->buffer_y + recon_picture_buf->origin_x +
-                    (recon_picture_buf->origin_y * recon_picture_buf->stride_y);
-
-                for (uint32_t i = 0; i < ht; i++) {
-                    for (j = 0; j < wd; j++)
-                        dst[j] = (uint8_t)pu2_src[j];
-                    dst += out_img->y_stride;
-                    pu2_src += recon_picture_buf->stride_y;
-                }
-
-                if (recon_picture_buf->color_format != EB_YUV400) {
-                    ASSERT(cb != NULL);
-                    /* Cb */
-                    dst = cb;
-                    pu2_src = (uint16_t *)recon_picture_buf->buffer_cb +
-                        (recon_picture_buf->origin_x >> sx) +
-                        ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb);
-
-                    for (uint32_t i = 0; i < ((ht + sy) >> sy); i++) {
-                        for (j = 0; j < ((wd + sx) >> sx); j++)
-                            dst[j] = (uint8_t)pu2_src[j];
-                        dst += out_img->cb_stride;
-                        pu2_src += recon_picture_buf->stride_cb;
-                    }
-                    ASSERT(cr != NULL);
-                    /* Cr */
-                    dst = cr;
-                    pu2_src = (uint16_t *)recon_picture_buf->buffer_cr +
-                        (recon_picture_buf->origin_x >> sx) +
-                        ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr);
-
-                    for (uint32_t i = 0; i < ((ht + sy) >> sy); i++) {
-                        for (j = 0; j < ((wd + sx) >> sx); j++)
-                            dst[j] = (uint8_t)pu2_src[j];
-                        dst += out_img->cr_stride;
-                        pu2_src += recon_picture_buf->stride_cr;
-                    }
-                }
-            }
-            else {
-            uint8_t *src, *dst;
-            dst = luma;
-            src = recon_picture_buf->buffer_y + recon_picture_buf->origin_x +
-                (recon_picture_buf->origin_y * recon_picture_buf->stride_y);
-
-            for (uint32_t i = 0; i < ht; i++) {
-                eb_memcpy(dst, src, wd);
-                dst += out_img->y_stride;
-                src += recon_picture_buf->stride_y;
-            }
-
-            if (recon_picture_buf->color_format != EB_YUV400) {
-                /* Cb */
-                dst = cb;
-                src = recon_picture_buf->buffer_cb + (recon_picture_buf->origin_x >> sx) +
-                    ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb);
-
-                for (uint32_t i = 0; i < ((ht + sy) >> sy); i++) {
-                    eb_memcpy(dst, src, ((wd + sx) >> sx));
-                    dst += out_img->cb_stride;
-                    src += recon_picture_buf->stride_cb;
-                }
-
-                /* Cr */
-                dst = cr;
-                src = recon_picture_buf->buffer_cr + (recon_picture_buf->origin_x >> sx) +
-                    ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr);
-
-                for (uint32_t i = 0; i < ((ht + sy) >> sy); i++) {
-                    eb_memcpy(dst, src, ((wd + sx) >> sx));
-                    dst += out_img->cr_stride;
-                    src += recon_picture_buf->stride_cr;
-                }
-            }
-        }
-        } else {
-            uint16_t *pu2_dst;
-            uint16_t *pu2_src;
-
-            /* Luma */
-            pu2_dst = (uint16_t *)luma;
-            pu2_src = (uint16_t *)recon_picture_buf->buffer_y + recon_picture_buf->origin_x +
-                      (recon_picture_buf->origin_y * recon_picture_buf->stride_y);
-
-            for (uint32_t i = 0; i < ht; i++) {
-                eb_memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * wd);
-                pu2_dst += out_img->y_stride;
-                pu2_src += recon_picture_buf->stride_y;
-            }
-
-            if (recon_picture_buf->color_format != EB_YUV400) {
-                /* Cb */
-                pu2_dst = (uint16_t *)cb;
-                pu2_src = (uint16_t *)recon_picture_buf->buffer_cb +
-                          (recon_picture_buf->origin_x >> sx) +
-                          ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb);
-
-                for (uint32_t i = 0; i < ((ht + sy) >> sy); i++) {
-                    eb_memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * ((wd + sx) >> sx));
-                    pu2_dst += out_img->cb_stride;
-                    pu2_src += recon_picture_buf->stride_cb;
-                }
-
-                /* Cr */
-                pu2_dst = (uint16_t *)cr;
-                pu2_src = (uint16_t *)recon_picture_buf->buffer_cr +
-                          (recon_picture_buf->origin_x >> sx) +
-                          ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr);
-
-                for (uint32_t i = 0; i < ((ht + sy) >> sy); i++) {
-                    eb_memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * ((wd + sx) >> sx));
-                    pu2_dst += out_img->cr_stride;
-                    pu2_src += recon_picture_buf->stride_cr;
-                }
-            }
+        int32_t  src_hbd = use_high_bit_depth || dec_handle_ptr->is_16bit_pipeline;
+        uint8_t *src_buf[MAX_MB_PLANE] = {
+            recon_picture_buf->buffer_y, recon_picture_buf->buffer_cb, recon_picture_buf->buffer_cr};
+        uint32_t src_stride[MAX_MB_PLANE] = {
+            recon_picture_buf->stride_y, recon_picture_buf->stride_cb, recon_picture_buf->stride_cr};
+        uint8_t *dst_buf[MAX_MB_PLANE]    = {luma, cb, cr};
+        uint32_t dst_stride[MAX_MB_PLANE] = {
+            out_img->y_stride, out_img->cb_stride, out_img->cr_stride};
+        int num_planes = recon_picture_buf->color_format == EB_YUV400 ? 1 : MAX_MB_PLANE;
+
+        ASSERT(!dec_handle_ptr->is_16bit_pipeline || recon_picture_buf->is_16bit_pipeline);
+        for (int plane = 0; plane < num_planes; plane++) {
+            uint32_t ssx = plane ? sx : 0;
+            uint32_t ssy = plane ? sy : 0;
+            uint8_t *src = src_buf[plane] + (((src_origin_y >> ssy) * src_stride[plane] +
+                                              (src_origin_x >> ssx))
+                                             << src_hbd);
+            ASSERT(dst_buf[plane] != NULL);
+            dec_copy_plane(src,
+                           src_stride[plane],
+                           src_hbd,
+                           dst_buf[plane],
+                           dst_stride[plane],
+                           use_high_bit_depth,
+                           plane ? (wd + ssx) >> ssx : luma_wd,
+                           plane ? (ht + ssy) >> ssy : luma_ht);
         }
     }
 
-    if (!dec_handle_ptr->dec_config.skip_film_grain) {
-        /* Need to fill the dst buf with recon data before calling film_grain */
-        AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
-        if (film_grain_ptr->apply_grain) {
-            switch (recon_picture_buf->bit_depth) {
-            case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
-            case EB_10BIT: film_grain_ptr->bit_depth = 10; break;
-            default: assert(0);
-            }
-            copy_even(luma, wd, ht, out_img->y_stride, use_high_bit_depth);
-            eb_av1_add_film_grain_run(film_grain_ptr,
-                                      luma,
-                                      cb,
-                                      cr,
-                                      even_h,/*(ht & 1 ? ht + 1 : ht),*/
-                                      even_w,/*(wd & 1 ? wd + 1 : ht),*/
-                                      out_img->y_stride,
-                                      out_img->cb_stride,
-                                      use_high_bit_depth,
-                                      sy,
-                                      sx);
+    /* Need to fill the dst buf with recon data before calling film_grain */
+    if (apply_grain) {
+        switch (recon_picture_buf->bit_depth) {
+        case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
+        case EB_10BIT: film_grain_ptr->bit_depth = 10; break;
+        default: assert(0);
         }
+        copy_even(luma, luma_wd, luma_ht, out_img->y_stride, use_high_bit_depth);
+        /* The grain of the region is the grain of the frame at its position */
+        eb_av1_add_film_grain_region(film_grain_ptr,
+                                     luma,
+                                     cb,
+                                     cr,
+                                     frame_even_h,
+                                     frame_even_w,
+                                     out_img->y_stride,
+                                     out_img->cb_stride,
+                                     use_high_bit_depth,
+                                     sy,
+                                     sx,
+                                     crop_x,
+                                     crop_y,
+                                     even_w,
+                                     even_h);
     }
 
     return 1;
@@ -442,6 +401,20 @@ EbErrorType eb_svt_dec_set_default_parameter(EbSvtAv1DecConfiguration *config_pt
     config_ptr->threads      = 1;
     config_ptr->num_p_frames = 1;
 
+    /* Asynchronous decode parameters */
+    config_ptr->input_queue_depth  = 0;
+    config_ptr->output_queue_depth = 1;
+
+    /* Region of interest decode parameters */
+    config_ptr->roi_x      = 0;
+    config_ptr->roi_y      = 0;
+    config_ptr->roi_width  = 0;
+    config_ptr->roi_height = 0;
+
+    /* Speed parameters */
+    config_ptr->skip_loop_filter = EB_DEC_SKIP_NONE;
+    config_ptr->skip_frame       = EB_DEC_SKIP_NONE;
+
     return return_error;
 }
 
@@ -526,12 +499,8 @@ svt_av1_dec_set_parameter(EbComponentType *         svt_dec_component,
     return EB_ErrorNone;
 }
 
-EB_API EbErrorType
-svt_av1_dec_init(EbComponentType *svt_dec_component) {
+static EbErrorType dec_init(EbDecHandle *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
-    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
-
-    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
 #ifdef ARCH_X86
     CPU_FLAGS    cpu_flags = get_cpu_flags_to_use();
 #else
@@ -568,18 +537,30 @@ svt_av1_dec_init(EbComponentType *svt_dec_component) {
     return_error = dec_mem_init(dec_handle_ptr);
     if (return_error != EB_ErrorNone) return return_error;
 
+    if (dec_handle_ptr->dec_config.input_queue_depth)
+        return_error = dec_async_ctor(dec_handle_ptr);
+
     return return_error;
 }
 
 EB_API EbErrorType
-svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data, const size_t data_size,
-                    uint32_t is_annexb) {
-    EbErrorType return_error = EB_ErrorNone;
+svt_av1_dec_init(EbComponentType *svt_dec_component) {
     if (svt_dec_component == NULL) return EB_ErrorBadParameter;
 
-    EbDecHandle *dec_handle_ptr       = (EbDecHandle *)svt_dec_component->p_component_private;
-    uint8_t *    data_start           = (uint8_t *)data;
-    uint8_t *    data_end             = (uint8_t *)data + data_size;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    /* The threads created here inherit the memory counter */
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&dec_handle_ptr->memory_counter);
+    EbErrorType      return_error = dec_init(dec_handle_ptr);
+    eb_memory_counter_attach(prev_counter);
+    return return_error;
+}
+
+/* Decodes all the OBUs of one temporal unit on the calling thread */
+static EbErrorType dec_decode_temporal_unit(EbDecHandle *dec_handle_ptr, const uint8_t *data,
+                                            const size_t data_size, uint32_t is_annexb) {
+    EbErrorType return_error          = EB_ErrorNone;
+    uint8_t *   data_start            = (uint8_t *)data;
+    uint8_t *   data_end              = (uint8_t *)data + data_size;
     dec_handle_ptr->seen_frame_header = 0;
 
     while (data_start < data_end) {
@@ -614,6 +595,207 @@ svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data, const
     return return_error;
 }
 
+/* Wakes the application if it is blocked in svt_av1_dec_get_picture.
+   Must be called with the queue mutex held. */
+static void dec_async_signal_app(DecAsyncCtxt *async_ctxt) {
+    if (async_ctxt->app_waiting) {
+        async_ctxt->app_waiting = EB_FALSE;
+        eb_post_semaphore(async_ctxt->output_event_semaphore);
+    }
+}
+
+/* Asynchronous decode kernel: pops temporal units from the input queue,
+   decodes them and pushes the shown pictures to the output queue */
+static void *dec_async_kernel(void *input_ptr) {
+    EbDecHandle * dec_handle_ptr = (EbDecHandle *)input_ptr;
+    DecAsyncCtxt *async_ctxt     = dec_handle_ptr->async_ctxt;
+
+    for (;;) {
+        eb_block_on_semaphore(async_ctxt->input_semaphore);
+        if (async_ctxt->shutdown) break;
+
+        eb_block_on_mutex(async_ctxt->queue_mutex);
+        DecAsyncInput *input = &async_ctxt->input_queue[async_ctxt->input_head];
+        eb_release_mutex(async_ctxt->queue_mutex);
+
+        EbErrorType return_error = dec_decode_temporal_unit(
+            dec_handle_ptr, input->data, input->data_size, input->is_annexb);
+
+        EbBool shown = EB_FALSE;
+        if (dec_handle_ptr->show_frame && !dec_handle_ptr->frame_dropped) {
+            /* The application frees output slots in svt_av1_dec_get_picture */
+            eb_block_on_semaphore(async_ctxt->output_space_semaphore);
+            if (async_ctxt->shutdown) break;
+
+            EbBufferHeaderType out_buf;
+            out_buf.p_buffer = (uint8_t *)&async_ctxt->output_queue[
+                (async_ctxt->output_head + async_ctxt->output_count) % async_ctxt->output_depth];
+            shown = (EbBool)svt_dec_out_buf(dec_handle_ptr, &out_buf);
+            if (!shown) eb_post_semaphore(async_ctxt->output_space_semaphore);
+        }
+
+        eb_block_on_mutex(async_ctxt->queue_mutex);
+        if (return_error != EB_ErrorNone) async_ctxt->decode_error = return_error;
+        if (shown) async_ctxt->output_count++;
+        async_ctxt->input_head = (async_ctxt->input_head + 1) % async_ctxt->input_depth;
+        async_ctxt->input_count--;
+        dec_async_signal_app(async_ctxt);
+        eb_release_mutex(async_ctxt->queue_mutex);
+    }
+    return NULL;
+}
+
+static EbErrorType dec_async_ctor(EbDecHandle *dec_handle_ptr) {
+    DecAsyncCtxt *async_ctxt;
+    EB_MALLOC_DEC(DecAsyncCtxt *, async_ctxt, sizeof(DecAsyncCtxt), EB_N_PTR);
+    memset(async_ctxt, 0, sizeof(*async_ctxt));
+
+    async_ctxt->input_depth  = dec_handle_ptr->dec_config.input_queue_depth;
+    async_ctxt->output_depth = MAX(dec_handle_ptr->dec_config.output_queue_depth, 1);
+    async_ctxt->decode_error = EB_ErrorNone;
+
+    EB_MALLOC_DEC(DecAsyncInput *,
+                  async_ctxt->input_queue,
+                  async_ctxt->input_depth * sizeof(DecAsyncInput),
+                  EB_N_PTR);
+    memset(async_ctxt->input_queue, 0, async_ctxt->input_depth * sizeof(DecAsyncInput));
+
+    /* Output planes are allocated by svt_dec_out_buf and
+       exchanged with the application in svt_av1_dec_get_picture */
+    EB_MALLOC_DEC(EbSvtIOFormat *,
+                  async_ctxt->output_queue,
+                  async_ctxt->output_depth * sizeof(EbSvtIOFormat),
+                  EB_N_PTR);
+    memset(async_ctxt->output_queue, 0, async_ctxt->output_depth * sizeof(EbSvtIOFormat));
+    for (uint32_t i = 0; i < async_ctxt->output_depth; i++)
+        async_ctxt->output_queue[i].bit_depth = dec_handle_ptr->dec_config.max_bit_depth;
+
+    EB_CREATE_MUTEX(async_ctxt->queue_mutex);
+    EB_CREATE_SEMAPHORE(async_ctxt->input_semaphore, 0, async_ctxt->input_depth + 1);
+    EB_CREATE_SEMAPHORE(
+        async_ctxt->output_space_semaphore, async_ctxt->output_depth, async_ctxt->output_depth + 1);
+    EB_CREATE_SEMAPHORE(async_ctxt->output_event_semaphore, 0, 1);
+
+    dec_handle_ptr->async_ctxt = async_ctxt;
+    EB_CREATE_THREAD(async_ctxt->decode_thread, dec_async_kernel, dec_handle_ptr);
+    if (async_ctxt->decode_thread == NULL) return EB_ErrorInsufficientResources;
+
+    return EB_ErrorNone;
+}
+
+/* Stops the asynchronous decode thread. The queued but not yet decoded
+   temporal units are dropped. */
+static void dec_async_dctor(EbDecHandle *dec_handle_ptr) {
+    DecAsyncCtxt *async_ctxt = dec_handle_ptr->async_ctxt;
+    if (async_ctxt == NULL) return;
+
+    async_ctxt->shutdown = EB_TRUE;
+    eb_post_semaphore(async_ctxt->input_semaphore);
+    eb_post_semaphore(async_ctxt->output_space_semaphore);
+    EB_DESTROY_THREAD(async_ctxt->decode_thread);
+
+    EB_DESTROY_SEMAPHORE(async_ctxt->output_event_semaphore);
+    EB_DESTROY_SEMAPHORE(async_ctxt->output_space_semaphore);
+    EB_DESTROY_SEMAPHORE(async_ctxt->input_semaphore);
+    EB_DESTROY_MUTEX(async_ctxt->queue_mutex);
+
+    for (uint32_t i = 0; i < async_ctxt->input_depth; i++) free(async_ctxt->input_queue[i].data);
+    for (uint32_t i = 0; i < async_ctxt->output_depth; i++) {
+        free(async_ctxt->output_queue[i].luma);
+        free(async_ctxt->output_queue[i].cb);
+        free(async_ctxt->output_queue[i].cr);
+    }
+    /* The context itself is released with the decoder memory map */
+    dec_handle_ptr->async_ctxt = NULL;
+}
+
+static EbErrorType dec_async_send(DecAsyncCtxt *async_ctxt, const uint8_t *data,
+                                  const size_t data_size, uint32_t is_annexb) {
+    eb_block_on_mutex(async_ctxt->queue_mutex);
+    if (data == NULL || data_size == 0) {
+        async_ctxt->end_of_stream = EB_TRUE;
+        EbErrorType return_error  = async_ctxt->decode_error;
+        eb_release_mutex(async_ctxt->queue_mutex);
+        return return_error;
+    }
+    if (async_ctxt->input_count == async_ctxt->input_depth) {
+        eb_release_mutex(async_ctxt->queue_mutex);
+        return EB_DecInputQueueFull;
+    }
+    /* Slots past input_count are owned by the application thread */
+    DecAsyncInput *input = &async_ctxt->input_queue[
+        (async_ctxt->input_head + async_ctxt->input_count) % async_ctxt->input_depth];
+    eb_release_mutex(async_ctxt->queue_mutex);
+
+    if (input->alloc_size < data_size) {
+        uint8_t *new_data = (uint8_t *)realloc(input->data, data_size);
+        if (new_data == NULL) return EB_ErrorInsufficientResources;
+        input->data       = new_data;
+        input->alloc_size = data_size;
+    }
+    eb_memcpy(input->data, (void *)data, data_size);
+    input->data_size = data_size;
+    input->is_annexb = is_annexb;
+
+    eb_block_on_mutex(async_ctxt->queue_mutex);
+    async_ctxt->input_count++;
+    async_ctxt->end_of_stream = EB_FALSE;
+    EbErrorType return_error  = async_ctxt->decode_error;
+    eb_release_mutex(async_ctxt->queue_mutex);
+    eb_post_semaphore(async_ctxt->input_semaphore);
+
+    return return_error;
+}
+
+static EbErrorType dec_async_get_picture(DecAsyncCtxt *async_ctxt, EbBufferHeaderType *p_buffer) {
+    for (;;) {
+        eb_block_on_mutex(async_ctxt->queue_mutex);
+        if (async_ctxt->output_count) {
+            /* Hand the decoded planes over and recycle the application's ones */
+            EbSvtIOFormat *out_img = (EbSvtIOFormat *)p_buffer->p_buffer;
+            EbSvtIOFormat  tmp     = *out_img;
+            *out_img               = async_ctxt->output_queue[async_ctxt->output_head];
+            async_ctxt->output_queue[async_ctxt->output_head] = tmp;
+            async_ctxt->output_head = (async_ctxt->output_head + 1) % async_ctxt->output_depth;
+            async_ctxt->output_count--;
+            eb_release_mutex(async_ctxt->queue_mutex);
+            eb_post_semaphore(async_ctxt->output_space_semaphore);
+            return EB_ErrorNone;
+        }
+        /* The decode error is sticky, report it once the queue has drained */
+        if (async_ctxt->input_count == 0 && async_ctxt->decode_error != EB_ErrorNone) {
+            EbErrorType return_error = async_ctxt->decode_error;
+            eb_release_mutex(async_ctxt->queue_mutex);
+            return return_error;
+        }
+        /* Only wait when the application cannot make progress otherwise */
+        if (async_ctxt->input_count == 0 ||
+            (!async_ctxt->end_of_stream && async_ctxt->input_count < async_ctxt->input_depth)) {
+            eb_release_mutex(async_ctxt->queue_mutex);
+            return EB_DecNoOutputPicture;
+        }
+        async_ctxt->app_waiting = EB_TRUE;
+        eb_release_mutex(async_ctxt->queue_mutex);
+        eb_block_on_semaphore(async_ctxt->output_event_semaphore);
+    }
+}
+
+EB_API EbErrorType
+svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data, const size_t data_size,
+                    uint32_t is_annexb) {
+    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    if (dec_handle_ptr->async_ctxt)
+        return dec_async_send(dec_handle_ptr->async_ctxt, data, data_size, is_annexb);
+
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&dec_handle_ptr->memory_counter);
+    EbErrorType      return_error =
+        dec_decode_temporal_unit(dec_handle_ptr, data, data_size, is_annexb);
+    eb_memory_counter_attach(prev_counter);
+    return return_error;
+}
+
 EB_API EbErrorType
 svt_av1_dec_get_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p_buffer,
                        EbAV1StreamInfo *stream_info, EbAV1FrameInfo *frame_info) {
@@ -624,27 +806,30 @@ svt_av1_dec_get_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *
     if (svt_dec_component == NULL) return EB_ErrorBadParameter;
 
     EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    if (dec_handle_ptr->async_ctxt)
+        return dec_async_get_picture(dec_handle_ptr->async_ctxt, p_buffer);
     /* Copy from recon pointer and return! TODO: Should remove the eb_memcpy! */
     if (0 == svt_dec_out_buf(dec_handle_ptr, p_buffer)) return_error = EB_DecNoOutputPicture;
     return return_error;
 }
 
-EB_API EbErrorType
-svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
-    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
-    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
-    EbErrorType  return_error   = EB_ErrorNone;
+static EbErrorType dec_deinit(EbDecHandle *dec_handle_ptr) {
+    EbErrorType return_error = EB_ErrorNone;
 
-    if (!dec_handle_ptr)
-        return EB_ErrorNone;
-    if (dec_handle_ptr->dec_config.threads > 1)
+    /* The asynchronous decode thread must be idle before the workers are released */
+    dec_async_dctor(dec_handle_ptr);
+    /* The worker threads are only created with the first sequence header */
+    if (dec_handle_ptr->dec_config.threads > 1 && dec_handle_ptr->thread_ctxt_pa)
         dec_sync_all_threads(dec_handle_ptr);
+    if (dec_handle_ptr->dec_config.stat_report) dec_print_memory_report(dec_handle_ptr);
     if (!svt_dec_memory_map)
         return EB_ErrorNone;
 
     // Loop through the ptr table and free all malloc'd pointers per channel
     EbMemoryMapEntry *memory_entry = svt_dec_memory_map;
     do {
+        eb_memory_count_remove_from(
+            memory_entry->ptr, memory_entry->ptr_type, memory_entry->component);
         switch (memory_entry->ptr_type) {
         case EB_N_PTR: free(memory_entry->ptr); break;
         case EB_A_PTR:
@@ -667,6 +852,31 @@ svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
     return return_error;
 }
 
+EB_API EbErrorType
+svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
+    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+
+    if (!dec_handle_ptr)
+        return EB_ErrorNone;
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&dec_handle_ptr->memory_counter);
+    EbErrorType      return_error = dec_deinit(dec_handle_ptr);
+    eb_memory_counter_attach(prev_counter);
+    return return_error;
+}
+
+EB_API EbErrorType
+svt_av1_dec_get_memory_usage(EbComponentType *svt_dec_component, SvtAv1MemoryUsage *usage) {
+    if (svt_dec_component == NULL || usage == NULL) return EB_ErrorBadParameter;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    if (!dec_handle_ptr) return EB_ErrorBadParameter;
+
+    eb_memory_counter_get_usage(&dec_handle_ptr->memory_counter, usage);
+    usage->budget   = 0;
+    usage->estimate = 0;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Encoder Componenet DeInit
 **********************************/
@@ -23,6 +23,7 @@ extern "C" {
 #include "EbCabacContextModel.h"
 #include "Av1Common.h"
 #include "EbThreads.h"
+#include "EbMalloc.h"
 
 /* This value is set to 72 to make
    DEC_PAD_VALUE a multiple of 16. */
@@ -86,12 +87,10 @@ typedef struct EbDecPicBuf {
 typedef struct CurFrameBuf {
     SBInfo *sb_info;
 
-    BlockModeInfo *mode_info;
-
+    /* Superblock coeff buf, reused by every superblock when a single
+       thread decodes the frame */
     int32_t *coeff[MAX_MB_PLANE];
 
-    TransformInfo_t *trans_info[MAX_MB_PLANE - 1];
-
     int8_t * cdef_strength;
     int32_t *delta_q;
     int32_t *delta_lf;
@@ -141,12 +140,70 @@ typedef struct MasterFrameBuf {
     /* TODO : Should be moved to thread ctxt */
     FrameMiMap frame_mi_map;
 
+    /* Superblock level ModeInfo and TransformInfo of the current frame,
+       and its coeffs when parse and reconstruction run in parallel */
+    DecSbPool mode_info_pool;
+    DecSbPool trans_info_pool;
+    DecSbPool coeff_pool;
+
     TemporalMvRef *tpl_mvs;
     int32_t        tpl_mvs_size;
     int8_t         ref_frame_side[REF_FRAMES];
 
 } MasterFrameBuf;
 
+/* Temporal unit waiting in the asynchronous input queue */
+typedef struct DecAsyncInput {
+    uint8_t *data;
+    size_t   data_size;
+    size_t   alloc_size;
+    uint32_t is_annexb;
+} DecAsyncInput;
+
+/* Asynchronous decode context: the application submits temporal units to
+   the input queue and a library thread decodes them into the output queue */
+typedef struct DecAsyncCtxt {
+    EbHandle decode_thread;
+    EbHandle queue_mutex;
+    /* Posted once per queued temporal unit */
+    EbHandle input_semaphore;
+    /* Counts the free output slots */
+    EbHandle output_space_semaphore;
+    /* Wakes an application thread waiting in svt_av1_dec_get_picture */
+    EbHandle output_event_semaphore;
+
+    DecAsyncInput *input_queue;
+    uint32_t       input_depth;
+    uint32_t       input_head;
+    /* Includes the temporal unit being decoded */
+    uint32_t       input_count;
+
+    EbSvtIOFormat *output_queue;
+    uint32_t       output_depth;
+    uint32_t       output_head;
+    uint32_t       output_count;
+
+    EbBool      end_of_stream;
+    EbBool      app_waiting;
+    EbBool      shutdown;
+    EbErrorType decode_error;
+} DecAsyncCtxt;
+
+/* Region of the current frame that is reconstructed and filtered when a
+   region of interest is configured, in mi units snapped to tile boundaries,
+   and the luma samples of the upscaled frame that are loop restored */
+typedef struct DecRoiRegion {
+    EbBool  enabled;
+    int32_t mi_row_start;
+    int32_t mi_row_end;
+    int32_t mi_col_start;
+    int32_t mi_col_end;
+    int32_t lr_x_start;
+    int32_t lr_x_end;
+    int32_t lr_y_start;
+    int32_t lr_y_end;
+} DecRoiRegion;
+
 /**************************************
  * Component Private Data
  **************************************/
@@ -245,7 +302,21 @@ typedef struct EbDecHandle {
     EbHandle              thread_semaphore;
     struct DecThreadCtxt *thread_ctxt_pa;
 
+    /* NULL when decoding synchronously on the caller's thread */
+    DecAsyncCtxt *async_ctxt;
+
+    /* Tiles of the current frame to reconstruct for the region of interest */
+    DecRoiRegion roi_region;
+
+    /* Current frame is parsed only, as requested by dec_config.skip_frame */
+    EbBool frame_dropped;
+    /* In-loop filters are bypassed for the current frame */
+    EbBool skip_loop_filters;
+
     EbBool is_16bit_pipeline; // internal bit-depth: when equals 1 internal bit-depth is 16bits regardless of the input bit-depth
+
+    /* Memory allocated by the instance and its threads */
+    EbMemoryCounter memory_counter;
 } EbDecHandle;
 
 /* Thread level context data */
@@ -751,6 +751,16 @@ void dec_loop_filter_sb(EbDecHandle *dec_handle,
     }
 }
 
+/* Returns whether the SB needs filtering for the region of interest. The
+   horizontal edges of an SB are filtered along with its right neighbour when
+   combine_vert_horz_lf is set, so the SB right of the region is kept too. */
+static INLINE EbBool dec_lf_sb_in_roi(EbDecHandle *dec_handle, int32_t mi_row, int32_t mi_col) {
+    int32_t sb_mi_size = dec_handle->seq_header.sb_mi_size;
+    return dec_roi_is_active(dec_handle, mi_row, mi_col, sb_mi_size, sb_mi_size) ||
+        (mi_col &&
+         dec_roi_is_active(dec_handle, mi_row, mi_col - sb_mi_size, sb_mi_size, sb_mi_size));
+}
+
 /* Row level function to trigger loop filter for each superblock*/
 void dec_loop_filter_row(EbDecHandle *dec_handle_ptr,
                          EbPictureBufferDesc *recon_picture_buf,
@@ -773,7 +783,8 @@ void dec_loop_filter_row(EbDecHandle *dec_handle_ptr,
         sb_lf_completed_in_prev_row =
             (volatile int32_t *)&lf_frame_info->sb_lf_completed_in_row[y_sb_index - 1];
     }
-    int32_t *sb_lf_completed_in_row = &lf_frame_info->sb_lf_completed_in_row[y_sb_index];
+    volatile int32_t *sb_lf_completed_in_row =
+        (volatile int32_t *)&lf_frame_info->sb_lf_completed_in_row[y_sb_index];
 
     for (int32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
         int32_t sb_origin_x     = x_sb_index << sb_size_log2;
@@ -784,24 +795,26 @@ void dec_loop_filter_row(EbDecHandle *dec_handle_ptr,
 
         /* Top-Right Sync*/
         if (y_sb_index) {
-            while (*sb_lf_completed_in_prev_row < MIN((x_sb_index + 2), pic_width_in_sb - 1))
-                ;
+            dec_mt_wait_progress(&frame_buf->dec_mt_frame_data,
+                                 sb_lf_completed_in_prev_row,
+                                 MIN((x_sb_index + 2), pic_width_in_sb - 1));
         }
         /*LF function for a SB*/
-        dec_loop_filter_sb(dec_handle_ptr,
-                           sb_info,
-                           frm_hdr,
-                           seq_header,
-                           recon_picture_buf,
-                           lf_ctxt,
-                           sb_origin_y >> 2,
-                           sb_origin_x >> 2,
-                           plane_start,
-                           plane_end,
-                           end_of_row_flag,
-                           sb_info->sb_delta_lf);
+        if (dec_lf_sb_in_roi(dec_handle_ptr, sb_origin_y >> 2, sb_origin_x >> 2))
+            dec_loop_filter_sb(dec_handle_ptr,
+                               sb_info,
+                               frm_hdr,
+                               seq_header,
+                               recon_picture_buf,
+                               lf_ctxt,
+                               sb_origin_y >> 2,
+                               sb_origin_x >> 2,
+                               plane_start,
+                               plane_end,
+                               end_of_row_flag,
+                               sb_info->sb_delta_lf);
         /* Update Top-Right Sync*/
-        *sb_lf_completed_in_row = x_sb_index;
+        dec_mt_set_progress(&frame_buf->dec_mt_frame_data, sb_lf_completed_in_row, x_sb_index);
     }
 }
 
@@ -863,6 +876,8 @@ void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr,
                     ((y_sb_index * master_frame_buf->sb_cols) + x_sb_index));*/
 
                 /*LF function for a SB*/
+                if (!dec_lf_sb_in_roi(dec_handle_ptr, sb_origin_y >> 2, sb_origin_x >> 2))
+                    continue;
                 dec_loop_filter_sb(dec_handle_ptr,
                                    sb_info,
                                    frm_hdr,
@@ -35,6 +35,7 @@
 #include "EbDecLF.h"
 
 #include "EbUtility.h"
+#include "EbLog.h"
 
 /*TODO: Remove and harmonize with encoder. Globals prevent harmonization now! */
 /*****************************************
@@ -129,6 +130,68 @@ EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
 for all the frames in parallel
 **********************************/
 
+/* Number of worst case SB reservations held by a pool chunk */
+#define DEC_SB_POOL_CHUNK_SBS 16
+
+static void dec_sb_pool_init(DecSbPool *pool, size_t sb_max_size, EbHandle mutex) {
+    pool->first_chunk = NULL;
+    pool->last_chunk  = NULL;
+    pool->next_chunk  = NULL;
+    pool->chunk_size  = ALIGN_POWER_OF_TWO(sb_max_size, 3) * DEC_SB_POOL_CHUNK_SBS;
+    pool->num_chunks  = 0;
+    pool->used_chunks = 0;
+    pool->peak_chunks = 0;
+    pool->mutex       = mutex;
+}
+
+static EbErrorType dec_sb_pool_alloc_chunk(DecSbPool *pool) {
+    DecSbPoolChunk *chunk;
+    EB_MALLOC_DEC(DecSbPoolChunk *, chunk,
+        sizeof(DecSbPoolChunk) + pool->chunk_size, EB_N_PTR);
+    chunk->next = NULL;
+    if (pool->last_chunk)
+        pool->last_chunk->next = chunk;
+    else
+        pool->first_chunk = chunk;
+    pool->last_chunk = chunk;
+    pool->num_chunks++;
+    return EB_ErrorNone;
+}
+
+/* Hands all the chunks back, to be called before the first SB of a frame */
+void dec_sb_pool_reset(DecSbPool *pool) {
+    pool->next_chunk  = pool->first_chunk;
+    pool->used_chunks = 0;
+}
+
+/* Returns 'size' bytes for the SB being parsed at the cursor, moving the
+   cursor to a new chunk when the current one is full. Chunks are allocated
+   on demand. Returns NULL when out of memory. */
+void *dec_sb_pool_reserve(DecSbPool *pool, DecSbPoolCursor *cursor, size_t size) {
+    if ((size_t)(cursor->end - cursor->cur) >= size) return cursor->cur;
+
+    assert(size <= pool->chunk_size);
+    if (pool->mutex) eb_block_on_mutex(pool->mutex);
+    EbErrorType return_error = EB_ErrorNone;
+    if (!pool->next_chunk) {
+        return_error = dec_sb_pool_alloc_chunk(pool);
+        pool->next_chunk = pool->last_chunk;
+    }
+    DecSbPoolChunk *chunk = NULL;
+    if (return_error == EB_ErrorNone) {
+        chunk = pool->next_chunk;
+        pool->next_chunk = chunk->next;
+        pool->used_chunks++;
+        pool->peak_chunks = AOMMAX(pool->peak_chunks, pool->used_chunks);
+    }
+    if (pool->mutex) eb_release_mutex(pool->mutex);
+    if (!chunk) return NULL;
+
+    cursor->cur = (uint8_t *)(chunk + 1);
+    cursor->end = cursor->cur + pool->chunk_size;
+    return cursor->cur;
+}
+
 static EbErrorType init_master_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
@@ -171,101 +234,20 @@ static EbErrorType init_master_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
         EB_MALLOC_DEC(SBInfo*, cur_frame_buf->sb_info,
             (num_sb * sizeof(SBInfo)), EB_N_PTR);
 
-        /* ModeInfo str allocation at 4x4 level */
-        EB_MALLOC_DEC(BlockModeInfo*, cur_frame_buf->mode_info,
-                    (num_sb * num_mis_in_sb * sizeof(BlockModeInfo)), EB_N_PTR);
-
-        /* TransformInfo str allocation at 4x4 level
-           TO-DO optimize memory based on the chroma subsampling.*/
-        EB_MALLOC_DEC(TransformInfo_t*, cur_frame_buf->trans_info[AOM_PLANE_Y],
-            (num_sb * num_mis_in_sb * sizeof(TransformInfo_t)), EB_N_PTR);
-
-        /* Coeff buf (1D compact) allocation for entire frame
-            TODO: Should reduce this to save memory and
-            dynammically allocate if needed */
-            /*TODO : Change to macro */
-            /* (16+1) : 1 for Length and 16 for all coeffs in 4x4 */
+        /* Coeff buf (1D compact) allocation for one SB, reused by every SB
+           when decoding on a single thread. The multi-threaded path carves
+           the coeffs of each SB out of coeff_pool instead.
+           (16+1) : 1 for Length and 16 for all coeffs in 4x4 */
         if (is_st) {
-            /*Size of coeff buf reduced to sb_sizesss*/
+            int32_t ss_shift = seq_header->color_config.subsampling_x +
+                               seq_header->color_config.subsampling_y;
             EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_Y],
                 (num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
+            EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
+                (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> ss_shift), EB_N_PTR);
+            EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
+                (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> ss_shift), EB_N_PTR);
         }
-        else {
-            EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_Y],
-                (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
-        }
-
-        /*TODO : Change to macro */
-        EB_MALLOC_DEC(TransformInfo_t*, cur_frame_buf->trans_info[AOM_PLANE_U],
-            (num_sb * num_mis_in_sb * sizeof(TransformInfo_t) * 2), EB_N_PTR);
-
-        /* Coeff buf (1D compact) allocation for entire frame
-        TODO: Should reduce this to save memory and
-        dynammically allocate if needed */
-        /*TODO : Change to macro */
-        /* (16+1) : 1 for Length and 16 for all coeffs in 4x4 */
-        if (seq_header->color_config.subsampling_x == 1 &&
-            seq_header->color_config.subsampling_y == 1) // 420
-        {
-            if (is_st) {
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
-                    (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2), EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
-                    (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2), EB_N_PTR);
-            }
-            else {
-                EB_MALLOC_DEC(int32_t*,
-                    cur_frame_buf->coeff[AOM_PLANE_U],
-                    (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2),
-                    EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*,
-                    cur_frame_buf->coeff[AOM_PLANE_V],
-                    (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2),
-                    EB_N_PTR);
-            }
-        }
-        else if (seq_header->color_config.subsampling_x == 1 &&
-                 seq_header->color_config.subsampling_y == 0) // 422
-        {
-            if (is_st) {
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
-                    (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1), EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
-                    (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1), EB_N_PTR);
-            }
-            else {
-                EB_MALLOC_DEC(int32_t*,
-                    cur_frame_buf->coeff[AOM_PLANE_U],
-                    (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1),
-                    EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*,
-                    cur_frame_buf->coeff[AOM_PLANE_V],
-                    (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1),
-                    EB_N_PTR);
-            }
-        }
-        else if (seq_header->color_config.subsampling_x == 0 &&
-                 seq_header->color_config.subsampling_y == 0) // 444
-        {
-            if (is_st) {
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
-                    (num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
-                    (num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
-            }
-            else {
-                EB_MALLOC_DEC(int32_t*,
-                    cur_frame_buf->coeff[AOM_PLANE_U],
-                    (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1)),
-                    EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*,
-                    cur_frame_buf->coeff[AOM_PLANE_V],
-                    (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1)),
-                    EB_N_PTR);
-            }
-        }
-        else
-            assert(0);
 
         /* delta_q allocation at SB level */
         EB_MALLOC_DEC(int32_t*, cur_frame_buf->delta_q,
@@ -305,7 +287,7 @@ static EbErrorType init_master_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
     frame_mi_map->sb_cols = sb_cols;
     frame_mi_map->sb_rows = sb_rows;
     frame_mi_map->mi_cols_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
-    frame_mi_map->mi_rows_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
+    frame_mi_map->mi_rows_algnsb = sb_rows * (1 << (sb_size_log2 - MI_SIZE_LOG2));
     /* SBInfo pointers for entire frame */
     EB_MALLOC_DEC(SBInfo**, frame_mi_map->pps_sb_info,
         sb_rows * sb_cols * sizeof(SBInfo *), EB_N_PTR);
@@ -319,6 +301,24 @@ static EbErrorType init_master_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
     master_frame_buf->tpl_mvs = NULL;
     master_frame_buf->tpl_mvs_size = 0;
 
+    /* ModeInfo and TransformInfo at 4x4 level are the worst case of an SB,
+       the pools only keep what each SB actually codes */
+    int32_t sb_chroma_tus = (num_mis_in_sb >> seq_header->color_config.subsampling_x) * 2;
+    int32_t sb_coeffs     = num_mis_in_sb * (16 + 1);
+    /* Chunk allocations append to the decoder memory map, so the pools
+       of a frame share one mutex */
+    EbHandle pool_mutex = NULL;
+    if (!is_st) {
+        EB_CREATE_MUTEX(pool_mutex);
+        if (pool_mutex == NULL) return EB_ErrorInsufficientResources;
+    }
+    dec_sb_pool_init(&master_frame_buf->mode_info_pool,
+        num_mis_in_sb * sizeof(BlockModeInfo), pool_mutex);
+    dec_sb_pool_init(&master_frame_buf->trans_info_pool,
+        AOMMAX(num_mis_in_sb, sb_chroma_tus) * sizeof(TransformInfo_t), pool_mutex);
+    dec_sb_pool_init(&master_frame_buf->coeff_pool,
+        sb_coeffs * sizeof(int32_t), pool_mutex);
+
     return return_error;
 }
 
@@ -498,6 +498,37 @@ static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
     return return_error;
 }
 
+static void dec_print_pool_usage(const char *name, const DecSbPool *pool) {
+    SVT_LOG("SVT [decoder]: %-22s: %8.2f MB peak, %8.2f MB allocated\n",
+            name,
+            pool->peak_chunks * (double)pool->chunk_size / (1 << 20),
+            pool->num_chunks * (double)pool->chunk_size / (1 << 20));
+}
+
+/* Memory report printed when stat_report is set */
+void dec_print_memory_report(EbDecHandle *dec_handle_ptr) {
+    static const char *component_name[SVT_AV1_MEMORY_COMPONENT_COUNT] = {
+        "other", "picture buffers", "contexts", "neighbor arrays", "me buffers"};
+    MasterFrameBuf *  master_frame_buf = &dec_handle_ptr->master_frame_buf;
+    SvtAv1MemoryUsage usage;
+
+    SVT_LOG("SVT [decoder]: %-22s: %8.2f MB\n",
+            "library memory",
+            dec_handle_ptr->total_lib_memory / (double)(1 << 20));
+    eb_memory_counter_get_usage(&dec_handle_ptr->memory_counter, &usage);
+    SVT_LOG("SVT [decoder]: %-22s: %8.2f MB\n", "peak memory", usage.peak / (double)(1 << 20));
+    for (int i = 0; i < SVT_AV1_MEMORY_COMPONENT_COUNT; i++) {
+        if (usage.component[i])
+            SVT_LOG("SVT [decoder]:   %-20s: %8.2f MB\n",
+                    component_name[i],
+                    usage.component[i] / (double)(1 << 20));
+    }
+    if (!dec_handle_ptr->mem_init_done) return;
+    dec_print_pool_usage("mode info pool", &master_frame_buf->mode_info_pool);
+    dec_print_pool_usage("transform info pool", &master_frame_buf->trans_info_pool);
+    dec_print_pool_usage("coeff pool", &master_frame_buf->coeff_pool);
+}
+
 EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
@@ -507,6 +538,7 @@ EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     /* init module ctxts */
     return_error |= dec_pic_mgr_init(dec_handle_ptr);
 
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_CONTEXTS);
     return_error |= init_parse_context(dec_handle_ptr);
 
     return_error |= init_dec_mod_ctxt(dec_handle_ptr,
@@ -515,6 +547,7 @@ EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     return_error |= init_lf_ctxt(dec_handle_ptr);
 
     return_error |= init_lr_ctxt(dec_handle_ptr);
+    eb_memory_component_set(prev);
 
     /* init frame buffers */
     return_error |= init_master_frame_ctxt(dec_handle_ptr);
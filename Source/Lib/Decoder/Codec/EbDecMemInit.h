@@ -37,6 +37,7 @@ extern EbMemoryMapEntry *memory_map_end_address;
         }                                                                             \
         node->ptr_type     = pointer_class;                                           \
         node->ptr          = pointer;                                                 \
+        node->component    = eb_memory_component_get();                               \
         node->prev_entry   = svt_dec_memory_map;                                      \
         svt_dec_memory_map = node;                                                    \
         (*svt_dec_memory_map_index)++;                                                \
@@ -46,6 +47,7 @@ extern EbMemoryMapEntry *memory_map_end_address;
             *svt_dec_total_lib_memory += (((n_elements) + (8 - ((n_elements) % 8))) + \
                                           sizeof(*node));                             \
         svt_dec_lib_malloc_count++;                                                   \
+        eb_memory_count_add(pointer, pointer_class);                                  \
     } while (0)
 #else
 #define EB_ALLIGN_MALLOC_DEC(type, pointer, n_elements, pointer_class)                \
@@ -59,6 +61,7 @@ extern EbMemoryMapEntry *memory_map_end_address;
         }                                                                             \
         node->ptr_type     = pointer_class;                                           \
         node->ptr          = pointer;                                                 \
+        node->component    = eb_memory_component_get();                               \
         node->prev_entry   = svt_dec_memory_map;                                      \
         svt_dec_memory_map = node;                                                    \
         (*svt_dec_memory_map_index)++;                                                \
@@ -68,6 +71,7 @@ extern EbMemoryMapEntry *memory_map_end_address;
             *svt_dec_total_lib_memory += (((n_elements) + (8 - ((n_elements) % 8))) + \
                                           sizeof(*node));                             \
         svt_dec_lib_malloc_count++;                                                   \
+        eb_memory_count_add(pointer, pointer_class);                                  \
     } while (0)
 #endif
 #define EB_MALLOC_DEC(type, pointer, n_elements, pointer_class)                       \
@@ -82,6 +86,7 @@ extern EbMemoryMapEntry *memory_map_end_address;
         }                                                                             \
         node->ptr_type     = pointer_class;                                           \
         node->ptr          = pointer;                                                 \
+        node->component    = eb_memory_component_get();                               \
         node->prev_entry   = svt_dec_memory_map;                                      \
         svt_dec_memory_map = node;                                                    \
         (*svt_dec_memory_map_index)++;                                                \
@@ -91,6 +96,7 @@ extern EbMemoryMapEntry *memory_map_end_address;
             *svt_dec_total_lib_memory += (((n_elements) + (8 - ((n_elements) % 8))) + \
                                           sizeof(*node));                             \
         svt_dec_lib_malloc_count++;                                                   \
+        eb_memory_count_add(pointer, pointer_class);                                  \
     } while (0)
 
 EbErrorType dec_eb_recon_picture_buffer_desc_ctor(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr,
@@ -100,6 +106,23 @@ EbErrorType dec_mem_init(EbDecHandle *dec_handle_ptr);
 
 EbErrorType init_dec_mod_ctxt(EbDecHandle *dec_handle_ptr, void **dec_mod_ctxt);
 
+void dec_print_memory_report(EbDecHandle *dec_handle_ptr);
+
+void dec_sb_pool_reset(DecSbPool *pool);
+
+void *dec_sb_pool_reserve(DecSbPool *pool, DecSbPoolCursor *cursor, size_t size);
+
+/* Keeps the first 'size' bytes of the last reservation of the cursor */
+static INLINE void dec_sb_pool_commit(DecSbPoolCursor *cursor, size_t size) {
+    cursor->cur += ALIGN_POWER_OF_TWO(size, 3);
+    assert(cursor->cur <= cursor->end);
+}
+
+static INLINE void dec_sb_pool_cursor_reset(DecSbPoolCursor *cursor) {
+    cursor->cur = NULL;
+    cursor->end = NULL;
+}
+
 #ifdef __cplusplus
 }
 #endif
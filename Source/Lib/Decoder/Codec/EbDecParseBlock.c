@@ -946,98 +946,139 @@ void motion_field_projections_row(EbDecHandle *dec_handle, int sb_row, const EbD
         motion_field_projection_row(dec_handle, LAST2_FRAME, sb_row, num_blk_mv_rows, 2);
 }
 
-void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt) {
-    DecMtFrameData *dec_mt_frame_data =
-        &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
-    EbBool is_mt = dec_handle->dec_config.threads > 1;
-    EbBool do_memset = EB_TRUE;
-
-    if (is_mt) {
-        volatile EbBool *start_motion_proj = &dec_mt_frame_data->start_motion_proj;
-
-        while (*start_motion_proj != EB_TRUE)
-            eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle->thread_semaphore
-                                                      : thread_ctxt->thread_semaphore);
-
-        DecMtMotionProjInfo *motion_proj_info =
-            &dec_mt_frame_data->motion_proj_info;
-        do_memset = EB_FALSE;
-        //lock mutex
-        eb_block_on_mutex(motion_proj_info->motion_proj_mutex);
-        //Check memset needed
-        if (motion_proj_info->motion_proj_init_done == EB_FALSE) {
-            do_memset = EB_TRUE;
-            motion_proj_info->motion_proj_init_done = EB_TRUE;
-        }
-        //unlock mutex
-        eb_release_mutex(motion_proj_info->motion_proj_mutex);
-    }
+/* Gathers the reference frame buffers and their order hints */
+static void get_ref_frames_order_hint(EbDecHandle *dec_handle, const EbDecPicBuf **ref_buf,
+                                      int *ref_order_hint) {
+    for (int ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ref_frame++) {
+        const int                ref_idx = ref_frame - LAST_FRAME;
+        const EbDecPicBuf *const buf     = get_ref_frame_buf(dec_handle, ref_frame);
 
-    if (do_memset) {
-        memset(dec_handle->master_frame_buf.ref_frame_side,
-               0,
-               sizeof(dec_handle->master_frame_buf.ref_frame_side));
+        ref_buf[ref_idx]        = buf;
+        ref_order_hint[ref_idx] = buf != NULL ? buf->order_hint : 0;
     }
+}
 
-    EbBool no_proj_flag = (dec_handle->frame_header.show_existing_frame ||
-                           (0 == dec_handle->frame_header.use_ref_frame_mvs));
+/* Sets the side of every reference frame relative to the current frame */
+void svt_setup_ref_frame_side(EbDecHandle *dec_handle) {
+    memset(dec_handle->master_frame_buf.ref_frame_side,
+           0,
+           sizeof(dec_handle->master_frame_buf.ref_frame_side));
 
     OrderHintInfo *order_hint_info = &dec_handle->seq_header.order_hint_info;
 
     if (!order_hint_info->enable_order_hint) return;
 
-    const int cur_order_hint = dec_handle->cur_pic_buf[0]->order_hint;
-
+    const int          cur_order_hint = dec_handle->cur_pic_buf[0]->order_hint;
     const EbDecPicBuf *ref_buf[INTER_REFS_PER_FRAME];
     int                ref_order_hint[INTER_REFS_PER_FRAME];
 
+    get_ref_frames_order_hint(dec_handle, ref_buf, ref_order_hint);
     for (int ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ref_frame++) {
-        const int                ref_idx    = ref_frame - LAST_FRAME;
-        const EbDecPicBuf *const buf        = get_ref_frame_buf(dec_handle, ref_frame);
-        int                      order_hint = 0;
-
-        if (buf != NULL) order_hint = buf->order_hint;
-
-        ref_buf[ref_idx]        = buf;
-        ref_order_hint[ref_idx] = order_hint;
+        const int order_hint = ref_order_hint[ref_frame - LAST_FRAME];
 
         if (get_relative_dist(order_hint_info, order_hint, cur_order_hint) > 0)
             dec_handle->master_frame_buf.ref_frame_side[ref_frame] = 1;
         else if (order_hint == cur_order_hint)
             dec_handle->master_frame_buf.ref_frame_side[ref_frame] = -1;
     }
-    if (!no_proj_flag) {
-        //branch of point for MT
-        if (is_mt) {
-            DecMtMotionProjInfo *motion_proj_info =
-                &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.motion_proj_info;
+}
 
-            while (1) {
-                int32_t proj_row = -1;
+/* Picks up the next motion field projection row of the frame, up to row
+   'max_row', and projects it. Returns 0 when no row was picked up. */
+static int motion_field_projections_next_row(EbDecHandle *dec_handle, const EbDecPicBuf **ref_buf,
+                                             int *ref_order_hint, int32_t max_row) {
+    DecMtMotionProjInfo *motion_proj_info =
+        &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.motion_proj_info;
+    int32_t proj_row = -1;
 
-                //lock mutex
-                eb_block_on_mutex(motion_proj_info->motion_proj_mutex);
+    //lock mutex
+    eb_block_on_mutex(motion_proj_info->motion_proj_mutex);
 
-                //pick up a row and increment the sb row counter
-                if (motion_proj_info->motion_proj_row_to_process !=
-                    motion_proj_info->num_motion_proj_rows) {
-                    proj_row = motion_proj_info->motion_proj_row_to_process;
-                    motion_proj_info->motion_proj_row_to_process++;
-                }
+    //pick up a row and increment the sb row counter
+    if (motion_proj_info->motion_proj_row_to_process != motion_proj_info->num_motion_proj_rows &&
+        motion_proj_info->motion_proj_row_to_process <= max_row) {
+        proj_row = motion_proj_info->motion_proj_row_to_process;
+        motion_proj_info->motion_proj_row_to_process++;
+    }
 
-                //unlock mutex
-                eb_release_mutex(motion_proj_info->motion_proj_mutex);
+    //unlock mutex
+    eb_release_mutex(motion_proj_info->motion_proj_mutex);
 
-                //wait for parse
-                if (-1 != proj_row)
-                    motion_field_projections_row(dec_handle, proj_row, ref_buf, ref_order_hint);
+    if (-1 == proj_row) return 0;
 
-                /*if all sb rows have been picked up for processing then break the while loop */
-                if (motion_proj_info->motion_proj_row_to_process ==
-                    motion_proj_info->num_motion_proj_rows) {
-                    break;
-                }
+    motion_field_projections_row(dec_handle, proj_row, ref_buf, ref_order_hint);
+    dec_mt_set_progress(&dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data,
+                        (volatile int32_t *)&motion_proj_info->motion_proj_row_done[proj_row],
+                        1);
+    return 1;
+}
+
+/* Waits for the projected motion field of the 64x64 rows covered by the
+   SB row starting at 'mi_row'. The waiting thread projects the rows it
+   needs that are not picked up yet. Only called with multiple threads. */
+void svt_wait_motion_field_rows(EbDecHandle *dec_handle, uint32_t mi_row) {
+    if (!dec_handle->frame_header.use_ref_frame_mvs) return;
+
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    DecMtMotionProjInfo *motion_proj_info = &dec_mt_frame_data->motion_proj_info;
+    volatile int32_t *   row_done = (volatile int32_t *)motion_proj_info->motion_proj_row_done;
+
+    const int first_row = mi_row >> (6 - MI_SIZE_LOG2);
+    const int last_row  = AOMMIN(
+        (int)(mi_row + dec_handle->seq_header.sb_mi_size - 1) >> (6 - MI_SIZE_LOG2),
+        motion_proj_info->num_motion_proj_rows - 1);
+
+    const EbDecPicBuf *ref_buf[INTER_REFS_PER_FRAME];
+    int                ref_order_hint[INTER_REFS_PER_FRAME];
+    EbBool             refs_ready = EB_FALSE;
+
+    for (int row = first_row; row <= last_row; row++) {
+        while (!row_done[row]) {
+            if (!refs_ready) {
+                get_ref_frames_order_hint(dec_handle, ref_buf, ref_order_hint);
+                refs_ready = EB_TRUE;
             }
+            /* Waits once the rows are in progress on other threads */
+            if (!motion_field_projections_next_row(
+                    dec_handle, ref_buf, ref_order_hint, last_row))
+                dec_mt_wait_progress(dec_mt_frame_data, &row_done[row], 1);
+        }
+    }
+}
+
+/* With multiple threads, only the worker threads project the rows while the
+   main thread starts parsing, and parsing of a SB row only waits for the rows
+   it needs, see svt_wait_motion_field_rows. The reference frame sides are
+   then set by the main thread before the workers are started. */
+void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    EbBool is_mt = dec_handle->dec_config.threads > 1;
+
+    if (is_mt) {
+        volatile EbBool *start_motion_proj = &dec_mt_frame_data->start_motion_proj;
+
+        while (*start_motion_proj != EB_TRUE)
+            eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle->thread_semaphore
+                                                      : thread_ctxt->thread_semaphore);
+    } else
+        svt_setup_ref_frame_side(dec_handle);
+
+    EbBool no_proj_flag = (dec_handle->frame_header.show_existing_frame ||
+                           (0 == dec_handle->frame_header.use_ref_frame_mvs) ||
+                           !dec_handle->seq_header.order_hint_info.enable_order_hint);
+
+    if (!no_proj_flag) {
+        const EbDecPicBuf *ref_buf[INTER_REFS_PER_FRAME];
+        int                ref_order_hint[INTER_REFS_PER_FRAME];
+
+        get_ref_frames_order_hint(dec_handle, ref_buf, ref_order_hint);
+        //branch of point for MT
+        if (is_mt) {
+            while (motion_field_projections_next_row(
+                dec_handle, ref_buf, ref_order_hint, INT32_MAX))
+                ;
         } else {
             const int mvs_rows    = (dec_handle->frame_header.mi_rows + 1) >> 1; //8x8 unit level
             const int sb_mvs_rows = (mvs_rows + 7) >> 3; //64x64 unit level
@@ -1046,18 +1087,14 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
         }
     }
 
+    /* No barrier, the workers move on to parsing right away */
     if (is_mt) {
         eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
         dec_mt_frame_data->num_threads_header++;
-        if (dec_handle->dec_config.threads == dec_mt_frame_data->num_threads_header) {
+        if (dec_handle->dec_config.threads - 1 == dec_mt_frame_data->num_threads_header) {
             dec_mt_frame_data->start_motion_proj = EB_FALSE;
         }
         eb_release_mutex(dec_mt_frame_data->temp_mutex);
-
-        volatile uint32_t *num_threads_header = &dec_mt_frame_data->num_threads_header;
-        while (*num_threads_header != dec_handle->dec_config.threads &&
-              (EB_FALSE == dec_mt_frame_data->end_flag))
-            ;
     }
 }
 
@@ -26,6 +26,8 @@
 
 #include "EbDecParseFrame.h"
 #include "EbDecParseHelper.h"
+#include "EbDecMemInit.h"
+#include "EbObuParse.h"
 
 /* Inititalizes prms for current tile from Master TilesInfo ! */
 void svt_tile_init(TileInfo *cur_tile_info, FrameHeader *frame_header, int32_t tile_row,
@@ -190,6 +192,20 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
         set_default_sgrproj(&lr_unit[p]->sgrproj_info);
     }
 
+    /* Each tile fills its own chunks of the SB pools */
+    dec_sb_pool_cursor_reset(&parse_ctx->mode_info_cursor);
+    for (int p = 0; p < MAX_MB_PLANE - 1; ++p)
+        dec_sb_pool_cursor_reset(&parse_ctx->trans_info_cursor[p]);
+    for (int p = 0; p < MAX_MB_PLANE; ++p) dec_sb_pool_cursor_reset(&parse_ctx->coeff_cursor[p]);
+
+    /* Tiles outside the region of interest are parsed but not reconstructed */
+    const TileInfo *cur_tile   = &parse_ctx->cur_tile_info;
+    EbBool          recon_tile = dec_roi_is_active(dec_handle_ptr,
+                                          cur_tile->mi_row_start,
+                                          cur_tile->mi_col_start,
+                                          cur_tile->mi_row_end - cur_tile->mi_row_start,
+                                          cur_tile->mi_col_end - cur_tile->mi_col_start);
+
     // to-do access to wiener info that is currently part of PartitionInfo
     int32_t sb_row_tile_start = 0;
     if (is_mt) {
@@ -205,6 +221,8 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
          mi_row += dec_handle_ptr->seq_header.sb_mi_size) {
         int32_t sb_row = (mi_row << MI_SIZE_LOG2) >> dec_handle_ptr->seq_header.sb_size_log2;
 
+        if (is_mt) svt_wait_motion_field_rows(dec_handle_ptr, mi_row);
+
         clear_left_context(parse_ctx);
 
         /*TODO: Move CFL to thread ctxt! We need to access DecModCtxt
@@ -230,19 +248,22 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
             SBInfo *sb_info = frame_buf->sb_info + (sb_row * master_frame_buf->sb_cols) + sb_col;
             *(master_frame_buf->frame_mi_map.pps_sb_info +
               sb_row * master_frame_buf->frame_mi_map.sb_cols + sb_col) = sb_info;
-            sb_info->sb_mode_info                                       = frame_buf->mode_info +
-                                    (sb_row * num_mis_in_sb * master_frame_buf->sb_cols) +
-                                    sb_col * num_mis_in_sb;
-
+            /* Reserve the worst case of the SB in the pools */
+            sb_info->sb_mode_info = dec_sb_pool_reserve(&master_frame_buf->mode_info_pool,
+                                                        &parse_ctx->mode_info_cursor,
+                                                        num_mis_in_sb * sizeof(BlockModeInfo));
             sb_info->sb_trans_info[AOM_PLANE_Y] =
-                frame_buf->trans_info[AOM_PLANE_Y] +
-                (sb_row * num_mis_in_sb * master_frame_buf->sb_cols) + sb_col * num_mis_in_sb;
-
+                dec_sb_pool_reserve(&master_frame_buf->trans_info_pool,
+                                    &parse_ctx->trans_info_cursor[AOM_PLANE_Y],
+                                    num_mis_in_sb * sizeof(TransformInfo_t));
             sb_info->sb_trans_info[AOM_PLANE_U] =
-                frame_buf->trans_info[AOM_PLANE_U] +
-                ((sb_row * num_mis_in_sb * master_frame_buf->sb_cols >> sy) +
-                 (sb_col * num_mis_in_sb >> sx)) *
-                    2;
+                dec_sb_pool_reserve(&master_frame_buf->trans_info_pool,
+                                    &parse_ctx->trans_info_cursor[AOM_PLANE_U],
+                                    (num_mis_in_sb >> sx) * 2 * sizeof(TransformInfo_t));
+            if (!sb_info->sb_mode_info || !sb_info->sb_trans_info[AOM_PLANE_Y] ||
+                !sb_info->sb_trans_info[AOM_PLANE_U])
+                return EB_ErrorInsufficientResources;
+
             if (dec_handle_ptr->dec_config.threads == 1) {
                 /*TODO : Change to macro */
                 sb_info->sb_coeff[AOM_PLANE_Y] = frame_buf->coeff[AOM_PLANE_Y];
@@ -250,20 +271,15 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
                 sb_info->sb_coeff[AOM_PLANE_V] = frame_buf->coeff[AOM_PLANE_V];
             }
             else {
-                /*TODO : Change to macro */
-                sb_info->sb_coeff[AOM_PLANE_Y] =
-                    frame_buf->coeff[AOM_PLANE_Y] +
-                    (sb_row * num_mis_in_sb * master_frame_buf->sb_cols * (16 + 1))
-                        + sb_col * num_mis_in_sb* (16 + 1);
-                /*TODO : Change to macro */
-                sb_info->sb_coeff[AOM_PLANE_U] =
-                    frame_buf->coeff[AOM_PLANE_U] +
-                    (sb_row * num_mis_in_sb * master_frame_buf->sb_cols * (16 + 1) >> (sy + sx))
-                        + (sb_col * num_mis_in_sb * (16 + 1) >> (sy + sx));
-                sb_info->sb_coeff[AOM_PLANE_V] =
-                    frame_buf->coeff[AOM_PLANE_V] +
-                    (sb_row * num_mis_in_sb * master_frame_buf->sb_cols * (16 + 1) >> (sy + sx))
-                        + (sb_col * num_mis_in_sb * (16 + 1) >> (sy + sx));
+                /* (16+1) : 1 for Length and 16 for all coeffs in 4x4 */
+                for (int plane = 0; plane < MAX_MB_PLANE; plane++) {
+                    size_t sb_coeffs = num_mis_in_sb * (16 + 1) >> (plane ? sx + sy : 0);
+                    sb_info->sb_coeff[plane] =
+                        dec_sb_pool_reserve(&master_frame_buf->coeff_pool,
+                                            &parse_ctx->coeff_cursor[plane],
+                                            sb_coeffs * sizeof(int32_t));
+                    if (!sb_info->sb_coeff[plane]) return EB_ErrorInsufficientResources;
+                }
             }
             int cdef_factor = dec_handle_ptr->seq_header.use_128x128_superblock ? 4 : 1;
             sb_info->sb_cdef_strength =
@@ -294,7 +310,24 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
             // Bit-stream parsing of the superblock
             parse_super_block(dec_handle_ptr, parse_ctx, mi_row, mi_col, sb_info);
 
-            if (!is_mt) {
+            /* Keep only what the SB coded */
+            dec_sb_pool_commit(&parse_ctx->mode_info_cursor,
+                               sb_info->num_block * sizeof(BlockModeInfo));
+            dec_sb_pool_commit(&parse_ctx->trans_info_cursor[AOM_PLANE_Y],
+                               parse_ctx->first_txb_offset[AOM_PLANE_Y] *
+                                   sizeof(TransformInfo_t));
+            dec_sb_pool_commit(&parse_ctx->trans_info_cursor[AOM_PLANE_U],
+                               parse_ctx->first_txb_offset[AOM_PLANE_U] *
+                                   sizeof(TransformInfo_t));
+            if (is_mt) {
+                for (int plane = 0; plane < MAX_MB_PLANE; plane++)
+                    dec_sb_pool_commit(
+                        &parse_ctx->coeff_cursor[plane],
+                        (parse_ctx->cur_coeff_buf[plane] - sb_info->sb_coeff[plane]) *
+                            sizeof(int32_t));
+            }
+
+            if (!is_mt && recon_tile) {
                 /* Init DecModCtxt */
                 DecModCtxt *dec_mod_ctxt = (DecModCtxt *)dec_handle_ptr->pv_dec_mod_ctxt;
                 dec_mod_ctxt->cur_coeff[AOM_PLANE_Y] = sb_info->sb_coeff[AOM_PLANE_Y];
@@ -313,8 +346,11 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
                 &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0]
                      .dec_mt_frame_data; //multi frame Parallel 0 -> idx
             assert(sb_row >= sb_row_tile_start);
-            dec_mt_frame_data->parse_recon_tile_info_array[tile_num]
-                .sb_recon_row_parsed[sb_row - sb_row_tile_start] = 1;
+            dec_mt_set_progress(dec_mt_frame_data,
+                                (volatile int32_t *)&dec_mt_frame_data
+                                    ->parse_recon_tile_info_array[tile_num]
+                                    .sb_recon_row_parsed[sb_row - sb_row_tile_start],
+                                1);
         }
     }
 
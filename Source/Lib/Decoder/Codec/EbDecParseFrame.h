@@ -104,6 +104,11 @@ typedef struct ParseCtxt {
     /* TODO: Points to the cur coeff_buf in SB. Should be moved out */
     int32_t *cur_coeff_buf[MAX_MB_PLANE];
 
+    /* Position of the tile in the superblock pools of the frame */
+    DecSbPoolCursor mode_info_cursor;
+    DecSbPoolCursor trans_info_cursor[MAX_MB_PLANE - 1];
+    DecSbPoolCursor coeff_cursor[MAX_MB_PLANE];
+
     /* Points to the cur luma_trans_info in a block */
     TransformInfo_t *cur_luma_trans_info;
 
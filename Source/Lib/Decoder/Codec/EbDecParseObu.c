@@ -1637,6 +1637,8 @@ static void realloc_parse_memory(EbDecHandle *dec_handle_ptr) {
     int num_tiles = tiles_info.tile_cols * tiles_info.tile_rows;
     int num_instances = MIN((int32_t)dec_handle_ptr->dec_config.threads,
         num_tiles);
+    const SvtAv1MemoryComponent prev =
+        eb_memory_component_set(SVT_AV1_MEMORY_NEIGHBOR_ARRAYS);
     if (dec_handle_ptr->dec_config.threads == 1) {
         /* For single thread case, allocate memory for one
            frame row above and one sb column for the left context. */
@@ -1647,6 +1649,7 @@ static void realloc_parse_memory(EbDecHandle *dec_handle_ptr) {
         reallocate_parse_context_memory(dec_handle_ptr,
             master_parse_ctx, num_instances);
     }
+    eb_memory_component_set(prev);
     if (num_tiles != master_parse_ctx->num_tiles)
         reallocate_parse_tile_data(master_parse_ctx, num_tiles);
 }
@@ -1718,6 +1721,8 @@ static void check_mt_support(EbDecHandle *dec_handle_ptr) {
             memory_entry = (EbMemoryMapEntry *)memory_entry->prev_entry;
         }
         do {
+            eb_memory_count_remove_from(
+                memory_entry->ptr, memory_entry->ptr_type, memory_entry->component);
             switch (memory_entry->ptr_type) {
             case EB_N_PTR: free(memory_entry->ptr); break;
             case EB_A_PTR:
@@ -1803,6 +1808,7 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
             dec_handle_ptr->show_existing_frame = frame_info->show_existing_frame;
             dec_handle_ptr->show_frame          = frame_info->show_frame;
             dec_handle_ptr->showable_frame      = frame_info->showable_frame;
+            dec_setup_skip_flags(dec_handle_ptr);
             return;
         }
 
@@ -2099,6 +2105,9 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
         if (EB_FALSE == dec_handle_ptr->start_thread_process) {
             dec_system_resource_init(dec_handle_ptr, &tiles_info);
             dec_handle_ptr->start_thread_process = EB_TRUE;
+            for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1;
+                 lib_thrd++)
+                eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
         }
         check_mt_support(dec_handle_ptr);
     }
@@ -2173,10 +2182,11 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
     dec_handle_ptr->show_existing_frame = frame_info->show_existing_frame;
     dec_handle_ptr->show_frame          = frame_info->show_frame;
     dec_handle_ptr->showable_frame      = frame_info->showable_frame;
+    dec_setup_skip_flags(dec_handle_ptr);
 
     /* TODO: Should be moved to caller */
     if (dec_handle_ptr->dec_config.threads == 1) {
-        if (!frame_info->show_existing_frame)
+        if (!frame_info->show_existing_frame && !dec_handle_ptr->frame_dropped)
             svt_setup_motion_field(dec_handle_ptr, NULL);
     }
 }
@@ -2265,6 +2275,9 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     header_bytes = (end_position - start_position) / 8;
     obu_header->payload_size -= header_bytes;
 
+    /* The tile data of a dropped frame is skipped by the caller */
+    if (dec_handle_ptr->frame_dropped) return status;
+
     dec_handle_ptr->cm.mi_cols       = dec_handle_ptr->frame_header.mi_cols;
     dec_handle_ptr->cm.mi_rows       = dec_handle_ptr->frame_header.mi_rows;
     dec_handle_ptr->cm.mi_stride     = dec_handle_ptr->frame_header.mi_stride;
@@ -2274,21 +2287,32 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     dec_handle_ptr->cm.frm_size      = dec_handle_ptr->frame_header.frame_size;
     dec_handle_ptr->cm.tiles_info    = dec_handle_ptr->frame_header.tiles_info;
     dec_handle_ptr->is_lf_enabled =
-        (!dec_handle_ptr->frame_header.allow_intrabc &&
+        (!dec_handle_ptr->frame_header.allow_intrabc && !dec_handle_ptr->skip_loop_filters &&
          (dec_handle_ptr->frame_header.loop_filter_params.filter_level[0] ||
           dec_handle_ptr->frame_header.loop_filter_params.filter_level[1]));
 
     uint32_t num_threads = dec_handle_ptr->dec_config.threads;
     int      is_mt       = num_threads != 1;
 
+    dec_setup_roi_region(dec_handle_ptr);
+
+    /* Every frame refills the SB pools from the start */
+    if (tg_start == 0) {
+        MasterFrameBuf *master_frame_buf = &dec_handle_ptr->master_frame_buf;
+        dec_sb_pool_reset(&master_frame_buf->mode_info_pool);
+        dec_sb_pool_reset(&master_frame_buf->trans_info_pool);
+        dec_sb_pool_reset(&master_frame_buf->coeff_pool);
+    }
+
     /* PPF flags derivation */
     EbBool no_ibc = !dec_handle_ptr->frame_header.allow_intrabc;
+    EbBool no_skip = !dec_handle_ptr->skip_loop_filters;
     /* LF */
     EbBool do_lf_flag =
-        no_ibc && (dec_handle_ptr->frame_header.loop_filter_params.filter_level[0] ||
+        no_ibc && no_skip && (dec_handle_ptr->frame_header.loop_filter_params.filter_level[0] ||
             dec_handle_ptr->frame_header.loop_filter_params.filter_level[1]);
     /* CDEF */
-    EbBool do_cdef = no_ibc && (!frame_header->coded_lossless &&
+    EbBool do_cdef = no_ibc && no_skip && (!frame_header->coded_lossless &&
         (frame_header->cdef_params.cdef_bits ||
             frame_header->cdef_params.cdef_y_strength[0] ||
             frame_header->cdef_params.cdef_uv_strength[0]));
@@ -2298,7 +2322,7 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     /* LR */
     //EbBool opt_lr = !do_cdef && !do_upscale;
     LrParams *lr_param = dec_handle_ptr->frame_header.lr_params;
-    EbBool    do_lr = no_ibc &&
+    EbBool    do_lr = no_ibc && no_skip &&
         (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
         lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
         lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
@@ -2337,18 +2361,20 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
         const int sb_mvs_rows = (mvs_rows + 7) >> 3; //64x64 unit level
         dec_mt_frame_data->motion_proj_info.num_motion_proj_rows       = sb_mvs_rows;
         dec_mt_frame_data->motion_proj_info.motion_proj_row_to_process = 0;
-        dec_mt_frame_data->motion_proj_info.motion_proj_init_done      = EB_FALSE;
         dec_mt_frame_data->num_threads_header                          = 0;
+        memset(dec_mt_frame_data->motion_proj_info.motion_proj_row_done,
+               0,
+               sb_mvs_rows * sizeof(uint32_t));
+        svt_setup_ref_frame_side(dec_handle_ptr);
 
+        /* The workers project the motion field while this thread starts
+           parsing, each SB row waits for its own projected rows */
         eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
         dec_mt_frame_data->start_motion_proj = EB_TRUE;
         eb_release_mutex(dec_mt_frame_data->temp_mutex);
-        eb_post_semaphore(dec_handle_ptr->thread_semaphore);
         for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
             eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
 
-        svt_setup_motion_field(dec_handle_ptr, NULL);
-
         svt_av1_queue_parse_jobs(dec_handle_ptr, tiles_info);
 
         eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
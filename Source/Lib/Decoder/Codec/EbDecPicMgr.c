@@ -153,10 +153,13 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
 
         input_pic_buf_desc_init_data.split_mode = EB_FALSE;
 
+        const SvtAv1MemoryComponent prev =
+            eb_memory_component_set(SVT_AV1_MEMORY_PICTURE_BUFFERS);
         EbErrorType return_error = dec_eb_recon_picture_buffer_desc_ctor(
             (EbPtr *)&(ps_pic_mgr->as_dec_pic[i].ps_pic_buf),
             (EbPtr)&input_pic_buf_desc_init_data,
             dec_handle_ptr->is_16bit_pipeline);
+        eb_memory_component_set(prev);
 
         if (return_error != EB_ErrorNone) return NULL;
 
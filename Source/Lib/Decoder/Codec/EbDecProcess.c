@@ -135,6 +135,78 @@ int32_t get_sb_row_to_process(DecMtRowInfo *sb_row_info) {
     return sb_row_to_process;
 }
 
+/* Number of polls of a progress before the waiting thread parks */
+#define DEC_MT_SPIN_COUNT 512
+
+/* Park slot states */
+#define DEC_MT_SLOT_FREE 0
+#define DEC_MT_SLOT_PARKED 1
+#define DEC_MT_SLOT_POSTED 2
+
+/* Progress sync between threads. A waiter takes a park slot before its last
+   check of the progress, an update is stored before num_parked is read, with
+   a full barrier in between on both sides : either the waiter sees the update
+   or the updater sees the waiter, no wake up is lost. Each slot has its own
+   semaphore so that a post is only ever consumed by the thread it is for. */
+void dec_mt_wait_progress(DecMtFrameData *dec_mt_frame_data, volatile int32_t *progress,
+                          int32_t target) {
+    uint8_t *slot_state = dec_mt_frame_data->park_slot_state;
+
+    while (*progress < target) {
+        int32_t spin = DEC_MT_SPIN_COUNT;
+        while (*progress < target && --spin) EB_CPU_PAUSE();
+        if (spin) break;
+
+        int32_t slot = 0;
+        eb_block_on_mutex(dec_mt_frame_data->park_mutex);
+        while (DEC_MT_SLOT_FREE != slot_state[slot]) slot++;
+        slot_state[slot] = DEC_MT_SLOT_PARKED;
+        dec_mt_frame_data->num_parked++;
+        eb_release_mutex(dec_mt_frame_data->park_mutex);
+        EB_MEMORY_BARRIER();
+
+        EbBool posted = EB_TRUE;
+        if (*progress >= target) {
+            /* Back out, unless an updater already owes this slot a post */
+            eb_block_on_mutex(dec_mt_frame_data->park_mutex);
+            if (DEC_MT_SLOT_PARKED == slot_state[slot]) {
+                dec_mt_frame_data->num_parked--;
+                posted = EB_FALSE;
+            }
+            eb_release_mutex(dec_mt_frame_data->park_mutex);
+        }
+        if (posted) eb_block_on_semaphore(dec_mt_frame_data->park_semaphore[slot]);
+
+        eb_block_on_mutex(dec_mt_frame_data->park_mutex);
+        slot_state[slot] = DEC_MT_SLOT_FREE;
+        eb_release_mutex(dec_mt_frame_data->park_mutex);
+    }
+    EB_MEMORY_BARRIER();
+}
+
+void dec_mt_wake_parked(DecMtFrameData *dec_mt_frame_data) {
+    EB_MEMORY_BARRIER();
+    if (0 == dec_mt_frame_data->num_parked) return;
+
+    /* Every parked thread checks its own progress again */
+    eb_block_on_mutex(dec_mt_frame_data->park_mutex);
+    for (uint32_t slot = 0; dec_mt_frame_data->num_parked; slot++) {
+        if (DEC_MT_SLOT_PARKED == dec_mt_frame_data->park_slot_state[slot]) {
+            dec_mt_frame_data->park_slot_state[slot] = DEC_MT_SLOT_POSTED;
+            dec_mt_frame_data->num_parked--;
+            eb_post_semaphore(dec_mt_frame_data->park_semaphore[slot]);
+        }
+    }
+    eb_release_mutex(dec_mt_frame_data->park_mutex);
+}
+
+void dec_mt_set_progress(DecMtFrameData *dec_mt_frame_data, volatile int32_t *progress,
+                         int32_t value) {
+    EB_MEMORY_BARRIER();
+    *progress = value;
+    dec_mt_wake_parked(dec_mt_frame_data);
+}
+
 /************************************
 * System Resource Managers & Fifos
 ************************************/
@@ -159,6 +231,13 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     /* Motion Filed Projection*/
     dec_mt_frame_data->motion_proj_info.num_motion_proj_rows = -1;
     EB_CREATE_MUTEX(dec_mt_frame_data->motion_proj_info.motion_proj_mutex);
+    int32_t max_motion_proj_rows =
+        (dec_handle_ptr->seq_header.max_frame_height + (MI_SIZE_64X64 << MI_SIZE_LOG2) - 1) /
+        (MI_SIZE_64X64 << MI_SIZE_LOG2);
+    EB_MALLOC_DEC(uint32_t *,
+                  dec_mt_frame_data->motion_proj_info.motion_proj_row_done,
+                  max_motion_proj_rows * sizeof(uint32_t),
+                  EB_N_PTR);
 
     int32_t  sb_size_h = block_size_high[dec_handle_ptr->seq_header.sb_size];
     uint32_t picture_height_in_sb = (dec_handle_ptr->frame_header.
@@ -382,6 +461,24 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     if (EB_FALSE == dec_handle_ptr->start_thread_process) {
         dec_mt_frame_data->end_flag           = EB_FALSE;
         dec_mt_frame_data->num_threads_exited = 0;
+        dec_mt_frame_data->num_parked         = 0;
+        dec_mt_frame_data->num_frames_lred    = 0;
+
+        /* One park slot per thread, main thread included */
+        uint32_t num_threads = dec_handle_ptr->dec_config.threads;
+        EB_MALLOC_DEC(EbHandle *,
+                      dec_mt_frame_data->park_semaphore,
+                      num_threads * sizeof(EbHandle),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(uint8_t *,
+                      dec_mt_frame_data->park_slot_state,
+                      num_threads * sizeof(uint8_t),
+                      EB_N_PTR);
+        for (uint32_t i = 0; i < num_threads; i++) {
+            EB_CREATE_SEMAPHORE(dec_mt_frame_data->park_semaphore[i], 0, 1);
+            dec_mt_frame_data->park_slot_state[i] = DEC_MT_SLOT_FREE;
+        }
+        EB_CREATE_MUTEX(dec_mt_frame_data->park_mutex);
 
         if (num_lib_threads > 0) {
             DecThreadCtxt *thread_ctxt_pa;
@@ -844,7 +941,6 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
             /* row-1 : To ensure line buf copy with TopR sync if LF skips row  */
             /* This prevent issues across Tiles where recon sync is not ensured*/
             /* row+1 : This is for CDEF actually, should be moved to CDEF stage*/
-            int32_t start_lf[3] = {0};
             int32_t row_index[3];
             row_index[0] = (sb_row)*tiles_info->tile_cols;
             row_index[1] = (sb_row - (sb_row == 0 ? 0 : 1)) * tiles_info->tile_cols;
@@ -853,20 +949,18 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
 #if MT_WAIT_PROFILE
             dec_timer_start(&timer);
 #endif
-            while ((!start_lf[0]) || (!start_lf[1]) || (!start_lf[2])) {
-                start_lf[0] = 1;
-                start_lf[1] = 1;
-                start_lf[2] = 1;
+            for (int j = 0; j < 3; j++) {
                 for (int i = 0; i < tiles_info->tile_cols; i++) {
-                    start_lf[0] &= dec_mt_frame_data->sb_recon_row_map[row_index[0] + i];
-                    start_lf[1] &= dec_mt_frame_data->sb_recon_row_map[row_index[1] + i];
-                    start_lf[2] &= dec_mt_frame_data->sb_recon_row_map[row_index[2] + i];
+                    dec_mt_wait_progress(
+                        dec_mt_frame_data,
+                        (volatile int32_t *)&dec_mt_frame_data->sb_recon_row_map[row_index[j] + i],
+                        1);
                 }
             }
 #if MT_WAIT_PROFILE
             dec_display_timer("LFWR", &timer, th_cnt, fp);
 #endif
-            if (!dec_handle->frame_header.allow_intrabc) {
+            if (!dec_handle->frame_header.allow_intrabc && !dec_handle->skip_loop_filters) {
                 if (dec_handle->frame_header.loop_filter_params.filter_level[0] ||
                     dec_handle->frame_header.loop_filter_params.filter_level[1]) {
                     dec_loop_filter_row(dec_handle,
@@ -887,14 +981,18 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
                     dec_handle, tile_rect_p, sb_row - 1, src, stride, num_planes);
 
                 /* Update LF done map */
-                dec_mt_frame_data1->lf_row_map[sb_row - 1] = 1;
+                dec_mt_set_progress(dec_mt_frame_data1,
+                                    (volatile int32_t *)&dec_mt_frame_data1->lf_row_map[sb_row - 1],
+                                    1);
             }
             if (sb_row == dec_mt_frame_data->sb_rows - 1) {
                 dec_save_lf_boundary_lines_sb_row(
                     dec_handle, tile_rect_p, sb_row, src, stride, num_planes);
 
                 /* Update LF done map */
-                dec_mt_frame_data1->lf_row_map[sb_row] = 1;
+                dec_mt_set_progress(dec_mt_frame_data1,
+                                    (volatile int32_t *)&dec_mt_frame_data1->lf_row_map[sb_row],
+                                    1);
             }
         } else
             break;
@@ -953,7 +1051,7 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
     EbBool do_upscale  = no_ibc &&
         !av1_superres_unscaled(&dec_handle_ptr->frame_header.frame_size);
     LrParams *lr_param = dec_handle_ptr->frame_header.lr_params;
-    EbBool    do_lr    = no_ibc &&
+    EbBool    do_lr    = no_ibc && !dec_handle_ptr->skip_loop_filters &&
         (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
          lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
          lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
@@ -1013,16 +1111,15 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
 #if MT_WAIT_PROFILE
             dec_timer_start(&timer);
 #endif
-            volatile int32_t *start_cdef = (volatile int32_t *)&dec_mt_frame_data
-                                                ->lf_row_map[sb_row + offset];
-            while (!*start_cdef)
-                ;
-            assert(*start_cdef == 1);
+            dec_mt_wait_progress(
+                dec_mt_frame_data,
+                (volatile int32_t *)&dec_mt_frame_data->lf_row_map[sb_row + offset],
+                1);
 #if MT_WAIT_PROFILE
             dec_display_timer("CWLF", &timer, th_cnt, fp);
 #endif
             FrameHeader *frame_header = &dec_handle_ptr->frame_header;
-            if (!frame_header->allow_intrabc) {
+            if (!frame_header->allow_intrabc && !dec_handle_ptr->skip_loop_filters) {
                 const int32_t do_cdef = !frame_header->coded_lossless &&
                                         (frame_header->cdef_params.cdef_bits ||
                                          frame_header->cdef_params.cdef_y_strength[0] ||
@@ -1056,7 +1153,10 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
                 }
             }
             /* Update CDEF done map */
-            dec_mt_frame_data1->cdef_completed_for_row_map[sb_row] = 1;
+            dec_mt_set_progress(
+                dec_mt_frame_data1,
+                (volatile int32_t *)&dec_mt_frame_data1->cdef_completed_for_row_map[sb_row],
+                1);
 
         } else
             break;
@@ -1071,10 +1171,11 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
     eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
     dec_mt_frame_data->num_threads_cdefed++;
     eb_release_mutex(dec_mt_frame_data->temp_mutex);
+    dec_mt_wake_parked(dec_mt_frame_data);
     if (do_upscale) {
-        volatile uint32_t *num_threads_cdefed = &dec_mt_frame_data->num_threads_cdefed;
-        while (*num_threads_cdefed != dec_handle_ptr->dec_config.threads)
-            ;
+        dec_mt_wait_progress(dec_mt_frame_data,
+                             (volatile int32_t *)&dec_mt_frame_data->num_threads_cdefed,
+                             (int32_t)dec_handle_ptr->dec_config.threads);
     }
 }
 
@@ -1228,7 +1329,7 @@ void dec_av1_loop_restoration_filter_frame_mt(
 
     EbBool    no_ibc   = !frame_header->allow_intrabc;
     LrParams *lr_param = frame_header->lr_params;
-    EbBool    do_lr    = no_ibc &&
+    EbBool    do_lr    = no_ibc && !dec_handle->skip_loop_filters &&
         (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
          lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
          lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
@@ -1239,11 +1340,10 @@ void dec_av1_loop_restoration_filter_frame_mt(
         int32_t sb_row = get_sb_row_to_process(&dec_mt_frame_data->lr_sb_row_info);
         if (-1 != sb_row) {
             /* Ensure all CDEF jobs are over for row_index row  */
-            volatile int32_t *start_lr =
-                (volatile int32_t *)&dec_mt_frame_data->
-                cdef_completed_for_row_map[sb_row];
-            while (!*start_lr)
-                ;
+            dec_mt_wait_progress(
+                dec_mt_frame_data,
+                (volatile int32_t *)&dec_mt_frame_data->cdef_completed_for_row_map[sb_row],
+                1);
 
             LrCtxt * lr_ctxt = (LrCtxt *)dec_handle->pv_lr_ctxt;
 
@@ -1308,8 +1408,12 @@ void dec_av1_loop_restoration_filter_frame_mt(
     }
 
     eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
+    /* The main thread resets num_threads_lred for the next frame, possibly
+       before a parked thread is back, so the barrier waits on the frame count */
+    int32_t num_frames_lred = dec_mt_frame_data->num_frames_lred;
     dec_mt_frame_data->num_threads_lred++;
     if (dec_handle->dec_config.threads == dec_mt_frame_data->num_threads_lred) {
+        dec_mt_frame_data->num_frames_lred++;
         dec_mt_frame_data->start_motion_proj  = EB_FALSE;
         dec_mt_frame_data->start_parse_frame  = EB_FALSE;
         dec_mt_frame_data->start_decode_frame = EB_FALSE;
@@ -1318,10 +1422,10 @@ void dec_av1_loop_restoration_filter_frame_mt(
         dec_mt_frame_data->start_lr_frame     = EB_FALSE;
     }
     eb_release_mutex(dec_mt_frame_data->temp_mutex);
+    dec_mt_wake_parked(dec_mt_frame_data);
 
-    volatile uint32_t *num_threads_lred = &dec_mt_frame_data->num_threads_lred;
-    while (*num_threads_lred != dec_handle->dec_config.threads &&
-            EB_FALSE == dec_mt_frame_data->end_flag);
+    dec_mt_wait_progress(
+        dec_mt_frame_data, &dec_mt_frame_data->num_frames_lred, num_frames_lred + 1);
 }
 
 void *dec_all_stage_kernel(void *input_ptr) {
@@ -1331,8 +1435,7 @@ void *dec_all_stage_kernel(void *input_ptr) {
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
     volatile EbBool *start_thread = (volatile EbBool *)&dec_handle_ptr->start_thread_process;
-    while (*start_thread == EB_FALSE)
-        ;
+    while (*start_thread == EB_FALSE) eb_block_on_semaphore(thread_ctxt->thread_semaphore);
 
     while (1) {
         /* Motion Field Projection */
@@ -1372,8 +1475,9 @@ void dec_sync_all_threads(EbDecHandle *dec_handle_ptr) {
     dec_mt_frame_data->num_threads_cdefed = 1;
     dec_mt_frame_data->num_threads_lred   = 1;
 
-    /* To make all worker exit except main thread! */
-    dec_mt_frame_data->num_threads_header          = 1;
+    /* Only the workers pass the motion field setup, the main thread
+       does not take part any more */
+    dec_mt_frame_data->num_threads_header          = 0;
     dec_handle_ptr->frame_header.use_ref_frame_mvs = 0;
     dec_mt_frame_data->start_motion_proj           = EB_TRUE;
 
@@ -71,9 +71,9 @@ typedef struct DecMtNode {
 } DecMtNode;
 
 typedef struct DecMtMotionProjInfo {
-    /* Array to store MotionFieldProjection rows picked up for processing in Frame.
-       This will be used for deciding row for motion_field_projections_row. */
-    //uint32_t    *row_motion_proj_started;
+    /* Array to store MotionFieldProjection rows completed in Frame. Parsing
+       of a SB row waits only for the 64x64 rows it covers. */
+    uint32_t *motion_proj_row_done;
 
     /* ToDo : change below items to be use DecMTRowInfo based */
     /* Number of rows in Frame : 64x64 level */
@@ -85,8 +85,6 @@ typedef struct DecMtMotionProjInfo {
     /* Motion Projection row state context */
     int32_t motion_proj_row_to_process;
 
-    EbBool motion_proj_init_done;
-
 } DecMtMotionProjInfo;
 
 
@@ -183,6 +181,16 @@ typedef struct DecMTFrameData {
 
     EbHandle            temp_mutex;
 
+    /* A thread waiting on the progress of another thread spins for a short
+       while, then parks in a free slot until the next progress update.
+       One slot per thread, each with its own semaphore. */
+    EbHandle           *park_semaphore;
+    uint8_t            *park_slot_state;
+    EbHandle            park_mutex;
+    volatile int32_t    num_parked;
+    /* Number of frames all the threads are done with, used as LR barrier */
+    volatile int32_t    num_frames_lred;
+
     TilesInfo *tiles_info;
 
     /* Motion Field Projection Info*/
@@ -247,6 +255,15 @@ typedef struct DecMTFrameData {
 #endif
 } DecMtFrameData;
 
+/* Blocks until '*progress' reaches 'target' */
+void dec_mt_wait_progress(DecMtFrameData *dec_mt_frame_data, volatile int32_t *progress,
+                          int32_t target);
+/* Publishes 'value' to '*progress' and wakes up the parked threads */
+void dec_mt_set_progress(DecMtFrameData *dec_mt_frame_data, volatile int32_t *progress,
+                         int32_t value);
+/* Wakes up the parked threads after a progress update made under a lock */
+void dec_mt_wake_parked(DecMtFrameData *dec_mt_frame_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -205,7 +205,7 @@ void decode_block(DecModCtxt *dec_mod_ctxt, BlockModeInfo *mode_info, int32_t mi
                     (volatile int32_t*) &dec_mt_frame_data->
                     parse_recon_tile_info_array[tiles_ctr].
                     sb_recon_completed_in_row[ref_sb_tile_row];
-                while (*ref_sb_completed < ref_sb_tile_col + 1);
+                dec_mt_wait_progress(dec_mt_frame_data, ref_sb_completed, ref_sb_tile_col + 1);
             }
         }
     }
@@ -26,6 +26,7 @@
 #include "EbDecProcessBlock.h"
 #include "EbDecNbr.h"
 #include "EbUtility.h"
+#include "EbDecUtils.h"
 
 /* decode partition */
 static void decode_partition(DecModCtxt *dec_mod_ctxt,
@@ -73,8 +74,9 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
     EbDecHandle *     dec_handle_ptr           = (EbDecHandle *)(dec_mod_ctxt->dec_handle_ptr);
     MasterFrameBuf *  master_frame_buf         = &dec_handle_ptr->master_frame_buf;
     CurFrameBuf *     frame_buf                = &master_frame_buf->cur_frame_bufs[0];
+    DecMtFrameData *  mt_frame_data            = &frame_buf->dec_mt_frame_data;
     volatile int32_t *sb_completed_in_prev_row = NULL;
-    uint32_t *        sb_completed_in_row;
+    volatile int32_t *sb_completed_in_row;
     int32_t           tile_wd_in_sb;
     int32_t           sb_mi_size_log2 = dec_mod_ctxt->seq_header->sb_size_log2 - MI_SIZE_LOG2;
 
@@ -89,7 +91,8 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
                                        ->sb_recon_completed_in_row[sb_row_in_tile - 1];
     }
 
-    sb_completed_in_row = &parse_recon_tile_info_array->sb_recon_completed_in_row[sb_row_in_tile];
+    sb_completed_in_row = (volatile int32_t *)&parse_recon_tile_info_array
+                              ->sb_recon_completed_in_row[sb_row_in_tile];
 
     tile_wd_in_sb =
         (AOMMIN(tile_info->tile_col_start_mi[tile_col + 1], dec_handle_ptr->frame_header.mi_cols) +
@@ -99,6 +102,14 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
     //tile_wd_in_sb = ( (tile_info->tile_col_start_mi[tile_col + 1] << MI_SIZE_LOG2) ) >>
     //   dec_mod_ctxt->seq_header->sb_size_log2;
 
+    /* Tiles outside the region of interest are only parsed */
+    const TileInfo *cur_tile   = &dec_mod_ctxt->cur_tile_info;
+    EbBool          recon_tile = dec_roi_is_active(dec_handle_ptr,
+                                          cur_tile->mi_row_start,
+                                          cur_tile->mi_col_start,
+                                          cur_tile->mi_row_end - cur_tile->mi_row_start,
+                                          cur_tile->mi_col_end - cur_tile->mi_col_start);
+
     for (uint32_t mi_col = tile_info->tile_col_start_mi[tile_col];
          mi_col < tile_info->tile_col_start_mi[tile_col + 1];
          mi_col += dec_mod_ctxt->seq_header->sb_mi_size)
@@ -113,18 +124,17 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
         dec_mod_ctxt->cur_coeff[AOM_PLANE_V] = sb_info->sb_coeff[AOM_PLANE_V];
         /* Top-Right Sync*/
         if (sb_row_in_tile) {
-            while (*sb_completed_in_prev_row < MIN((sb_col + 2), tile_wd_in_sb))
-                ;
-            //Sleep(5); /* ToDo : Change */
+            dec_mt_wait_progress(
+                mt_frame_data, sb_completed_in_prev_row, MIN((sb_col + 2), tile_wd_in_sb));
         }
 
-        decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
-        *sb_completed_in_row = (uint32_t)(sb_col + 1);
+        if (recon_tile) decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
+        dec_mt_set_progress(mt_frame_data, sb_completed_in_row, sb_col + 1);
     }
 
-    DecMtFrameData *mt_frame_data = &frame_buf->dec_mt_frame_data;
-    int             index         = mi_row / dec_mod_ctxt->seq_header->sb_mi_size;
-    mt_frame_data->sb_recon_row_map[(index * tile_info->tile_cols) + tile_col] = 1;
+    int       index       = mi_row / dec_mod_ctxt->seq_header->sb_mi_size;
+    uint32_t *sb_recon_row = &mt_frame_data->sb_recon_row_map[index * tile_info->tile_cols];
+    dec_mt_set_progress(mt_frame_data, (volatile int32_t *)&sb_recon_row[tile_col], 1);
     return status;
 }
 EbErrorType decode_tile(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
@@ -153,10 +163,13 @@ EbErrorType decode_tile(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
 
         //wait for parse
         if (-1 != sb_row_in_tile) {
-            volatile int32_t *sb_row_parsed = (volatile int32_t *)&parse_recon_tile_info_array
-                                                  ->sb_recon_row_parsed[sb_row_in_tile];
-            while (0 == *sb_row_parsed)
-                ;
+            EbDecHandle *   dec_handle_ptr = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
+            DecMtFrameData *mt_frame_data =
+                &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+            dec_mt_wait_progress(mt_frame_data,
+                                 (volatile int32_t *)&parse_recon_tile_info_array
+                                     ->sb_recon_row_parsed[sb_row_in_tile],
+                                 1);
 
             int32_t sb_row = sb_row_in_tile + sb_row_tile_start;
 
@@ -282,24 +282,36 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t sb_row
     uint8_t dst_stride = RESTORATION_PROC_UNIT_SIZE;
 
     volatile int32_t *sb_lr_completed_in_prev_row = NULL;
-    int32_t *sb_lr_completed_in_row, nsync = 1;
+    volatile int32_t *sb_lr_completed_in_row = NULL;
+    int32_t nsync = 1;
     EbBool is_mt = dec_handle->dec_config.threads > 1;
+    DecMtFrameData *dec_mt_frame_data = &dec_handle->master_frame_buf.
+        cur_frame_bufs[0].dec_mt_frame_data;
 
     int32_t sb_row_idx = (is_mt == 0) ? 0 : sb_row;
     int32_t index = lr_ctxt->is_thread_min ? thread_cnt : sb_row_idx;
 
     if (is_mt) {
-        DecMtFrameData *dec_mt_frame_data = &dec_handle->master_frame_buf.
-            cur_frame_bufs[0].dec_mt_frame_data;
-
         if (sb_row) {
             sb_lr_completed_in_prev_row = (volatile int32_t *)
                 &dec_mt_frame_data->sb_lr_completed_in_row[sb_row - 1];
         }
-        sb_lr_completed_in_row =
+        sb_lr_completed_in_row = (volatile int32_t *)
             &dec_mt_frame_data->sb_lr_completed_in_row[sb_row];
     }
 
+    /* With a region of interest, only the processing units overlapping it
+       are restored. A unit keeps the restored samples of its right edge in
+       place when the next unit is skipped, and takes back those of the
+       previous unit only when that one was restored. */
+    const DecRoiRegion *roi = &dec_handle->roi_region;
+    int sb_size_log2 = dec_handle->seq_header.sb_size_log2;
+    int row_start_y = (sb_row << sb_size_log2) - RESTORATION_UNIT_OFFSET;
+    int row_end_y = ((sb_row + 1) << sb_size_log2) - RESTORATION_UNIT_OFFSET;
+    EbBool row_active = !roi->enabled ||
+        (row_end_y > roi->lr_y_start && row_start_y < roi->lr_y_end);
+    EbBool prev_active = EB_FALSE;
+
     for (int col_y = 0, sb_col_y = 0; col_y < tile_w_y; col_y += w_y, sb_col_y++) {
         int remaining_w_y = tile_w_y - col_y;
         int proc_width_y = RESTORATION_PROC_UNIT_SIZE;
@@ -310,9 +322,23 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t sb_row
             if (sb_row) {
                 if (col_y >= tile_w_y - w_y)
                     nsync = 0;
-                while (*sb_lr_completed_in_prev_row < (sb_col_y + nsync));
+                dec_mt_wait_progress(dec_mt_frame_data,
+                    sb_lr_completed_in_prev_row, sb_col_y + nsync);
             }
         }
+
+        int col_x = tile_rect[AOM_PLANE_Y].left + col_y;
+        EbBool active = row_active && (!roi->enabled ||
+            (col_x + w_y > roi->lr_x_start && col_x < roi->lr_x_end));
+        int next_w_y = AOMMIN(tile_w_y - col_y - w_y, RESTORATION_PROC_UNIT_SIZE);
+        EbBool next_active = row_active && (!roi->enabled ||
+            (col_x + w_y + next_w_y > roi->lr_x_start && col_x + w_y < roi->lr_x_end));
+        if (!active) {
+            prev_active = EB_FALSE;
+            if (is_mt)
+                dec_mt_set_progress(dec_mt_frame_data, sb_lr_completed_in_row, sb_col_y);
+            continue;
+        }
         int sx = 0, sy = 0;
         uint8_t* src = NULL;
         uint32_t src_stride = 0;
@@ -420,14 +446,14 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t sb_row
                     dst_stride, lr_ctxt->rst_tmpbuf[index], optimized_lr);
             src_ptr = src_proc - proc_width;
             // restore LR_data of previous block
-            if (col)
+            if (col && prev_active)
                 for (int proc = 0; proc < height; proc++) {
                     eb_memcpy(src_ptr, bdry_lr_ptr, width);
                     src_ptr += stride;
                     bdry_lr_ptr += width;
                 }
 
-            if ((col + block_w) < plane_tile_w)
+            if ((col + block_w) < plane_tile_w && next_active)
                 for (int proc = 0; proc < height; proc++) {
                     // save lr_data of current block to temp_buf
                     eb_memcpy(bdry_lr, src_proc, width);
@@ -440,8 +466,9 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t sb_row
                 }
         }
 
+        prev_active = EB_TRUE;
         if (is_mt) {
-            *sb_lr_completed_in_row = sb_col_y;
+            dec_mt_set_progress(dec_mt_frame_data, sb_lr_completed_in_row, sb_col_y);
         }
     }
 }
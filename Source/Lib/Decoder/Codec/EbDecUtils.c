@@ -21,6 +21,8 @@
 #include "EbMcp.h"
 #include "EbDecBlock.h"
 #include "EbDecMemInit.h"
+#include "EbCdef.h"
+#include "EbRestoration.h"
 
 EbErrorType check_add_tplmv_buf(EbDecHandle *dec_handle_ptr) {
     FrameHeader * ps_frm_hdr = &dec_handle_ptr->frame_header;
@@ -305,3 +307,96 @@ int inverse_recenter(int r, int v) {
     else
         return r + (v >> 1);
 }
+
+/* Samples read on each side of an edge by the 14-tap deblocking filter */
+#define DEC_ROI_DEBLOCK_BORDER 7
+/* Samples read on each side of a position by the 8-tap superres upscaler */
+#define DEC_ROI_UPSCALE_BORDER 4
+
+/* Derives the tiles of the current frame that cover the configured region of
+   interest grown by the extents of the in-loop filters: the loop restoration
+   border in the upscaled frame, the superres taps mapped to the coded frame,
+   then the CDEF and deblocking borders. The borders are scaled by the chroma
+   subsampling to cover the chroma planes too. Whole tiles are reconstructed,
+   so the region is snapped outwards to tile boundaries. */
+void dec_setup_roi_region(EbDecHandle *dec_handle_ptr) {
+    EbSvtAv1DecConfiguration *config       = &dec_handle_ptr->dec_config;
+    FrameHeader *             frame_header = &dec_handle_ptr->frame_header;
+    FrameSize *               frame_size   = &frame_header->frame_size;
+    TilesInfo *               tiles_info   = &frame_header->tiles_info;
+    DecRoiRegion *            roi          = &dec_handle_ptr->roi_region;
+    EbColorConfig *           color_config = &dec_handle_ptr->seq_header.color_config;
+
+    roi->enabled = config->roi_width && config->roi_height;
+    if (!roi->enabled) return;
+
+    int32_t ss_x = color_config->mono_chrome ? 0 : color_config->subsampling_x;
+    int32_t ss_y = color_config->mono_chrome ? 0 : color_config->subsampling_y;
+
+    /* Loop restoration reads the CDEF output around the region */
+    int64_t lr_x0 = (int64_t)config->roi_x - (RESTORATION_BORDER << ss_x);
+    int64_t lr_y0 = (int64_t)config->roi_y - (RESTORATION_BORDER << ss_y);
+    int64_t lr_x1 = (int64_t)config->roi_x + config->roi_width + (RESTORATION_BORDER << ss_x);
+    int64_t lr_y1 = (int64_t)config->roi_y + config->roi_height + (RESTORATION_BORDER << ss_y);
+    roi->lr_x_start = (int32_t)AOMMAX(lr_x0, 0);
+    roi->lr_y_start = (int32_t)AOMMAX(lr_y0, 0);
+    roi->lr_x_end   = (int32_t)AOMMIN(lr_x1, frame_size->superres_upscaled_width);
+    roi->lr_y_end   = (int32_t)AOMMIN(lr_y1, frame_size->frame_height);
+
+    /* The upscaler reads around the position of each sample in the coded
+       frame */
+    int64_t x0 = lr_x0, x1 = lr_x1;
+    if (frame_size->frame_width != frame_size->superres_upscaled_width) {
+        const int64_t denom = frame_size->superres_denominator;
+        x0 = x0 * denom / SCALE_NUMERATOR - (DEC_ROI_UPSCALE_BORDER << ss_x);
+        x1 = (x1 * denom + SCALE_NUMERATOR - 1) / SCALE_NUMERATOR +
+            (DEC_ROI_UPSCALE_BORDER << ss_x);
+    }
+
+    /* CDEF and the deblocking filter read around the samples they filter */
+    const int32_t border = CDEF_VBORDER + DEC_ROI_DEBLOCK_BORDER;
+    x0 = (x0 - (border << ss_x)) >> MI_SIZE_LOG2;
+    x1 = (x1 + (border << ss_x) + MI_SIZE - 1) >> MI_SIZE_LOG2;
+    int64_t y0 = (lr_y0 - (border << ss_y)) >> MI_SIZE_LOG2;
+    int64_t y1 = (lr_y1 + (border << ss_y) + MI_SIZE - 1) >> MI_SIZE_LOG2;
+
+    /* Nothing to decode outside the frame: fall back to the full frame */
+    if (x0 >= frame_header->mi_cols || y0 >= frame_header->mi_rows) {
+        roi->enabled = EB_FALSE;
+        return;
+    }
+
+    int32_t col = 0, row = 0;
+    while (tiles_info->tile_col_start_mi[col + 1] <= x0) col++;
+    roi->mi_col_start = tiles_info->tile_col_start_mi[col];
+    while (col < tiles_info->tile_cols && tiles_info->tile_col_start_mi[col] < x1) col++;
+    roi->mi_col_end = AOMMIN(tiles_info->tile_col_start_mi[col], frame_header->mi_cols);
+
+    while (tiles_info->tile_row_start_mi[row + 1] <= y0) row++;
+    roi->mi_row_start = tiles_info->tile_row_start_mi[row];
+    while (row < tiles_info->tile_rows && tiles_info->tile_row_start_mi[row] < y1) row++;
+    roi->mi_row_end = AOMMIN(tiles_info->tile_row_start_mi[row], frame_header->mi_rows);
+}
+
+static EbBool dec_skip_level_applies(EbDecSkipLevel level, const FrameHeader *frame_header) {
+    switch (level) {
+    case EB_DEC_SKIP_NONREF:
+        /* A shown existing frame was decoded as a reference */
+        return !frame_header->show_existing_frame && !frame_header->refresh_frame_flags;
+    case EB_DEC_SKIP_NONKEY: return frame_header->frame_type != KEY_FRAME;
+    case EB_DEC_SKIP_ALL: return EB_TRUE;
+    default: return EB_FALSE;
+    }
+}
+
+/* Derives the frame level skip flags of the current frame from the
+   skip_frame and skip_loop_filter levels of the configuration. Must be
+   called once the frame type and the refresh flags are known. */
+void dec_setup_skip_flags(EbDecHandle *dec_handle_ptr) {
+    EbSvtAv1DecConfiguration *config       = &dec_handle_ptr->dec_config;
+    FrameHeader *             frame_header = &dec_handle_ptr->frame_header;
+
+    dec_handle_ptr->frame_dropped = dec_skip_level_applies(config->skip_frame, frame_header);
+    dec_handle_ptr->skip_loop_filters =
+        dec_skip_level_applies(config->skip_loop_filter, frame_header);
+}
@@ -61,6 +61,20 @@ void pad_row(EbPictureBufferDesc *recon_picture_buf,
 
 int inverse_recenter(int r, int v);
 
+void dec_setup_roi_region(EbDecHandle *dec_handle_ptr);
+
+void dec_setup_skip_flags(EbDecHandle *dec_handle_ptr);
+
+/* Returns whether the mi_h x mi_w area at (mi_row, mi_col) overlaps the
+   reconstructed region of the current frame */
+static INLINE EbBool dec_roi_is_active(const EbDecHandle *dec_handle_ptr, int32_t mi_row,
+                                       int32_t mi_col, int32_t mi_h, int32_t mi_w) {
+    const DecRoiRegion *roi = &dec_handle_ptr->roi_region;
+    if (!roi->enabled) return EB_TRUE;
+    return (EbBool)(mi_row < roi->mi_row_end && mi_row + mi_h > roi->mi_row_start &&
+                    mi_col < roi->mi_col_end && mi_col + mi_w > roi->mi_col_start);
+}
+
 static INLINE int is_interintra_allowed_bsize(const BlockSize bsize) {
     return (bsize >= BLOCK_8X8) && (bsize <= BLOCK_32X32);
 }
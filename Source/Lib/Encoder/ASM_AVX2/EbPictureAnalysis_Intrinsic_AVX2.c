@@ -0,0 +1,133 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+// Packs the 16 32-bit values of a and b (each < 256) to 16 bytes, in order
+static INLINE __m128i pack_32_to_8_avx2(const __m256i a, const __m256i b) {
+    const __m256i w = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+    return _mm256_castsi256_si128(
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(w, w), 0x08));
+}
+
+// Packs the 32 16-bit values of a and b (each < 256) to 32 bytes, in order
+static INLINE __m256i pack_16_to_8_avx2(const __m256i a, const __m256i b) {
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+}
+
+/********************************************
+ * decimation_2d_avx2
+ *      decimates the input, steps 2 and 4 are vectorized
+ ********************************************/
+void decimation_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width,
+                        uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride,
+                        uint32_t decim_step) {
+    if (decim_step != 2 && decim_step != 4) {
+        decimation_2d_c(input_samples,
+                        input_stride,
+                        input_area_width,
+                        input_area_height,
+                        decim_samples,
+                        decim_stride,
+                        decim_step);
+        return;
+    }
+
+    const uint32_t shift       = decim_step >> 1;
+    const uint32_t out_width   = (input_area_width + decim_step - 1) >> shift;
+    const uint32_t out_per_reg = 64 >> shift;
+    const __m256i  mask16      = _mm256_set1_epi16(0x00FF);
+    const __m256i  mask32      = _mm256_set1_epi32(0x000000FF);
+
+    for (uint32_t y = 0; y < input_area_height; y += decim_step) {
+        uint32_t x = 0;
+        // Whole registers are only read inside the input area
+        for (; (x + out_per_reg) << shift <= input_area_width; x += out_per_reg) {
+            const __m256i in0 = _mm256_loadu_si256((const __m256i *)(input_samples + (x << shift)));
+            const __m256i in1 =
+                _mm256_loadu_si256((const __m256i *)(input_samples + (x << shift) + 32));
+            if (decim_step == 2)
+                _mm256_storeu_si256((__m256i *)(decim_samples + x),
+                                    pack_16_to_8_avx2(_mm256_and_si256(in0, mask16),
+                                                      _mm256_and_si256(in1, mask16)));
+            else
+                _mm_storeu_si128((__m128i *)(decim_samples + x),
+                                 pack_32_to_8_avx2(_mm256_and_si256(in0, mask32),
+                                                   _mm256_and_si256(in1, mask32)));
+        }
+        for (; x < out_width; ++x) decim_samples[x] = input_samples[x << shift];
+
+        input_samples += input_stride * decim_step;
+        decim_samples += decim_stride;
+    }
+}
+
+/********************************************
+ * downsample_2d_avx2
+ *      2x2 0-phase filtering as downsample_2d_c, steps 2 and 4 are vectorized
+ ********************************************/
+void downsample_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width,
+                        uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride,
+                        uint32_t decim_step) {
+    if (decim_step != 2 && decim_step != 4) {
+        downsample_2d_c(input_samples,
+                        input_stride,
+                        input_area_width,
+                        input_area_height,
+                        decim_samples,
+                        decim_stride,
+                        decim_step);
+        return;
+    }
+
+    const uint32_t half_decim_step = decim_step >> 1;
+    const uint32_t shift           = half_decim_step;
+    const uint32_t out_per_reg     = 64 >> shift;
+    // Pixels (step / 2 - 1, step / 2) of each group of 'step' pixels are filtered
+    const __m256i taps = decim_step == 2 ? _mm256_set1_epi8(1) : _mm256_set1_epi32(0x00010100);
+    const __m256i ones16 = _mm256_set1_epi16(1);
+    const __m256i round  = decim_step == 2 ? _mm256_set1_epi16(2) : _mm256_set1_epi32(2);
+
+    input_samples += half_decim_step * input_stride;
+    for (uint32_t y = half_decim_step; y < input_area_height; y += decim_step) {
+        const uint8_t *prev_input_line = input_samples - input_stride;
+        uint32_t       x               = 0;
+        for (; (x + out_per_reg) << shift <= input_area_width; x += out_per_reg) {
+            const uint8_t *p0   = prev_input_line + (x << shift);
+            const uint8_t *p1   = input_samples + (x << shift);
+            __m256i        sum0 = _mm256_add_epi16(
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)p0), taps),
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)p1), taps));
+            __m256i sum1 = _mm256_add_epi16(
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)(p0 + 32)), taps),
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)(p1 + 32)), taps));
+            if (decim_step == 2) {
+                sum0 = _mm256_srli_epi16(_mm256_add_epi16(sum0, round), 2);
+                sum1 = _mm256_srli_epi16(_mm256_add_epi16(sum1, round), 2);
+                _mm256_storeu_si256((__m256i *)(decim_samples + x), pack_16_to_8_avx2(sum0, sum1));
+            } else {
+                sum0 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(sum0, ones16), round), 2);
+                sum1 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(sum1, ones16), round), 2);
+                _mm_storeu_si128((__m128i *)(decim_samples + x), pack_32_to_8_avx2(sum0, sum1));
+            }
+        }
+        for (uint32_t h = (x << shift) + half_decim_step; h < input_area_width; h += decim_step, ++x) {
+            const uint32_t sum = (uint32_t)prev_input_line[h - 1] + (uint32_t)prev_input_line[h] +
+                                 (uint32_t)input_samples[h - 1] + (uint32_t)input_samples[h];
+            decim_samples[x] = (sum + 2) >> 2;
+        }
+        input_samples += input_stride * decim_step;
+        decim_samples += decim_stride;
+    }
+}
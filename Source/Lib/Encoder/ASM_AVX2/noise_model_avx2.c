@@ -0,0 +1,133 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+
+// Same operations as the C version, element by element, so the equation
+// system stays bit exact
+void eb_aom_noise_model_add_observation_avx2(double *A, double *b, const double *buffer,
+                                             double val, int32_t n, double normalization) {
+    const double  norm2   = normalization * normalization;
+    const __m256d norm2_v = _mm256_set1_pd(norm2);
+
+    for (int32_t i = 0; i < n; ++i) {
+        const __m256d bi    = _mm256_set1_pd(buffer[i]);
+        double *      a_row = A + i * n;
+        int32_t       j     = i;
+
+        for (; j + 4 <= n; j += 4) {
+            const __m256d prod = _mm256_div_pd(_mm256_mul_pd(bi, _mm256_loadu_pd(buffer + j)),
+                                               norm2_v);
+            _mm256_storeu_pd(a_row + j, _mm256_add_pd(_mm256_loadu_pd(a_row + j), prod));
+        }
+        for (; j < n; ++j) a_row[j] += (buffer[i] * buffer[j]) / norm2;
+        b[i] += (buffer[i] * val) / norm2;
+    }
+}
+
+static INLINE __m256 cvt_8_pd_ps(const double *src) {
+    const __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(src));
+    const __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(src + 4));
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+}
+
+// Each lane of at_b sums one column of A in the order of multiply_mat, and the
+// plane is evaluated sample by sample, so block and plane are bit exact
+void eb_aom_flat_block_remove_plane_avx2(double *block, double *plane, const double *A,
+                                         const double *at_a_inv, double normalization, int32_t n) {
+    const __m256d norm_v   = _mm256_set1_pd(normalization);
+    const __m256i row_mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+    const __m128i col_idx  = _mm_setr_epi32(0, 3, 6, 9);
+    __m256d       at_b     = _mm256_setzero_pd();
+    double        at_a_inv__b[4], plane_coords[3];
+    int32_t       i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m256d b = _mm256_div_pd(_mm256_loadu_pd(block + i), norm_v);
+        _mm256_storeu_pd(block + i, b);
+        at_b = _mm256_add_pd(at_b,
+                             _mm256_mul_pd(_mm256_permute4x64_pd(b, 0x00),
+                                           _mm256_maskload_pd(A + 3 * i, row_mask)));
+        at_b = _mm256_add_pd(at_b,
+                             _mm256_mul_pd(_mm256_permute4x64_pd(b, 0x55),
+                                           _mm256_maskload_pd(A + 3 * i + 3, row_mask)));
+        at_b = _mm256_add_pd(at_b,
+                             _mm256_mul_pd(_mm256_permute4x64_pd(b, 0xaa),
+                                           _mm256_maskload_pd(A + 3 * i + 6, row_mask)));
+        at_b = _mm256_add_pd(at_b,
+                             _mm256_mul_pd(_mm256_permute4x64_pd(b, 0xff),
+                                           _mm256_maskload_pd(A + 3 * i + 9, row_mask)));
+    }
+    for (; i < n; ++i) {
+        block[i] /= normalization;
+        at_b = _mm256_add_pd(
+            at_b,
+            _mm256_mul_pd(_mm256_set1_pd(block[i]), _mm256_maskload_pd(A + 3 * i, row_mask)));
+    }
+    _mm256_storeu_pd(at_a_inv__b, at_b);
+
+    for (int32_t row = 0; row < 3; ++row) {
+        double sum = 0;
+        for (int32_t k = 0; k < 3; ++k) sum += at_a_inv[row * 3 + k] * at_a_inv__b[k];
+        plane_coords[row] = sum;
+    }
+
+    const __m256d c0 = _mm256_set1_pd(plane_coords[0]);
+    const __m256d c1 = _mm256_set1_pd(plane_coords[1]);
+    const __m256d c2 = _mm256_set1_pd(plane_coords[2]);
+    for (i = 0; i + 4 <= n; i += 4) {
+        const double *a = A + 3 * i;
+        __m256d p = _mm256_add_pd(_mm256_setzero_pd(),
+                                  _mm256_mul_pd(_mm256_i32gather_pd(a, col_idx, 8), c0));
+        p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_i32gather_pd(a + 1, col_idx, 8), c1));
+        p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_i32gather_pd(a + 2, col_idx, 8), c2));
+        _mm256_storeu_pd(plane + i, p);
+        _mm256_storeu_pd(block + i, _mm256_sub_pd(_mm256_loadu_pd(block + i), p));
+    }
+    for (; i < n; ++i) {
+        double sum = 0;
+        for (int32_t k = 0; k < 3; ++k) sum += A[3 * i + k] * plane_coords[k];
+        plane[i] = sum;
+        block[i] -= sum;
+    }
+}
+
+void eb_aom_wiener_window_block_avx2(const double *block_d, const float *window, float *block,
+                                     int32_t n) {
+    int32_t i;
+    for (i = 0; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(block + i,
+                         _mm256_mul_ps(cvt_8_pd_ps(block_d + i), _mm256_loadu_ps(window + i)));
+    for (; i < n; ++i) block[i] = (float)block_d[i] * window[i];
+}
+
+void eb_aom_wiener_accumulate_block_avx2(const float *block, const double *plane_d,
+                                         const float *window, float *result,
+                                         int32_t result_stride, int32_t block_size) {
+    for (int32_t y = 0; y < block_size; ++y) {
+        const int32_t row = y * block_size;
+        float *       res = result + y * result_stride;
+        int32_t       x;
+        for (x = 0; x + 8 <= block_size; x += 8) {
+            const __m256 w     = _mm256_loadu_ps(window + row + x);
+            const __m256 plane = _mm256_mul_ps(cvt_8_pd_ps(plane_d + row + x), w);
+            const __m256 sum   = _mm256_add_ps(_mm256_loadu_ps(block + row + x), plane);
+            _mm256_storeu_ps(res + x,
+                             _mm256_add_ps(_mm256_loadu_ps(res + x), _mm256_mul_ps(sum, w)));
+        }
+        for (; x < block_size; ++x) {
+            const int32_t i = row + x;
+            res[x] += (block[i] + (float)plane_d[i] * window[i]) * window[i];
+        }
+    }
+}
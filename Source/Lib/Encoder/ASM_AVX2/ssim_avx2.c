@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+static INLINE uint32_t hadd32_avx2(const __m256i v) {
+    const __m128i v4 = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    const __m128i v2 = _mm_add_epi32(v4, _mm_srli_si128(v4, 8));
+    const __m128i v1 = _mm_add_epi32(v2, _mm_srli_si128(v2, 4));
+    return (uint32_t)_mm_cvtsi128_si32(v1);
+}
+
+// s and r hold 16 pixels (two rows of 8) widened to 16 bits. All products fit
+// in signed 16 bits x 16 bits with pairwise sums below 2^31 for up to 12-bit
+// input, so _mm256_madd_epi16() is exact.
+static INLINE void ssim_accumulate_avx2(const __m256i s, const __m256i r, __m256i *sum_s,
+                                        __m256i *sum_r, __m256i *sum_sq_s, __m256i *sum_sq_r,
+                                        __m256i *sum_sxr) {
+    const __m256i one = _mm256_set1_epi16(1);
+    *sum_s            = _mm256_add_epi32(*sum_s, _mm256_madd_epi16(s, one));
+    *sum_r            = _mm256_add_epi32(*sum_r, _mm256_madd_epi16(r, one));
+    *sum_sq_s         = _mm256_add_epi32(*sum_sq_s, _mm256_madd_epi16(s, s));
+    *sum_sq_r         = _mm256_add_epi32(*sum_sq_r, _mm256_madd_epi16(r, r));
+    *sum_sxr          = _mm256_add_epi32(*sum_sxr, _mm256_madd_epi16(s, r));
+}
+
+static INLINE __m256i load_u8_8x2_avx2(const uint8_t *p, int stride) {
+    const __m128i row0 = _mm_loadl_epi64((const __m128i *)p);
+    const __m128i row1 = _mm_loadl_epi64((const __m128i *)(p + stride));
+    return _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(row0, row1));
+}
+
+void aom_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s,
+                             uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                             uint32_t *sum_sxr) {
+    __m256i v_sum_s    = _mm256_setzero_si256();
+    __m256i v_sum_r    = _mm256_setzero_si256();
+    __m256i v_sum_sq_s = _mm256_setzero_si256();
+    __m256i v_sum_sq_r = _mm256_setzero_si256();
+    __m256i v_sum_sxr  = _mm256_setzero_si256();
+
+    for (int i = 0; i < 8; i += 2, s += 2 * sp, r += 2 * rp) {
+        ssim_accumulate_avx2(load_u8_8x2_avx2(s, sp),
+                             load_u8_8x2_avx2(r, rp),
+                             &v_sum_s,
+                             &v_sum_r,
+                             &v_sum_sq_s,
+                             &v_sum_sq_r,
+                             &v_sum_sxr);
+    }
+
+    *sum_s += hadd32_avx2(v_sum_s);
+    *sum_r += hadd32_avx2(v_sum_r);
+    *sum_sq_s += hadd32_avx2(v_sum_sq_s);
+    *sum_sq_r += hadd32_avx2(v_sum_sq_r);
+    *sum_sxr += hadd32_avx2(v_sum_sxr);
+}
+
+void aom_highbd_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *sinc, int spinc,
+                                    const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r,
+                                    uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    __m256i v_sum_s    = _mm256_setzero_si256();
+    __m256i v_sum_r    = _mm256_setzero_si256();
+    __m256i v_sum_sq_s = _mm256_setzero_si256();
+    __m256i v_sum_sq_r = _mm256_setzero_si256();
+    __m256i v_sum_sxr  = _mm256_setzero_si256();
+
+    for (int i = 0; i < 8; i += 2, s += 2 * sp, sinc += 2 * spinc, r += 2 * rp) {
+        // Rebuild the 10-bit source from the 8 msb and the 2 lsb planes.
+        const __m256i msb = load_u8_8x2_avx2(s, sp);
+        const __m256i lsb = load_u8_8x2_avx2(sinc, spinc);
+        const __m256i v_s =
+            _mm256_or_si256(_mm256_slli_epi16(msb, 2), _mm256_srli_epi16(lsb, 6));
+        const __m256i v_r = _mm256_insertf128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)r)),
+            _mm_loadu_si128((const __m128i *)(r + rp)),
+            1);
+        ssim_accumulate_avx2(
+            v_s, v_r, &v_sum_s, &v_sum_r, &v_sum_sq_s, &v_sum_sq_r, &v_sum_sxr);
+    }
+
+    *sum_s += hadd32_avx2(v_sum_s);
+    *sum_r += hadd32_avx2(v_sum_r);
+    *sum_sq_s += hadd32_avx2(v_sum_sq_s);
+    *sum_sq_r += hadd32_avx2(v_sum_sq_r);
+    *sum_sxr += hadd32_avx2(v_sum_sxr);
+}
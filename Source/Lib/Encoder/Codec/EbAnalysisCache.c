@@ -0,0 +1,517 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "EbAnalysisCache.h"
+#include "EbMotionEstimationLcuResults.h"
+#include "EbUtility.h"
+#include "EbLog.h"
+
+#ifdef _WIN32
+#define fseeko _fseeki64
+#define ftello _ftelli64
+#endif
+
+#define ANALYSIS_CACHE_MAGIC 0x43415653 // "SVAC"
+#define ANALYSIS_CACHE_VERSION 1
+
+/* File layout:
+ * - AnalysisCacheSignature
+ * - one record per picture, in the order the pictures complete ME:
+ *   AnalysisCacheRecordHeader, the SB payload offsets (sb_count + 1 entries,
+ *   relative to the first SB payload) and the SB payloads
+ * - the AnalysisCacheIndexEntry of every record
+ * - AnalysisCacheFooter
+ *
+ * SB payload: ME distortion, do_comp, then per PU the candidate count, the
+ * candidates and the MVs of the searched references, then the OIS results of
+ * the 16x16 blocks of the SB. Records are only valid for the same build of
+ * the encoder, the structures are stored as they are in memory. */
+typedef struct AnalysisCacheRecordHeader {
+    uint64_t             picture_number;
+    uint32_t             is_overlay;
+    uint32_t             sb_count;
+    uint32_t             pu_count;
+    uint32_t             has_me;
+    uint32_t             has_ois;
+    uint32_t             mv_count[MAX_NUM_OF_REF_PIC_LIST];
+    uint8_t              is_global_motion[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    EbWarpedMotionParams global_motion[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+} AnalysisCacheRecordHeader;
+
+typedef struct AnalysisCacheFooter {
+    uint64_t index_offset;
+    uint32_t index_count;
+    uint32_t magic;
+} AnalysisCacheFooter;
+
+static void analysis_cache_dctor(EbPtr p) {
+    AnalysisCache *obj = (AnalysisCache *)p;
+    if (obj->file) {
+        if (obj->mode == ANALYSIS_CACHE_WRITE) {
+            AnalysisCacheFooter footer;
+            footer.index_offset = (uint64_t)ftello(obj->file);
+            footer.index_count  = obj->index_count;
+            footer.magic        = ANALYSIS_CACHE_MAGIC;
+            if (fwrite(obj->index, sizeof(*obj->index), obj->index_count, obj->file) !=
+                    obj->index_count ||
+                fwrite(&footer, sizeof(footer), 1, obj->file) != 1)
+                SVT_ERROR("Failed to write the analysis cache index\n");
+        }
+        fclose(obj->file);
+    }
+    EB_FREE_ARRAY(obj->index);
+    EB_FREE_ARRAY(obj->record_offset[0]);
+    EB_FREE_ARRAY(obj->record_offset[1]);
+    EB_FREE_ARRAY(obj->sb_offset);
+    EB_FREE_ARRAY(obj->buffer);
+    EB_DESTROY_MUTEX(obj->mutex);
+}
+
+static void analysis_cache_signature(SequenceControlSet *scs_ptr, AnalysisCacheSignature *sig) {
+    const EbSvtAv1EncConfiguration *config = &scs_ptr->static_config;
+
+    memset(sig, 0, sizeof(*sig));
+    sig->magic                = ANALYSIS_CACHE_MAGIC;
+    sig->version              = ANALYSIS_CACHE_VERSION;
+    sig->width                = scs_ptr->max_input_luma_width;
+    sig->height               = scs_ptr->max_input_luma_height;
+    sig->sb_sz                = scs_ptr->sb_sz;
+    sig->enc_mode             = config->enc_mode;
+    sig->pred_structure       = config->pred_structure;
+    sig->hierarchical_levels  = config->hierarchical_levels;
+    sig->intra_period_length  = config->intra_period_length;
+    sig->intra_refresh_type   = config->intra_refresh_type;
+    sig->look_ahead_distance  = config->look_ahead_distance;
+    sig->scene_lad            = scs_ptr->scene_lad;
+    sig->enable_tpl_la        = config->enable_tpl_la;
+    sig->enable_global_motion = config->enable_global_motion;
+    sig->tf_level             = scs_ptr->tf_level;
+    sig->tf_low_qp            = scs_ptr->tf_level && config->qp <= ALT_REF_QP_THRESH;
+    sig->altref_strength      = config->altref_strength;
+    sig->altref_nframes       = config->altref_nframes;
+    sig->enable_overlays      = config->enable_overlays;
+    sig->superres_mode        = config->superres_mode;
+    sig->first_pass           = use_output_stat(scs_ptr);
+}
+
+static INLINE uint32_t sb_payload_max_size(uint32_t sb_sz) {
+    return sizeof(uint32_t) + MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH +
+        SQUARE_PU_COUNT * (1 + MAX_PA_ME_CAND * sizeof(MeCandidate) + MAX_PA_ME_MV * sizeof(MvCandidate)) +
+        (sb_sz / 16) * (sb_sz / 16) * sizeof(OisMbResults);
+}
+
+EbErrorType analysis_cache_ctor(AnalysisCache *cache_ptr, SequenceControlSet *scs_ptr,
+                                const char *path, AnalysisCacheMode mode) {
+    AnalysisCacheSignature signature;
+    AnalysisCacheSignature file_signature;
+    AnalysisCacheFooter    footer;
+    const uint32_t         pic_width_in_sb =
+        (scs_ptr->max_input_luma_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+    const uint32_t pic_height_in_sb =
+        (scs_ptr->max_input_luma_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+
+    cache_ptr->dctor = analysis_cache_dctor;
+    cache_ptr->mode  = mode;
+    EB_CREATE_MUTEX(cache_ptr->mutex);
+    EB_MALLOC_ARRAY(cache_ptr->sb_offset, pic_width_in_sb * pic_height_in_sb + 1);
+    cache_ptr->sb_row_buffer_size = pic_width_in_sb * sb_payload_max_size(scs_ptr->sb_sz);
+    EB_MALLOC_ARRAY(cache_ptr->buffer, cache_ptr->sb_row_buffer_size);
+
+    analysis_cache_signature(scs_ptr, &signature);
+    FOPEN(cache_ptr->file, path, mode == ANALYSIS_CACHE_WRITE ? "wb" : "rb");
+    if (!cache_ptr->file) {
+        SVT_ERROR("Unable to open the analysis cache file %s\n", path);
+        return EB_ErrorBadParameter;
+    }
+    if (mode == ANALYSIS_CACHE_WRITE) {
+        if (fwrite(&signature, sizeof(signature), 1, cache_ptr->file) != 1) {
+            SVT_ERROR("Failed to write the analysis cache file %s\n", path);
+            return EB_ErrorInsufficientResources;
+        }
+        return EB_ErrorNone;
+    }
+
+    if (fread(&file_signature, sizeof(file_signature), 1, cache_ptr->file) != 1 ||
+        file_signature.magic != ANALYSIS_CACHE_MAGIC ||
+        fseeko(cache_ptr->file, -(int64_t)sizeof(footer), SEEK_END) ||
+        fread(&footer, sizeof(footer), 1, cache_ptr->file) != 1 ||
+        footer.magic != ANALYSIS_CACHE_MAGIC) {
+        SVT_ERROR("%s is not a complete analysis cache file\n", path);
+        return EB_ErrorBadParameter;
+    }
+    // The index sits between the records and the footer
+    const uint64_t file_size = (uint64_t)ftello(cache_ptr->file);
+    if (footer.index_offset < sizeof(signature) || footer.index_offset > file_size - sizeof(footer) ||
+        (file_size - footer.index_offset - sizeof(footer)) / sizeof(*cache_ptr->index) !=
+            footer.index_count ||
+        (file_size - footer.index_offset - sizeof(footer)) % sizeof(*cache_ptr->index)) {
+        SVT_ERROR("The analysis cache index of %s is corrupted\n", path);
+        return EB_ErrorBadParameter;
+    }
+    cache_ptr->records_end = footer.index_offset;
+    if (memcmp(&file_signature, &signature, sizeof(signature))) {
+        SVT_ERROR("The analysis cache file %s was produced with different encoder settings\n",
+                  path);
+        return EB_ErrorBadParameter;
+    }
+
+    // Record offsets by picture number
+    EB_MALLOC_ARRAY(cache_ptr->index, MAX(footer.index_count, 1));
+    if (fseeko(cache_ptr->file, (int64_t)footer.index_offset, SEEK_SET) ||
+        fread(cache_ptr->index, sizeof(*cache_ptr->index), footer.index_count, cache_ptr->file) !=
+            footer.index_count) {
+        SVT_ERROR("Failed to read the analysis cache index of %s\n", path);
+        return EB_ErrorBadParameter;
+    }
+    // Every picture, and overlay, has one record, so the picture numbers
+    // are below the record count
+    cache_ptr->picture_count = footer.index_count;
+    EB_CALLOC_ARRAY(cache_ptr->record_offset[0], MAX(cache_ptr->picture_count, 1));
+    EB_CALLOC_ARRAY(cache_ptr->record_offset[1], MAX(cache_ptr->picture_count, 1));
+    for (uint32_t i = 0; i < footer.index_count; ++i) {
+        const AnalysisCacheIndexEntry *entry = &cache_ptr->index[i];
+        if (entry->picture_number >= cache_ptr->picture_count || entry->is_overlay > 1 ||
+            entry->reserved || entry->offset < sizeof(signature) ||
+            entry->offset > footer.index_offset ||
+            footer.index_offset - entry->offset < sizeof(AnalysisCacheRecordHeader) ||
+            cache_ptr->record_offset[entry->is_overlay][entry->picture_number]) {
+            SVT_ERROR("The analysis cache index of %s is corrupted\n", path);
+            return EB_ErrorBadParameter;
+        }
+        cache_ptr->record_offset[entry->is_overlay][entry->picture_number] = entry->offset;
+    }
+    EB_FREE_ARRAY(cache_ptr->index);
+    return EB_ErrorNone;
+}
+
+// Record header fields of the picture as it is being encoded, the global
+// motion is left out
+static void analysis_cache_record_header(PictureParentControlSet *  pcs_ptr,
+                                         AnalysisCacheRecordHeader *header) {
+    SequenceControlSet *scs_ptr          = pcs_ptr->scs_ptr;
+    const uint32_t      pic_width_in_sb  = (pcs_ptr->aligned_width + scs_ptr->sb_sz - 1) /
+        scs_ptr->sb_sz;
+    const uint32_t      pic_height_in_sb = (pcs_ptr->aligned_height + scs_ptr->sb_sz - 1) /
+        scs_ptr->sb_sz;
+
+    memset(header, 0, sizeof(*header));
+    header->picture_number = pcs_ptr->picture_number;
+    header->is_overlay     = pcs_ptr->is_overlay;
+    header->sb_count       = pic_width_in_sb * pic_height_in_sb;
+    header->pu_count       = pcs_ptr->max_number_of_pus_per_sb;
+    header->has_me         = pcs_ptr->slice_type != I_SLICE && !scs_ptr->in_loop_me;
+    header->has_ois        = scs_ptr->static_config.look_ahead_distance != 0 &&
+        scs_ptr->static_config.enable_tpl_la && pcs_ptr->ois_mb_results;
+    if (header->has_me) {
+        header->mv_count[REF_LIST_0] = pcs_ptr->ref_list0_count_try;
+        header->mv_count[REF_LIST_1] =
+            pcs_ptr->slice_type == B_SLICE ? pcs_ptr->ref_list1_count_try : 0;
+    }
+}
+
+// 16x16 block area of an SB, in units of 16x16 blocks
+static void analysis_cache_sb_mb_area(PictureParentControlSet *pcs_ptr, uint32_t sb_index,
+                                      uint32_t *mb_x0, uint32_t *mb_y0, uint32_t *mb_x1,
+                                      uint32_t *mb_y1) {
+    SequenceControlSet *scs_ptr         = pcs_ptr->scs_ptr;
+    const uint32_t      pic_width_in_sb = (pcs_ptr->aligned_width + scs_ptr->sb_sz - 1) /
+        scs_ptr->sb_sz;
+    const uint32_t mb_cols = (scs_ptr->seq_header.max_frame_width + 15) / 16;
+    const uint32_t mb_rows = (scs_ptr->seq_header.max_frame_height + 15) / 16;
+
+    *mb_x0 = (sb_index % pic_width_in_sb) * scs_ptr->sb_sz / 16;
+    *mb_y0 = (sb_index / pic_width_in_sb) * scs_ptr->sb_sz / 16;
+    *mb_x1 = MIN(*mb_x0 + scs_ptr->sb_sz / 16, mb_cols);
+    *mb_y1 = MIN(*mb_y0 + scs_ptr->sb_sz / 16, mb_rows);
+}
+
+static uint32_t analysis_cache_sb_size(PictureParentControlSet *        pcs_ptr,
+                                       const AnalysisCacheRecordHeader *header,
+                                       uint32_t                         sb_index) {
+    uint32_t size = 0;
+
+    if (header->has_me) {
+        const MeSbResults *me_results = pcs_ptr->pa_me_data->me_results[sb_index];
+        size += sizeof(uint32_t) + sizeof(me_results->do_comp);
+        for (uint32_t pu_index = 0; pu_index < header->pu_count; ++pu_index)
+            size += 1 + me_results->total_me_candidate_index[pu_index] * sizeof(MeCandidate);
+        size += header->pu_count * (header->mv_count[REF_LIST_0] + header->mv_count[REF_LIST_1]) *
+            sizeof(MvCandidate);
+    }
+    if (header->has_ois) {
+        uint32_t mb_x0, mb_y0, mb_x1, mb_y1;
+        analysis_cache_sb_mb_area(pcs_ptr, sb_index, &mb_x0, &mb_y0, &mb_x1, &mb_y1);
+        size += (mb_x1 - mb_x0) * (mb_y1 - mb_y0) * sizeof(OisMbResults);
+    }
+    return size;
+}
+
+static uint8_t *analysis_cache_pack_sb(PictureParentControlSet *        pcs_ptr,
+                                       const AnalysisCacheRecordHeader *header,
+                                       uint32_t sb_index, uint8_t *dst) {
+    if (header->has_me) {
+        const MeSbResults *me_results = pcs_ptr->pa_me_data->me_results[sb_index];
+        EB_MEMCPY(dst, &pcs_ptr->rc_me_distortion[sb_index], sizeof(uint32_t));
+        dst += sizeof(uint32_t);
+        EB_MEMCPY(dst, me_results->do_comp, sizeof(me_results->do_comp));
+        dst += sizeof(me_results->do_comp);
+        for (uint32_t pu_index = 0; pu_index < header->pu_count; ++pu_index) {
+            const uint8_t      count = me_results->total_me_candidate_index[pu_index];
+            const MvCandidate *mv    = &me_results->me_mv_array[pu_index * MAX_PA_ME_MV];
+            *dst++                   = count;
+            EB_MEMCPY(dst,
+                      &me_results->me_candidate_array[pu_index * MAX_PA_ME_CAND],
+                      count * sizeof(MeCandidate));
+            dst += count * sizeof(MeCandidate);
+            EB_MEMCPY(dst, mv, header->mv_count[REF_LIST_0] * sizeof(MvCandidate));
+            dst += header->mv_count[REF_LIST_0] * sizeof(MvCandidate);
+            EB_MEMCPY(dst, mv + 4, header->mv_count[REF_LIST_1] * sizeof(MvCandidate));
+            dst += header->mv_count[REF_LIST_1] * sizeof(MvCandidate);
+        }
+    }
+    if (header->has_ois) {
+        const uint32_t mb_stride = (pcs_ptr->scs_ptr->seq_header.max_frame_width + 15) / 16;
+        uint32_t       mb_x0, mb_y0, mb_x1, mb_y1;
+        analysis_cache_sb_mb_area(pcs_ptr, sb_index, &mb_x0, &mb_y0, &mb_x1, &mb_y1);
+        for (uint32_t mb_y = mb_y0; mb_y < mb_y1; ++mb_y)
+            for (uint32_t mb_x = mb_x0; mb_x < mb_x1; ++mb_x) {
+                EB_MEMCPY(dst, pcs_ptr->ois_mb_results[mb_y * mb_stride + mb_x], sizeof(OisMbResults));
+                dst += sizeof(OisMbResults);
+            }
+    }
+    return dst;
+}
+
+// A candidate may only refer to the MVs stored for the picture
+static EbBool analysis_cache_valid_candidate(const AnalysisCacheRecordHeader *header,
+                                             const MeCandidate *              cand) {
+    if (cand->direction > 2) return EB_FALSE;
+    if (cand->direction != 1 && cand->ref_idx_l0 >= header->mv_count[cand->ref0_list])
+        return EB_FALSE;
+    if (cand->direction != 0 && cand->ref_idx_l1 >= header->mv_count[cand->ref1_list])
+        return EB_FALSE;
+    return EB_TRUE;
+}
+
+// Returns EB_FALSE when the SB payload [src, end) is not a valid SB of the
+// picture, the results of the SB are then partially overwritten
+static EbBool analysis_cache_unpack_sb(PictureParentControlSet *        pcs_ptr,
+                                       const AnalysisCacheRecordHeader *header, uint32_t sb_index,
+                                       const uint8_t *src, const uint8_t *end) {
+    const size_t mv_size = (header->mv_count[REF_LIST_0] + header->mv_count[REF_LIST_1]) *
+        sizeof(MvCandidate);
+
+    if (header->has_me) {
+        MeSbResults *me_results = pcs_ptr->pa_me_data->me_results[sb_index];
+        if ((size_t)(end - src) < sizeof(uint32_t) + sizeof(me_results->do_comp)) return EB_FALSE;
+        EB_MEMCPY(&pcs_ptr->rc_me_distortion[sb_index], src, sizeof(uint32_t));
+        src += sizeof(uint32_t);
+        EB_MEMCPY(me_results->do_comp, src, sizeof(me_results->do_comp));
+        src += sizeof(me_results->do_comp);
+        for (uint32_t pu_index = 0; pu_index < header->pu_count; ++pu_index) {
+            if (src == end) return EB_FALSE;
+            const uint8_t count = *src++;
+            MvCandidate * mv    = &me_results->me_mv_array[pu_index * MAX_PA_ME_MV];
+            MeCandidate * cand  = &me_results->me_candidate_array[pu_index * MAX_PA_ME_CAND];
+            if (count > MAX_PA_ME_CAND ||
+                (size_t)(end - src) < count * sizeof(MeCandidate) + mv_size)
+                return EB_FALSE;
+            me_results->total_me_candidate_index[pu_index] = count;
+            EB_MEMCPY(cand, src, count * sizeof(MeCandidate));
+            src += count * sizeof(MeCandidate);
+            for (uint32_t i = 0; i < count; ++i)
+                if (!analysis_cache_valid_candidate(header, &cand[i])) return EB_FALSE;
+            EB_MEMCPY(mv, src, header->mv_count[REF_LIST_0] * sizeof(MvCandidate));
+            src += header->mv_count[REF_LIST_0] * sizeof(MvCandidate);
+            EB_MEMCPY(mv + 4, src, header->mv_count[REF_LIST_1] * sizeof(MvCandidate));
+            src += header->mv_count[REF_LIST_1] * sizeof(MvCandidate);
+        }
+    }
+    if (header->has_ois) {
+        const uint32_t mb_stride = (pcs_ptr->scs_ptr->seq_header.max_frame_width + 15) / 16;
+        uint32_t       mb_x0, mb_y0, mb_x1, mb_y1;
+        analysis_cache_sb_mb_area(pcs_ptr, sb_index, &mb_x0, &mb_y0, &mb_x1, &mb_y1);
+        if ((size_t)(end - src) != (mb_x1 - mb_x0) * (mb_y1 - mb_y0) * sizeof(OisMbResults))
+            return EB_FALSE;
+        for (uint32_t mb_y = mb_y0; mb_y < mb_y1; ++mb_y)
+            for (uint32_t mb_x = mb_x0; mb_x < mb_x1; ++mb_x) {
+                EB_MEMCPY(pcs_ptr->ois_mb_results[mb_y * mb_stride + mb_x], src, sizeof(OisMbResults));
+                src += sizeof(OisMbResults);
+            }
+    }
+    return src == end;
+}
+
+static EbErrorType analysis_cache_grow_index(AnalysisCache *cache_ptr) {
+    const uint32_t index_size = MAX(2 * cache_ptr->index_size, 64);
+    EB_REALLOC_ARRAY(cache_ptr->index, index_size);
+    cache_ptr->index_size = index_size;
+    return EB_ErrorNone;
+}
+
+/************************************************
+ * Append the ME and OIS results of a picture, called once all its ME
+ * segments are done
+ ************************************************/
+EbErrorType analysis_cache_store_picture(AnalysisCache *cache_ptr, PictureParentControlSet *pcs_ptr) {
+    AnalysisCacheRecordHeader header;
+    EbErrorType               return_error = EB_ErrorNone;
+
+    analysis_cache_record_header(pcs_ptr, &header);
+    for (uint32_t li = 0; li < MAX_NUM_OF_REF_PIC_LIST; ++li)
+        for (uint32_t ri = 0; ri < REF_LIST_MAX_DEPTH; ++ri) {
+            header.is_global_motion[li][ri] = (uint8_t)pcs_ptr->is_global_motion[li][ri];
+            header.global_motion[li][ri]    = pcs_ptr->global_motion_estimation[li][ri];
+        }
+
+    eb_block_on_mutex(cache_ptr->mutex);
+    if (cache_ptr->index_count == cache_ptr->index_size) {
+        return_error = analysis_cache_grow_index(cache_ptr);
+        if (return_error != EB_ErrorNone) {
+            eb_release_mutex(cache_ptr->mutex);
+            SVT_ERROR("Failed to grow the analysis cache index\n");
+            return return_error;
+        }
+    }
+    AnalysisCacheIndexEntry *entry = &cache_ptr->index[cache_ptr->index_count];
+    entry->picture_number          = pcs_ptr->picture_number;
+    entry->is_overlay              = pcs_ptr->is_overlay;
+    entry->reserved                = 0;
+    entry->offset                  = (uint64_t)ftello(cache_ptr->file);
+
+    cache_ptr->sb_offset[0] = 0;
+    for (uint32_t sb_index = 0; sb_index < header.sb_count; ++sb_index)
+        cache_ptr->sb_offset[sb_index + 1] =
+            cache_ptr->sb_offset[sb_index] + analysis_cache_sb_size(pcs_ptr, &header, sb_index);
+    EbBool ok = header.pu_count <= SQUARE_PU_COUNT &&
+        fwrite(&header, sizeof(header), 1, cache_ptr->file) == 1 &&
+        fwrite(cache_ptr->sb_offset, sizeof(uint32_t), header.sb_count + 1, cache_ptr->file) ==
+            header.sb_count + 1;
+    for (uint32_t sb_index = 0; ok && sb_index < header.sb_count; ++sb_index) {
+        const size_t size = (size_t)(
+            analysis_cache_pack_sb(pcs_ptr, &header, sb_index, cache_ptr->buffer) -
+            cache_ptr->buffer);
+        ok = fwrite(cache_ptr->buffer, 1, size, cache_ptr->file) == size;
+    }
+    if (ok)
+        cache_ptr->index_count++;
+    else {
+        SVT_ERROR("Failed to write picture %d to the analysis cache\n", (int)pcs_ptr->picture_number);
+        return_error = EB_ErrorInsufficientResources;
+    }
+    eb_release_mutex(cache_ptr->mutex);
+    return return_error;
+}
+
+// The record header must describe the picture as it is being encoded
+static EbBool analysis_cache_valid_header(const AnalysisCacheRecordHeader *header,
+                                          const AnalysisCacheRecordHeader *expected) {
+    if (header->picture_number != expected->picture_number ||
+        header->is_overlay != expected->is_overlay || header->sb_count != expected->sb_count ||
+        header->pu_count != expected->pu_count || header->pu_count > SQUARE_PU_COUNT ||
+        header->has_me != expected->has_me || header->has_ois != expected->has_ois ||
+        header->mv_count[REF_LIST_0] != expected->mv_count[REF_LIST_0] ||
+        header->mv_count[REF_LIST_1] != expected->mv_count[REF_LIST_1] ||
+        header->mv_count[REF_LIST_0] > 4 || header->mv_count[REF_LIST_1] > MAX_PA_ME_MV - 4)
+        return EB_FALSE;
+    for (uint32_t li = 0; li < MAX_NUM_OF_REF_PIC_LIST; ++li)
+        for (uint32_t ri = 0; ri < REF_LIST_MAX_DEPTH; ++ri)
+            if (header->is_global_motion[li][ri] > 1 ||
+                header->global_motion[li][ri].wmtype >= TRANS_TYPES)
+                return EB_FALSE;
+    return EB_TRUE;
+}
+
+// The SB payloads must be in order, fit an SB and end before the index
+static EbBool analysis_cache_valid_sb_offsets(const AnalysisCache *cache_ptr,
+                                              const uint32_t *sb_offset, uint32_t sb_count,
+                                              uint32_t sb_sz, uint64_t payload_offset) {
+    const uint32_t max_size = sb_payload_max_size(sb_sz);
+
+    if (sb_offset[0] != 0) return EB_FALSE;
+    for (uint32_t sb_index = 0; sb_index < sb_count; ++sb_index)
+        if (sb_offset[sb_index + 1] < sb_offset[sb_index] ||
+            sb_offset[sb_index + 1] - sb_offset[sb_index] > max_size)
+            return EB_FALSE;
+    return payload_offset <= cache_ptr->records_end &&
+        sb_offset[sb_count] <= cache_ptr->records_end - payload_offset;
+}
+
+/************************************************
+ * Load the ME and OIS results of the SBs of a ME segment. Returns EB_FALSE
+ * when the picture is not in the cache, the segment is then analysed as
+ * usual. A record that does not match the picture rejects the whole cache.
+ ************************************************/
+EbBool analysis_cache_load_segment(AnalysisCache *cache_ptr, PictureParentControlSet *pcs_ptr,
+                                   EbBool load_global_motion, uint32_t x_sb_start_index,
+                                   uint32_t x_sb_end_index, uint32_t y_sb_start_index,
+                                   uint32_t y_sb_end_index) {
+    AnalysisCacheRecordHeader expected;
+    AnalysisCacheRecordHeader header;
+
+    if (cache_ptr->rejected || pcs_ptr->picture_number >= cache_ptr->picture_count)
+        return EB_FALSE;
+    const uint64_t offset =
+        cache_ptr->record_offset[pcs_ptr->is_overlay ? 1 : 0][pcs_ptr->picture_number];
+    if (!offset) return EB_FALSE;
+    analysis_cache_record_header(pcs_ptr, &expected);
+    const uint32_t pic_width_in_sb = (pcs_ptr->aligned_width + pcs_ptr->scs_ptr->sb_sz - 1) /
+        pcs_ptr->scs_ptr->sb_sz;
+    const uint64_t payload_offset = offset + sizeof(header) +
+        (expected.sb_count + 1) * sizeof(uint32_t);
+
+    eb_block_on_mutex(cache_ptr->mutex);
+    if (cache_ptr->rejected) {
+        eb_release_mutex(cache_ptr->mutex);
+        return EB_FALSE;
+    }
+    EbBool ok = !fseeko(cache_ptr->file, (int64_t)offset, SEEK_SET) &&
+        fread(&header, sizeof(header), 1, cache_ptr->file) == 1 &&
+        analysis_cache_valid_header(&header, &expected) &&
+        fread(cache_ptr->sb_offset, sizeof(uint32_t), header.sb_count + 1, cache_ptr->file) ==
+            header.sb_count + 1 &&
+        analysis_cache_valid_sb_offsets(
+            cache_ptr, cache_ptr->sb_offset, header.sb_count, pcs_ptr->scs_ptr->sb_sz, payload_offset);
+    for (uint32_t y_sb_index = y_sb_start_index; ok && y_sb_index < y_sb_end_index; ++y_sb_index) {
+        // The SBs of a segment row are contiguous in the record
+        const uint32_t first = y_sb_index * pic_width_in_sb + x_sb_start_index;
+        const uint32_t end   = y_sb_index * pic_width_in_sb + x_sb_end_index;
+        const uint32_t size  = cache_ptr->sb_offset[end] - cache_ptr->sb_offset[first];
+        ok = size <= cache_ptr->sb_row_buffer_size &&
+            !fseeko(cache_ptr->file,
+                    (int64_t)(payload_offset + cache_ptr->sb_offset[first]),
+                    SEEK_SET) &&
+            fread(cache_ptr->buffer, 1, size, cache_ptr->file) == size;
+        for (uint32_t sb_index = first; ok && sb_index < end; ++sb_index)
+            ok = analysis_cache_unpack_sb(
+                pcs_ptr,
+                &header,
+                sb_index,
+                cache_ptr->buffer + cache_ptr->sb_offset[sb_index] - cache_ptr->sb_offset[first],
+                cache_ptr->buffer + cache_ptr->sb_offset[sb_index + 1] -
+                    cache_ptr->sb_offset[first]);
+    }
+    if (ok && load_global_motion)
+        for (uint32_t li = 0; li < MAX_NUM_OF_REF_PIC_LIST; ++li)
+            for (uint32_t ri = 0; ri < REF_LIST_MAX_DEPTH; ++ri) {
+                pcs_ptr->is_global_motion[li][ri]         = (EbBool)header.is_global_motion[li][ri];
+                pcs_ptr->global_motion_estimation[li][ri] = header.global_motion[li][ri];
+            }
+    if (!ok) {
+        cache_ptr->rejected = EB_TRUE;
+        SVT_WARN("Picture %d does not match the analysis cache, the cache is no longer used\n",
+                 (int)pcs_ptr->picture_number);
+    }
+    eb_release_mutex(cache_ptr->mutex);
+    return ok;
+}
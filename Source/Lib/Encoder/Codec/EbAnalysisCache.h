@@ -0,0 +1,112 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAnalysisCache_h
+#define EbAnalysisCache_h
+
+#include <stdio.h>
+#include "EbDefinitions.h"
+#include "EbObject.h"
+#include "EbSequenceControlSet.h"
+#include "EbPictureControlSet.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum AnalysisCacheMode {
+    ANALYSIS_CACHE_OFF   = 0,
+    ANALYSIS_CACHE_WRITE = 1,
+    ANALYSIS_CACHE_READ  = 2
+} AnalysisCacheMode;
+
+/**************************************
+     * Analysis cache signature
+     **************************************/
+// The settings the open loop analysis depends on. A cache is only read back
+// by an encode with the same signature, the QP and rate control targets are
+// free to change
+typedef struct AnalysisCacheSignature {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t sb_sz;
+    int32_t  enc_mode;
+    uint32_t pred_structure;
+    uint32_t hierarchical_levels;
+    int32_t  intra_period_length;
+    uint32_t intra_refresh_type;
+    uint32_t look_ahead_distance;
+    uint32_t scene_lad;
+    uint32_t enable_tpl_la;
+    uint32_t enable_global_motion;
+    int32_t  tf_level;
+    uint32_t tf_low_qp; // the temporal filter strength depends on the QP class
+    uint32_t altref_strength;
+    uint32_t altref_nframes;
+    uint32_t enable_overlays;
+    uint32_t superres_mode;
+    uint32_t first_pass;
+} AnalysisCacheSignature;
+
+typedef struct AnalysisCacheIndexEntry {
+    uint64_t picture_number;
+    uint32_t is_overlay;
+    uint32_t reserved;
+    uint64_t offset;
+} AnalysisCacheIndexEntry;
+
+/**************************************
+     * Analysis cache
+     **************************************/
+// Per picture motion estimation and open loop intra search results, kept in
+// a file so that re-encodes of the same source at other QPs can skip them.
+// Pictures are written by initial rate control once all their ME segments
+// are done, and read back per ME segment.
+typedef struct AnalysisCache {
+    EbDctor           dctor;
+    AnalysisCacheMode mode;
+    FILE *            file;
+    EbHandle          mutex;
+    // Write: records written so far
+    AnalysisCacheIndexEntry *index;
+    uint32_t                 index_count;
+    uint32_t                 index_size;
+    // Read: record offset of each picture number, [is_overlay], 0 when absent
+    uint64_t *record_offset[2];
+    uint64_t  picture_count;
+    // Read: end of the records, and set once a record failed the validation
+    uint64_t records_end;
+    EbBool   rejected;
+    // SB offset table and serialized SBs of one SB row
+    uint32_t *sb_offset;
+    uint8_t * buffer;
+    uint32_t  sb_row_buffer_size;
+} AnalysisCache;
+
+/**************************************
+     * Extern Function Declarations
+     **************************************/
+extern EbErrorType analysis_cache_ctor(AnalysisCache *cache_ptr, SequenceControlSet *scs_ptr,
+                                       const char *path, AnalysisCacheMode mode);
+
+extern EbErrorType analysis_cache_store_picture(AnalysisCache *          cache_ptr,
+                                                PictureParentControlSet *pcs_ptr);
+
+extern EbBool analysis_cache_load_segment(AnalysisCache *cache_ptr, PictureParentControlSet *pcs_ptr,
+                                          EbBool   load_global_motion,
+                                          uint32_t x_sb_start_index, uint32_t x_sb_end_index,
+                                          uint32_t y_sb_start_index, uint32_t y_sb_end_index);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbAnalysisCache_h
@@ -21,6 +21,7 @@
 #include "grainSynthesis.h"
 //To fix warning C4013: 'convert_16bit_to_8bit' undefined; assuming extern returning int
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #include "EbRateDistortionCost.h"
 #include "EbPictureDecisionProcess.h"
 #include "firstpass.h"
@@ -651,14 +652,15 @@ static double similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s,
 
 static double ssim_8x8(const uint8_t *s, int sp, const uint8_t *r, int rp) {
   uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-  aom_ssim_parms_8x8_c(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
+  aom_ssim_parms_8x8(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
   return similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 8);
 }
 
 static double highbd_ssim_8x8(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r,
                               int rp, uint32_t bd, uint32_t shift) {
   uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-  aom_highbd_ssim_parms_8x8_c(s, sp, sinc, spinc, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
+  aom_highbd_ssim_parms_8x8(
+      s, sp, sinc, spinc, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
   return similarity(sum_s >> shift, sum_r >> shift, sum_sq_s >> (2 * shift),
                     sum_sq_r >> (2 * shift), sum_sxr >> (2 * shift), 64, bd);
 }
@@ -964,6 +966,26 @@ void ssim_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
 
 }
 
+// Sum of squared errors of an 8-bit plane. The plane is walked in 64x64
+// blocks so the SIMD kernel's 32-bit lane accumulators cannot overflow; the
+// columns right of the last full 64-wide block use the C kernel.
+static uint64_t plane_sse(const uint8_t *a, int a_stride, const uint8_t *b, int b_stride,
+                          int width, int height) {
+    const int width64 = width & ~63;
+    uint64_t  sse     = 0;
+
+    for (int y = 0; y < height; y += 64) {
+        const int h = AOMMIN(64, height - y);
+        for (int x = 0; x < width64; x += 64)
+            sse += eb_aom_sse(a + x, a_stride, b + x, b_stride, 64, h);
+        if (width > width64)
+            sse += eb_aom_sse_c(a + width64, a_stride, b + width64, b_stride, width - width64, h);
+        a += a_stride * h;
+        b += b_stride * h;
+    }
+    return sse;
+}
+
 void psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr, EbBool free_memory) {
     EbBool is_16bit = (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
@@ -984,7 +1006,6 @@ void psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
             (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_unscaled_picture_ptr;
 
         uint64_t sse_total[3] = {0};
-        uint64_t residual_distortion = 0;
         EbByte   input_buffer;
         EbByte   recon_coeff_buffer;
 
@@ -1009,23 +1030,12 @@ void psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
         input_buffer = &(buffer_y[input_picture_ptr->origin_x +
                                   input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
 
-        residual_distortion = 0;
-
-        for (int row_index = 0;
-             row_index < input_picture_ptr->height - scs_ptr->max_input_pad_bottom;
-             ++row_index) {
-            for (int column_index = 0;
-                 column_index < input_picture_ptr->width - scs_ptr->max_input_pad_right;
-                 ++column_index) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-            }
-
-            input_buffer += input_picture_ptr->stride_y;
-            recon_coeff_buffer += recon_ptr->stride_y;
-        }
-
-        sse_total[0] = residual_distortion;
+        sse_total[0] = plane_sse(input_buffer,
+                                 input_picture_ptr->stride_y,
+                                 recon_coeff_buffer,
+                                 recon_ptr->stride_y,
+                                 input_picture_ptr->width - scs_ptr->max_input_pad_right,
+                                 input_picture_ptr->height - scs_ptr->max_input_pad_bottom);
 
         recon_coeff_buffer =
             &((recon_ptr->buffer_cb)[recon_ptr->origin_x / 2 +
@@ -1033,45 +1043,30 @@ void psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
         input_buffer = &(buffer_cb[input_picture_ptr->origin_x / 2 +
                                    input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
 
-        residual_distortion = 0;
-        for (int row_index = 0; row_index <
-             (input_picture_ptr->height - scs_ptr->max_input_pad_bottom) >> ss_y;
-             ++row_index) {
-            for (int column_index = 0; column_index <
-                 (input_picture_ptr->width - scs_ptr->max_input_pad_right) >> ss_x;
-                 ++column_index) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-            }
-
-            input_buffer += input_picture_ptr->stride_cb;
-            recon_coeff_buffer += recon_ptr->stride_cb;
-        }
-
-        sse_total[1] = residual_distortion;
+        const int32_t width_uv =
+            (input_picture_ptr->width - scs_ptr->max_input_pad_right) >> ss_x;
+        const int32_t height_uv =
+            (input_picture_ptr->height - scs_ptr->max_input_pad_bottom) >> ss_y;
+        sse_total[1] = plane_sse(input_buffer,
+                                 input_picture_ptr->stride_cb,
+                                 recon_coeff_buffer,
+                                 recon_ptr->stride_cb,
+                                 width_uv,
+                                 height_uv);
 
         recon_coeff_buffer =
             &((recon_ptr->buffer_cr)[recon_ptr->origin_x / 2 +
                                      recon_ptr->origin_y / 2 * recon_ptr->stride_cr]);
         input_buffer        = &(buffer_cr[input_picture_ptr->origin_x / 2 +
                                    input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-        residual_distortion = 0;
-
-        for (int row_index = 0; row_index <
-             (input_picture_ptr->height - scs_ptr->max_input_pad_bottom) >> ss_y;
-             ++row_index) {
-            for (int column_index = 0; column_index <
-                 (input_picture_ptr->width - scs_ptr->max_input_pad_right) >> ss_x;
-                 ++column_index) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-            }
 
-            input_buffer += input_picture_ptr->stride_cr;
-            recon_coeff_buffer += recon_ptr->stride_cr;
-        }
+        sse_total[2] = plane_sse(input_buffer,
+                                 input_picture_ptr->stride_cr,
+                                 recon_coeff_buffer,
+                                 recon_ptr->stride_cr,
+                                 width_uv,
+                                 height_uv);
 
-        sse_total[2]                      = residual_distortion;
         pcs_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sse_total[0];
         pcs_ptr->parent_pcs_ptr->cb_sse   = (uint32_t)sse_total[1];
         pcs_ptr->parent_pcs_ptr->cr_sse   = (uint32_t)sse_total[2];
@@ -2525,6 +2520,15 @@ EbErrorType signal_derivation_enc_dec_kernel_oq(
         context_ptr->spatial_sse_full_loop_level =
         sequence_control_set_ptr->static_config.spatial_sse_full_loop_level;
 
+    // md_pred_cache_enabled | Default Encoder Settings | Command Line Settings
+    //           0           | OFF                      | OFF
+    //           1           | ON                       | ON
+    if (sequence_control_set_ptr->static_config.enable_md_pred_cache == DEFAULT)
+        context_ptr->md_pred_cache_enabled = EB_TRUE;
+    else
+        context_ptr->md_pred_cache_enabled =
+        (EbBool)sequence_control_set_ptr->static_config.enable_md_pred_cache;
+
     if (context_ptr->chroma_level <= CHROMA_MODE_1)
         context_ptr->blk_skip_decision = EB_TRUE;
     else
@@ -4085,11 +4089,15 @@ void *mode_decision_kernel(void *input_ptr) {
         context_ptr->tot_intra_coded_area       = 0;
 
         memset(context_ptr->md_context->part_cnt, 0, sizeof(uint32_t) * SSEG_NUM * (NUMBER_OF_SHAPES-1) * FB_NUM);
-        generate_nsq_prob(pcs_ptr, context_ptr->md_context);
         memset(context_ptr->md_context->pred_depth_count, 0, sizeof(uint32_t) * DEPTH_DELTA_NUM * (NUMBER_OF_SHAPES-1));
-        generate_depth_prob(pcs_ptr, context_ptr->md_context);
         memset( context_ptr->md_context->txt_cnt, 0, sizeof(uint32_t) * TXT_DEPTH_DELTA_NUM * TX_TYPES);
-        generate_txt_prob(pcs_ptr, context_ptr->md_context);
+        // The analysis-only first pass skips mode decision, so the references carry no MD
+        // statistics
+        if (!use_analysis_only_first_pass(scs_ptr)) {
+            generate_nsq_prob(pcs_ptr, context_ptr->md_context);
+            generate_depth_prob(pcs_ptr, context_ptr->md_context);
+            generate_txt_prob(pcs_ptr, context_ptr->md_context);
+        }
 
         // Segment-loop
         while (assign_enc_dec_segments(segments_ptr,
@@ -4142,6 +4150,11 @@ void *mode_decision_kernel(void *input_ptr) {
                             .tile_group_sb_start_x;
                     sb_index = (uint16_t)((y_sb_index + tile_group_y_sb_start) * pic_width_in_sb +
                                           x_sb_index + tile_group_x_sb_start);
+                    // The analysis-only first pass stats are produced by the ME process
+                    if (use_analysis_only_first_pass(scs_ptr)) {
+                        context_ptr->coded_sb_count++;
+                        continue;
+                    }
                     if (use_output_stat(scs_ptr) && sb_index == 0)
                         setup_firstpass_data(pcs_ptr->parent_pcs_ptr);
                     sb_ptr = context_ptr->md_context->sb_ptr = pcs_ptr->sb_ptr_array[sb_index];
@@ -4208,17 +4221,34 @@ void *mode_decision_kernel(void *input_ptr) {
                                     AVG_CDF_WEIGHT_TOP);
                             }
                         }
+                        // The rate table of this thread can be updated incrementally only if
+                        // it was last built for the same picture. An overlay shares the
+                        // picture_number of its ALTREF but has its own picture_number_alt
+                        // and frame header
+                        ModeDecisionContext *md_ctx = context_ptr->md_context;
+                        const EbBool         same_picture =
+                            md_ctx->rate_est_fc_valid &&
+                            md_ctx->rate_est_picture_number_alt ==
+                                pcs_ptr->parent_pcs_ptr->picture_number_alt;
+                        const FRAME_CONTEXT *prev_fc = same_picture ? md_ctx->rate_est_fc : NULL;
                         // Initial Rate Estimation of the syntax elements
-                        av1_estimate_syntax_rate(&context_ptr->md_context->rate_est_table,
-                            pcs_ptr->slice_type == I_SLICE,
-                            &pcs_ptr->ec_ctx_array[sb_index]);
+                        av1_estimate_syntax_rate(&md_ctx->rate_est_table,
+                                                 pcs_ptr->slice_type == I_SLICE,
+                                                 &pcs_ptr->ec_ctx_array[sb_index],
+                                                 prev_fc);
                         // Initial Rate Estimation of the Motion vectors
                         av1_estimate_mv_rate(pcs_ptr,
-                            &context_ptr->md_context->rate_est_table,
-                            &pcs_ptr->ec_ctx_array[sb_index]);
-
-                        av1_estimate_coefficients_rate(&context_ptr->md_context->rate_est_table,
-                            &pcs_ptr->ec_ctx_array[sb_index]);
+                                             &md_ctx->rate_est_table,
+                                             &pcs_ptr->ec_ctx_array[sb_index],
+                                             prev_fc);
+
+                        av1_estimate_coefficients_rate(
+                            &md_ctx->rate_est_table, &pcs_ptr->ec_ctx_array[sb_index], prev_fc);
+                        // Keep the CDFs the table was built from for the next SB
+                        *md_ctx->rate_est_fc                = pcs_ptr->ec_ctx_array[sb_index];
+                        md_ctx->rate_est_picture_number_alt =
+                            pcs_ptr->parent_pcs_ptr->picture_number_alt;
+                        md_ctx->rate_est_fc_valid           = EB_TRUE;
 
                         //let the candidate point to the new rate table.
                         uint32_t cand_index;
@@ -6298,6 +6298,203 @@ void search_compound_diff_wedge(PictureControlSet *    picture_control_set_ptr,
                          context_ptr->diff10);
 }
 
+/*
+ * MD inter prediction cache
+ * A translational prediction without masks, OBMC or inter-intra depends only on the
+ * references, the MVs and the filters, as long as the MVs are not clamped to the block
+ * and the block is larger than 4 (4-tap filters are used otherwise). The prediction of
+ * such a block can be copied from any cached prediction of the same key covering it.
+ */
+void md_pred_cache_reset(ModeDecisionContext *md_context_ptr) {
+    for (uint32_t i = 0; i < MD_PRED_CACHE_ENTRIES; i++) md_context_ptr->pred_cache[i].valid = EB_FALSE;
+    md_context_ptr->pred_cache_pool_head = 0;
+    md_context_ptr->pred_cache_next      = 0;
+}
+
+static INLINE EbBool md_pred_cache_mv_unclamped(const MacroBlockD *xd, Mv mv, int32_t bw,
+                                                int32_t bh, int32_t ss) {
+    const MV src_mv = {mv.y, mv.x};
+    const MV mv_q4  = clamp_mv_to_umv_border_sb(xd, &src_mv, bw, bh, ss, ss);
+    return mv_q4.row == src_mv.row * (1 << (1 - ss)) && mv_q4.col == src_mv.col * (1 << (1 - ss));
+}
+
+/* Returns EB_TRUE when the prediction of the candidate only depends on the key:
+ * translational, without inter-intra or masked compound, and larger than 4 */
+EbBool md_pred_cache_candidate_eligible(const ModeDecisionCandidate *candidate_ptr,
+                                        const MvUnit *mv_unit, const BlockGeom *blk_geom) {
+    return candidate_ptr->motion_mode == SIMPLE_TRANSLATION && !candidate_ptr->is_interintra_used &&
+           blk_geom->bwidth > 4 && blk_geom->bheight > 4 &&
+           (mv_unit->pred_direction != BI_PRED ||
+            !is_masked_compound_type(candidate_ptr->interinter_comp.type));
+}
+
+void md_pred_cache_set_key(MdPredCacheEntry *key, const ModeDecisionCandidate *candidate_ptr,
+                           const MvUnit *mv_unit, uint8_t is16bit, uint16_t origin_x,
+                           uint16_t origin_y, const BlockGeom *blk_geom) {
+    key->is16bit        = is16bit;
+    key->pred_direction = mv_unit->pred_direction;
+    key->ref_frame_type = candidate_ptr->ref_frame_type;
+    key->ref_idx_l0     = mv_unit->pred_direction != UNI_PRED_LIST_1 ? candidate_ptr->ref_frame_index_l0 : -1;
+    key->ref_idx_l1     = mv_unit->pred_direction != UNI_PRED_LIST_0 ? candidate_ptr->ref_frame_index_l1 : -1;
+    key->compound_idx   = mv_unit->pred_direction == BI_PRED ? candidate_ptr->compound_idx : 0;
+    key->interp_filters = candidate_ptr->interp_filters;
+    key->mv[0].mv_union = key->ref_idx_l0 >= 0 ? mv_unit->mv[REF_LIST_0].mv_union : 0;
+    key->mv[1].mv_union = key->ref_idx_l1 >= 0 ? mv_unit->mv[REF_LIST_1].mv_union : 0;
+    key->origin_x       = origin_x;
+    key->origin_y       = origin_y;
+    key->bwidth         = blk_geom->bwidth;
+    key->bheight        = blk_geom->bheight;
+}
+
+static INLINE EbBool md_pred_cache_same_key(const MdPredCacheEntry *a, const MdPredCacheEntry *b) {
+    return a->is16bit == b->is16bit && a->pred_direction == b->pred_direction &&
+           a->ref_frame_type == b->ref_frame_type && a->ref_idx_l0 == b->ref_idx_l0 &&
+           a->ref_idx_l1 == b->ref_idx_l1 && a->compound_idx == b->compound_idx &&
+           a->interp_filters == b->interp_filters && a->mv[0].mv_union == b->mv[0].mv_union &&
+           a->mv[1].mv_union == b->mv[1].mv_union;
+}
+
+static void md_pred_cache_copy_plane(uint8_t *src, uint32_t src_stride, uint8_t *dst,
+                                     uint32_t dst_stride, uint32_t width, uint32_t height,
+                                     uint8_t is16bit) {
+    for (uint32_t i = 0; i < height; i++)
+        eb_memcpy(dst + ((i * dst_stride) << is16bit),
+                  src + ((i * src_stride) << is16bit),
+                  width << is16bit);
+}
+
+/* Copy the prediction of the block from a cached entry covering it.
+ * Returns EB_FALSE on a miss. */
+EbBool md_pred_cache_fetch(ModeDecisionContext *md_context_ptr, const MdPredCacheEntry *key,
+                           EbBool perform_chroma, EbPictureBufferDesc *prediction_ptr) {
+    const BlockGeom *blk_geom = md_context_ptr->blk_geom;
+    for (uint32_t i = 0; i < MD_PRED_CACHE_ENTRIES; i++) {
+        MdPredCacheEntry *entry = &md_context_ptr->pred_cache[i];
+        if (!entry->valid || !md_pred_cache_same_key(entry, key)) continue;
+        if (key->origin_x < entry->origin_x || key->origin_y < entry->origin_y ||
+            key->origin_x + key->bwidth > entry->origin_x + entry->bwidth ||
+            key->origin_y + key->bheight > entry->origin_y + entry->bheight)
+            continue;
+        const EbBool same_rect = key->origin_x == entry->origin_x &&
+                                 key->origin_y == entry->origin_y &&
+                                 key->bwidth == entry->bwidth && key->bheight == entry->bheight;
+        // Chroma of blocks up to 4 uses 4-tap filters, so it can only be served by the same block
+        if (perform_chroma &&
+            (!entry->has_chroma ||
+             (!same_rect && (blk_geom->bwidth_uv <= 4 || blk_geom->bheight_uv <= 4))))
+            continue;
+
+        const uint8_t is16bit  = key->is16bit;
+        uint8_t *     src      = md_context_ptr->pred_cache_pool + entry->offset;
+        uint32_t      offset_x = key->origin_x - entry->origin_x;
+        uint32_t      offset_y = key->origin_y - entry->origin_y;
+        md_pred_cache_copy_plane(
+            src + ((offset_x + offset_y * entry->bwidth) << is16bit),
+            entry->bwidth,
+            prediction_ptr->buffer_y +
+                ((prediction_ptr->origin_x + blk_geom->origin_x +
+                  (prediction_ptr->origin_y + blk_geom->origin_y) * prediction_ptr->stride_y)
+                 << is16bit),
+            prediction_ptr->stride_y,
+            key->bwidth,
+            key->bheight,
+            is16bit);
+        if (perform_chroma) {
+            const uint32_t entry_bwidth_uv  = entry->bwidth >> 1;
+            const uint32_t entry_bheight_uv = entry->bheight >> 1;
+            const uint32_t dst_offset_uv =
+                (prediction_ptr->origin_x + ((blk_geom->origin_x >> 3) << 3)) / 2 +
+                (prediction_ptr->origin_y + ((blk_geom->origin_y >> 3) << 3)) / 2 *
+                    prediction_ptr->stride_cb;
+            uint8_t *src_cb = src + ((entry->bwidth * entry->bheight) << is16bit);
+            uint8_t *src_cr = src_cb + ((entry_bwidth_uv * entry_bheight_uv) << is16bit);
+            offset_x >>= 1;
+            offset_y >>= 1;
+            md_pred_cache_copy_plane(src_cb + ((offset_x + offset_y * entry_bwidth_uv) << is16bit),
+                                     entry_bwidth_uv,
+                                     prediction_ptr->buffer_cb + (dst_offset_uv << is16bit),
+                                     prediction_ptr->stride_cb,
+                                     blk_geom->bwidth_uv,
+                                     blk_geom->bheight_uv,
+                                     is16bit);
+            md_pred_cache_copy_plane(src_cr + ((offset_x + offset_y * entry_bwidth_uv) << is16bit),
+                                     entry_bwidth_uv,
+                                     prediction_ptr->buffer_cr + (dst_offset_uv << is16bit),
+                                     prediction_ptr->stride_cr,
+                                     blk_geom->bwidth_uv,
+                                     blk_geom->bheight_uv,
+                                     is16bit);
+        }
+        return EB_TRUE;
+    }
+    return EB_FALSE;
+}
+
+/* Keep the prediction of the block, overwriting the oldest predictions of the pool */
+void md_pred_cache_store(ModeDecisionContext *md_context_ptr, const MdPredCacheEntry *key,
+                         EbBool perform_chroma, EbPictureBufferDesc *prediction_ptr) {
+    const BlockGeom *blk_geom = md_context_ptr->blk_geom;
+    const uint8_t    is16bit  = key->is16bit;
+    const uint32_t   luma_size = (uint32_t)(key->bwidth * key->bheight) << is16bit;
+    const uint32_t   size      = perform_chroma ? luma_size + (luma_size >> 1) : luma_size;
+    if (md_context_ptr->pred_cache_pool_head + size > md_context_ptr->pred_cache_pool_size)
+        md_context_ptr->pred_cache_pool_head = 0;
+    const uint32_t offset = md_context_ptr->pred_cache_pool_head;
+    md_context_ptr->pred_cache_pool_head += size;
+
+    MdPredCacheEntry *slot = NULL;
+    for (uint32_t i = 0; i < MD_PRED_CACHE_ENTRIES; i++) {
+        MdPredCacheEntry *entry = &md_context_ptr->pred_cache[i];
+        if (entry->valid && entry->offset < offset + size && offset < entry->offset + entry->size)
+            entry->valid = EB_FALSE;
+        if (!entry->valid && !slot) slot = entry;
+    }
+    if (!slot) {
+        slot = &md_context_ptr->pred_cache[md_context_ptr->pred_cache_next];
+        md_context_ptr->pred_cache_next = (md_context_ptr->pred_cache_next + 1) % MD_PRED_CACHE_ENTRIES;
+    }
+    *slot            = *key;
+    slot->valid      = EB_TRUE;
+    slot->has_chroma = (uint8_t)perform_chroma;
+    slot->offset     = offset;
+    slot->size       = size;
+
+    uint8_t *dst = md_context_ptr->pred_cache_pool + offset;
+    md_pred_cache_copy_plane(
+        prediction_ptr->buffer_y +
+            ((prediction_ptr->origin_x + blk_geom->origin_x +
+              (prediction_ptr->origin_y + blk_geom->origin_y) * prediction_ptr->stride_y)
+             << is16bit),
+        prediction_ptr->stride_y,
+        dst,
+        key->bwidth,
+        key->bwidth,
+        key->bheight,
+        is16bit);
+    if (perform_chroma) {
+        const uint32_t src_offset_uv =
+            (prediction_ptr->origin_x + ((blk_geom->origin_x >> 3) << 3)) / 2 +
+            (prediction_ptr->origin_y + ((blk_geom->origin_y >> 3) << 3)) / 2 *
+                prediction_ptr->stride_cb;
+        dst += luma_size;
+        md_pred_cache_copy_plane(prediction_ptr->buffer_cb + (src_offset_uv << is16bit),
+                                 prediction_ptr->stride_cb,
+                                 dst,
+                                 blk_geom->bwidth_uv,
+                                 blk_geom->bwidth_uv,
+                                 blk_geom->bheight_uv,
+                                 is16bit);
+        dst += luma_size >> 2;
+        md_pred_cache_copy_plane(prediction_ptr->buffer_cr + (src_offset_uv << is16bit),
+                                 prediction_ptr->stride_cr,
+                                 dst,
+                                 blk_geom->bwidth_uv,
+                                 blk_geom->bwidth_uv,
+                                 blk_geom->bheight_uv,
+                                 is16bit);
+    }
+}
+
 EbErrorType inter_pu_prediction_av1(uint8_t hbd_mode_decision, ModeDecisionContext *md_context_ptr,
                                     PictureControlSet *          picture_control_set_ptr,
                                     ModeDecisionCandidateBuffer *candidate_buffer_ptr) {
@@ -6504,6 +6701,48 @@ EbErrorType inter_pu_prediction_av1(uint8_t hbd_mode_decision, ModeDecisionConte
         cr_recon_neighbor_array   = md_context_ptr->cr_recon_neighbor_array16bit;
     }
 
+    const EbBool perform_chroma = md_context_ptr->chroma_level <= CHROMA_MODE_1 &&
+                                  md_context_ptr->md_staging_skip_chroma_pred == EB_FALSE &&
+                                  md_context_ptr->blk_geom->has_uv;
+    EbPictureBufferDesc *enhanced_pic =
+            picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+    MacroBlockD *xd = md_context_ptr->blk_ptr->av1xd;
+    // Only unscaled translational predictions with unclamped MVs can be cached
+    EbBool use_pred_cache =
+            md_context_ptr->md_pred_cache_enabled &&
+            md_pred_cache_candidate_eligible(candidate_ptr, &mv_unit, md_context_ptr->blk_geom);
+    if (use_pred_cache && mv_unit.pred_direction != UNI_PRED_LIST_1)
+        use_pred_cache = ref_pic_list0->width == enhanced_pic->width &&
+                         ref_pic_list0->height == enhanced_pic->height &&
+                         md_pred_cache_mv_unclamped(xd, mv_0, md_context_ptr->blk_geom->bwidth,
+                                                    md_context_ptr->blk_geom->bheight, 0) &&
+                         (!perform_chroma ||
+                          md_pred_cache_mv_unclamped(xd, mv_0, md_context_ptr->blk_geom->bwidth_uv,
+                                                     md_context_ptr->blk_geom->bheight_uv, 1));
+    if (use_pred_cache && mv_unit.pred_direction != UNI_PRED_LIST_0)
+        use_pred_cache = ref_pic_list1->width == enhanced_pic->width &&
+                         ref_pic_list1->height == enhanced_pic->height &&
+                         md_pred_cache_mv_unclamped(xd, mv_1, md_context_ptr->blk_geom->bwidth,
+                                                    md_context_ptr->blk_geom->bheight, 0) &&
+                         (!perform_chroma ||
+                          md_pred_cache_mv_unclamped(xd, mv_1, md_context_ptr->blk_geom->bwidth_uv,
+                                                     md_context_ptr->blk_geom->bheight_uv, 1));
+    MdPredCacheEntry pred_cache_key;
+    if (use_pred_cache) {
+        md_pred_cache_set_key(&pred_cache_key,
+                              candidate_ptr,
+                              &mv_unit,
+                              hbd_mode_decision ? 1 : 0,
+                              md_context_ptr->blk_origin_x,
+                              md_context_ptr->blk_origin_y,
+                              md_context_ptr->blk_geom);
+        if (md_pred_cache_fetch(md_context_ptr,
+                                &pred_cache_key,
+                                perform_chroma,
+                                candidate_buffer_ptr->prediction_ptr))
+            return return_error;
+    }
+
     av1_inter_prediction(
             picture_control_set_ptr,
             candidate_buffer_ptr->candidate_ptr->interp_filters,
@@ -6537,5 +6776,11 @@ EbErrorType inter_pu_prediction_av1(uint8_t hbd_mode_decision, ModeDecisionConte
              md_context_ptr->md_staging_skip_chroma_pred == EB_FALSE,
             hbd_mode_decision ? EB_10BIT : EB_8BIT);
 
+    if (use_pred_cache)
+        md_pred_cache_store(md_context_ptr,
+                            &pred_cache_key,
+                            perform_chroma,
+                            candidate_buffer_ptr->prediction_ptr);
+
     return return_error;
 }
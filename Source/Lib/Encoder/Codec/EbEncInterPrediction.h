@@ -109,6 +109,21 @@ void calc_pred_masked_compound(
         ModeDecisionCandidate                *candidate_ptr);
 
 
+struct MdPredCacheEntry;
+void   md_pred_cache_reset(struct ModeDecisionContext *md_context_ptr);
+EbBool md_pred_cache_candidate_eligible(const ModeDecisionCandidate *candidate_ptr,
+                                        const MvUnit *mv_unit, const BlockGeom *blk_geom);
+void   md_pred_cache_set_key(struct MdPredCacheEntry *key,
+                             const ModeDecisionCandidate *candidate_ptr, const MvUnit *mv_unit,
+                             uint8_t is16bit, uint16_t origin_x, uint16_t origin_y,
+                             const BlockGeom *blk_geom);
+EbBool md_pred_cache_fetch(struct ModeDecisionContext *md_context_ptr,
+                           const struct MdPredCacheEntry *key, EbBool perform_chroma,
+                           EbPictureBufferDesc *prediction_ptr);
+void   md_pred_cache_store(struct ModeDecisionContext *md_context_ptr,
+                           const struct MdPredCacheEntry *key, EbBool perform_chroma,
+                           EbPictureBufferDesc *prediction_ptr);
+
 EbErrorType inter_pu_prediction_av1(
         uint8_t                              hbd_mode_decision,
         struct ModeDecisionContext           *md_context_ptr,
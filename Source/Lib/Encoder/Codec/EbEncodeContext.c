@@ -14,6 +14,7 @@
 #include "EbEncodeContext.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbThreads.h"
+#include "EbAnalysisCache.h"
 
 static EbErrorType create_stats_buffer(FIRSTPASS_STATS **frame_stats_buffer,
     STATS_BUFFER_CTX *stats_buf_context,
@@ -24,7 +25,6 @@ static EbErrorType create_stats_buffer(FIRSTPASS_STATS **frame_stats_buffer,
     // *frame_stats_buffer =
     //     (FIRSTPASS_STATS *)aom_calloc(size, sizeof(FIRSTPASS_STATS));
     EB_MALLOC_ARRAY((*frame_stats_buffer), size);
-    if (frame_stats_buffer == NULL) return EB_ErrorInsufficientResources;
 
     stats_buf_context->stats_in_start = *frame_stats_buffer;
     stats_buf_context->stats_in_end = stats_buf_context->stats_in_start;
@@ -56,6 +56,8 @@ static void encode_context_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->sc_buffer_mutex);
     EB_DESTROY_MUTEX(obj->shared_reference_mutex);
     EB_DESTROY_MUTEX(obj->stat_file_mutex);
+    EB_DESTROY_MUTEX(obj->stats_in_mutex);
+    EB_DESTROY_SEMAPHORE(obj->stats_in_semaphore);
     EB_DELETE(obj->prediction_structure_group_ptr);
     EB_DELETE_PTR_ARRAY(obj->picture_decision_reorder_queue,
                         PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
@@ -72,7 +74,9 @@ static void encode_context_dctor(EbPtr p) {
     EB_DELETE_PTR_ARRAY(obj->packetization_reorder_queue, PACKETIZATION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE_ARRAY(obj->rate_control_tables_array);
     EB_FREE(obj->stats_out.stat);
+    EB_FREE(obj->stats_out.ready);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
+    EB_DELETE(obj->analysis_cache);
 }
 
 EbErrorType encode_context_ctor(EncodeContext* encode_context_ptr, EbPtr object_init_data_ptr) {
@@ -181,10 +185,17 @@ EbErrorType encode_context_ctor(EncodeContext* encode_context_ptr, EbPtr object_
     encode_context_ptr->max_coded_poc_selected_ref_qp = 32;
     EB_CREATE_MUTEX(encode_context_ptr->shared_reference_mutex);
     EB_CREATE_MUTEX(encode_context_ptr->stat_file_mutex);
-    encode_context_ptr->num_lap_buffers = 0; //lap not supported for now
-    int *num_lap_buffers = &encode_context_ptr->num_lap_buffers;
-    create_stats_buffer(&encode_context_ptr->frame_stats_buffer,
-                        &encode_context_ptr->stats_buf_context,
-                        *num_lap_buffers);
+    EB_CREATE_MUTEX(encode_context_ptr->stats_in_mutex);
+    EB_CREATE_SEMAPHORE(encode_context_ptr->stats_in_semaphore, 0, 1);
     return EB_ErrorNone;
 }
+
+/* The stats buffer is sized from the configuration, it is created once the
+ * parameters are set rather than with the context */
+EbErrorType encode_context_create_stats_buffer(EncodeContext *encode_context_ptr,
+                                               int            num_lap_buffers) {
+    encode_context_ptr->num_lap_buffers = num_lap_buffers;
+    return create_stats_buffer(&encode_context_ptr->frame_stats_buffer,
+                               &encode_context_ptr->stats_buf_context,
+                               num_lap_buffers);
+}
@@ -67,10 +67,14 @@ typedef struct DPBInfo {
     DpbDependentList dep_list1;
 } DPBInfo;
 
+struct AnalysisCache;
+
 typedef struct FirstPassStatsOut {
     FIRSTPASS_STATS* stat;
+    uint8_t* ready; // per frame, set once stat[] holds the final frame stats
     size_t size;
     size_t capability;
+    size_t streamed; // frames already returned by SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_STREAM
 } FirstPassStatsOut;
 
 typedef struct EncodeContext {
@@ -204,6 +208,12 @@ typedef struct EncodeContext {
     STATS_BUFFER_CTX stats_buf_context;
     SvtAv1FixedBuf rc_twopass_stats_in; // replaced oxcf->two_pass_cfg.stats_in in aom
     FirstPassStatsOut stats_out;
+    // Streaming second pass (rc_twopass_stats_window), the mutex guards stats_buf_context
+    EbHandle stats_in_mutex;
+    EbHandle stats_in_semaphore; // posted for every push of first pass stats
+    EbBool   stats_in_eos;
+    // ME and OIS results shared with other encodes of the same source, NULL when off
+    struct AnalysisCache *analysis_cache;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
@@ -215,4 +225,6 @@ typedef struct EncodeContextInitData {
  **************************************/
 extern EbErrorType encode_context_ctor(EncodeContext *encode_context_ptr,
                                        EbPtr          object_init_data_ptr);
+extern EbErrorType encode_context_create_stats_buffer(EncodeContext *encode_context_ptr,
+                                                      int            num_lap_buffers);
 #endif // EbEncodeContext_h
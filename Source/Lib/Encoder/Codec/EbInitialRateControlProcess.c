@@ -26,6 +26,7 @@
 #include "EbLog.h"
 #include "EbIntraPrediction.h"
 #include "EbMotionEstimation.h"
+#include "EbAnalysisCache.h"
 /**************************************
  * Context
  **************************************/
@@ -1366,6 +1367,10 @@ void *initial_rate_control_kernel(void *input_ptr) {
             SequenceControlSet *scs_ptr = (SequenceControlSet *)
                                               pcs_ptr->scs_wrapper_ptr->object_ptr;
             EncodeContext *encode_context_ptr = (EncodeContext *)scs_ptr->encode_context_ptr;
+            // Keep the ME and OIS results for later encodes of the same source
+            if (encode_context_ptr->analysis_cache &&
+                encode_context_ptr->analysis_cache->mode == ANALYSIS_CACHE_WRITE)
+                analysis_cache_store_picture(encode_context_ptr->analysis_cache, pcs_ptr);
             if (scs_ptr->static_config.look_ahead_distance == 0 || scs_ptr->static_config.enable_tpl_la == 0) {
                 // Release Pa Ref pictures when not needed
 #if INL_ME
@@ -60,90 +60,156 @@ void av1_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, const i
         if (cdf[i] == AOM_ICDF(CDF_PROB_TOP)) break;
     }
 }
+
+/*************************************************************
+* cdf_changed
+* Check whether a CDF of fc differs from the same CDF in prev_fc
+* (the context the rate tables were last built from).
+* A NULL prev_fc means the tables are not valid yet.
+**************************************************************/
+static INLINE EbBool cdf_changed(const FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc,
+                                 const AomCdfProb *cdf) {
+    if (!prev_fc) return EB_TRUE;
+    const ptrdiff_t   offset   = (const uint8_t *)cdf - (const uint8_t *)fc;
+    const AomCdfProb *prev_cdf = (const AomCdfProb *)((const uint8_t *)prev_fc + offset);
+    for (int32_t i = 0;; ++i) {
+        if (cdf[i] != prev_cdf[i]) return EB_TRUE;
+        // The adaptation counter past the last symbol does not affect the rate
+        if (cdf[i] == AOM_ICDF(CDF_PROB_TOP)) return EB_FALSE;
+    }
+}
+
+/*************************************************************
+* update_rate_from_cdf
+* Rebuild the rate of a syntax element only when its CDF changed
+**************************************************************/
+static INLINE void update_rate_from_cdf(const FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc,
+                                        int32_t *costs, const AomCdfProb *cdf,
+                                        const int32_t *inv_map) {
+    if (cdf_changed(fc, prev_fc, cdf)) av1_get_syntax_rate_from_cdf(costs, cdf, inv_map);
+}
 int av1_filter_intra_allowed_bsize(uint8_t enable_filter_intra, BlockSize bs);
 
 /*************************************************************
 * av1_estimate_syntax_rate()
 * Estimate the rate for each syntax elements and for
 * all scenarios based on the frame CDF
+* When prev_fc is not NULL, md_rate_estimation_array holds the rates of
+* prev_fc and only the rates of the CDFs that changed are rebuilt
 **************************************************************/
 void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array, EbBool is_i_slice,
-                              FRAME_CONTEXT *fc) {
+                              FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc) {
     int32_t i, j;
 
     md_rate_estimation_array->initialized = 1;
 
     for (i = 0; i < PARTITION_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->partition_fac_bits[i], fc->partition_cdf[i], NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->partition_fac_bits[i],
+                             fc->partition_cdf[i],
+                             NULL);
 
     //if (cm->skip_mode_flag) { // NM - Hardcoded to true
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->skip_mode_fac_bits[i],
+                             fc->skip_mode_cdfs[i],
+                             NULL);
     //}
 
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
+        update_rate_from_cdf(
+            fc, prev_fc, md_rate_estimation_array->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
     for (i = 0; i < KF_MODE_CONTEXTS; ++i)
         for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->y_mode_fac_bits[i][j],
+                                 fc->kf_y_cdf[i][j],
+                                 NULL);
 
     for (i = 0; i < BlockSize_GROUPS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+        update_rate_from_cdf(
+            fc, prev_fc, md_rate_estimation_array->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
 
     for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
         for (j = 0; j < INTRA_MODES; ++j)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
-                                         fc->uv_mode_cdf[i][j],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
+                                 fc->uv_mode_cdf[i][j],
+                                 NULL);
     }
 
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
+    update_rate_from_cdf(fc,
+                         prev_fc,
+                         md_rate_estimation_array->filter_intra_mode_fac_bits,
+                         fc->filter_intra_mode_cdf,
+                         NULL);
     for (i = 0; i < BlockSizeS_ALL; ++i) {
         if (av1_filter_intra_allowed_bsize(1, i))
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->filter_intra_fac_bits[i], fc->filter_intra_cdfs[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->filter_intra_fac_bits[i],
+                                 fc->filter_intra_cdfs[i],
+                                 NULL);
     }
     for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_interp_fac_bitss[i],
-                                     fc->switchable_interp_cdf[i],
-                                     NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->switchable_interp_fac_bitss[i],
+                             fc->switchable_interp_cdf[i],
+                             NULL);
 
     for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->palette_ysize_fac_bits[i], fc->palette_y_size_cdf[i], NULL);
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_size_fac_bits[i],
-                                     fc->palette_uv_size_cdf[i],
-                                     NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->palette_ysize_fac_bits[i],
+                             fc->palette_y_size_cdf[i],
+                             NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->palette_uv_size_fac_bits[i],
+                             fc->palette_uv_size_cdf[i],
+                             NULL);
         for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ymode_fac_bits[i][j],
-                                         fc->palette_y_mode_cdf[i][j],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->palette_ymode_fac_bits[i][j],
+                                 fc->palette_y_mode_cdf[i][j],
+                                 NULL);
     }
 
     for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_mode_fac_bits[i],
-                                     fc->palette_uv_mode_cdf[i],
-                                     NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->palette_uv_mode_fac_bits[i],
+                             fc->palette_uv_mode_cdf[i],
+                             NULL);
     for (i = 0; i < PALETTE_SIZES; ++i) {
         for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ycolor_fac_bitss[i][j],
-                                         fc->palette_y_color_index_cdf[i][j],
-                                         NULL);
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_color_fac_bits[i][j],
-                                         fc->palette_uv_color_index_cdf[i][j],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->palette_ycolor_fac_bitss[i][j],
+                                 fc->palette_y_color_index_cdf[i][j],
+                                 NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->palette_uv_color_fac_bits[i][j],
+                                 fc->palette_uv_color_index_cdf[i][j],
+                                 NULL);
         }
     }
 
+    // The sign rates are folded into the alpha rates, so the CfL table is rebuilt as a whole
+    EbBool cfl_changed = cdf_changed(fc, prev_fc, fc->cfl_sign_cdf);
+    for (i = 0; i < CFL_ALPHA_CONTEXTS && !cfl_changed; ++i)
+        cfl_changed = cdf_changed(fc, prev_fc, fc->cfl_alpha_cdf[i]);
     int32_t sign_fac_bits[CFL_JOINT_SIGNS];
-    av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
-    for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+    if (cfl_changed) av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
+    for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS && cfl_changed; joint_sign++) {
         int32_t *fac_bits_u = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
         int32_t *fac_bits_v = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
         if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
@@ -166,131 +232,203 @@ void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array,
 
     for (i = 0; i < MAX_TX_CATS; ++i)
         for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->tx_size_fac_bits[i][j],
+                                 fc->tx_size_cdf[i][j],
+                                 NULL);
 
     for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->txfm_partition_fac_bits[i],
+                             fc->txfm_partition_cdf[i],
+                             NULL);
     }
 
     for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
         int32_t s;
         for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
             if (use_inter_ext_tx_for_txsize[s][i])
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_tx_type_fac_bits[s][i],
-                                             fc->inter_ext_tx_cdf[s][i],
-                                             av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->inter_tx_type_fac_bits[s][i],
+                                     fc->inter_ext_tx_cdf[s][i],
+                                     av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
         }
         for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
             if (use_intra_ext_tx_for_txsize[s][i]) {
                 for (j = 0; j < INTRA_MODES; ++j)
-                    av1_get_syntax_rate_from_cdf(
-                        md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
-                        fc->intra_ext_tx_cdf[s][i][j],
-                        av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+                    update_rate_from_cdf(fc,
+                                         prev_fc,
+                                         md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
+                                         fc->intra_ext_tx_cdf[s][i][j],
+                                         av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
             }
         }
     }
     for (i = 0; i < DIRECTIONAL_MODES; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->switchable_restore_fac_bits, fc->switchable_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intrabc_fac_bits, fc->intrabc_cdf, NULL);
+        update_rate_from_cdf(fc,
+                             prev_fc,
+                             md_rate_estimation_array->angle_delta_fac_bits[i],
+                             fc->angle_delta_cdf[i],
+                             NULL);
+    update_rate_from_cdf(fc,
+                         prev_fc,
+                         md_rate_estimation_array->switchable_restore_fac_bits,
+                         fc->switchable_restore_cdf,
+                         NULL);
+    update_rate_from_cdf(fc,
+                         prev_fc,
+                         md_rate_estimation_array->wiener_restore_fac_bits,
+                         fc->wiener_restore_cdf,
+                         NULL);
+    update_rate_from_cdf(fc,
+                         prev_fc,
+                         md_rate_estimation_array->sgrproj_restore_fac_bits,
+                         fc->sgrproj_restore_cdf,
+                         NULL);
+    update_rate_from_cdf(
+        fc, prev_fc, md_rate_estimation_array->intrabc_fac_bits, fc->intrabc_cdf, NULL);
 
     if (!is_i_slice) { // NM - Hardcoded to true
         for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_inter_fac_bits[i],
+                                 fc->comp_inter_cdf[i],
+                                 NULL);
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < SINGLE_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->single_ref_fac_bits[i][j],
-                                             fc->single_ref_cdf[i][j],
-                                             NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->single_ref_fac_bits[i][j],
+                                     fc->single_ref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_type_fac_bits[i],
-                                         fc->comp_ref_type_cdf[i],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_ref_type_fac_bits[i],
+                                 fc->comp_ref_type_cdf[i],
+                                 NULL);
         for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
             for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
-                                             fc->uni_comp_ref_cdf[i][j],
-                                             NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
+                                     fc->uni_comp_ref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < FWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_fac_bits[i][j],
-                                             fc->comp_ref_cdf[i][j],
-                                             NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->comp_ref_fac_bits[i][j],
+                                     fc->comp_ref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < BWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
-                                             fc->comp_bwdref_cdf[i][j],
-                                             NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
+                                     fc->comp_bwdref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->intra_inter_fac_bits[i],
+                                 fc->intra_inter_cdf[i],
+                                 NULL);
         for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->new_mv_mode_fac_bits[i],
+                                 fc->newmv_cdf[i],
+                                 NULL);
         for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->zero_mv_mode_fac_bits[i],
+                                 fc->zeromv_cdf[i],
+                                 NULL);
         for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->ref_mv_mode_fac_bits[i],
+                                 fc->refmv_cdf[i],
+                                 NULL);
         for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
+            update_rate_from_cdf(
+                fc, prev_fc, md_rate_estimation_array->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
         for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_compound_mode_fac_bits[i],
-                                         fc->inter_compound_mode_cdf[i],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->inter_compound_mode_fac_bits[i],
+                                 fc->inter_compound_mode_cdf[i],
+                                 NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->compound_type_fac_bits[i],
-                                         fc->compound_type_cdf[i],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->compound_type_fac_bits[i],
+                                 fc->compound_type_cdf[i],
+                                 NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i) {
             if (get_interinter_wedge_bits((BlockSize)i))
-                av1_get_syntax_rate_from_cdf(
-                    md_rate_estimation_array->wedge_idx_fac_bits[i], fc->wedge_idx_cdf[i], NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->wedge_idx_fac_bits[i],
+                                     fc->wedge_idx_cdf[i],
+                                     NULL);
         }
         for (i = 0; i < BlockSize_GROUPS; ++i) {
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_intra_mode_fac_bits[i],
-                                         fc->interintra_mode_cdf[i],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->inter_intra_fac_bits[i],
+                                 fc->interintra_cdf[i],
+                                 NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->inter_intra_mode_fac_bits[i],
+                                 fc->interintra_mode_cdf[i],
+                                 NULL);
         }
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
-                                         fc->wedge_interintra_cdf[i],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
+                                 fc->wedge_interintra_cdf[i],
+                                 NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->motion_mode_fac_bits[i],
+                                 fc->motion_mode_cdf[i],
+                                 NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->motion_mode_fac_bits1[i],
+                                 fc->obmc_cdf[i],
+                                 NULL);
         for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_idx_fac_bits[i],
+                                 fc->compound_index_cdf[i],
+                                 NULL);
         for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_group_idx_fac_bits[i],
-                                         fc->comp_group_idx_cdf[i],
-                                         NULL);
+            update_rate_from_cdf(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_group_idx_fac_bits[i],
+                                 fc->comp_group_idx_cdf[i],
+                                 NULL);
     }
 }
 
@@ -349,9 +487,13 @@ void eb_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2], const Nmv
 * av1_estimate_mv_rate()
 * Estimate the rate of motion vectors
 * based on the frame CDF
+* When prev_fc is not NULL, md_rate_estimation_array holds the rates of
+* prev_fc for the same picture and the tables are rebuilt only when the
+* MV CDFs changed
 ***************************************************************************/
 void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
-                          MdRateEstimationContext *md_rate_estimation_array, FRAME_CONTEXT *fc)
+                          MdRateEstimationContext *md_rate_estimation_array, FRAME_CONTEXT *fc,
+                          const FRAME_CONTEXT *prev_fc)
 
 {
     int32_t *    nmvcost[2];
@@ -363,17 +505,19 @@ void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
     nmvcost_hp[0] = &md_rate_estimation_array->nmv_costs_hp[0][MV_MAX];
     nmvcost_hp[1] = &md_rate_estimation_array->nmv_costs_hp[1][MV_MAX];
 
-    eb_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
-                                frm_hdr->allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
-                                &fc->nmvc,
-                                frm_hdr->allow_high_precision_mv);
+    if (!prev_fc || memcmp(&fc->nmvc, &prev_fc->nmvc, sizeof(fc->nmvc)))
+        eb_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
+                                    frm_hdr->allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
+                                    &fc->nmvc,
+                                    frm_hdr->allow_high_precision_mv);
     md_rate_estimation_array->nmvcoststack[0] =
         frm_hdr->allow_high_precision_mv ? &md_rate_estimation_array->nmv_costs_hp[0][MV_MAX]
                                          : &md_rate_estimation_array->nmv_costs[0][MV_MAX];
     md_rate_estimation_array->nmvcoststack[1] =
         frm_hdr->allow_high_precision_mv ? &md_rate_estimation_array->nmv_costs_hp[1][MV_MAX]
                                          : &md_rate_estimation_array->nmv_costs[1][MV_MAX];
-    if (frm_hdr->allow_intrabc) {
+    if (frm_hdr->allow_intrabc &&
+        (!prev_fc || memcmp(&fc->ndvc, &prev_fc->ndvc, sizeof(fc->ndvc)))) {
         int32_t *dvcost[2] = {&md_rate_estimation_array->dv_cost[0][MV_MAX],
                               &md_rate_estimation_array->dv_cost[1][MV_MAX]};
         eb_av1_build_nmv_cost_table(
@@ -384,9 +528,11 @@ void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
 * av1_estimate_coefficients_rate()
 * Estimate the rate of the quantised coefficient
 * based on the frame CDF
+* When prev_fc is not NULL, md_rate_estimation_array holds the rates of
+* prev_fc and only the rates of the CDFs that changed are rebuilt
 ***************************************************************************/
 void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_array,
-                                    FRAME_CONTEXT *          fc) {
+                                    FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc) {
     const int32_t num_planes     = 3; // NM - Hardcoded to 3
     const int32_t nplanes        = AOMMIN(num_planes, PLANE_TYPES);
 
@@ -405,7 +551,7 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
                 case 6:
                 default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
                 }
-                av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
+                update_rate_from_cdf(fc, prev_fc, pcost->eob_cost[ctx], pcdf, NULL);
             }
         }
     }
@@ -414,15 +560,21 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
             LvMapCoeffCost *pcost = &md_rate_estimation_array->coeff_fac_bits[tx_size][plane];
 
             for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
+                update_rate_from_cdf(
+                    fc, prev_fc, pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
 
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     pcost->base_eob_cost[ctx],
+                                     fc->coeff_base_eob_cdf[tx_size][plane][ctx],
+                                     NULL);
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     pcost->base_cost[ctx],
+                                     fc->coeff_base_cdf[tx_size][plane][ctx],
+                                     NULL);
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
                 pcost->base_cost[ctx][4] = 0;
                 pcost->base_cost[ctx][5] =
@@ -431,18 +583,23 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
                 pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
             }
             for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+                update_rate_from_cdf(fc,
+                                     prev_fc,
+                                     pcost->eob_extra_cost[ctx],
+                                     fc->eob_extra_cdf[tx_size][plane][ctx],
+                                     NULL);
 
             for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
+                update_rate_from_cdf(
+                    fc, prev_fc, pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
 
             for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
                 int32_t br_rate[BR_CDF_SIZE];
                 int32_t prev_cost = 0;
                 int32_t i, j;
-                av1_get_syntax_rate_from_cdf(br_rate, fc->coeff_br_cdf[AOMMIN(tx_size, TX_32X32)][plane][ctx], NULL);
+                const AomCdfProb *br_cdf = fc->coeff_br_cdf[AOMMIN(tx_size, TX_32X32)][plane][ctx];
+                if (!cdf_changed(fc, prev_fc, br_cdf)) continue;
+                av1_get_syntax_rate_from_cdf(br_rate, br_cdf, NULL);
                 // SVT_LOG("br_rate: ");
                 // for(j = 0; j < BR_CDF_SIZE; j++)
                 //  SVT_LOG("%4d ", br_rate[j]);
@@ -189,14 +189,16 @@ extern "C" {
     extern void av1_estimate_syntax_rate(
         MdRateEstimationContext      *md_rate_estimation_array,
         EbBool                          is_i_slice,
-        FRAME_CONTEXT                  *fc);
+        FRAME_CONTEXT                  *fc,
+        const FRAME_CONTEXT            *prev_fc);
     /**************************************************************************
     * Estimate the rate of the quantised coefficient
     * based on the frame CDF
     ***************************************************************************/
     extern void av1_estimate_coefficients_rate(
         MdRateEstimationContext  *md_rate_estimation_array,
-        FRAME_CONTEXT              *fc);
+        FRAME_CONTEXT              *fc,
+        const FRAME_CONTEXT        *prev_fc);
     /**************************************************************************
     * av1_estimate_mv_rate()
     * Estimate the rate of motion vectors
@@ -205,7 +207,8 @@ extern "C" {
 extern void av1_estimate_mv_rate(
         struct PictureControlSet *pcs_ptr,
         MdRateEstimationContext  *md_rate_estimation_array,
-        FRAME_CONTEXT            *fc);
+        FRAME_CONTEXT            *fc,
+        const FRAME_CONTEXT      *prev_fc);
 #define AVG_CDF_WEIGHT_LEFT      3
 #define AVG_CDF_WEIGHT_TOP       1
 
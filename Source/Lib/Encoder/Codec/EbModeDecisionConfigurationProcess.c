@@ -1169,13 +1169,15 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
         // Initial Rate Estimation of the syntax elements
         av1_estimate_syntax_rate(md_rate_estimation_array,
             pcs_ptr->slice_type == I_SLICE ? EB_TRUE : EB_FALSE,
-            &pcs_ptr->md_frame_context);
+            &pcs_ptr->md_frame_context,
+            NULL);
         // Initial Rate Estimation of the Motion vectors
         av1_estimate_mv_rate(
-            pcs_ptr, md_rate_estimation_array, &pcs_ptr->md_frame_context);
+            pcs_ptr, md_rate_estimation_array, &pcs_ptr->md_frame_context, NULL);
         // Initial Rate Estimation of the quantized coefficients
         av1_estimate_coefficients_rate(md_rate_estimation_array,
-            &pcs_ptr->md_frame_context);
+            &pcs_ptr->md_frame_context,
+            NULL);
         if (frm_hdr->allow_intrabc) {
             int            i;
             int            speed          = 1;
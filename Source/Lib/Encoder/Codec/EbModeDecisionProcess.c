@@ -54,6 +54,7 @@ static void mode_decision_context_dctor(EbPtr p) {
     if (obj->hbd_mode_decision != EB_10_BIT_MD) EB_FREE_ALIGNED_ARRAY(obj->cfl_temp_luma_recon);
 #endif
     if (obj->is_md_rate_estimation_ptr_owner) EB_FREE_ARRAY(obj->md_rate_estimation_ptr);
+    EB_FREE_ARRAY(obj->rate_est_fc);
     EB_FREE_ARRAY(obj->fast_candidate_array);
     EB_FREE_ARRAY(obj->fast_candidate_ptr_array);
     EB_FREE_ARRAY(obj->fast_cost_array);
@@ -89,6 +90,7 @@ static void mode_decision_context_dctor(EbPtr p) {
         EB_DELETE(obj->recon_ptr[txt_itr]);
     }
     EB_DELETE(obj->prediction_ptr_temp);
+    EB_FREE_ALIGNED_ARRAY(obj->pred_cache_pool);
     EB_DELETE(obj->cfl_temp_prediction_ptr);
     EB_DELETE(obj->residual_quant_coeff_ptr);
 
@@ -127,6 +129,8 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
     // MD rate Estimation tables
     EB_MALLOC_ARRAY(context_ptr->md_rate_estimation_ptr, 1);
     context_ptr->is_md_rate_estimation_ptr_owner = EB_TRUE;
+    EB_MALLOC_ARRAY(context_ptr->rate_est_fc, 1);
+    context_ptr->rate_est_fc_valid = EB_FALSE;
 
     EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit, block_max_count_sb);
     EB_MALLOC_ARRAY(context_ptr->md_blk_arr_nsq, block_max_count_sb);
@@ -300,6 +304,12 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
         eb_picture_buffer_desc_ctor,
         (EbPtr)&picture_buffer_desc_init_data);
 
+    // Inter prediction cache pool: luma + 4:2:0 chroma, 16 bit samples
+    context_ptr->pred_cache_pool_size =
+        MD_PRED_CACHE_SB_COUNT * ((sb_size * sb_size * 3) >> 1) * sizeof(uint16_t);
+    EB_MALLOC_ALIGNED_ARRAY(context_ptr->pred_cache_pool, context_ptr->pred_cache_pool_size);
+    md_pred_cache_reset(context_ptr);
+
     EB_NEW(context_ptr->cfl_temp_prediction_ptr,
         eb_picture_buffer_desc_ctor,
         (EbPtr)&picture_buffer_desc_init_data);
@@ -466,6 +476,7 @@ void reset_mode_decision(SequenceControlSet *scs_ptr, ModeDecisionContext *conte
     // QP
     context_ptr->qp_index  = (uint8_t)frm_hdr->quantization_params.base_q_idx;
     av1_lambda_assign_md(pcs_ptr, context_ptr);
+
     // Reset MD rate Estimation table to initial values by copying from md_rate_estimation_array
     if (context_ptr->is_md_rate_estimation_ptr_owner) {
         context_ptr->is_md_rate_estimation_ptr_owner = EB_FALSE;
@@ -514,5 +525,9 @@ void mode_decision_configure_sb(ModeDecisionContext *context_ptr, PictureControl
 
     av1_lambda_assign_md(pcs_ptr, context_ptr);
 
+    // The cached predictions are shared by the PD passes of the SB. Blocks of
+    // other SBs are never covered by them, so they would only fill the pool
+    md_pred_cache_reset(context_ptr);
+
     return;
 }
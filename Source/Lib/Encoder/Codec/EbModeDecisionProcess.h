@@ -61,6 +61,32 @@ typedef struct {
     uint8_t best_palette_color_map[MAX_PALETTE_SQUARE];
     int     kmeans_data_buf[2 * MAX_PALETTE_SQUARE];
 } PALETTE_BUFFER;
+
+#define MD_PRED_CACHE_ENTRIES 64
+#define MD_PRED_CACHE_SB_COUNT 4 // size of the prediction pool, in SB areas
+/**************************************
+ * MD inter prediction cache entry: a
+ * translational prediction of a block,
+ * kept for the current SB
+ **************************************/
+typedef struct MdPredCacheEntry {
+    EbBool   valid;
+    uint8_t  is16bit;
+    uint8_t  has_chroma;
+    uint8_t  pred_direction;
+    uint8_t  ref_frame_type;
+    int8_t   ref_idx_l0;
+    int8_t   ref_idx_l1;
+    uint8_t  compound_idx;
+    uint32_t interp_filters;
+    Mv       mv[2];
+    uint16_t origin_x; // luma position in the picture
+    uint16_t origin_y;
+    uint8_t  bwidth;
+    uint8_t  bheight;
+    uint32_t offset; // position in the prediction pool, in bytes
+    uint32_t size; // in bytes
+} MdPredCacheEntry;
 typedef struct MdBlkStruct {
     unsigned             tested_blk_flag : 1; //tells whether this CU is tested in MD.
     unsigned             mdc_array_index : 7;
@@ -237,6 +263,9 @@ typedef struct ModeDecisionContext {
     MdRateEstimationContext *     md_rate_estimation_ptr;
     EbBool                        is_md_rate_estimation_ptr_owner;
     struct MdRateEstimationContext rate_est_table;
+    FRAME_CONTEXT *               rate_est_fc; // CDFs rate_est_table was last built from
+    uint64_t                      rate_est_picture_number_alt; // picture rate_est_fc belongs to
+    EbBool                        rate_est_fc_valid;
     InterPredictionContext *      inter_prediction_context;
     MdBlkStruct *                md_local_blk_unit;
     BlkStruct *                  md_blk_arr_nsq;
@@ -364,6 +393,13 @@ typedef struct ModeDecisionContext {
     uint32_t me_cand_offset;
     EbPictureBufferDesc *cfl_temp_prediction_ptr;
     EbPictureBufferDesc *prediction_ptr_temp;
+    // Inter prediction cache, shared by the MD stages and the block shapes of an SB
+    EbBool           md_pred_cache_enabled;
+    MdPredCacheEntry pred_cache[MD_PRED_CACHE_ENTRIES];
+    uint8_t *        pred_cache_pool;
+    uint32_t         pred_cache_pool_size;
+    uint32_t         pred_cache_pool_head;
+    uint8_t          pred_cache_next;
     EbPictureBufferDesc
         *residual_quant_coeff_ptr; // One buffer for residual and quantized coefficient
     uint8_t  tx_depth;
@@ -35,24 +35,6 @@ extern "C" {
         MeContext                 *context_ptr,
         EbPictureBufferDesc       *input_ptr);
 
-    extern void decimation_2d(
-        uint8_t                   *input_samples,
-        uint32_t                   input_stride,
-        uint32_t                   input_area_width,
-        uint32_t                   input_area_height,
-        uint8_t                   *decim_samples,
-        uint32_t                   decim_stride,
-        uint32_t                   decim_step);
-
-    extern void downsample_2d(
-        uint8_t                   *input_samples,
-        uint32_t                   input_stride,
-        uint32_t                   input_area_width,
-        uint32_t                   input_area_height,
-        uint8_t                   *decim_samples,
-        uint32_t                   decim_stride,
-        uint32_t                   decim_step);
-
     extern EbErrorType open_loop_intra_search_sb(
         PictureParentControlSet   *pcs_ptr,
         uint32_t                       sb_index,
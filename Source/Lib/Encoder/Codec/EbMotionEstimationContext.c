@@ -24,6 +24,7 @@ void motion_estimation_pred_unit_ctor(MePredUnit *pu) {
 
 static void me_context_dctor(EbPtr p) {
     MeContext *obj = (MeContext *)p;
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_ME_BUFFERS);
     EB_FREE_ALIGNED_ARRAY(obj->quarter_sb_buffer);
 
     EB_FREE_ARRAY(obj->mvd_bits_array);
@@ -31,8 +32,9 @@ static void me_context_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->p_eight_pos_sad16x16);
     EB_FREE_ALIGNED_ARRAY(obj->sixteenth_sb_buffer);
     EB_FREE_ALIGNED_ARRAY(obj->sb_buffer);
+    eb_memory_component_set(prev);
 }
-EbErrorType me_context_ctor(MeContext *object_ptr) {
+static EbErrorType me_context_init(MeContext *object_ptr) {
     uint32_t pu_index;
     uint32_t me_candidate_index;
 
@@ -75,3 +77,10 @@ EbErrorType me_context_ctor(MeContext *object_ptr) {
 #endif
     return EB_ErrorNone;
 }
+// The search buffers are charged to SVT_AV1_MEMORY_ME_BUFFERS
+EbErrorType me_context_ctor(MeContext *object_ptr) {
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_ME_BUFFERS);
+    EbErrorType return_error = me_context_init(object_ptr);
+    eb_memory_component_set(prev);
+    return return_error;
+}
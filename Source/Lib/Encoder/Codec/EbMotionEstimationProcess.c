@@ -21,6 +21,7 @@
 #include "EbMotionEstimation.h"
 #include "EbLambdaRateTables.h"
 #include "EbComputeSAD.h"
+#include "aom_dsp_rtcd.h"
 #ifdef ARCH_X86
 #include <emmintrin.h>
 #endif
@@ -28,6 +29,7 @@
 #include "EbGlobalMotionEstimation.h"
 
 #include "EbResize.h"
+#include "EbAnalysisCache.h"
 #if INL_ME
 #include "EbPictureDemuxResults.h"
 #include "EbRateControlTasks.h"
@@ -773,11 +775,29 @@ void *motion_estimation_kernel(void *input_ptr) {
                 y_segment_index, picture_height_in_sb, pcs_ptr->me_segments_row_count);
             uint32_t y_sb_end_index = SEGMENT_END_IDX(
                 y_segment_index, picture_height_in_sb, pcs_ptr->me_segments_row_count);
+            // Reuse the ME and OIS results of a previous encode of the same source
+            AnalysisCache *analysis_cache = scs_ptr->encode_context_ptr->analysis_cache;
+            const EbBool   cached         = analysis_cache &&
+                analysis_cache->mode == ANALYSIS_CACHE_READ &&
+                analysis_cache_load_segment(
+                    analysis_cache,
+                    pcs_ptr,
+                    segment_index == 0 && context_ptr->me_context_ptr->compute_global_motion,
+                    x_sb_start_index,
+                    x_sb_end_index,
+                    y_sb_start_index,
+                    y_sb_end_index);
+            if (cached && pcs_ptr->slice_type != I_SLICE) {
+                eb_block_on_mutex(pcs_ptr->me_processed_sb_mutex);
+                pcs_ptr->me_processed_sb_count += (uint16_t)((x_sb_end_index - x_sb_start_index) *
+                                                             (y_sb_end_index - y_sb_start_index));
+                eb_release_mutex(pcs_ptr->me_processed_sb_mutex);
+            }
             // *** MOTION ESTIMATION CODE ***
 #if INL_ME
-            if (pcs_ptr->slice_type != I_SLICE && !scs_ptr->in_loop_me) {
+            if (pcs_ptr->slice_type != I_SLICE && !scs_ptr->in_loop_me && !cached) {
 #else
-            if (pcs_ptr->slice_type != I_SLICE) {
+            if (pcs_ptr->slice_type != I_SLICE && !cached) {
 #endif
                 // Use scaled source references if resolution of the reference is different that of the input
                 use_scaled_source_refs_if_needed(pcs_ptr,
@@ -917,7 +937,7 @@ void *motion_estimation_kernel(void *input_ptr) {
             }
             // Global motion estimation
             // TODO: create an other kernel ?
-            if (context_ptr->me_context_ptr->compute_global_motion &&
+            if (context_ptr->me_context_ptr->compute_global_motion && !cached &&
                 // Compute only when ME of all 64x64 SBs is performed
                 pcs_ptr->me_processed_sb_count == pcs_ptr->sb_total_count) {
 #if INL_ME
@@ -930,7 +950,7 @@ void *motion_estimation_kernel(void *input_ptr) {
 #endif
             }
             if (scs_ptr->static_config.look_ahead_distance != 0 &&
-                scs_ptr->static_config.enable_tpl_la)
+                scs_ptr->static_config.enable_tpl_la && !cached)
                 for (uint32_t y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index;
                      ++y_sb_index)
                     for (uint32_t x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index;
@@ -938,6 +958,15 @@ void *motion_estimation_kernel(void *input_ptr) {
                         uint32_t sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
                         open_loop_intra_search_mb(pcs_ptr, sb_index, input_picture_ptr);
                     }
+            // Analysis-only first pass: derive the first pass stats from the PA and ME data
+            if (use_analysis_only_first_pass(scs_ptr))
+                for (uint32_t y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index;
+                     ++y_sb_index)
+                    for (uint32_t x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index;
+                         ++x_sb_index) {
+                        uint32_t sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
+                        first_pass_analysis_sb(pcs_ptr, sb_index, input_picture_ptr);
+                    }
             // ZZ SADs Computation
             // 1 lookahead frame is needed to get valid (0,0) SAD
 #if INL_ME
@@ -961,7 +990,8 @@ void *motion_estimation_kernel(void *input_ptr) {
 
             // ZZ SSDs Computation
             // 1 lookahead frame is needed to get valid (0,0) SAD
-            if (use_output_stat(scs_ptr) && scs_ptr->static_config.look_ahead_distance != 0) {
+            if (use_output_stat(scs_ptr) && !use_analysis_only_first_pass(scs_ptr) &&
+                scs_ptr->static_config.look_ahead_distance != 0) {
                 // ZZ SSDs Computation using full picture
                 if (pcs_ptr->picture_number > 0) {
                     compute_zz_ssd(
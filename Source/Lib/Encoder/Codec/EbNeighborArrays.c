@@ -20,17 +20,19 @@
 
 static void neighbor_array_unit_dctor32(EbPtr p) {
     NeighborArrayUnit32 *obj = (NeighborArrayUnit32 *)p;
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_NEIGHBOR_ARRAYS);
     EB_FREE(obj->left_array);
     EB_FREE(obj->top_array);
     EB_FREE(obj->top_left_array);
+    eb_memory_component_set(prev);
 }
 /*************************************************
  * Neighbor Array Unit Ctor
  *************************************************/
-EbErrorType neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr, uint32_t max_picture_width,
-                                       uint32_t max_picture_height, uint32_t unit_size,
-                                       uint32_t granularity_normal, uint32_t granularity_top_left,
-                                       uint32_t type_mask) {
+static EbErrorType na_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr, uint32_t max_picture_width,
+                                  uint32_t max_picture_height, uint32_t unit_size,
+                                  uint32_t granularity_normal, uint32_t granularity_top_left,
+                                  uint32_t type_mask) {
     na_unit_ptr->dctor                     = neighbor_array_unit_dctor32;
     na_unit_ptr->unit_size                 = (uint8_t)(unit_size);
     na_unit_ptr->granularity_normal        = (uint8_t)(granularity_normal);
@@ -67,15 +69,17 @@ EbErrorType neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr, uint32_
 
 static void neighbor_array_unit_dctor(EbPtr p) {
     NeighborArrayUnit *obj = (NeighborArrayUnit *)p;
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_NEIGHBOR_ARRAYS);
     EB_FREE(obj->left_array);
     EB_FREE(obj->top_array);
     EB_FREE(obj->top_left_array);
+    eb_memory_component_set(prev);
 }
 
-EbErrorType neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uint32_t max_picture_width,
-                                     uint32_t max_picture_height, uint32_t unit_size,
-                                     uint32_t granularity_normal, uint32_t granularity_top_left,
-                                     uint32_t type_mask) {
+static EbErrorType na_unit_ctor(NeighborArrayUnit *na_unit_ptr, uint32_t max_picture_width,
+                                uint32_t max_picture_height, uint32_t unit_size,
+                                uint32_t granularity_normal, uint32_t granularity_top_left,
+                                uint32_t type_mask) {
     na_unit_ptr->dctor                     = neighbor_array_unit_dctor;
     na_unit_ptr->unit_size                 = (uint8_t)(unit_size);
     na_unit_ptr->granularity_normal        = (uint8_t)(granularity_normal);
@@ -108,6 +112,39 @@ EbErrorType neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uint32_t ma
     return EB_ErrorNone;
 }
 
+// The arrays are charged to SVT_AV1_MEMORY_NEIGHBOR_ARRAYS
+EbErrorType neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr, uint32_t max_picture_width,
+                                       uint32_t max_picture_height, uint32_t unit_size,
+                                       uint32_t granularity_normal, uint32_t granularity_top_left,
+                                       uint32_t type_mask) {
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_NEIGHBOR_ARRAYS);
+    EbErrorType return_error = na_unit_ctor32(na_unit_ptr,
+                                              max_picture_width,
+                                              max_picture_height,
+                                              unit_size,
+                                              granularity_normal,
+                                              granularity_top_left,
+                                              type_mask);
+    eb_memory_component_set(prev);
+    return return_error;
+}
+
+EbErrorType neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uint32_t max_picture_width,
+                                     uint32_t max_picture_height, uint32_t unit_size,
+                                     uint32_t granularity_normal, uint32_t granularity_top_left,
+                                     uint32_t type_mask) {
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_NEIGHBOR_ARRAYS);
+    EbErrorType return_error = na_unit_ctor(na_unit_ptr,
+                                            max_picture_width,
+                                            max_picture_height,
+                                            unit_size,
+                                            granularity_normal,
+                                            granularity_top_left,
+                                            type_mask);
+    eb_memory_component_set(prev);
+    return return_error;
+}
+
 /*************************************************
  * Neighbor Array Unit Reset
  *************************************************/
@@ -625,6 +625,10 @@ void *packetization_kernel(void *input_ptr) {
     EbObjectWrapper *    rate_control_tasks_wrapper_ptr;
     EbObjectWrapper *    picture_manager_results_wrapper_ptr;
 
+    // Output packets are owned by the application and released on its thread,
+    // so they are not charged to the instance
+    eb_memory_counter_attach(NULL);
+
     context_ptr->tot_shown_frames            = 0;
     context_ptr->disp_order_continuity_count = 0;
 
@@ -187,10 +187,10 @@ void down_sample_chroma(EbPictureBufferDesc *input_picture_ptr,
  * Picture Analysis Context Destructor
  ************************************************/
 /********************************************
-    * decimation_2d
+    * decimation_2d_c
     *      decimates the input
     ********************************************/
-void decimation_2d(uint8_t *input_samples, // input parameter, input samples Ptr
+void decimation_2d_c(uint8_t *input_samples, // input parameter, input samples Ptr
                    uint32_t input_stride, // input parameter, input stride
                    uint32_t input_area_width, // input parameter, input area width
                    uint32_t input_area_height, // input parameter, input area height
@@ -216,11 +216,11 @@ void decimation_2d(uint8_t *input_samples, // input parameter, input samples Ptr
 }
 
 /********************************************
- * downsample_2d
+ * downsample_2d_c
  *      downsamples the input
  * Alternative implementation to decimation_2d that performs filtering (2x2, 0-phase)
  ********************************************/
-void downsample_2d(uint8_t *input_samples, // input parameter, input samples Ptr
+void downsample_2d_c(uint8_t *input_samples, // input parameter, input samples Ptr
                    uint32_t input_stride, // input parameter, input stride
                    uint32_t input_area_width, // input parameter, input area width
                    uint32_t input_area_height, // input parameter, input area height
@@ -2574,8 +2574,67 @@ EbErrorType compute_block_mean_compute_variance(
     return return_error;
 }
 
+/********************************************
+ * denoise_pass_rows
+ *      denoises the block rows of the current Wiener pass nobody took yet,
+ *      called with pa_segments_mutex held, released while a row is denoised
+ ********************************************/
+static void denoise_pass_rows(PictureParentControlSet *pcs_ptr) {
+    const AomWienerPass *pass = pcs_ptr->denoise_pass;
+    while (pcs_ptr->denoise_rows_next < pass->num_rows) {
+        const int32_t row = pcs_ptr->denoise_rows_next++;
+        eb_release_mutex(pcs_ptr->pa_segments_mutex);
+        const int32_t success = eb_aom_wiener_denoise_rows(pass, row, row + 1);
+        eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+        pcs_ptr->denoise_pass_success &= success;
+        if (++pcs_ptr->denoise_rows_done == pass->num_rows && pcs_ptr->denoise_pass_waiting) {
+            pcs_ptr->denoise_pass_waiting = EB_FALSE;
+            eb_post_semaphore(pcs_ptr->denoise_rows_done_semaphore);
+        }
+    }
+}
+
+// Wakes up the segments waiting for the prelude, called with pa_segments_mutex held
+static void wake_up_pa_segments(PictureParentControlSet *pcs_ptr) {
+    for (; pcs_ptr->pa_segments_waiting_count; --pcs_ptr->pa_segments_waiting_count)
+        eb_post_semaphore(pcs_ptr->pa_prelude_done_semaphore);
+}
+
+/********************************************
+ * run_denoise_pass
+ *      AomWienerPassRunner of the prelude: the segments of the picture that
+ *      wait for the prelude take block rows of the pass as well
+ ********************************************/
+static int32_t run_denoise_pass(void *priv, const AomWienerPass *pass) {
+    PictureParentControlSet *pcs_ptr = (PictureParentControlSet *)priv;
+    int32_t                  success;
+
+    eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+    pcs_ptr->denoise_pass         = pass;
+    pcs_ptr->denoise_rows_next    = 0;
+    pcs_ptr->denoise_rows_done    = 0;
+    pcs_ptr->denoise_pass_success = 1;
+    wake_up_pa_segments(pcs_ptr);
+    denoise_pass_rows(pcs_ptr);
+    if (pcs_ptr->denoise_rows_done < pass->num_rows) {
+        // Wait for the rows still being denoised by other segments
+        pcs_ptr->denoise_pass_waiting = EB_TRUE;
+        eb_release_mutex(pcs_ptr->pa_segments_mutex);
+        eb_block_on_semaphore(pcs_ptr->denoise_rows_done_semaphore);
+        eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+    }
+    pcs_ptr->denoise_pass = NULL;
+    success               = pcs_ptr->denoise_pass_success;
+    eb_release_mutex(pcs_ptr->pa_segments_mutex);
+    return success;
+}
+
 static int32_t apply_denoise_2d(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
                                 EbPictureBufferDesc *inputPicturePointer) {
+    // The other segments of the picture are idle until the prelude is done
+    pcs_ptr->denoise_and_model->run_wiener_pass =
+        pcs_ptr->pa_segments_total_count > 1 ? run_denoise_pass : NULL;
+    pcs_ptr->denoise_and_model->run_wiener_pass_priv = pcs_ptr;
     if (eb_aom_denoise_and_model_run(pcs_ptr->denoise_and_model,
                                      inputPicturePointer,
                                      &pcs_ptr->frm_hdr.film_grain_params,
@@ -2965,15 +3024,20 @@ void sub_sample_chroma_generate_pixel_intensity_histogram_bins(
  ** Compute Picture Variance
  ** Compute Block Mean for all blocks in the picture
  ************************************************/
-void compute_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
-                                        PictureParentControlSet *pcs_ptr,
-                                        EbPictureBufferDesc *    input_picture_ptr,
-                                        EbPictureBufferDesc *    input_padded_picture_ptr,
-                                        uint32_t                 sb_total_count) {
+/*******************************************
+ * compute_sb_spatial_statistics
+ *   block means and variances of the SBs [sb_start, sb_end),
+ *   returns the sum of their 64x64 variances
+ *******************************************/
+static uint64_t compute_sb_spatial_statistics(SequenceControlSet *     scs_ptr,
+                                              PictureParentControlSet *pcs_ptr,
+                                              EbPictureBufferDesc *    input_picture_ptr,
+                                              EbPictureBufferDesc *    input_padded_picture_ptr,
+                                              uint32_t sb_start, uint32_t sb_end) {
     // Variance
     uint64_t pic_tot_variance = 0;
 
-    for (uint16_t sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
+    for (uint32_t sb_index = sb_start; sb_index < sb_end; ++sb_index) {
         SbParams *sb_params = &pcs_ptr->sb_params_array[sb_index];
 
         uint16_t sb_origin_x    = sb_params->origin_x; // to avoid using child PCS
@@ -3006,9 +3070,18 @@ void compute_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
         pic_tot_variance += (pcs_ptr->variance[sb_index][RASTER_SCAN_CU_INDEX_64x64]);
     }
 
-    pcs_ptr->pic_avg_variance = (uint16_t)(pic_tot_variance / sb_total_count);
+    return pic_tot_variance;
+}
 
-    return;
+void compute_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
+                                        PictureParentControlSet *pcs_ptr,
+                                        EbPictureBufferDesc *    input_picture_ptr,
+                                        EbPictureBufferDesc *    input_padded_picture_ptr,
+                                        uint32_t                 sb_total_count) {
+    const uint64_t pic_tot_variance = compute_sb_spatial_statistics(
+        scs_ptr, pcs_ptr, input_picture_ptr, input_padded_picture_ptr, 0, pcs_ptr->sb_total_count);
+
+    pcs_ptr->pic_avg_variance = (uint16_t)(pic_tot_variance / sb_total_count);
 }
 
 #if INL_ME
@@ -3122,15 +3195,14 @@ void calculate_input_average_intensity(SequenceControlSet *     scs_ptr,
 }
 
 /************************************************
- * Gathering statistics per picture
+ * Gathering intensity statistics per picture
  ** Calculating the pixel intensity histogram bins per picture needed for SCD
- ** Computing Picture Variance
+ ** Calculating the average intensity
  ************************************************/
-void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
-                                  EbPictureBufferDesc *input_picture_ptr,
-                                  EbPictureBufferDesc *input_padded_picture_ptr,
-                                  EbPictureBufferDesc *sixteenth_decimated_picture_ptr,
-                                  uint32_t             sb_total_count) {
+static void gathering_picture_intensity_statistics(SequenceControlSet *     scs_ptr,
+                                                   PictureParentControlSet *pcs_ptr,
+                                                   EbPictureBufferDesc *    input_picture_ptr,
+                                                   EbPictureBufferDesc *sixteenth_decimated_picture_ptr) {
     uint64_t sum_avg_intensity_ttl_regions_luma = 0;
     uint64_t sum_avg_intensity_ttl_regions_cb   = 0;
     uint64_t sum_avg_intensity_ttl_regions_cr   = 0;
@@ -3161,6 +3233,20 @@ void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentCont
                                       sum_avg_intensity_ttl_regions_luma,
                                       sum_avg_intensity_ttl_regions_cb,
                                       sum_avg_intensity_ttl_regions_cr);
+}
+
+/************************************************
+ * Gathering statistics per picture
+ ** Calculating the pixel intensity histogram bins per picture needed for SCD
+ ** Computing Picture Variance
+ ************************************************/
+void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
+                                  EbPictureBufferDesc *input_picture_ptr,
+                                  EbPictureBufferDesc *input_padded_picture_ptr,
+                                  EbPictureBufferDesc *sixteenth_decimated_picture_ptr,
+                                  uint32_t             sb_total_count) {
+    gathering_picture_intensity_statistics(
+        scs_ptr, pcs_ptr, input_picture_ptr, sixteenth_decimated_picture_ptr);
 
     compute_picture_spatial_statistics(
         scs_ptr, pcs_ptr, input_picture_ptr, input_padded_picture_ptr, sb_total_count);
@@ -3354,8 +3440,9 @@ void downsample_decimation_input_picture(PictureParentControlSet *pcs_ptr,
                                          EbPictureBufferDesc *    input_padded_picture_ptr,
                                          EbPictureBufferDesc *    quarter_decimated_picture_ptr,
                                          EbPictureBufferDesc *    sixteenth_decimated_picture_ptr) {
-    // Decimate input picture for HME L0 and L1
-    if (pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag) {
+    // Decimate input picture for HME L0 and L1, there is no decimated 1/4 picture
+    // when the filtered one is used
+    if ((pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag) && quarter_decimated_picture_ptr) {
         if (pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag) {
             decimation_2d(
                 &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x +
@@ -3557,9 +3644,14 @@ EbBool is_valid_palette_nb_colors_highbd(const uint16_t *src, int stride,
 
 // Estimate if the source frame is screen content, based on the portion of
 // blocks that have no more than 4 (experimentally selected) luma colors.
-static void is_screen_content(PictureParentControlSet *pcs_ptr, int bit_depth) {
-    const int blk_w = 16;
-    const int blk_h = 16;
+#define SC_BLK_SIZE 16
+/* Counts the 16x16 blocks of the luma rows [row_start, row_end) used by the
+   screen content detection, row_start is a multiple of 16 */
+static void count_screen_content_blocks(PictureParentControlSet *pcs_ptr, int bit_depth,
+                                        int row_start, int row_end, int *color_count,
+                                        int *color_var_count) {
+    const int blk_w = SC_BLK_SIZE;
+    const int blk_h = SC_BLK_SIZE;
     // These threshold values are selected experimentally.
     const int          color_thresh = 4;
     const int          var_thresh = 0;
@@ -3575,7 +3667,7 @@ static void is_screen_content(PictureParentControlSet *pcs_ptr, int bit_depth) {
     EbPictureBufferDesc *input_picture_ptr =
         pcs_ptr->enhanced_picture_ptr;
 
-    for (int r = 0; r + blk_h <= input_picture_ptr->height; r += blk_h)
+    for (int r = row_start; r + blk_h <= row_end; r += blk_h)
     {
         for (int c = 0; c + blk_w <= input_picture_ptr->width; c += blk_w)
         {
@@ -3631,6 +3723,16 @@ static void is_screen_content(PictureParentControlSet *pcs_ptr, int bit_depth) {
         }
     }
 
+    *color_count     = counts_1;
+    *color_var_count = counts_2;
+}
+
+static void set_screen_content_detected(PictureParentControlSet *pcs_ptr, int counts_1,
+                                        int counts_2) {
+    const int            blk_w             = SC_BLK_SIZE;
+    const int            blk_h             = SC_BLK_SIZE;
+    EbPictureBufferDesc *input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+
     // The threshold values are selected experimentally.
     uint8_t color_detection = (counts_1 * blk_h * blk_w * 10 > input_picture_ptr->width * input_picture_ptr->height);
 
@@ -3641,15 +3743,112 @@ static void is_screen_content(PictureParentControlSet *pcs_ptr, int bit_depth) {
 
 }
 
+static void is_screen_content(PictureParentControlSet *pcs_ptr, int bit_depth) {
+    int counts_1, counts_2;
+
+    count_screen_content_blocks(
+        pcs_ptr, bit_depth, 0, pcs_ptr->enhanced_picture_ptr->height, &counts_1, &counts_2);
+    set_screen_content_detected(pcs_ptr, counts_1, counts_2);
+}
+
 /************************************************
  * 1/4 & 1/16 input picture downsampling (filtering)
  ************************************************/
+/* Number of 1/4 picture rows produced per strip by the fused 1/4 and 1/16
+   downsampling, small enough for the strip to still be in cache when the
+   1/16 rows are derived from it */
+#define DOWNSAMPLE_STRIP_ROWS 16
+
+/********************************************
+ * downsample_2d_quarter_sixteenth
+ *      builds the rows [row_start, row_end) of the 1/4 picture from the input
+ *      and the 1/16 picture rows derived from them, in horizontal strips
+ *      instead of two whole picture passes. row_start is even, and the
+ *      segment ending the picture is flagged by last_rows. The output is
+ *      identical to the two separate downsample_2d calls.
+ ********************************************/
+static void downsample_2d_quarter_sixteenth(EbPictureBufferDesc *input_padded_picture_ptr,
+                                            EbPictureBufferDesc *quarter_picture_ptr,
+                                            EbPictureBufferDesc *sixteenth_picture_ptr,
+                                            uint32_t row_start, uint32_t row_end,
+                                            EbBool last_rows) {
+    uint8_t *input = &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x +
+                                                         input_padded_picture_ptr->origin_y *
+                                                             input_padded_picture_ptr->stride_y];
+    uint8_t *quarter =
+        &quarter_picture_ptr->buffer_y[quarter_picture_ptr->origin_x +
+                                       quarter_picture_ptr->origin_y * quarter_picture_ptr->stride_y];
+    uint8_t *sixteenth = &sixteenth_picture_ptr->buffer_y[sixteenth_picture_ptr->origin_x +
+                                                          sixteenth_picture_ptr->origin_y *
+                                                              sixteenth_picture_ptr->stride_y];
+    const uint32_t input_stride     = input_padded_picture_ptr->stride_y;
+    const uint32_t quarter_stride   = quarter_picture_ptr->stride_y;
+    const uint32_t sixteenth_stride = sixteenth_picture_ptr->stride_y;
+    // Rows of the 1/4 picture read for the 1/16
+    const uint32_t quarter_h = quarter_picture_ptr->height;
+    // 1/4 rows already downsampled to the 1/16 picture, always even
+    uint32_t consumed = row_start;
+
+    for (uint32_t row = row_start; row < row_end; row += DOWNSAMPLE_STRIP_ROWS) {
+        const uint32_t rows = MIN(DOWNSAMPLE_STRIP_ROWS, row_end - row);
+        downsample_2d(input + 2 * row * input_stride,
+                      input_stride,
+                      input_padded_picture_ptr->width,
+                      2 * rows,
+                      quarter + row * quarter_stride,
+                      quarter_stride,
+                      2);
+        if (row >= quarter_h) continue;
+        const uint32_t sixteenth_src_rows = MIN(rows, quarter_h - row) & ~1;
+        downsample_2d(quarter + row * quarter_stride,
+                      quarter_stride,
+                      quarter_picture_ptr->width,
+                      sixteenth_src_rows,
+                      sixteenth + (row >> 1) * sixteenth_stride,
+                      sixteenth_stride,
+                      2);
+        consumed = row + sixteenth_src_rows;
+    }
+    // Remaining 1/16 rows, when the 1/4 picture is taller than the input allows
+    if (last_rows && quarter_h > consumed + 1)
+        downsample_2d(quarter + consumed * quarter_stride,
+                      quarter_stride,
+                      quarter_picture_ptr->width,
+                      quarter_h - consumed,
+                      sixteenth + (consumed >> 1) * sixteenth_stride,
+                      sixteenth_stride,
+                      2);
+}
+
 void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
                                         EbPictureBufferDesc *    input_padded_picture_ptr,
                                         EbPictureBufferDesc *    quarter_picture_ptr,
                                         EbPictureBufferDesc *    sixteenth_picture_ptr) {
     // Downsample input picture for HME L0 and L1
     if (pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag) {
+        if ((pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag) &&
+            (pcs_ptr->enable_hme_level0_flag || pcs_ptr->tf_enable_hme_level0_flag)) {
+            downsample_2d_quarter_sixteenth(input_padded_picture_ptr,
+                                            quarter_picture_ptr,
+                                            sixteenth_picture_ptr,
+                                            0,
+                                            input_padded_picture_ptr->height >> 1,
+                                            EB_TRUE);
+            generate_padding(&quarter_picture_ptr->buffer_y[0],
+                             quarter_picture_ptr->stride_y,
+                             quarter_picture_ptr->width,
+                             quarter_picture_ptr->height,
+                             quarter_picture_ptr->origin_x,
+                             quarter_picture_ptr->origin_y);
+            generate_padding(&sixteenth_picture_ptr->buffer_y[0],
+                             sixteenth_picture_ptr->stride_y,
+                             sixteenth_picture_ptr->width,
+                             sixteenth_picture_ptr->height,
+                             sixteenth_picture_ptr->origin_x,
+                             sixteenth_picture_ptr->origin_y);
+            return;
+        }
+
         if (pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag) {
             downsample_2d(
                 &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x +
@@ -3717,6 +3916,28 @@ void downsample_filtering_input_picture_ex(
                                         EbPictureBufferDesc *    input_padded_picture_ptr,
                                         EbPictureBufferDesc *    quarter_picture_ptr,
                                         EbPictureBufferDesc *    sixteenth_picture_ptr) {
+    if (quarter_picture_ptr && sixteenth_picture_ptr) {
+        downsample_2d_quarter_sixteenth(input_padded_picture_ptr,
+                                        quarter_picture_ptr,
+                                        sixteenth_picture_ptr,
+                                        0,
+                                        input_padded_picture_ptr->height >> 1,
+                                        EB_TRUE);
+        generate_padding(&quarter_picture_ptr->buffer_y[0],
+                         quarter_picture_ptr->stride_y,
+                         quarter_picture_ptr->width,
+                         quarter_picture_ptr->height,
+                         quarter_picture_ptr->origin_x,
+                         quarter_picture_ptr->origin_y);
+        generate_padding(&sixteenth_picture_ptr->buffer_y[0],
+                         sixteenth_picture_ptr->stride_y,
+                         sixteenth_picture_ptr->width,
+                         sixteenth_picture_ptr->height,
+                         sixteenth_picture_ptr->origin_x,
+                         sixteenth_picture_ptr->origin_y);
+        return;
+    }
+
     if (quarter_picture_ptr) {
         downsample_2d(
                 &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x +
@@ -3877,6 +4098,214 @@ void pad_input_pictures(SequenceControlSet *scs_ptr,
                 input_picture_ptr->origin_y >> scs_ptr->subsampling_y);
     }
 }
+
+static INLINE uint8_t *luma_row_ptr(EbPictureBufferDesc *picture_ptr, uint32_t row) {
+    return &picture_ptr->buffer_y[picture_ptr->origin_x +
+                                  (picture_ptr->origin_y + row) * picture_ptr->stride_y];
+}
+
+/********************************************
+ * downsample_input_picture_segment
+ *      1/4 & 1/16 decimation and filtering of the input rows
+ *      [row_start, row_end), row_start being a multiple of 4. Same output as
+ *      downsample_decimation_input_picture() and
+ *      downsample_filtering_input_picture(), but for the padding of the
+ *      downsampled pictures done by pad_downsampled_pictures().
+ ********************************************/
+static void downsample_input_picture_segment(SequenceControlSet *     scs_ptr,
+                                             PictureParentControlSet *pcs_ptr,
+                                             EbPaReferenceObject *    pa_ref_obj_,
+                                             uint32_t row_start, uint32_t row_end,
+                                             EbBool last_rows) {
+    EbPictureBufferDesc *input_padded_picture_ptr =
+        (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
+    EbPictureBufferDesc *quarter_decimated_picture_ptr =
+        (EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr;
+    EbPictureBufferDesc *sixteenth_decimated_picture_ptr =
+        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr;
+    uint8_t *      input        = luma_row_ptr(input_padded_picture_ptr, row_start);
+    const uint32_t input_stride = input_padded_picture_ptr->stride_y;
+    const uint32_t width        = input_padded_picture_ptr->width;
+    const uint32_t rows         = row_end - row_start;
+    const EbBool   hme          = pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag;
+    const EbBool   hme_level0 =
+        hme && (pcs_ptr->enable_hme_level0_flag || pcs_ptr->tf_enable_hme_level0_flag);
+    const EbBool hme_level1 =
+        hme && (pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag);
+
+    // 1/4 & 1/16 input picture decimation
+    if (hme_level1 && quarter_decimated_picture_ptr)
+        decimation_2d(input,
+                      input_stride,
+                      width,
+                      rows,
+                      luma_row_ptr(quarter_decimated_picture_ptr, row_start >> 1),
+                      quarter_decimated_picture_ptr->stride_y,
+                      2);
+    decimation_2d(input,
+                  input_stride,
+                  width,
+                  rows,
+                  luma_row_ptr(sixteenth_decimated_picture_ptr, row_start >> 2),
+                  sixteenth_decimated_picture_ptr->stride_y,
+                  4);
+
+    // 1/4 & 1/16 input picture downsampling through filtering
+    if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
+        EbPictureBufferDesc *quarter_picture_ptr =
+            (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr;
+        EbPictureBufferDesc *sixteenth_picture_ptr =
+            (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr;
+        if (hme_level1 && hme_level0)
+            downsample_2d_quarter_sixteenth(input_padded_picture_ptr,
+                                            quarter_picture_ptr,
+                                            sixteenth_picture_ptr,
+                                            row_start >> 1,
+                                            row_end >> 1,
+                                            last_rows);
+        else if (hme_level1)
+            downsample_2d(input,
+                          input_stride,
+                          width,
+                          rows,
+                          luma_row_ptr(quarter_picture_ptr, row_start >> 1),
+                          quarter_picture_ptr->stride_y,
+                          2);
+        else if (hme_level0)
+            downsample_2d(input,
+                          input_stride,
+                          width,
+                          rows,
+                          luma_row_ptr(sixteenth_picture_ptr, row_start >> 2),
+                          sixteenth_picture_ptr->stride_y,
+                          4);
+    }
+}
+
+static void pad_luma_picture(EbPictureBufferDesc *picture_ptr) {
+    generate_padding(&picture_ptr->buffer_y[0],
+                     picture_ptr->stride_y,
+                     picture_ptr->width,
+                     picture_ptr->height,
+                     picture_ptr->origin_x,
+                     picture_ptr->origin_y);
+}
+
+/********************************************
+ * pad_downsampled_pictures
+ *      padding of the pictures built by downsample_input_picture_segment()
+ ********************************************/
+static void pad_downsampled_pictures(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
+                                     EbPaReferenceObject *pa_ref_obj_) {
+    const EbBool hme = pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag;
+    const EbBool hme_level0 =
+        hme && (pcs_ptr->enable_hme_level0_flag || pcs_ptr->tf_enable_hme_level0_flag);
+    const EbBool hme_level1 =
+        hme && (pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag);
+
+    if (hme_level1 && pa_ref_obj_->quarter_decimated_picture_ptr)
+        pad_luma_picture((EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr);
+    pad_luma_picture((EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr);
+    if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
+        if (hme_level1)
+            pad_luma_picture((EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr);
+        if (hme_level0)
+            pad_luma_picture((EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr);
+    }
+}
+
+/********************************************
+ * picture_analysis_segment
+ *      downsampling, block statistics and screen content block counts of
+ *      the SB rows of one PA segment
+ ********************************************/
+static void picture_analysis_segment(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
+                                     uint32_t segment_index) {
+    EbPaReferenceObject *pa_ref_obj_ =
+        (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+    EbPictureBufferDesc *input_padded_picture_ptr =
+        (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
+    const uint32_t segments_count = pcs_ptr->pa_segments_total_count;
+    const EbBool   last_segment   = segment_index == segments_count - 1;
+    const uint32_t sb_row_start =
+        SEGMENT_START_IDX(segment_index, pcs_ptr->picture_sb_height, segments_count);
+    const uint32_t sb_row_end =
+        SEGMENT_END_IDX(segment_index, pcs_ptr->picture_sb_height, segments_count);
+    const uint32_t row_start = sb_row_start * scs_ptr->sb_sz;
+    const uint32_t row_end =
+        last_segment ? input_padded_picture_ptr->height : sb_row_end * scs_ptr->sb_sz;
+    int color_count = 0, color_var_count = 0;
+
+    downsample_input_picture_segment(
+        scs_ptr, pcs_ptr, pa_ref_obj_, row_start, row_end, last_segment);
+
+    // Block means and variances, the intensity histograms need the whole
+    // 1/16 picture and are left to the picture completion
+    const uint64_t tot_variance = compute_sb_spatial_statistics(
+        scs_ptr,
+        pcs_ptr,
+        pcs_ptr->chroma_downsampled_picture_ptr,
+        input_padded_picture_ptr,
+        sb_row_start * pcs_ptr->picture_sb_width,
+        last_segment ? pcs_ptr->sb_total_count : sb_row_end * pcs_ptr->picture_sb_width);
+
+    if (scs_ptr->static_config.screen_content_mode == 2) // auto detect
+        count_screen_content_blocks(
+            pcs_ptr,
+            scs_ptr->static_config.encoder_bit_depth,
+            row_start,
+            last_segment ? pcs_ptr->enhanced_picture_ptr->height : row_end,
+            &color_count,
+            &color_var_count);
+
+    eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+    pcs_ptr->pa_tot_variance += tot_variance;
+    pcs_ptr->sc_color_block_count += color_count;
+    pcs_ptr->sc_color_var_block_count += color_var_count;
+    eb_release_mutex(pcs_ptr->pa_segments_mutex);
+}
+
+/********************************************
+ * wait_for_pa_prelude
+ *      the segments > 0 of a picture wait for the prelude of the first one,
+ *      denoising block rows of its Wiener passes meanwhile
+ ********************************************/
+static void wait_for_pa_prelude(PictureParentControlSet *pcs_ptr) {
+    eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+    while (!pcs_ptr->pa_prelude_done) {
+        if (pcs_ptr->denoise_pass) denoise_pass_rows(pcs_ptr);
+        ++pcs_ptr->pa_segments_waiting_count;
+        eb_release_mutex(pcs_ptr->pa_segments_mutex);
+        eb_block_on_semaphore(pcs_ptr->pa_prelude_done_semaphore);
+        eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+    }
+    eb_release_mutex(pcs_ptr->pa_segments_mutex);
+}
+
+/********************************************
+ * picture_analysis_complete
+ *      picture level statistics, once all the segments are done
+ ********************************************/
+static void picture_analysis_complete(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr) {
+    EbPaReferenceObject *pa_ref_obj_ =
+        (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+
+    pad_downsampled_pictures(scs_ptr, pcs_ptr, pa_ref_obj_);
+
+    // Hsan: always use decimated until studying the trade offs
+    gathering_picture_intensity_statistics(
+        scs_ptr,
+        pcs_ptr,
+        pcs_ptr->chroma_downsampled_picture_ptr,
+        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr);
+    pcs_ptr->pic_avg_variance = (uint16_t)(pcs_ptr->pa_tot_variance / pcs_ptr->sb_total_count);
+
+    if (scs_ptr->static_config.screen_content_mode == 2) // auto detect
+        set_screen_content_detected(
+            pcs_ptr, pcs_ptr->sc_color_block_count, pcs_ptr->sc_color_var_block_count);
+    else // off / on
+        pcs_ptr->sc_content_detected = scs_ptr->static_config.screen_content_mode;
+}
 #endif
 
 
@@ -4088,7 +4517,9 @@ void *picture_analysis_kernel(void *input_ptr) {
 
     EbPictureBufferDesc *input_padded_picture_ptr;
     EbPictureBufferDesc *input_picture_ptr;
-
+    uint32_t             segment_index;
+    EbBool               segmented;
+    EbBool               last_segment;
 
     for (;;) {
         // Get Input Full Object
@@ -4098,12 +4529,21 @@ void *picture_analysis_kernel(void *input_ptr) {
         in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
         pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
 
-        // Mariana : save enhanced picture ptr, move this from here
-        pcs_ptr->enhanced_unscaled_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+        scs_ptr        = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+        segment_index  = in_results_ptr->segment_index;
+        // The picture is analysed by pa_segments_total_count PA threads, each
+        // handling a band of SB rows. The first segment does the whole
+        // picture operations (padding, pre-processing, luma copy) before
+        // releasing the others
+        segmented = !pcs_ptr->is_overlay && !scs_ptr->in_loop_me;
+
+        if (segment_index == 0) {
+            // Mariana : save enhanced picture ptr, move this from here
+            pcs_ptr->enhanced_unscaled_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+        }
 
         // There is no need to do processing for overlay picture. Overlay and AltRef share the same results.
-        if (!pcs_ptr->is_overlay) {
-            scs_ptr           = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+        if (!pcs_ptr->is_overlay && segment_index == 0) {
             input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
 
             // Padding for input pictures
@@ -4166,6 +4606,12 @@ void *picture_analysis_kernel(void *input_ptr) {
                 pa_ref_obj_->quarter_decimated_picture_ptr = pa_ref_obj_->quarter_filtered_picture_ptr = ds_obj->quarter_picture_ptr;
                 pa_ref_obj_->sixteenth_decimated_picture_ptr = pa_ref_obj_->sixteenth_filtered_picture_ptr = ds_obj->sixteenth_picture_ptr;
 #endif
+
+                if (scs_ptr->static_config.screen_content_mode == 2) { // auto detect
+                    is_screen_content(pcs_ptr,
+                                      scs_ptr->static_config.encoder_bit_depth);
+                } else // off / on
+                    pcs_ptr->sc_content_detected = scs_ptr->static_config.screen_content_mode;
             } else {
                 // Original path
                 // Get PA ref, copy 8bit luma to pa_ref->input_padded_picture_ptr
@@ -4184,38 +4630,34 @@ void *picture_analysis_kernel(void *input_ptr) {
                               sizeof(uint8_t) * input_picture_ptr->width);
                 // Pad input picture to complete border SBs
                 pad_picture_to_multiple_of_sb_dimensions(input_padded_picture_ptr);
-                // 1/4 & 1/16 input picture decimation
-                downsample_decimation_input_picture(
-                        pcs_ptr,
-                        input_padded_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr);
-
-                // 1/4 & 1/16 input picture downsampling through filtering
-                if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
-                    downsample_filtering_input_picture(
-                            pcs_ptr,
-                            input_padded_picture_ptr,
-                            (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr,
-                            (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr);
-                }
-                // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
-                gathering_picture_statistics(
-                        scs_ptr,
-                        pcs_ptr,
-                        pcs_ptr->chroma_downsampled_picture_ptr, //420 input_picture_ptr
-                        input_padded_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_
-                        ->sixteenth_decimated_picture_ptr, // Hsan: always use decimated until studying the trade offs
-                        pcs_ptr->sb_total_count);
+
+                pcs_ptr->pa_tot_variance          = 0;
+                pcs_ptr->sc_color_block_count     = 0;
+                pcs_ptr->sc_color_var_block_count = 0;
+                eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+                pcs_ptr->pa_prelude_done = EB_TRUE;
+                wake_up_pa_segments(pcs_ptr);
+                eb_release_mutex(pcs_ptr->pa_segments_mutex);
             }
+        } else if (segmented)
+            wait_for_pa_prelude(pcs_ptr);
 
-            if (scs_ptr->static_config.screen_content_mode == 2) { // auto detect
-                is_screen_content(pcs_ptr,
-                                  scs_ptr->static_config.encoder_bit_depth);
-            } else // off / on
-                pcs_ptr->sc_content_detected = scs_ptr->static_config.screen_content_mode;
+        if (segmented)
+            picture_analysis_segment(scs_ptr, pcs_ptr, segment_index);
+
+        eb_block_on_mutex(pcs_ptr->pa_segments_mutex);
+        last_segment =
+            ++pcs_ptr->pa_segments_done_count == pcs_ptr->pa_segments_total_count;
+        eb_release_mutex(pcs_ptr->pa_segments_mutex);
+
+        if (!last_segment) {
+            // Release the Input Results
+            eb_release_object(in_results_wrapper_ptr);
+            continue;
         }
+        if (segmented)
+            picture_analysis_complete(scs_ptr, pcs_ptr);
+
         // Get Empty Results Object
         eb_get_empty_object(context_ptr->picture_analysis_results_output_fifo_ptr,
                             &out_results_wrapper_ptr);
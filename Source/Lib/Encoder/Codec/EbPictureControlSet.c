@@ -1187,6 +1187,9 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
     EB_DESTROY_MUTEX(obj->rc_distortion_histogram_mutex);
     EB_DESTROY_SEMAPHORE(obj->temp_filt_done_semaphore);
     EB_DESTROY_MUTEX(obj->temp_filt_mutex);
+    EB_DESTROY_MUTEX(obj->pa_segments_mutex);
+    EB_DESTROY_SEMAPHORE(obj->pa_prelude_done_semaphore);
+    EB_DESTROY_SEMAPHORE(obj->denoise_rows_done_semaphore);
     EB_DESTROY_MUTEX(obj->debug_mutex);
     EB_FREE_ARRAY(obj->tile_group_info);
 #if INL_ME
@@ -1314,6 +1317,9 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
     EB_MALLOC_ARRAY(object_ptr->sb_depth_mode_array, object_ptr->sb_total_count);
     EB_CREATE_SEMAPHORE(object_ptr->temp_filt_done_semaphore, 0, 1);
     EB_CREATE_MUTEX(object_ptr->temp_filt_mutex);
+    EB_CREATE_MUTEX(object_ptr->pa_segments_mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->pa_prelude_done_semaphore, 0, PA_SEGMENTS_MAX_COUNT);
+    EB_CREATE_SEMAPHORE(object_ptr->denoise_rows_done_semaphore, 0, 1);
     EB_CREATE_MUTEX(object_ptr->debug_mutex);
     EB_MALLOC_ARRAY(object_ptr->av1_cm, 1);
 
@@ -1403,10 +1409,12 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
 }
 static void me_dctor(EbPtr p) {
     MotionEstimationData *obj = (MotionEstimationData *)p;
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_ME_BUFFERS);
 
     EB_DELETE_PTR_ARRAY(obj->me_results, obj->sb_total_count_unscaled);
+    eb_memory_component_set(prev);
 }
-EbErrorType me_ctor(MotionEstimationData *object_ptr,
+static EbErrorType me_data_ctor(MotionEstimationData *object_ptr,
     EbPtr                    object_init_data_ptr) {
 
     PictureControlSetInitData *init_data_ptr = (PictureControlSetInitData *)object_init_data_ptr;
@@ -1430,6 +1438,14 @@ EbErrorType me_ctor(MotionEstimationData *object_ptr,
 
     return return_error;
 }
+// The ME results are charged to SVT_AV1_MEMORY_ME_BUFFERS
+EbErrorType me_ctor(MotionEstimationData *object_ptr,
+    EbPtr                    object_init_data_ptr) {
+    const SvtAv1MemoryComponent prev = eb_memory_component_set(SVT_AV1_MEMORY_ME_BUFFERS);
+    EbErrorType return_error = me_data_ctor(object_ptr, object_init_data_ptr);
+    eb_memory_component_set(prev);
+    return return_error;
+}
 EbErrorType sb_params_init_pcs(SequenceControlSet *scs_ptr,
                                PictureParentControlSet *pcs_ptr) {
     EbErrorType return_error = EB_ErrorNone;
@@ -45,6 +45,7 @@ extern "C" {
 #define HISTOGRAM_NUMBER_OF_BINS 256
 #define MAX_NUMBER_OF_REGIONS_IN_WIDTH 4
 #define MAX_NUMBER_OF_REGIONS_IN_HEIGHT 4
+#define PA_SEGMENTS_MAX_COUNT 8 // picture analysis segments per picture
 #define MAX_REF_QP_NUM 81
 #define QPS_SW_THRESH 8 // 100 to shut QPS/QPM (i.e. CORE only)
 // BDP OFF
@@ -519,6 +520,8 @@ typedef struct PictureParentControlSet {
     EbBool           idr_flag;
     EbBool           cra_flag;
     EbBool           scene_change_flag;
+    EbBool           lookahead_scene_change; // scene change found by the scene lookahead
+    uint32_t         frames_to_scene_change; // next scene lookahead scene change, 0: none
     EbBool           end_of_sequence_flag;
     uint8_t          picture_qp;
     uint64_t         picture_number;
@@ -797,6 +800,24 @@ typedef struct PictureParentControlSet {
     EbByte                          save_enhanced_picture_bit_inc_ptr[3];
     EbHandle                        temp_filt_done_semaphore;
     EbHandle                        temp_filt_mutex;
+    // Picture analysis segments
+    uint16_t                        pa_segments_total_count;
+    uint16_t                        pa_segments_done_count;
+    EbHandle                        pa_segments_mutex;
+    EbHandle                        pa_prelude_done_semaphore;
+    EbBool                          pa_prelude_done;
+    uint16_t                        pa_segments_waiting_count;
+    // Wiener pass of the film grain denoising, its block rows are shared with
+    // the segments waiting for the prelude
+    const AomWienerPass *           denoise_pass;
+    int32_t                         denoise_rows_next;
+    int32_t                         denoise_rows_done;
+    int32_t                         denoise_pass_success;
+    EbBool                          denoise_pass_waiting;
+    EbHandle                        denoise_rows_done_semaphore;
+    uint64_t                        pa_tot_variance;
+    int32_t                         sc_color_block_count;
+    int32_t                         sc_color_var_block_count;
     EbHandle                        debug_mutex;
 
     uint8_t  temp_filt_prep_done;
@@ -26,6 +26,7 @@
 #include "EbReferenceObject.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbTemporalFiltering.h"
+#include "EbSceneLookahead.h"
 #include "EbObject.h"
 #include "EbUtility.h"
 #include "EbLog.h"
@@ -219,12 +220,6 @@ EbErrorType derive_tf_window_params(
 #define FUTURE_WINDOW_WIDTH                 12
 #endif
 
-#define FLASH_TH                            5
-#define FADE_TH                             3
-#define SCENE_TH                            3000
-#define NOISY_SCENE_TH                      4500    // SCD TH in presence of noise
-#define HIGH_PICTURE_VARIANCE_TH            1500
-#define NUM64x64INPIC(w,h)          ((w*h)>> (eb_log2f(BLOCK_SIZE_64)<<1))
 #define QUEUE_GET_PREVIOUS_SPOT(h)  ((h == 0) ? PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH - 1 : h - 1)
 #define QUEUE_GET_NEXT_SPOT(h,off)  (( (h+off) >= PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH) ? h+off - PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH  : h + off)
 
@@ -4539,7 +4534,7 @@ void* picture_decision_kernel(void *input_ptr)
     uint32_t                           mini_gop_index;
     uint32_t                           out_stride_diff64;
 
-    EbBool                          window_avail, frame_passthrough;
+    EbBool                          window_avail, frame_passthrough, key_deferred;
     uint32_t                           window_index;
     uint32_t                           entry_index;
 #if !NEW_DELAY
@@ -4652,7 +4647,10 @@ void* picture_decision_kernel(void *input_ptr)
             if (pcs_ptr->idr_flag == EB_TRUE)
                 context_ptr->last_solid_color_frame_poc = 0xFFFFFFFF;
             if (window_avail == EB_TRUE && queue_entry_ptr->picture_number > 0) {
-                if (scs_ptr->static_config.scene_change_detection) {
+                if (scs_ptr->scene_lad)
+                    // Scene changes found by the scene lookahead
+                    pcs_ptr->scene_change_flag = pcs_ptr->lookahead_scene_change;
+                else if (scs_ptr->static_config.scene_change_detection) {
                     pcs_ptr->scene_change_flag = scene_transition_detector(
                         context_ptr,
                         scs_ptr,
@@ -4703,11 +4701,21 @@ void* picture_decision_kernel(void *input_ptr)
                 release_prev_picture_from_reorder_queue(
                     encode_context_ptr);
 
+                // A periodic CRA shortly followed by a scene change found by the scene
+                // lookahead is moved to the scene change, which starts a new intra period
+                key_deferred = scs_ptr->scene_lad &&
+                    scs_ptr->static_config.rate_control_mode == 0 &&
+                    scs_ptr->intra_refresh_type == CRA_REFRESH &&
+                    scs_ptr->intra_period_length > 0 &&
+                    encode_context_ptr->intra_period_position == (uint32_t)scs_ptr->intra_period_length &&
+                    pcs_ptr->frames_to_scene_change > 0 &&
+                    pcs_ptr->frames_to_scene_change <= (uint32_t)(scs_ptr->intra_period_length + 1) / SCENE_LAD_KEY_DEFER_RATIO;
+
                 // If the Intra period length is 0, then introduce an intra for every picture
                 if (scs_ptr->intra_period_length == 0)
                     pcs_ptr->cra_flag = EB_TRUE;
                 // If an #IntraPeriodLength has passed since the last Intra, then introduce a CRA or IDR based on Intra Refresh type
-                else if (scs_ptr->intra_period_length != -1) {
+                else if (scs_ptr->intra_period_length != -1 && !key_deferred) {
                     pcs_ptr->cra_flag =
                         (scs_ptr->intra_refresh_type != CRA_REFRESH) ?
                         pcs_ptr->cra_flag :
@@ -4731,6 +4739,9 @@ void* picture_decision_kernel(void *input_ptr)
                     pcs_ptr->is_next_frame_intra = 0;
                 else
                     pcs_ptr->is_next_frame_intra = (int32_t)(encode_context_ptr->intra_period_position + 1) == scs_ptr->intra_period_length;
+                // The next picture is a scene change found by the scene lookahead
+                if (pcs_ptr->frames_to_scene_change == 1)
+                    pcs_ptr->is_next_frame_intra = 1;
 #endif
 
 
@@ -4749,7 +4760,9 @@ void* picture_decision_kernel(void *input_ptr)
                 else
                 {
                     // Increment the Intra Period Position
-                    encode_context_ptr->intra_period_position = ((encode_context_ptr->intra_period_position == (uint32_t)scs_ptr->intra_period_length) || (pcs_ptr->scene_change_flag == EB_TRUE)) ? 0 : encode_context_ptr->intra_period_position + 1;
+                    // A deferred key frame stays due until the scene change
+                    encode_context_ptr->intra_period_position = key_deferred ? encode_context_ptr->intra_period_position :
+                        ((encode_context_ptr->intra_period_position == (uint32_t)scs_ptr->intra_period_length) || (pcs_ptr->scene_change_flag == EB_TRUE)) ? 0 : encode_context_ptr->intra_period_position + 1;
                 }
 
 #if NEW_DELAY_DBG_MSG
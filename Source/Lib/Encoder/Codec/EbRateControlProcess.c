@@ -6025,11 +6025,15 @@ void *rate_control_kernel(void *input_ptr) {
                     set_rc_buffer_sizes(scs_ptr);
                     av1_rc_init(scs_ptr);
                 }
+                if (scs_ptr->lap_enabled)
+                    svt_av1_wait_first_pass_stats(scs_ptr);
                 svt_av1_get_second_pass_params(pcs_ptr->parent_pcs_ptr);
                 av1_configure_buffer_updates(pcs_ptr, &(pcs_ptr->parent_pcs_ptr->refresh_frame), 0);
                 av1_set_target_rate(pcs_ptr,
                     pcs_ptr->parent_pcs_ptr->av1_cm->frm_size.frame_width,
                     pcs_ptr->parent_pcs_ptr->av1_cm->frm_size.frame_height);
+                if (scs_ptr->lap_enabled)
+                    svt_av1_release_first_pass_stats(scs_ptr);
             }
             else
             if (scs_ptr->static_config.rate_control_mode) {
@@ -374,10 +374,13 @@ EbErrorType eb_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_,
     EB_NEW(pa_ref_obj_->input_padded_picture_ptr,
            eb_picture_buffer_desc_ctor,
            (EbPtr)picture_buffer_desc_init_data_ptr);
-    // Quarter Decim reference picture constructor
-    EB_NEW(pa_ref_obj_->quarter_decimated_picture_ptr,
-           eb_picture_buffer_desc_ctor,
-           (EbPtr)(picture_buffer_desc_init_data_ptr + 1));
+    // Quarter Decim reference picture constructor, ME, GM and TF only read the
+    // filtered one when it is there
+    if (!(picture_buffer_desc_init_data_ptr + 1)->down_sampled_filtered) {
+        EB_NEW(pa_ref_obj_->quarter_decimated_picture_ptr,
+               eb_picture_buffer_desc_ctor,
+               (EbPtr)(picture_buffer_desc_init_data_ptr + 1));
+    }
     EB_NEW(pa_ref_obj_->sixteenth_decimated_picture_ptr,
            eb_picture_buffer_desc_ctor,
            (EbPtr)(picture_buffer_desc_init_data_ptr + 2));
@@ -1196,7 +1196,9 @@ static EbErrorType allocate_downscaled_source_reference_pics(EbPictureBufferDesc
     initData.top_padding        = picture_ptr_for_reference->origin_y >> 1;
     initData.bot_padding        = picture_ptr_for_reference->origin_y >> 1;
 
-    EB_NEW(*quarter_decimated_picture_ptr, eb_picture_buffer_desc_ctor, (EbPtr)&initData);
+    // the filtered 1/4 picture replaces the decimated one
+    if(down_sampling_method_me_search != ME_FILTERED_DOWNSAMPLED)
+        EB_NEW(*quarter_decimated_picture_ptr, eb_picture_buffer_desc_ctor, (EbPtr)&initData);
 
     initData.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
     initData.max_width          = spr_params.encoding_width >> 2;
@@ -19,6 +19,7 @@
 #include "EbPictureBufferDesc.h"
 #include "EbResourceCoordinationProcess.h"
 #include "EbResourceCoordinationResults.h"
+#include "EbSceneLookahead.h"
 #include "EbTransforms.h"
 #include "EbTime.h"
 #include "EbObject.h"
@@ -33,6 +34,7 @@ typedef struct ResourceCoordinationContext {
     EbObjectWrapper **             sequence_control_set_active_array;
     EbFifo *                       sequence_control_set_empty_fifo_ptr;
     EbCallback **                  app_callback_ptr_array;
+    SceneLookahead *               scene_lookahead;
 
     // Compute Segments
     uint32_t compute_segments_total_count_array;
@@ -71,6 +73,7 @@ static void resource_coordination_context_dctor(EbPtr p) {
         EB_FREE_ARRAY(obj->sequence_control_set_active_array);
         EB_FREE_ARRAY(obj->picture_number_array);
         EB_FREE_ARRAY(obj->picture_control_set_fifo_ptr_array);
+        EB_DELETE(obj->scene_lookahead);
         EB_FREE_ARRAY(obj);
     }
 }
@@ -95,6 +98,10 @@ EbErrorType resource_coordination_context_ctor(EbThreadContext *thread_contxt_pt
 
     context_ptr->input_buffer_fifo_ptr =
         eb_system_resource_get_consumer_fifo(enc_handle_ptr->input_buffer_resource_ptr, 0);
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->scene_lad)
+        EB_NEW(context_ptr->scene_lookahead,
+               scene_lookahead_ctor,
+               enc_handle_ptr->scs_instance_array[0]->scs_ptr->scene_lad);
     context_ptr->resource_coordination_results_output_fifo_ptr =
         eb_system_resource_get_producer_fifo(
             enc_handle_ptr->resource_coordination_results_resource_ptr, 0);
@@ -646,14 +653,18 @@ static void setup_two_pass(SequenceControlSet *scs_ptr) {
 
     EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
 
-    int num_lap_buffers = 0;
-    int size = get_stats_buf_size(num_lap_buffers, MAX_LAG_BUFFERS);
+    int size = get_stats_buf_size(encode_context_ptr->num_lap_buffers, MAX_LAG_BUFFERS);
     for (int i = 0; i < size; i++)
         scs_ptr->twopass.frame_stats_arr[i] = &encode_context_ptr->frame_stats_buffer[i];
 
     scs_ptr->twopass.stats_buf_ctx = &encode_context_ptr->stats_buf_context;
     scs_ptr->twopass.stats_in = scs_ptr->twopass.stats_buf_ctx->stats_in_start;
-    if (use_input_stat(scs_ptr)) {
+    if (scs_ptr->static_config.rc_twopass_stats_window) {
+        // First pass stats are streamed in by svt_av1_enc_push_first_pass_stats(), the stats
+        // buffer is the linear look ahead buffer consumed by the rate control
+        scs_ptr->lap_enabled = 1;
+        svt_av1_init_single_pass_lap(scs_ptr);
+    } else if (use_input_stat(scs_ptr)) {
         const size_t packet_sz = sizeof(FIRSTPASS_STATS);
         const int packets = (int)(encode_context_ptr->rc_twopass_stats_in.sz / packet_sz);
 
@@ -727,13 +738,23 @@ void *resource_coordination_kernel(void *input_ptr) {
 
     uint32_t         input_size           = 0;
     EbObjectWrapper *prev_pcs_wrapper_ptr = 0;
+    EbBool           lookahead_scene_change = EB_FALSE;
+    uint32_t         frames_to_scene_change = 0;
 
     for (;;) {
         // Tie instance_index to zero for now...
         uint32_t instance_index = 0;
 
         // Get the Next svt Input Buffer [BLOCKING]
-        EB_GET_FULL_OBJECT(context_ptr->input_buffer_fifo_ptr, &eb_input_wrapper_ptr);
+        if (context_ptr->scene_lookahead) {
+            if (scene_lookahead_get_input(context_ptr->scene_lookahead,
+                                          context_ptr->input_buffer_fifo_ptr,
+                                          &eb_input_wrapper_ptr,
+                                          &lookahead_scene_change,
+                                          &frames_to_scene_change) == EB_NoErrorFifoShutdown)
+                return NULL;
+        } else
+            EB_GET_FULL_OBJECT(context_ptr->input_buffer_fifo_ptr, &eb_input_wrapper_ptr);
 
         eb_input_ptr = (EbBufferHeaderType *)eb_input_wrapper_ptr->object_ptr;
 
@@ -948,8 +969,10 @@ void *resource_coordination_kernel(void *input_ptr) {
                                 (pcs_ptr->input_ptr->pic_type == EB_AV1_KEY_PICTURE);
             pcs_ptr->cra_flag =
                 (pcs_ptr->input_ptr->pic_type == EB_AV1_INTRA_ONLY_PICTURE) ? EB_TRUE : EB_FALSE;
-            pcs_ptr->scene_change_flag = EB_FALSE;
-            pcs_ptr->qp_on_the_fly     = EB_FALSE;
+            pcs_ptr->scene_change_flag      = EB_FALSE;
+            pcs_ptr->lookahead_scene_change = lookahead_scene_change;
+            pcs_ptr->frames_to_scene_change = frames_to_scene_change;
+            pcs_ptr->qp_on_the_fly          = EB_FALSE;
             pcs_ptr->sb_total_count    = scs_ptr->sb_total_count;
             if (scs_ptr->static_config.speed_control_flag) {
                 speed_buffer_control(context_ptr, pcs_ptr, scs_ptr);
@@ -959,7 +982,9 @@ void *resource_coordination_kernel(void *input_ptr) {
 
             // Set the SCD Mode
             scs_ptr->scd_mode =
-                scs_ptr->static_config.scene_change_detection == 0 ? SCD_MODE_0 : SCD_MODE_1;
+                scs_ptr->static_config.scene_change_detection == 0 || scs_ptr->scene_lad
+                    ? SCD_MODE_0
+                    : SCD_MODE_1;
 
             // Set the block mean calculation prec
             scs_ptr->block_mean_calc_prec = BLOCK_MEAN_PREC_SUB;
@@ -1077,19 +1102,35 @@ void *resource_coordination_kernel(void *input_ptr) {
 
             // Get Empty Output Results Object
             if (pcs_ptr->picture_number > 0 && (prev_pcs_wrapper_ptr != NULL)) {
-                ((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)
-                    ->end_of_sequence_flag = end_of_sequence_flag;
-                eb_get_empty_object(context_ptr->resource_coordination_results_output_fifo_ptr,
-                                    &output_wrapper_ptr);
-                out_results_ptr = (ResourceCoordinationResults *)output_wrapper_ptr->object_ptr;
-                out_results_ptr->pcs_wrapper_ptr = prev_pcs_wrapper_ptr;
+                PictureParentControlSet *prev_pcs_ptr =
+                    (PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr;
+                SequenceControlSet *prev_scs_ptr =
+                    (SequenceControlSet *)prev_pcs_ptr->scs_wrapper_ptr->object_ptr;
+                prev_pcs_ptr->end_of_sequence_flag = end_of_sequence_flag;
                 // since overlay frame has the end of sequence set properly, set the end of sequence to true in the alt ref picture
-                if (((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)->is_overlay &&
-                    end_of_sequence_flag)
-                    ((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)
-                        ->alt_ref_ppcs_ptr->end_of_sequence_flag = EB_TRUE;
-                // Post the finished Results Object
-                eb_post_full_object(output_wrapper_ptr);
+                if (prev_pcs_ptr->is_overlay && end_of_sequence_flag)
+                    prev_pcs_ptr->alt_ref_ppcs_ptr->end_of_sequence_flag = EB_TRUE;
+                // Picture analysis segments, overlay pictures are not analysed
+                prev_pcs_ptr->pa_segments_total_count =
+                    (prev_pcs_ptr->is_overlay || prev_scs_ptr->in_loop_me)
+                        ? 1
+                        : (uint16_t)MIN(prev_scs_ptr->pa_segment_row_count,
+                                        prev_pcs_ptr->picture_sb_height);
+                prev_pcs_ptr->pa_segments_done_count    = 0;
+                prev_pcs_ptr->pa_segments_waiting_count = 0;
+                prev_pcs_ptr->pa_prelude_done           = EB_FALSE;
+                for (uint32_t segment_index = 0;
+                     segment_index < prev_pcs_ptr->pa_segments_total_count;
+                     ++segment_index) {
+                    eb_get_empty_object(context_ptr->resource_coordination_results_output_fifo_ptr,
+                                        &output_wrapper_ptr);
+                    out_results_ptr =
+                        (ResourceCoordinationResults *)output_wrapper_ptr->object_ptr;
+                    out_results_ptr->pcs_wrapper_ptr = prev_pcs_wrapper_ptr;
+                    out_results_ptr->segment_index   = segment_index;
+                    // Post the finished Results Object
+                    eb_post_full_object(output_wrapper_ptr);
+                }
             }
             prev_pcs_wrapper_ptr = pcs_wrapper_ptr;
         }
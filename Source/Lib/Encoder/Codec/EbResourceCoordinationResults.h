@@ -24,6 +24,7 @@ extern "C" {
 typedef struct ResourceCoordinationResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
+    uint32_t         segment_index;
 } ResourceCoordinationResults;
 
 typedef struct ResourceCoordinationResultInitData {
@@ -0,0 +1,308 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "EbSceneLookahead.h"
+#include "EbPictureBufferDesc.h"
+#include "EbUtility.h"
+
+// Subsampling step of the statistics, in both directions: 1/16 of the samples
+#define SCENE_LAD_STEP 4
+#define SCENE_LAD_STEP_LOG2 2
+
+static void scene_lookahead_dctor(EbPtr p) {
+    SceneLookahead *obj = (SceneLookahead *)p;
+    EB_FREE_ARRAY(obj->entries);
+}
+
+EbErrorType scene_lookahead_ctor(SceneLookahead *lookahead_ptr, uint32_t distance) {
+    lookahead_ptr->dctor = scene_lookahead_dctor;
+
+    // Pending pictures (distance + 1 at most) and the last picture given out,
+    // which is the past picture of the oldest pending one
+    lookahead_ptr->distance = distance;
+    lookahead_ptr->size     = distance + 2;
+    EB_CALLOC_ARRAY(lookahead_ptr->entries, lookahead_ptr->size);
+    lookahead_ptr->reset_running_avg = EB_TRUE;
+    return EB_ErrorNone;
+}
+
+static INLINE SceneLookaheadEntry *scene_lookahead_entry(SceneLookahead *lookahead_ptr,
+                                                         int32_t         offset) {
+    return &lookahead_ptr
+                ->entries[(lookahead_ptr->head + lookahead_ptr->size + offset) % lookahead_ptr->size];
+}
+
+/************************************************
+ * Histogram of the 1/16 subsampled area, bins scaled by 1 << shift and
+ * initialized to 1 as in the picture analysis, returns the samples mean
+ ************************************************/
+static uint8_t subsampled_histogram(const uint8_t *src, uint32_t stride, uint32_t width,
+                                    uint32_t height, uint32_t shift, uint32_t *histogram) {
+    uint64_t sum   = 0;
+    uint32_t count = 0;
+
+    for (uint32_t bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin) histogram[bin] = 1;
+    for (uint32_t y = 0; y < height; y += SCENE_LAD_STEP) {
+        for (uint32_t x = 0; x < width; x += SCENE_LAD_STEP) {
+            ++histogram[src[x]];
+            sum += src[x];
+        }
+        count += (width + SCENE_LAD_STEP - 1) >> SCENE_LAD_STEP_LOG2;
+        src += stride << SCENE_LAD_STEP_LOG2;
+    }
+    for (uint32_t bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin) histogram[bin] <<= shift;
+    return count ? (uint8_t)((sum + (count >> 1)) / count) : 0;
+}
+
+/************************************************
+ * Average of the 64x64 blocks luma variances, on the 1/16 subsampled picture
+ ************************************************/
+static uint16_t subsampled_average_variance(const uint8_t *src, uint32_t stride, uint32_t width,
+                                            uint32_t height) {
+    uint64_t tot_variance = 0;
+    uint32_t block_count  = 0;
+
+    for (uint32_t block_y = 0; block_y < height; block_y += BLOCK_SIZE_64) {
+        for (uint32_t block_x = 0; block_x < width; block_x += BLOCK_SIZE_64) {
+            const uint32_t block_w = MIN(BLOCK_SIZE_64, width - block_x);
+            const uint32_t block_h = MIN(BLOCK_SIZE_64, height - block_y);
+            const uint8_t *block   = src + block_y * stride + block_x;
+            uint64_t       sum = 0, sum_sq = 0;
+            uint32_t       count = 0;
+            for (uint32_t y = 0; y < block_h; y += SCENE_LAD_STEP) {
+                for (uint32_t x = 0; x < block_w; x += SCENE_LAD_STEP) {
+                    sum += block[x];
+                    sum_sq += block[x] * block[x];
+                    ++count;
+                }
+                block += stride << SCENE_LAD_STEP_LOG2;
+            }
+            tot_variance += (sum_sq - sum * sum / count) / count;
+            ++block_count;
+        }
+    }
+    return block_count ? (uint16_t)MIN(tot_variance / block_count, 0xFFFF) : 0;
+}
+
+/************************************************
+ * Scene lookahead statistics of an input picture
+ ** Per region luma and chroma histograms, with the same bin scale as the
+ ** picture analysis ones, and luma average intensity
+ ** Average 64x64 variance
+ ************************************************/
+static void scene_lookahead_gather_stats(EbPictureBufferDesc *input_picture_ptr,
+                                         SceneLookaheadStats *stats) {
+    const uint32_t ss_x = input_picture_ptr->color_format == EB_YUV444 ? 0 : 1;
+    const uint32_t ss_y = input_picture_ptr->color_format >= EB_YUV422 ? 0 : 1;
+    const uint32_t region_width  = input_picture_ptr->width / SCENE_LAD_REGIONS_PER_WIDTH;
+    const uint32_t region_height = input_picture_ptr->height / SCENE_LAD_REGIONS_PER_HEIGHT;
+    const uint8_t *luma = input_picture_ptr->buffer_y + input_picture_ptr->origin_x +
+                          input_picture_ptr->origin_y * input_picture_ptr->stride_y;
+
+    for (uint32_t region_x = 0; region_x < SCENE_LAD_REGIONS_PER_WIDTH; ++region_x) {
+        for (uint32_t region_y = 0; region_y < SCENE_LAD_REGIONS_PER_HEIGHT; ++region_y) {
+            const uint32_t x0 = region_x * region_width;
+            const uint32_t y0 = region_y * region_height;
+            const uint32_t width =
+                region_x == SCENE_LAD_REGIONS_PER_WIDTH - 1 ? input_picture_ptr->width - x0
+                                                            : region_width;
+            const uint32_t height =
+                region_y == SCENE_LAD_REGIONS_PER_HEIGHT - 1 ? input_picture_ptr->height - y0
+                                                             : region_height;
+            const uint32_t chroma_offset_cb =
+                ((input_picture_ptr->origin_y + y0) >> ss_y) * input_picture_ptr->stride_cb +
+                ((input_picture_ptr->origin_x + x0) >> ss_x);
+            const uint32_t chroma_offset_cr =
+                ((input_picture_ptr->origin_y + y0) >> ss_y) * input_picture_ptr->stride_cr +
+                ((input_picture_ptr->origin_x + x0) >> ss_x);
+
+            stats->average_intensity[region_x][region_y] =
+                subsampled_histogram(luma + y0 * input_picture_ptr->stride_y + x0,
+                                     input_picture_ptr->stride_y,
+                                     width,
+                                     height,
+                                     2 * SCENE_LAD_STEP_LOG2,
+                                     stats->histogram[region_x][region_y][0]);
+            // Chroma bins count 4:2:0 chroma samples, as the picture analysis ones
+            subsampled_histogram(input_picture_ptr->buffer_cb + chroma_offset_cb,
+                                 input_picture_ptr->stride_cb,
+                                 width >> ss_x,
+                                 height >> ss_y,
+                                 2 * SCENE_LAD_STEP_LOG2 - 2 + ss_x + ss_y,
+                                 stats->histogram[region_x][region_y][1]);
+            subsampled_histogram(input_picture_ptr->buffer_cr + chroma_offset_cr,
+                                 input_picture_ptr->stride_cr,
+                                 width >> ss_x,
+                                 height >> ss_y,
+                                 2 * SCENE_LAD_STEP_LOG2 - 2 + ss_x + ss_y,
+                                 stats->histogram[region_x][region_y][2]);
+        }
+    }
+    stats->pic_avg_variance = subsampled_average_variance(
+        luma, input_picture_ptr->stride_y, input_picture_ptr->width, input_picture_ptr->height);
+}
+
+/************************************************
+ * Scene change decision of the current picture, same as
+ * scene_transition_detector() in picture decision but on the scene
+ * lookahead statistics
+ ************************************************/
+static EbBool scene_lookahead_detect(SceneLookahead *lookahead_ptr, uint32_t pic_width,
+                                     uint32_t pic_height, const SceneLookaheadStats *prev,
+                                     const SceneLookaheadStats *current,
+                                     const SceneLookaheadStats *future) {
+    const uint32_t region_count_threshold =
+        (uint32_t)(((float)(SCENE_LAD_REGIONS_PER_WIDTH * SCENE_LAD_REGIONS_PER_HEIGHT * 50) /
+                    100) +
+                   0.5);
+    const uint32_t region_width  = pic_width / SCENE_LAD_REGIONS_PER_WIDTH;
+    const uint32_t region_height = pic_height / SCENE_LAD_REGIONS_PER_HEIGHT;
+    const EbBool   noisy =
+        ABS((int32_t)current->pic_avg_variance - (int32_t)prev->pic_avg_variance) >
+            NOISE_VARIANCE_TH &&
+        (current->pic_avg_variance > HIGH_PICTURE_VARIANCE_TH ||
+         prev->pic_avg_variance > HIGH_PICTURE_VARIANCE_TH);
+    uint32_t is_abrupt_change_count = 0;
+    uint32_t is_scene_change_count  = 0;
+
+    for (uint32_t region_x = 0; region_x < SCENE_LAD_REGIONS_PER_WIDTH; ++region_x) {
+        for (uint32_t region_y = 0; region_y < SCENE_LAD_REGIONS_PER_HEIGHT; ++region_y) {
+            const uint32_t width = region_x == SCENE_LAD_REGIONS_PER_WIDTH - 1
+                                       ? pic_width - region_x * region_width
+                                       : region_width;
+            const uint32_t height = region_y == SCENE_LAD_REGIONS_PER_HEIGHT - 1
+                                        ? pic_height - region_y * region_height
+                                        : region_height;
+            const uint32_t region_threshold = (noisy ? NOISY_SCENE_TH : SCENE_TH) *
+                                              NUM64x64INPIC(width, height);
+            uint32_t *ahd_running_avg = lookahead_ptr->ahd_running_avg[region_x][region_y];
+            uint32_t  ahd[3]          = {0, 0, 0};
+            EbBool    is_abrupt_change = EB_FALSE;
+
+            // accumulative histogram (absolute) differences between the past and current frame
+            for (int plane = 0; plane < 3; ++plane)
+                for (int bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin)
+                    ahd[plane] += ABS((int32_t)current->histogram[region_x][region_y][plane][bin] -
+                                      (int32_t)prev->histogram[region_x][region_y][plane][bin]);
+
+            if (lookahead_ptr->reset_running_avg)
+                for (int plane = 0; plane < 3; ++plane) ahd_running_avg[plane] = ahd[plane];
+
+            for (int plane = 0; plane < 3; ++plane) {
+                const uint32_t ahd_error =
+                    ABS((int32_t)ahd_running_avg[plane] - (int32_t)ahd[plane]);
+                if (ahd_error > (plane ? region_threshold / 4 : region_threshold) &&
+                    ahd[plane] >= ahd_error)
+                    is_abrupt_change = EB_TRUE;
+            }
+
+            if (is_abrupt_change) {
+                // average intensity differences between the past, current and next frames
+                const uint8_t aid_future_past = (uint8_t)ABS(
+                    (int16_t)future->average_intensity[region_x][region_y] -
+                    (int16_t)prev->average_intensity[region_x][region_y]);
+                const uint8_t aid_future_present = (uint8_t)ABS(
+                    (int16_t)future->average_intensity[region_x][region_y] -
+                    (int16_t)current->average_intensity[region_x][region_y]);
+                const uint8_t aid_present_past = (uint8_t)ABS(
+                    (int16_t)current->average_intensity[region_x][region_y] -
+                    (int16_t)prev->average_intensity[region_x][region_y]);
+
+                // neither a flash nor a fade
+                if (!(aid_future_past < FLASH_TH && aid_future_present >= FLASH_TH &&
+                      aid_present_past >= FLASH_TH) &&
+                    !(aid_future_present < FADE_TH && aid_present_past < FADE_TH))
+                    ++is_scene_change_count;
+                ++is_abrupt_change_count;
+            } else
+                ahd_running_avg[0] = (3 * ahd_running_avg[0] + ahd[0]) / 4;
+        }
+    }
+
+    lookahead_ptr->reset_running_avg = is_abrupt_change_count >= region_count_threshold;
+    return is_scene_change_count >= region_count_threshold;
+}
+
+static void scene_lookahead_push(SceneLookahead *lookahead_ptr, EbObjectWrapper *input_wrapper_ptr) {
+    EbBufferHeaderType * input_ptr = (EbBufferHeaderType *)input_wrapper_ptr->object_ptr;
+    SceneLookaheadEntry *entry_ptr =
+        scene_lookahead_entry(lookahead_ptr, (int32_t)lookahead_ptr->count);
+    // Display order index of the new picture
+    const uint64_t picture_index = lookahead_ptr->popped_count + lookahead_ptr->count;
+
+    entry_ptr->input_wrapper_ptr = input_wrapper_ptr;
+    entry_ptr->scene_change      = EB_FALSE;
+    lookahead_ptr->count++;
+    if (input_ptr->flags & EB_BUFFERFLAG_EOS) {
+        // No picture past the end of sequence
+        lookahead_ptr->eos_queued = EB_TRUE;
+        return;
+    }
+
+    EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc *)input_ptr->p_buffer;
+    scene_lookahead_gather_stats(input_picture_ptr, &entry_ptr->stats);
+
+    // The new picture is the future of the previous one, whose decision can be made
+    if (picture_index >= 2) {
+        SceneLookaheadEntry *current_ptr =
+            scene_lookahead_entry(lookahead_ptr, (int32_t)lookahead_ptr->count - 2);
+        SceneLookaheadEntry *prev_ptr =
+            scene_lookahead_entry(lookahead_ptr, (int32_t)lookahead_ptr->count - 3);
+        current_ptr->scene_change = scene_lookahead_detect(lookahead_ptr,
+                                                           input_picture_ptr->width,
+                                                           input_picture_ptr->height,
+                                                           &prev_ptr->stats,
+                                                           &current_ptr->stats,
+                                                           &entry_ptr->stats);
+    }
+}
+
+/************************************************
+ * scene_lookahead_get_input
+ ** Fills the scene lookahead from the input buffer fifo, then gives out its
+ ** oldest picture, with its scene change decision and the distance to the
+ ** next scene change found in the lookahead (0 if none)
+ ** Returns EB_NoErrorFifoShutdown when the input buffer fifo shuts down
+ ************************************************/
+EbErrorType scene_lookahead_get_input(SceneLookahead *lookahead_ptr, EbFifo *input_buffer_fifo_ptr,
+                                      EbObjectWrapper **input_wrapper_dbl_ptr,
+                                      EbBool *scene_change, uint32_t *frames_to_scene_change) {
+    EbObjectWrapper *input_wrapper_ptr;
+
+    while (!lookahead_ptr->eos_queued && lookahead_ptr->count <= lookahead_ptr->distance) {
+        // Get the Next svt Input Buffer [BLOCKING]
+        if (eb_get_full_object(input_buffer_fifo_ptr, &input_wrapper_ptr) ==
+            EB_NoErrorFifoShutdown)
+            return EB_NoErrorFifoShutdown;
+        scene_lookahead_push(lookahead_ptr, input_wrapper_ptr);
+    }
+
+    SceneLookaheadEntry *entry_ptr = scene_lookahead_entry(lookahead_ptr, 0);
+    input_wrapper_ptr              = entry_ptr->input_wrapper_ptr;
+    *scene_change                  = entry_ptr->scene_change;
+    *frames_to_scene_change        = 0;
+    for (uint32_t offset = 1; offset < lookahead_ptr->count; ++offset) {
+        if (scene_lookahead_entry(lookahead_ptr, (int32_t)offset)->scene_change) {
+            *frames_to_scene_change = offset;
+            break;
+        }
+    }
+
+    if (((EbBufferHeaderType *)input_wrapper_ptr->object_ptr)->flags & EB_BUFFERFLAG_EOS)
+        lookahead_ptr->eos_queued = EB_FALSE;
+    lookahead_ptr->head = (lookahead_ptr->head + 1) % lookahead_ptr->size;
+    lookahead_ptr->count--;
+    lookahead_ptr->popped_count++;
+    *input_wrapper_dbl_ptr = input_wrapper_ptr;
+    return EB_ErrorNone;
+}
@@ -0,0 +1,89 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbSceneLookahead_h
+#define EbSceneLookahead_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+#include "EbPictureControlSet.h"
+#include "EbObject.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Scene change detection thresholds
+#define FLASH_TH 5
+#define FADE_TH 3
+#define SCENE_TH 3000
+#define NOISY_SCENE_TH 4500 // SCD TH in presence of noise
+#define HIGH_PICTURE_VARIANCE_TH 1500
+#define NUM64x64INPIC(w, h) ((w * h) >> (eb_log2f(BLOCK_SIZE_64) << 1))
+
+#define SCENE_LAD_REGIONS_PER_WIDTH HIGHER_THAN_CLASS_1_REGION_SPLIT_PER_WIDTH
+#define SCENE_LAD_REGIONS_PER_HEIGHT HIGHER_THAN_CLASS_1_REGION_SPLIT_PER_HEIGHT
+// A periodic key frame is moved to a scene change up to intra period / ratio pictures later
+#define SCENE_LAD_KEY_DEFER_RATIO 4
+
+/**************************************
+     * Scene lookahead picture statistics
+     **************************************/
+// The subset of the picture analysis statistics the scene change detection
+// uses, computed on the 1/16 subsampled input picture
+typedef struct SceneLookaheadStats {
+    uint32_t histogram[SCENE_LAD_REGIONS_PER_WIDTH][SCENE_LAD_REGIONS_PER_HEIGHT][3]
+                      [HISTOGRAM_NUMBER_OF_BINS];
+    uint8_t  average_intensity[SCENE_LAD_REGIONS_PER_WIDTH][SCENE_LAD_REGIONS_PER_HEIGHT];
+    uint16_t pic_avg_variance;
+} SceneLookaheadStats;
+
+typedef struct SceneLookaheadEntry {
+    EbObjectWrapper *   input_wrapper_ptr;
+    SceneLookaheadStats stats;
+    EbBool              scene_change;
+} SceneLookaheadEntry;
+
+/**************************************
+     * Scene lookahead
+     **************************************/
+// Input pictures are held here, as input buffers plus their downscaled
+// statistics only, for distance pictures before a parent PCS is given to
+// them. Scene changes are decided over the whole window, so that the GOP
+// decisions can see them long before the pictures reach picture decision.
+typedef struct SceneLookahead {
+    EbDctor              dctor;
+    SceneLookaheadEntry *entries; // ring of distance + 2 entries
+    uint32_t             size;
+    uint32_t             distance;
+    uint32_t             head; // oldest pending entry
+    uint32_t             count; // pending entries
+    uint64_t             popped_count;
+    EbBool               eos_queued;
+    // Scene change detection state, as in the picture decision context
+    EbBool   reset_running_avg;
+    uint32_t ahd_running_avg[SCENE_LAD_REGIONS_PER_WIDTH][SCENE_LAD_REGIONS_PER_HEIGHT][3];
+} SceneLookahead;
+
+/**************************************
+     * Extern Function Declarations
+     **************************************/
+extern EbErrorType scene_lookahead_ctor(SceneLookahead *lookahead_ptr, uint32_t distance);
+
+extern EbErrorType scene_lookahead_get_input(SceneLookahead *  lookahead_ptr,
+                                             EbFifo *          input_buffer_fifo_ptr,
+                                             EbObjectWrapper **input_wrapper_dbl_ptr,
+                                             EbBool *          scene_change,
+                                             uint32_t *        frames_to_scene_change);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbSceneLookahead_h
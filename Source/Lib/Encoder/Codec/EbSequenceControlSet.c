@@ -62,6 +62,7 @@ EbErrorType eb_sequence_control_set_ctor(SequenceControlSet *scs_ptr, EbPtr obje
         scs_ptr->enc_dec_segment_col_count_array[segment_index] = 1;
         scs_ptr->enc_dec_segment_row_count_array[segment_index] = 1;
     }
+    scs_ptr->pa_segment_row_count = 1;
 
     // Encode Context
     if (scs_init_data != NULL) scs_ptr->encode_context_ptr = scs_init_data->encode_context_ptr;
@@ -248,6 +249,7 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->overlay_input_picture_buffer_init_count = src->overlay_input_picture_buffer_init_count;
     dst->output_stream_buffer_fifo_init_count = src->output_stream_buffer_fifo_init_count;
     dst->output_recon_buffer_fifo_init_count = src->output_recon_buffer_fifo_init_count;
+    dst->memory_estimate = src->memory_estimate;
     dst->resource_coordination_fifo_init_count = src->resource_coordination_fifo_init_count;
     dst->picture_analysis_fifo_init_count = src->picture_analysis_fifo_init_count;
     dst->picture_decision_fifo_init_count = src->picture_decision_fifo_init_count;
@@ -295,9 +297,11 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->down_sampling_method_me_search = src->down_sampling_method_me_search;
     dst->tf_segment_column_count        = src->tf_segment_column_count;
     dst->tf_segment_row_count           = src->tf_segment_row_count;
+    dst->pa_segment_row_count           = src->pa_segment_row_count;
     dst->over_boundary_block_mode       = src->over_boundary_block_mode;
     dst->mfmv_enabled                   = src->mfmv_enabled;
     dst->scd_delay                      = src->scd_delay;
+    dst->scene_lad                      = src->scene_lad;
 #if INL_ME
     dst->in_loop_me                     = src->in_loop_me;
 #endif
@@ -69,6 +69,8 @@ typedef struct SequenceControlSet {
     /*!< Number of delay frames needed to implement future window
          for algorithms such as SceneChange or TemporalFiltering */
     uint32_t scd_delay;
+    /*!< Number of future pictures in the scene lookahead, 0: OFF */
+    uint32_t scene_lad;
     /*!< Enable the use of altrefs in the stream */
     int8_t   tf_level;
     /*!<  */
@@ -155,6 +157,7 @@ typedef struct SequenceControlSet {
     uint32_t rest_segment_row_count;
     uint32_t tf_segment_column_count;
     uint32_t tf_segment_row_count;
+    uint32_t pa_segment_row_count;
 
     /*!< Picture, reference, recon and input output buffer count */
     uint32_t picture_control_set_pool_init_count;
@@ -166,6 +169,8 @@ typedef struct SequenceControlSet {
     uint32_t overlay_input_picture_buffer_init_count;
     uint32_t output_stream_buffer_fifo_init_count;
     uint32_t output_recon_buffer_fifo_init_count;
+    /*!< Estimated memory footprint of the buffer configuration, in bytes */
+    uint64_t memory_estimate;
 
     /*!< Inter processes fifos count */
     uint32_t resource_coordination_fifo_init_count;
@@ -239,7 +244,8 @@ EbErrorType sb_geom_init(SequenceControlSet *scs_ptr);
 
 inline static EbBool use_input_stat(const SequenceControlSet* scs_ptr)
 {
-    return !!scs_ptr->static_config.rc_twopass_stats_in.sz;
+    return scs_ptr->static_config.rc_twopass_stats_in.sz ||
+        scs_ptr->static_config.rc_twopass_stats_window;
 }
 
 inline static EbBool use_output_stat(const SequenceControlSet* scs_ptr)
@@ -247,6 +253,11 @@ inline static EbBool use_output_stat(const SequenceControlSet* scs_ptr)
     return scs_ptr->static_config.rc_firstpass_stats_out;
 }
 
+inline static EbBool use_analysis_only_first_pass(const SequenceControlSet* scs_ptr)
+{
+    return use_output_stat(scs_ptr) && scs_ptr->static_config.rc_firstpass_analysis_only;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -308,6 +308,10 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
     eb_aom_ifft8x8_float = eb_aom_ifft8x8_float_c;
     eb_aom_ifft2x2_float = eb_aom_ifft2x2_float_c;
     eb_aom_ifft4x4_float = eb_aom_ifft4x4_float_c;
+    eb_aom_noise_model_add_observation = eb_aom_noise_model_add_observation_c;
+    eb_aom_flat_block_remove_plane = eb_aom_flat_block_remove_plane_c;
+    eb_aom_wiener_window_block = eb_aom_wiener_window_block_c;
+    eb_aom_wiener_accumulate_block = eb_aom_wiener_accumulate_block_c;
     av1_get_gradient_hist = av1_get_gradient_hist_c;
 
     search_one_dual = search_one_dual_c;
@@ -327,6 +331,8 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
     compute_mean_square_values_8x8 = compute_mean_squared_values_c;
     compute_sub_mean_8x8 = compute_sub_mean_8x8_c;
     compute_interm_var_four8x8 = compute_interm_var_four8x8_c;
+    decimation_2d = decimation_2d_c;
+    downsample_2d = downsample_2d_c;
     sad_16b_kernel = sad_16b_kernel_c;
     eb_av1_compute_cross_correlation = eb_av1_compute_cross_correlation_c;
     eb_av1_k_means_dim1 = av1_k_means_dim1_c;
@@ -338,6 +344,8 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
 
     variance_highbd = variance_highbd_c;
     eb_av1_haar_ac_sad_8x8_uint8_input = eb_av1_haar_ac_sad_8x8_uint8_input_c;
+    aom_ssim_parms_8x8 = aom_ssim_parms_8x8_c;
+    aom_highbd_ssim_parms_8x8 = aom_highbd_ssim_parms_8x8_c;
 
 #ifdef ARCH_X86
     flags &= get_cpu_flags_to_use();
@@ -586,6 +594,10 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
                     if (flags & HAS_AVX2) eb_aom_ifft32x32_float = eb_aom_ifft32x32_float_avx2;
                     if (flags & HAS_AVX2) eb_aom_ifft8x8_float = eb_aom_ifft8x8_float_avx2;
                     if (flags & HAS_SSE2) eb_aom_ifft4x4_float = eb_aom_ifft4x4_float_sse2;
+                    if (flags & HAS_AVX2) eb_aom_noise_model_add_observation = eb_aom_noise_model_add_observation_avx2;
+                    if (flags & HAS_AVX2) eb_aom_flat_block_remove_plane = eb_aom_flat_block_remove_plane_avx2;
+                    if (flags & HAS_AVX2) eb_aom_wiener_window_block = eb_aom_wiener_window_block_avx2;
+                    if (flags & HAS_AVX2) eb_aom_wiener_accumulate_block = eb_aom_wiener_accumulate_block_avx2;
                     if (flags & HAS_AVX2) av1_get_gradient_hist = av1_get_gradient_hist_avx2;
                     SET_AVX2_AVX512(
                         search_one_dual, search_one_dual_c, search_one_dual_avx2, search_one_dual_avx512);
@@ -632,6 +644,8 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
                         compute_interm_var_four8x8_c,
                         compute_interm_var_four8x8_helper_sse2,
                         compute_interm_var_four8x8_avx2_intrin);
+                    SET_AVX2(decimation_2d, decimation_2d_c, decimation_2d_avx2);
+                    SET_AVX2(downsample_2d, downsample_2d_c, downsample_2d_avx2);
                     SET_AVX2(sad_16b_kernel, sad_16b_kernel_c, sad_16bit_kernel_avx2);
                     SET_AVX2(eb_av1_compute_cross_correlation,
                         eb_av1_compute_cross_correlation_c,
@@ -646,6 +660,10 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
                     SET_AVX2(eb_av1_haar_ac_sad_8x8_uint8_input,
                              eb_av1_haar_ac_sad_8x8_uint8_input_c,
                              eb_av1_haar_ac_sad_8x8_uint8_input_avx2);
+                    SET_AVX2(aom_ssim_parms_8x8, aom_ssim_parms_8x8_c, aom_ssim_parms_8x8_avx2);
+                    SET_AVX2(aom_highbd_ssim_parms_8x8,
+                             aom_highbd_ssim_parms_8x8_c,
+                             aom_highbd_ssim_parms_8x8_avx2);
 #endif
 
 }
@@ -501,6 +501,14 @@ extern "C" {
     RTCD_EXTERN void(*eb_aom_fft4x4_float)(const float *input, float *temp, float *output);
     void eb_aom_fft8x8_float_c(const float *input, float *temp, float *output);
     RTCD_EXTERN void(*eb_aom_fft8x8_float)(const float *input, float *temp, float *output);
+    void eb_aom_noise_model_add_observation_c(double *A, double *b, const double *buffer, double val, int32_t n, double normalization);
+    RTCD_EXTERN void(*eb_aom_noise_model_add_observation)(double *A, double *b, const double *buffer, double val, int32_t n, double normalization);
+    void eb_aom_flat_block_remove_plane_c(double *block, double *plane, const double *A, const double *at_a_inv, double normalization, int32_t n);
+    RTCD_EXTERN void(*eb_aom_flat_block_remove_plane)(double *block, double *plane, const double *A, const double *at_a_inv, double normalization, int32_t n);
+    void eb_aom_wiener_window_block_c(const double *block_d, const float *window, float *block, int32_t n);
+    RTCD_EXTERN void(*eb_aom_wiener_window_block)(const double *block_d, const float *window, float *block, int32_t n);
+    void eb_aom_wiener_accumulate_block_c(const float *block, const double *plane_d, const float *window, float *result, int32_t result_stride, int32_t block_size);
+    RTCD_EXTERN void(*eb_aom_wiener_accumulate_block)(const float *block, const double *plane_d, const float *window, float *result, int32_t result_stride, int32_t block_size);
     void eb_av1_get_nz_map_contexts_c(const uint8_t *const levels, const int16_t *const scan, const uint16_t eob, const TxSize tx_size, const TxClass tx_class, int8_t *const coeff_contexts);
     RTCD_EXTERN void(*eb_av1_get_nz_map_contexts)(const uint8_t *const levels, const int16_t *const scan, const uint16_t eob, const TxSize tx_size, const TxClass tx_class, int8_t *const coeff_contexts);
     RTCD_EXTERN void(*sad_loop_kernel)(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride, uint32_t block_height, uint32_t block_width, uint64_t *best_sad, int16_t *x_search_center, int16_t *y_search_center, uint32_t src_stride_raw, int16_t search_area_width, int16_t search_area_height);
@@ -558,12 +566,20 @@ extern "C" {
     RTCD_EXTERN uint64_t(*compute_sub_mean_8x8)(uint8_t* input_samples, uint16_t input_stride);
     uint64_t compute_sub_mean_8x8_c(uint8_t* input_samples, uint16_t input_stride);
     RTCD_EXTERN void(*compute_interm_var_four8x8)(uint8_t *input_samples, uint16_t input_stride, uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks);
+    void decimation_2d_c(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    RTCD_EXTERN void(*decimation_2d)(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    void downsample_2d_c(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    RTCD_EXTERN void(*downsample_2d)(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
     RTCD_EXTERN uint32_t(*sad_16b_kernel)(uint16_t *src, uint32_t src_stride, uint16_t *ref, uint32_t ref_stride, uint32_t height, uint32_t width);
     RTCD_EXTERN void(*pme_sad_loop_kernel)(uint8_t* src, uint32_t src_stride, uint8_t* ref, uint32_t ref_stride, uint32_t block_height, uint32_t block_width, uint32_t* best_sad, int16_t* best_mvx, int16_t* best_mvy, int16_t search_position_start_x, int16_t search_position_start_y, int16_t search_area_width, int16_t search_area_height, int16_t search_step, int16_t mvx, int16_t mvy);
     RTCD_EXTERN uint32_t(*variance_highbd)(const uint16_t *a, int a_stride, const uint16_t *b, int b_stride, int w, int h, uint32_t *sse);
     uint32_t variance_highbd_c(const uint16_t *a, int a_stride, const uint16_t *b, int b_stride, int w, int h, uint32_t *sse);
     RTCD_EXTERN int(*eb_av1_haar_ac_sad_8x8_uint8_input)(uint8_t *input, int stride, int hbd);
     int eb_av1_haar_ac_sad_8x8_uint8_input_c(uint8_t *input, int stride, int hbd);
+    void aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    RTCD_EXTERN void(*aom_ssim_parms_8x8)(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    RTCD_EXTERN void(*aom_highbd_ssim_parms_8x8)(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
 #ifdef ARCH_X86
     uint32_t combined_averaging_ssd_avx2(uint8_t *src, ptrdiff_t src_stride, uint8_t *ref1, ptrdiff_t ref1_stride, uint8_t *ref2, ptrdiff_t ref2_stride, uint32_t height, uint32_t width);
     uint32_t combined_averaging_ssd_avx512(uint8_t *src, ptrdiff_t src_stride, uint8_t *ref1, ptrdiff_t ref1_stride, uint8_t *ref2, ptrdiff_t ref2_stride, uint32_t height, uint32_t width);
@@ -1014,6 +1030,14 @@ extern "C" {
 
     void eb_aom_fft8x8_float_avx2(const float *input, float *temp, float *output);
 
+    void eb_aom_noise_model_add_observation_avx2(double *A, double *b, const double *buffer, double val, int32_t n, double normalization);
+
+    void eb_aom_flat_block_remove_plane_avx2(double *block, double *plane, const double *A, const double *at_a_inv, double normalization, int32_t n);
+
+    void eb_aom_wiener_window_block_avx2(const double *block_d, const float *window, float *block, int32_t n);
+
+    void eb_aom_wiener_accumulate_block_avx2(const float *block, const double *plane_d, const float *window, float *result, int32_t result_stride, int32_t block_size);
+
     void eb_av1_get_nz_map_contexts_sse2(const uint8_t *const levels, const int16_t *const scan, const uint16_t eob, const TxSize tx_size, const TxClass tx_class, int8_t *const coeff_contexts);
 
     void residual_kernel8bit_avx2(uint8_t *input, uint32_t input_stride, uint8_t *pred, uint32_t pred_stride, int16_t *residual, uint32_t residual_stride, uint32_t area_width, uint32_t area_height);
@@ -1107,6 +1131,8 @@ extern "C" {
     void compute_interm_var_four8x8_avx2_intrin(uint8_t *input_samples, uint16_t input_stride,
         uint64_t *mean_of8x8_blocks, // mean of four  8x8
         uint64_t *mean_of_squared8x8_blocks);
+    void decimation_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    void downsample_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
     uint32_t sad_16bit_kernel_avx2(uint16_t *src, uint32_t src_stride, uint16_t *ref,
         uint32_t ref_stride, uint32_t height, uint32_t width);
     void svt_av1_apply_temporal_filter_planewise_avx2(
@@ -1126,6 +1152,8 @@ extern "C" {
     uint32_t variance_highbd_avx2(const uint16_t *a, int a_stride, const uint16_t *b, int b_stride,
                               int w, int h, uint32_t *sse);
     int eb_av1_haar_ac_sad_8x8_uint8_input_avx2(uint8_t *input, int stride, int hbd);
+    void aom_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void aom_highbd_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
 
 #endif
 
@@ -18,6 +18,8 @@
 #include "EbRateControlProcess.h"
 #include "EbSequenceControlSet.h"
 #include "EbPictureControlSet.h"
+#include "EbReferenceObject.h"
+#include "EbUtility.h"
 #include "firstpass.h"
 #include "EbLog.h"
 #include "EbModeDecisionProcess.h"
@@ -53,20 +55,25 @@ static EbErrorType realloc_stats_out(FirstPassStatsOut* out, uint64_t frame_numb
         size_t capability = frame_number >= STATS_CAPABILITY_INIT ?
             STATS_CAPABILITY_GROW(frame_number) : STATS_CAPABILITY_INIT;
         EB_REALLOC_ARRAY(out->stat, capability);
+        EB_REALLOC_ARRAY(out->ready, capability);
+        memset(out->ready + out->capability, 0, capability - out->capability);
         out->capability = capability;
     }
     out->size = frame_number + 1;
     return EB_ErrorNone;
 }
 
+// is_frame is EB_FALSE for the totals appended at the end of the pass, which are
+// not streamed out by SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_STREAM.
 static AOM_INLINE void output_stats(SequenceControlSet *scs_ptr, FIRSTPASS_STATS *stats,
-                                    uint64_t frame_number) {
+                                    uint64_t frame_number, EbBool is_frame) {
     FirstPassStatsOut* stats_out = &scs_ptr->encode_context_ptr->stats_out;
     eb_block_on_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
     if (realloc_stats_out(stats_out, frame_number) != EB_ErrorNone) {
         SVT_ERROR("realloc_stats_out request %d entries failed failed\n", frame_number);
     } else {
-        stats_out->stat[frame_number] = *stats;
+        stats_out->stat[frame_number]  = *stats;
+        stats_out->ready[frame_number] = (uint8_t)is_frame;
     }
 // TEMP debug code
 #if OUTPUT_FPF
@@ -163,7 +170,8 @@ void svt_av1_end_first_pass(PictureParentControlSet *pcs_ptr) {
 
     if (twopass->stats_buf_ctx->total_stats) {
         // add the total to the end of the file
-        output_stats(scs_ptr, twopass->stats_buf_ctx->total_stats, pcs_ptr->picture_number + 1);
+        output_stats(
+            scs_ptr, twopass->stats_buf_ctx->total_stats, pcs_ptr->picture_number + 1, EB_FALSE);
     }
 }
 static double raw_motion_error_stdev(int *raw_motion_err_list, int raw_motion_err_counts) {
@@ -314,7 +322,7 @@ static void update_firstpass_stats(PictureParentControlSet *pcs_ptr,
     // We will store the stats inside the persistent twopass struct (and NOT the
     // local variable 'fps'), and then cpi->output_pkt_list will point to it.
     *this_frame_stats = fps;
-    output_stats(scs_ptr, this_frame_stats, pcs_ptr->picture_number);
+    output_stats(scs_ptr, this_frame_stats, pcs_ptr->picture_number, EB_TRUE);
     if (twopass->stats_buf_ctx->total_stats != NULL) {
         svt_av1_accumulate_stats(twopass->stats_buf_ctx->total_stats, &fps);
     }
@@ -436,6 +444,226 @@ void first_pass_frame_end(PictureParentControlSet *pcs_ptr, const int64_t ts_dur
     update_firstpass_stats(
         pcs_ptr, &stats, raw_err_stdev, (const int)pcs_ptr->picture_number, ts_duration);
 }
+/******************************************************
+ * Open loop DC prediction of a 16x16 block from the source samples above
+ * and to the left of it, following the AV1 DC_PRED edge rules.
+ ******************************************************/
+static int first_pass_analysis_dc_pred(const uint8_t *src, int stride, EbBool has_top,
+                                       EbBool has_left) {
+    int sum = 0;
+    if (has_top)
+        for (int i = 0; i < 16; i++) sum += src[i - stride];
+    if (has_left)
+        for (int i = 0; i < 16; i++) sum += src[i * stride - 1];
+    if (has_top && has_left) return (sum + 16) >> 5;
+    if (has_top || has_left) return (sum + 8) >> 4;
+    return 128;
+}
+/******************************************************
+ * Returns EB_TRUE when the open loop ME of the current 16x16 block produced a
+ * candidate pointing to (list_idx, ref_idx).
+ ******************************************************/
+static EbBool first_pass_analysis_me_valid(const MeSbResults *me_results, uint32_t pu_index,
+                                           uint8_t list_idx, uint8_t ref_idx) {
+    const uint8_t      total_me_cnt = me_results->total_me_candidate_index[pu_index];
+    const MeCandidate *me_block_results =
+        &me_results->me_candidate_array[pu_index * MAX_PA_ME_CAND];
+
+    for (uint32_t me_cand_i = 0; me_cand_i < total_me_cnt; ++me_cand_i) {
+        const MeCandidate *me_cand = &me_block_results[me_cand_i];
+        if ((me_cand->direction == 0 || me_cand->direction == 2) &&
+            list_idx == me_cand->ref0_list && ref_idx == me_cand->ref_idx_l0)
+            return EB_TRUE;
+        if ((me_cand->direction == 1 || me_cand->direction == 2) &&
+            list_idx == me_cand->ref1_list && ref_idx == me_cand->ref_idx_l1)
+            return EB_TRUE;
+    }
+    return EB_FALSE;
+}
+/******************************************************
+ * SSE of a block against a full-pel displaced block of a padded reference.
+ * The displacement is clamped to the padded area of the reference.
+ ******************************************************/
+static int first_pass_analysis_sse(EbPictureBufferDesc *input_picture_ptr,
+                                   uint32_t input_origin_index, EbPictureBufferDesc *ref_pic_ptr,
+                                   int32_t pos_x, int32_t pos_y, uint32_t blk_width,
+                                   uint32_t blk_height) {
+    pos_x = CLIP3(-(int32_t)ref_pic_ptr->origin_x,
+                  (int32_t)(ref_pic_ptr->width + ref_pic_ptr->origin_x - blk_width),
+                  pos_x);
+    pos_y = CLIP3(-(int32_t)ref_pic_ptr->origin_y,
+                  (int32_t)(ref_pic_ptr->height + ref_pic_ptr->origin_y - blk_height),
+                  pos_y);
+    const uint32_t ref_origin_index = (ref_pic_ptr->origin_y + pos_y) * ref_pic_ptr->stride_y +
+        ref_pic_ptr->origin_x + pos_x;
+    return (int)spatial_full_distortion_kernel(input_picture_ptr->buffer_y,
+                                               input_origin_index,
+                                               input_picture_ptr->stride_y,
+                                               ref_pic_ptr->buffer_y,
+                                               ref_origin_index,
+                                               ref_pic_ptr->stride_y,
+                                               blk_width,
+                                               blk_height);
+}
+/******************************************************
+ * first_pass_analysis_sb
+ * Analysis-only first pass (rc_firstpass_analysis_only): fills the 16x16 first
+ * pass stats of one SB from the picture analysis mean/variance and the open
+ * loop ME results, instead of running the first pass mode decision in EncDec.
+ * The intra error is the SSE of an open loop DC prediction, derived from the
+ * block mean and variance. The inter errors are the SSE at the ME full-pel MV
+ * of the first two LAST references.
+ ******************************************************/
+void first_pass_analysis_sb(PictureParentControlSet *pcs_ptr, uint32_t sb_index,
+                            EbPictureBufferDesc *input_picture_ptr) {
+    SequenceControlSet *scs_ptr   = pcs_ptr->scs_ptr;
+    SbParams *          sb_params = &pcs_ptr->sb_params_array[sb_index];
+    const int           mb_cols   = (scs_ptr->seq_header.max_frame_width + 16 - 1) / 16;
+    const int           mb_rows   = (scs_ptr->seq_header.max_frame_height + 16 - 1) / 16;
+    const int           stride    = input_picture_ptr->stride_y;
+    const uint8_t       num_refs  =
+        pcs_ptr->slice_type == I_SLICE ? 0 : AOMMIN(pcs_ptr->ref_list0_count_try, 2);
+    const MeSbResults *  me_results  = num_refs ? pcs_ptr->pa_me_data->me_results[sb_index] : NULL;
+    EbPictureBufferDesc *ref_pics[2] = {NULL, NULL};
+    for (uint8_t ref_idx = 0; ref_idx < num_refs; ref_idx++)
+        ref_pics[ref_idx] = ((EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[REF_LIST_0][ref_idx]
+                                 ->object_ptr)
+                                ->input_padded_picture_ptr;
+    MV last_mv = kZeroMv;
+
+    for (uint32_t blk_y = 0; blk_y < sb_params->height; blk_y += 16) {
+        for (uint32_t blk_x = 0; blk_x < sb_params->width; blk_x += 16) {
+            const uint32_t mb_origin_x = sb_params->origin_x + blk_x;
+            const uint32_t mb_origin_y = sb_params->origin_y + blk_y;
+            const int      mb_col      = mb_origin_x >> 4;
+            const int      mb_row      = mb_origin_y >> 4;
+            const uint32_t blk_width   = AOMMIN(16, sb_params->width - blk_x);
+            const uint32_t blk_height  = AOMMIN(16, sb_params->height - blk_y);
+            const uint32_t pu_index = ME_TIER_ZERO_PU_16x16_0 + (blk_y >> 4) * 4 + (blk_x >> 4);
+            const uint32_t input_origin_index =
+                (input_picture_ptr->origin_y + mb_origin_y) * stride +
+                input_picture_ptr->origin_x + mb_origin_x;
+            uint8_t *    src      = input_picture_ptr->buffer_y + input_origin_index;
+            FRAME_STATS *mb_stats = &pcs_ptr->firstpass_data.mb_stats[mb_row * mb_cols + mb_col];
+
+            memset(mb_stats, 0, sizeof(*mb_stats));
+            mb_stats->image_data_start_row = INVALID_ROW;
+
+            // Intra: SSE of a flat predictor is N * (variance + (mean - dc)^2)
+            const int dc        = first_pass_analysis_dc_pred(src, stride, mb_row > 0, mb_col > 0);
+            const int mean_diff = (int)pcs_ptr->y_mean[sb_index][pu_index] - dc;
+            int       this_intra_error =
+                (int)((pcs_ptr->variance[sb_index][pu_index] + mean_diff * mean_diff) *
+                      blk_width * blk_height);
+
+            if (this_intra_error < UL_INTRA_THRESH)
+                ++mb_stats->intra_skip_count;
+            else if (mb_col > 0)
+                mb_stats->image_data_start_row = mb_row;
+
+            const double log_intra = log1p((double)this_intra_error);
+            if (log_intra < 10.0)
+                mb_stats->intra_factor += 1.0 + ((10.0 - log_intra) * 0.05);
+            else
+                mb_stats->intra_factor += 1.0;
+            if ((src[0] < DARK_THRESH) && (log_intra < 9.0))
+                mb_stats->brightness_factor += 1.0 + (0.01 * (DARK_THRESH - src[0]));
+            else
+                mb_stats->brightness_factor += 1.0;
+            this_intra_error += INTRA_MODE_PENALTY;
+            for (int r8 = 0; r8 < 2; ++r8)
+                for (int c8 = 0; c8 < 2; ++c8)
+                    mb_stats->frame_avg_wavelet_energy += eb_av1_haar_ac_sad_8x8_uint8_input(
+                        src + c8 * 8 + r8 * 8 * stride, stride, 0);
+            mb_stats->intra_error += this_intra_error;
+
+            if (!num_refs ||
+                !first_pass_analysis_me_valid(me_results, pu_index, REF_LIST_0, 0)) {
+                pcs_ptr->firstpass_data.raw_motion_err_list[mb_row * mb_cols + mb_col] =
+                    num_refs ? first_pass_analysis_sse(input_picture_ptr,
+                                                       input_origin_index,
+                                                       ref_pics[0],
+                                                       mb_origin_x,
+                                                       mb_origin_y,
+                                                       blk_width,
+                                                       blk_height)
+                             : 0;
+                mb_stats->sr_coded_error += this_intra_error;
+                mb_stats->tr_coded_error += this_intra_error;
+                mb_stats->coded_error += this_intra_error;
+                continue;
+            }
+
+            // Inter: SSE at the ME MV of each reference, ME MVs are 1/4 pel
+            int        motion_errors[2];
+            FULLPEL_MV mvs[2];
+            for (uint8_t ref_idx = 0; ref_idx < num_refs; ref_idx++) {
+                if (ref_idx &&
+                    !first_pass_analysis_me_valid(me_results, pu_index, REF_LIST_0, ref_idx)) {
+                    motion_errors[ref_idx] = motion_errors[0];
+                    mvs[ref_idx]           = mvs[0];
+                    continue;
+                }
+                const MvCandidate *me_mv = &me_results->me_mv_array[pu_index * MAX_PA_ME_MV + ref_idx];
+                mvs[ref_idx].col = (me_mv->x_mv + 2) >> 2;
+                mvs[ref_idx].row = (me_mv->y_mv + 2) >> 2;
+                motion_errors[ref_idx] = first_pass_analysis_sse(input_picture_ptr,
+                                                                 input_origin_index,
+                                                                 ref_pics[ref_idx],
+                                                                 mb_origin_x + mvs[ref_idx].col,
+                                                                 mb_origin_y + mvs[ref_idx].row,
+                                                                 blk_width,
+                                                                 blk_height);
+                // No rate estimation at this stage, a new MV only carries the mode penalty
+                if (mvs[ref_idx].col != 0 || mvs[ref_idx].row != 0)
+                    motion_errors[ref_idx] += NEW_MV_MODE_PENALTY;
+            }
+            pcs_ptr->firstpass_data.raw_motion_err_list[mb_row * mb_cols + mb_col] =
+                (mvs[0].col == 0 && mvs[0].row == 0)
+                ? motion_errors[0]
+                : first_pass_analysis_sse(input_picture_ptr,
+                                          input_origin_index,
+                                          ref_pics[0],
+                                          mb_origin_x,
+                                          mb_origin_y,
+                                          blk_width,
+                                          blk_height);
+
+            const int motion_error    = motion_errors[0];
+            const int gf_motion_error = num_refs > 1 ? motion_errors[1] : motion_error;
+            if (gf_motion_error < motion_error && gf_motion_error < this_intra_error)
+                ++mb_stats->second_ref_count;
+            mb_stats->sr_coded_error +=
+                num_refs > 1 ? AOMMIN(gf_motion_error, this_intra_error) : motion_error;
+            // alt_ref_frame is not supported yet
+            mb_stats->tr_coded_error += motion_error;
+
+            int this_inter_error = this_intra_error;
+            if (motion_error <= this_intra_error) {
+                if (((this_intra_error - INTRA_MODE_PENALTY) * 9 <= motion_error * 10) &&
+                    (this_intra_error < (2 * INTRA_MODE_PENALTY))) {
+                    mb_stats->neutral_count += 1.0;
+                } else if ((this_intra_error > NCOUNT_INTRA_THRESH) &&
+                           (this_intra_error < (NCOUNT_INTRA_FACTOR * motion_error))) {
+                    mb_stats->neutral_count +=
+                        (double)motion_error / DOUBLE_DIVIDE_CHECK((double)this_intra_error);
+                }
+                const MV best_mv = get_mv_from_fullmv(&mvs[0]);
+                this_inter_error = motion_error;
+                mb_stats->sum_mvr += best_mv.row;
+                mb_stats->sum_mvr_abs += abs(best_mv.row);
+                mb_stats->sum_mvc += best_mv.col;
+                mb_stats->sum_mvc_abs += abs(best_mv.col);
+                mb_stats->sum_mvrs += best_mv.row * best_mv.row;
+                mb_stats->sum_mvcs += best_mv.col * best_mv.col;
+                ++mb_stats->inter_count;
+                accumulate_mv_stats(
+                    best_mv, mvs[0], mb_row, mb_col, mb_rows, mb_cols, &last_mv, mb_stats);
+            }
+            mb_stats->coded_error += this_inter_error;
+        }
+    }
+}
 /******************************************************
 * Derive Pre-Analysis settings for first pass
 Input   : encoder mode and tune
@@ -331,6 +331,9 @@ extern void svt_av1_end_first_pass(struct PictureParentControlSet *pcs_ptr);
 extern void first_pass_frame_end(struct PictureParentControlSet *pcs_ptr, const int64_t ts_duration);
 extern void setup_firstpass_data(struct PictureParentControlSet *pcs_ptr);
 extern void average_non_16x16_stats(FRAME_STATS *mb_stats, int blk_num);
+struct EbPictureBufferDesc;
+extern void first_pass_analysis_sb(struct PictureParentControlSet *pcs_ptr, uint32_t sb_index,
+                                   struct EbPictureBufferDesc *input_picture_ptr);
 void accumulate_mv_stats(const MV best_mv, const FULLPEL_MV mv,
     const int mb_row, const int mb_col,
     const int mb_rows, const int mb_cols,
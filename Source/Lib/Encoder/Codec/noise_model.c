@@ -16,6 +16,7 @@
 #include "noise_util.h"
 #include "mathutils.h"
 #include "EbLog.h"
+#include "aom_dsp_rtcd.h"
 
 #define kLowPolyNumParams 3
 
@@ -489,43 +490,53 @@ void eb_aom_flat_block_finder_free(AomFlatBlockFinder *block_finder) {
     memset(block_finder, 0, sizeof(*block_finder));
 }
 
+/* Normalizes the 'n' samples of block and removes the low order plane fitted
+   to them, the plane is returned in 'plane' */
+void eb_aom_flat_block_remove_plane_c(double *block, double *plane, const double *A,
+                                      const double *at_a_inv, double normalization, int32_t n) {
+    double plane_coords[kLowPolyNumParams];
+    double at_a_inv__b[kLowPolyNumParams];
+    int32_t i;
+
+    for (i = 0; i < n; ++i) block[i] /= normalization;
+    multiply_mat(block, A, at_a_inv__b, 1, n, kLowPolyNumParams);
+    multiply_mat(at_a_inv, at_a_inv__b, plane_coords, kLowPolyNumParams, kLowPolyNumParams, 1);
+    multiply_mat(A, plane_coords, plane, n, kLowPolyNumParams, 1);
+
+    for (i = 0; i < n; ++i) block[i] -= plane[i];
+}
+
 void eb_aom_flat_block_finder_extract_block(const AomFlatBlockFinder *block_finder,
                                             const uint8_t *const data, int32_t w, int32_t h,
                                             int32_t stride, int32_t offsx, int32_t offsy,
                                             double *plane, double *block) {
     const int32_t block_size = block_finder->block_size;
-    const int32_t n          = block_size * block_size;
-    const double *A          = block_finder->A;
-    const double *at_a_inv   = block_finder->at_a_inv;
-    double        plane_coords[kLowPolyNumParams];
-    double        at_a_inv__b[kLowPolyNumParams];
-    int32_t       xi, yi, i;
+    int32_t       xi, yi;
 
     if (block_finder->use_highbd) {
         const uint16_t *const data16 = (const uint16_t *const)data;
         for (yi = 0; yi < block_size; ++yi) {
             const int32_t y = clamp(offsy + yi, 0, h - 1);
             for (xi = 0; xi < block_size; ++xi) {
-                const int32_t x = clamp(offsx + xi, 0, w - 1);
-                block[yi * block_size + xi] =
-                    ((double)data16[y * stride + x]) / block_finder->normalization;
+                const int32_t x             = clamp(offsx + xi, 0, w - 1);
+                block[yi * block_size + xi] = (double)data16[y * stride + x];
             }
         }
     } else {
         for (yi = 0; yi < block_size; ++yi) {
             const int32_t y = clamp(offsy + yi, 0, h - 1);
             for (xi = 0; xi < block_size; ++xi) {
-                const int32_t x = clamp(offsx + xi, 0, w - 1);
-                block[yi * block_size + xi] =
-                    ((double)data[y * stride + x]) / block_finder->normalization;
+                const int32_t x             = clamp(offsx + xi, 0, w - 1);
+                block[yi * block_size + xi] = (double)data[y * stride + x];
             }
         }
     }
-    multiply_mat(block, A, at_a_inv__b, 1, n, kLowPolyNumParams);
-    multiply_mat(at_a_inv, at_a_inv__b, plane_coords, kLowPolyNumParams, kLowPolyNumParams, 1);
-    multiply_mat(A, plane_coords, plane, n, kLowPolyNumParams, 1);
-
-    for (i = 0; i < n; ++i) block[i] -= plane[i];
+    eb_aom_flat_block_remove_plane(block,
+                                   plane,
+                                   block_finder->A,
+                                   block_finder->at_a_inv,
+                                   block_finder->normalization,
+                                   block_size * block_size);
 }
 
 typedef struct {
@@ -781,6 +792,18 @@ void eb_aom_noise_model_free(AomNoiseModel *model) {
 EXTRACT_AR_ROW(uint8_t, lowbd);
 EXTRACT_AR_ROW(uint16_t, highbd);
 
+/* Adds one observation to the normal equations of the AR model : the outer
+   product of 'buffer' goes to A and 'buffer' scaled by 'val' goes to b.
+   Only the upper triangle of A (j >= i) is updated. */
+void eb_aom_noise_model_add_observation_c(double *A, double *b, const double *buffer, double val,
+                                          int32_t n, double normalization) {
+    const double norm2 = normalization * normalization;
+    for (int32_t i = 0; i < n; ++i) {
+        for (int32_t j = i; j < n; ++j) A[i * n + j] += (buffer[i] * buffer[j]) / norm2;
+        b[i] += (buffer[i] * val) / norm2;
+    }
+}
+
 static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                       const uint8_t *const data, const uint8_t *const denoised,
                                       int32_t w, int32_t h, int32_t stride, int32_t sub_log2[2],
@@ -842,18 +865,15 @@ static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                                    x + x_o,
                                                    y + y_o,
                                                    buffer);
-                    for (int32_t i = 0; i < n; ++i) {
-                        for (int32_t j = 0; j < n; ++j) {
-                            A[i * n + j] +=
-                                (buffer[i] * buffer[j]) / (normalization * normalization);
-                        }
-                        b[i] += (buffer[i] * val) / (normalization * normalization);
-                    }
+                    eb_aom_noise_model_add_observation(A, b, buffer, val, n, normalization);
                     noise_model->latest_state[c].num_observations++;
                 }
             }
         }
     }
+    // Only the upper triangle was accumulated, A is symmetric
+    for (int32_t i = 1; i < n; ++i)
+        for (int32_t j = 0; j < i; ++j) A[i * n + j] = A[j * n + i];
     free(buffer);
     return 1;
 }
@@ -1242,8 +1262,23 @@ int32_t eb_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_model
     return 1;
 }
 
-static void pointwise_multiply(const float *a, float *b, int32_t n) {
-    for (int32_t i = 0; i < n; ++i) b[i] *= a[i];
+/* Converts the block to float and applies the window function */
+void eb_aom_wiener_window_block_c(const double *block_d, const float *window, float *block,
+                                  int32_t n) {
+    for (int32_t i = 0; i < n; ++i) block[i] = (float)block_d[i] * window[i];
+}
+
+/* Adds the filtered block and its plane approximation to the result. The
+   window function is applied to the plane, then to the sum of plane + block. */
+void eb_aom_wiener_accumulate_block_c(const float *block, const double *plane_d,
+                                      const float *window, float *result, int32_t result_stride,
+                                      int32_t block_size) {
+    for (int32_t y = 0; y < block_size; ++y) {
+        for (int32_t x = 0; x < block_size; ++x) {
+            const int32_t i = y * block_size + x;
+            result[y * result_stride + x] += (block[i] + (float)plane_d[i] * window[i]) * window[i];
+        }
+    }
 }
 
 static float *get_half_cos_window(int32_t block_size) {
@@ -1294,25 +1329,65 @@ static float *get_half_cos_window(int32_t block_size) {
 DITHER_AND_QUANTIZE(uint8_t, lowbd);
 DITHER_AND_QUANTIZE(uint16_t, highbd);
 
+int32_t eb_aom_wiener_denoise_rows(const AomWienerPass *pass, int32_t row_start, int32_t row_end) {
+    const int32_t          block_size       = pass->block_finder->block_size;
+    const int32_t          pixels_per_block = block_size * block_size;
+    struct aom_noise_tx_t *tx               = eb_aom_noise_tx_malloc(block_size);
+    DECLARE_ALIGNED(32, float, *block);
+    block           = (float *)eb_aom_memalign(32, 2 * pixels_per_block * sizeof(*block));
+    double *block_d = (double *)malloc(pixels_per_block * sizeof(*block_d));
+    double *plane_d = (double *)malloc(pixels_per_block * sizeof(*plane_d));
+    const int32_t success =
+        (int32_t)((tx != NULL) && (block != NULL) && (block_d != NULL) && (plane_d != NULL));
+
+    for (int32_t row = success ? row_start : row_end; row < row_end; ++row) {
+        // Pad the boundary, the first block row and column start outside the plane
+        float *result_row =
+            pass->result + (row * block_size + pass->offsy) * pass->result_stride + pass->offsx;
+        for (int32_t bx = -1; bx < pass->num_blocks_w; ++bx) {
+            eb_aom_flat_block_finder_extract_block(pass->block_finder,
+                                                   pass->data,
+                                                   pass->w,
+                                                   pass->h,
+                                                   pass->stride,
+                                                   bx * block_size + pass->offsx,
+                                                   (row - 1) * block_size + pass->offsy,
+                                                   plane_d,
+                                                   block_d);
+            eb_aom_wiener_window_block(block_d, pass->window_function, block, pixels_per_block);
+            eb_aom_noise_tx_forward(tx, block);
+            eb_aom_noise_tx_filter(tx, pass->noise_psd);
+            eb_aom_noise_tx_inverse(tx, block);
+            eb_aom_wiener_accumulate_block(block,
+                                           plane_d,
+                                           pass->window_function,
+                                           result_row + (bx + 1) * block_size,
+                                           pass->result_stride,
+                                           block_size);
+        }
+    }
+    eb_aom_free(block);
+    free(plane_d);
+    free(block_d);
+    eb_aom_noise_tx_free(tx);
+    return success;
+}
+
 int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
                                  int32_t h, int32_t stride[3], int32_t chroma_sub[2],
                                  float *noise_psd[3], int32_t block_size, int32_t bit_depth,
-                                 int32_t use_highbd) {
-    float *plane = NULL, *window_full = NULL, *window_chroma = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block                          = NULL;
-    double *               block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full       = NULL;
-    struct aom_noise_tx_t *tx_chroma     = NULL;
-    const int32_t          num_blocks_w  = (w + block_size - 1) / block_size;
-    const int32_t          num_blocks_h  = (h + block_size - 1) / block_size;
-    const int32_t          result_stride = (num_blocks_w + 2) * block_size;
-    const int32_t          result_height = (num_blocks_h + 2) * block_size;
-    float *                result        = NULL;
-    int32_t                init_success  = 1;
-    AomFlatBlockFinder     block_finder_full;
-    AomFlatBlockFinder     block_finder_chroma;
-    const float            k_block_normalization = (float)((1 << bit_depth) - 1);
+                                 int32_t use_highbd, AomWienerPassRunner run_pass,
+                                 void *run_pass_priv) {
+    float *             window_full = NULL, *window_chroma = NULL;
+    const int32_t       num_blocks_w  = (w + block_size - 1) / block_size;
+    const int32_t       num_blocks_h  = (h + block_size - 1) / block_size;
+    const int32_t       result_stride = (num_blocks_w + 2) * block_size;
+    const int32_t       result_height = (num_blocks_h + 2) * block_size;
+    float *             result        = NULL;
+    int32_t             init_success  = 1;
+    AomFlatBlockFinder  block_finder_full;
+    AomFlatBlockFinder  block_finder_chroma;
+    const float         k_block_normalization = (float)((1 << bit_depth) - 1);
     if (chroma_sub[0] != chroma_sub[1]) {
         SVT_ERROR(
             "eb_aom_wiener_denoise_2d doesn't handle different chroma "
@@ -1321,84 +1396,44 @@ int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised
     }
     init_success &=
         eb_aom_flat_block_finder_init(&block_finder_full, block_size, bit_depth, use_highbd);
-    result  = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
-    plane   = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block   = (float *)eb_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d = (double *)malloc(block_size * block_size * sizeof(*plane_d));
+    result = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
     window_full = get_half_cos_window(block_size);
-    tx_full     = eb_aom_noise_tx_malloc(block_size);
 
     if (chroma_sub[0] != 0) {
         init_success &= eb_aom_flat_block_finder_init(
             &block_finder_chroma, block_size >> chroma_sub[0], bit_depth, use_highbd);
         window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma     = eb_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
-    } else {
+    } else
         window_chroma = window_full;
-        tx_chroma     = tx_full;
-    }
 
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) &&
-                              (plane_d != NULL) && (block != NULL) && (block_d != NULL) &&
-                              (window_full != NULL) && (window_chroma != NULL) && (result != NULL));
+    init_success &=
+        (int32_t)((window_full != NULL) && (window_chroma != NULL) && (result != NULL));
     for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
-        float *                window_function = c == 0 ? window_full : window_chroma;
-        AomFlatBlockFinder *   block_finder    = &block_finder_full;
-        const int32_t          chroma_sub_h    = c > 0 ? chroma_sub[1] : 0;
-        const int32_t          chroma_sub_w    = c > 0 ? chroma_sub[0] : 0;
-        struct aom_noise_tx_t *tx              = (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
+        const int32_t chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
+        const int32_t chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
+        AomWienerPass pass;
         if (!data[c] || !denoised[c]) continue;
-        if (c > 0 && chroma_sub[0] != 0) block_finder = &block_finder_chroma;
+        pass.block_finder =
+            (c > 0 && chroma_sub[0] != 0) ? &block_finder_chroma : &block_finder_full;
+        pass.data            = data[c];
+        pass.w               = w >> chroma_sub_w;
+        pass.h               = h >> chroma_sub_h;
+        pass.stride          = stride[c];
+        pass.window_function = c == 0 ? window_full : window_chroma;
+        pass.noise_psd       = noise_psd[c];
+        pass.num_blocks_w    = num_blocks_w;
+        pass.num_rows        = num_blocks_h + 1;
+        pass.result          = result;
+        pass.result_stride   = result_stride;
         memset(result, 0, sizeof(*result) * result_stride * result_height);
-        // Do overlapped block processing (half overlapped). The block rows can
-        // easily be done in parallel
-        for (int32_t offsy = 0; offsy < (block_size >> chroma_sub_h);
-             offsy += (block_size >> chroma_sub_h) / 2) {
-            for (int32_t offsx = 0; offsx < (block_size >> chroma_sub_w);
-                 offsx += (block_size >> chroma_sub_w) / 2) {
-                // Pad the boundary when processing each block-set.
-                for (int32_t by = -1; by < num_blocks_h; ++by) {
-                    for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
-                        const int32_t pixels_per_block =
-                            (block_size >> chroma_sub_w) * (block_size >> chroma_sub_h);
-                        eb_aom_flat_block_finder_extract_block(
-                            block_finder,
-                            data[c],
-                            w >> chroma_sub_w,
-                            h >> chroma_sub_h,
-                            stride[c],
-                            bx * (block_size >> chroma_sub_w) + offsx,
-                            by * (block_size >> chroma_sub_h) + offsy,
-                            plane_d,
-                            block_d);
-                        for (int32_t j = 0; j < pixels_per_block; ++j) {
-                            block[j] = (float)block_d[j];
-                            plane[j] = (float)plane_d[j];
-                        }
-                        pointwise_multiply(window_function, block, pixels_per_block);
-                        eb_aom_noise_tx_forward(tx, block);
-                        eb_aom_noise_tx_filter(tx, noise_psd[c]);
-                        eb_aom_noise_tx_inverse(tx, block);
-
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-                        pointwise_multiply(window_function, plane, pixels_per_block);
-
-                        for (int32_t y = 0; y < (block_size >> chroma_sub_h); ++y) {
-                            const int32_t y_result =
-                                y + (by + 1) * (block_size >> chroma_sub_h) + offsy;
-                            for (int32_t x = 0; x < (block_size >> chroma_sub_w); ++x) {
-                                const int32_t x_result =
-                                    x + (bx + 1) * (block_size >> chroma_sub_w) + offsx;
-                                result[y_result * result_stride + x_result] +=
-                                    (block[y * (block_size >> chroma_sub_w) + x] +
-                                     plane[y * (block_size >> chroma_sub_w) + x]) *
-                                    window_function[y * (block_size >> chroma_sub_w) + x];
-                            }
-                        }
-                    }
-                }
+        // Do overlapped block processing (half overlapped). The block rows of
+        // a pass are independent, the passes add up in order
+        for (pass.offsy = 0; pass.offsy < (block_size >> chroma_sub_h);
+             pass.offsy += (block_size >> chroma_sub_h) / 2) {
+            for (pass.offsx = 0; pass.offsx < (block_size >> chroma_sub_w);
+                 pass.offsx += (block_size >> chroma_sub_w) / 2) {
+                init_success &= run_pass ? run_pass(run_pass_priv, &pass)
+                                         : eb_aom_wiener_denoise_rows(&pass, 0, pass.num_rows);
             }
         }
         if (use_highbd) {
@@ -1426,19 +1461,12 @@ int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised
         }
     }
     free(result);
-    free(plane);
-    eb_aom_free(block);
-    free(plane_d);
-    free(block_d);
     free(window_full);
 
-    eb_aom_noise_tx_free(tx_full);
-
     eb_aom_flat_block_finder_free(&block_finder_full);
     if (chroma_sub[0] != 0) {
         eb_aom_flat_block_finder_free(&block_finder_chroma);
         free(window_chroma);
-        eb_aom_noise_tx_free(tx_chroma);
     }
     return init_success;
 }
@@ -1675,7 +1703,9 @@ int32_t eb_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBu
                                   ctx->noise_psd,
                                   block_size,
                                   ctx->bit_depth,
-                                  use_highbd)) {
+                                  use_highbd,
+                                  ctx->run_wiener_pass,
+                                  ctx->run_wiener_pass_priv)) {
         SVT_ERROR("Unable to denoise image\n");
         return 0;
     }
@@ -199,6 +199,41 @@ typedef enum {
     AOM_NOISE_STATUS_INTERNAL_ERROR,
 } AomNoiseStatus;
 
+/*!\brief One half overlapped pass of the Wiener denoising over a plane.
+     *
+     * Block row 'row' of a pass only adds to the rows
+     * [row * block_size + offsy, (row + 1) * block_size + offsy) of result, so
+     * the block rows of a pass can be denoised by different threads. The passes
+     * of a plane add to the same result and have to run one after the other for
+     * the output to be bit exact.
+     */
+typedef struct AomWienerPass {
+    const AomFlatBlockFinder *block_finder; // block_size is the block size in the plane
+    const uint8_t *           data;
+    int32_t                   w; // Plane width
+    int32_t                   h; // Plane height
+    int32_t                   stride;
+    const float *             window_function;
+    const float *             noise_psd;
+    int32_t                   offsx;
+    int32_t                   offsy;
+    int32_t                   num_blocks_w;
+    int32_t                   num_rows; // Number of block rows, the padding row included
+    float *                   result;
+    int32_t                   result_stride;
+} AomWienerPass;
+
+/*!\brief Denoises the block rows [row_start, row_end) of a Wiener pass.
+     *
+     * Returns 0 on failure.
+     */
+int32_t eb_aom_wiener_denoise_rows(const AomWienerPass *pass, int32_t row_start, int32_t row_end);
+
+/*!\brief Runs all the block rows of a Wiener pass, possibly on several
+     * threads, and returns once they are done. Returns 0 on failure.
+     */
+typedef int32_t (*AomWienerPassRunner)(void *priv, const AomWienerPass *pass);
+
 /************************************
      * DenoiseAndModelInitData
      ************************************/
@@ -238,6 +273,10 @@ typedef struct AomDenoiseAndModel {
 
     AomFlatBlockFinder flat_block_finder;
     AomNoiseModel      noise_model;
+
+    // Runs the Wiener passes of the denoising, in the calling thread when NULL
+    AomWienerPassRunner run_wiener_pass;
+    void *              run_wiener_pass_priv;
 } AomDenoiseAndModel;
 
 /************************************
@@ -311,11 +350,15 @@ int32_t eb_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_model
      * \param[in]     use_highbd      If true, uint8 pointers are interpreted as
      *                                uint16 and stride is measured in uint16.
      *                                This must be true when bit_depth >= 10.
+     * \param[in]     run_pass        Runs the block rows of each pass, they are
+     *                                run in the calling thread when NULL
+     * \param[in]     run_pass_priv   Passed to run_pass
      */
 int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
                                  int32_t h, int32_t stride[3], int32_t chroma_sub_log2[2],
                                  float *noise_psd[3], int32_t block_size, int32_t bit_depth,
-                                 int32_t use_highbd);
+                                 int32_t use_highbd, AomWienerPassRunner run_pass,
+                                 void *run_pass_priv);
 
 struct AomDenoiseAndModel;
 
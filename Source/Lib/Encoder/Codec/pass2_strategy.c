@@ -83,6 +83,18 @@ static int input_stats(TWO_PASS *p, FIRSTPASS_STATS *fps) {
   return 1;
 }
 
+// With streamed stats (lap_enabled) the stats buffer is linear and stats_in
+// always points at its start: the consumed frame is dropped from the head.
+static int input_stats_lap(TWO_PASS *p, FIRSTPASS_STATS *fps) {
+  if (p->stats_in >= p->stats_buf_ctx->stats_in_end) return EOF;
+
+  *fps = *p->stats_in;
+  memmove(p->stats_buf_ctx->stats_in_start, p->stats_buf_ctx->stats_in_start + 1,
+          (p->stats_buf_ctx->stats_in_end - p->stats_in - 1) * sizeof(FIRSTPASS_STATS));
+  p->stats_buf_ctx->stats_in_end--;
+  return 1;
+}
+
 // Read frame stats at an offset from the current position.
 static const FIRSTPASS_STATS *read_frame_stats(const TWO_PASS *p, int offset) {
   if ((offset >= 0 && p->stats_in + offset >= p->stats_buf_ctx->stats_in_end) ||
@@ -2025,7 +2037,7 @@ static void process_first_pass_stats(PictureParentControlSet *pcs_ptr,
 
   int err = 0;
   if (scs_ptr->lap_enabled) {
-    //err = input_stats_lap(twopass, this_frame);
+    err = input_stats_lap(twopass, this_frame);
   } else {
     err = input_stats(twopass, this_frame);
   }
@@ -2272,6 +2284,41 @@ static void av1_new_framerate(SequenceControlSet *scs_ptr, double framerate) {
   av1_rc_update_framerate(scs_ptr/*, scs_ptr->seq_header.max_frame_width, scs_ptr->seq_header.max_frame_height*/);
 }
 
+static void init_two_pass_cfg(SequenceControlSet *scs_ptr) {
+  EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+  FrameInfo *frame_info = &encode_context_ptr->frame_info;
+  const int is_vbr = scs_ptr->static_config.rate_control_mode == 1;
+  frame_info->frame_width  = scs_ptr->seq_header.max_frame_width;
+  frame_info->frame_height = scs_ptr->seq_header.max_frame_height;
+  frame_info->mb_cols = (scs_ptr->seq_header.max_frame_width  + 16 - 1) / 16;
+  frame_info->mb_rows = (scs_ptr->seq_header.max_frame_height + 16 - 1) / 16;
+  frame_info->num_mbs = frame_info->mb_cols * frame_info->mb_rows;
+  frame_info->bit_depth = scs_ptr->static_config.encoder_bit_depth;
+  // input config  from options
+  encode_context_ptr->two_pass_cfg.vbrmin_section = scs_ptr->static_config.vbr_min_section_pct;
+  encode_context_ptr->two_pass_cfg.vbrmax_section = scs_ptr->static_config.vbr_max_section_pct;
+  encode_context_ptr->two_pass_cfg.vbrbias        = scs_ptr->static_config.vbr_bias_pct;
+  encode_context_ptr->rc_cfg.mode = scs_ptr->static_config.rate_control_mode == 1 ? AOM_VBR : AOM_Q;
+  encode_context_ptr->rc_cfg.best_allowed_q  = (int32_t)quantizer_to_qindex[scs_ptr->static_config.min_qp_allowed];
+  encode_context_ptr->rc_cfg.worst_allowed_q = (int32_t)quantizer_to_qindex[scs_ptr->static_config.max_qp_allowed];
+  encode_context_ptr->rc_cfg.over_shoot_pct  = scs_ptr->static_config.over_shoot_pct;
+  encode_context_ptr->rc_cfg.under_shoot_pct = scs_ptr->static_config.under_shoot_pct;
+  encode_context_ptr->rc_cfg.cq_level = quantizer_to_qindex[scs_ptr->static_config.qp];
+  encode_context_ptr->rc_cfg.maximum_buffer_size_ms   = is_vbr ? 240000 : 6000;//cfg->rc_buf_sz;
+  encode_context_ptr->rc_cfg.starting_buffer_level_ms = is_vbr ? 60000  : 4000;//cfg->rc_buf_initial_sz;
+  encode_context_ptr->rc_cfg.optimal_buffer_level_ms  = is_vbr ? 60000  : 5000;//cfg->rc_buf_optimal_sz;
+  encode_context_ptr->gf_cfg.lag_in_frames = 25;//hack scs_ptr->static_config.look_ahead_distance + 1;
+  encode_context_ptr->gf_cfg.gf_min_pyr_height = scs_ptr->static_config.hierarchical_levels;
+  encode_context_ptr->gf_cfg.gf_max_pyr_height = scs_ptr->static_config.hierarchical_levels;
+  encode_context_ptr->gf_cfg.min_gf_interval   = 1 << scs_ptr->static_config.hierarchical_levels;
+  encode_context_ptr->gf_cfg.max_gf_interval   = 1 << scs_ptr->static_config.hierarchical_levels;
+  encode_context_ptr->gf_cfg.enable_auto_arf   = 1;
+  encode_context_ptr->kf_cfg.sframe_dist   = 0; // not supported yet
+  encode_context_ptr->kf_cfg.sframe_mode   = 0; // not supported yet
+  encode_context_ptr->kf_cfg.auto_key      = 0;
+  encode_context_ptr->kf_cfg.key_freq_max  = scs_ptr->intra_period_length + 1;
+}
+
 void svt_av1_init_second_pass(SequenceControlSet *scs_ptr) {
   TWO_PASS *const twopass = &scs_ptr->twopass;
   EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
@@ -2282,38 +2329,7 @@ void svt_av1_init_second_pass(SequenceControlSet *scs_ptr) {
 
   if (!twopass->stats_buf_ctx->stats_in_end) return;
 
-  {
-      const int is_vbr = scs_ptr->static_config.rate_control_mode == 1;
-      frame_info->frame_width  = scs_ptr->seq_header.max_frame_width;
-      frame_info->frame_height = scs_ptr->seq_header.max_frame_height;
-      frame_info->mb_cols = (scs_ptr->seq_header.max_frame_width  + 16 - 1) / 16;
-      frame_info->mb_rows = (scs_ptr->seq_header.max_frame_height + 16 - 1) / 16;
-      frame_info->num_mbs = frame_info->mb_cols * frame_info->mb_rows;
-      frame_info->bit_depth = scs_ptr->static_config.encoder_bit_depth;
-      // input config  from options
-      encode_context_ptr->two_pass_cfg.vbrmin_section = scs_ptr->static_config.vbr_min_section_pct;
-      encode_context_ptr->two_pass_cfg.vbrmax_section = scs_ptr->static_config.vbr_max_section_pct;
-      encode_context_ptr->two_pass_cfg.vbrbias        = scs_ptr->static_config.vbr_bias_pct;
-      encode_context_ptr->rc_cfg.mode = scs_ptr->static_config.rate_control_mode == 1 ? AOM_VBR : AOM_Q;
-      encode_context_ptr->rc_cfg.best_allowed_q  = (int32_t)quantizer_to_qindex[scs_ptr->static_config.min_qp_allowed];
-      encode_context_ptr->rc_cfg.worst_allowed_q = (int32_t)quantizer_to_qindex[scs_ptr->static_config.max_qp_allowed];
-      encode_context_ptr->rc_cfg.over_shoot_pct  = scs_ptr->static_config.over_shoot_pct;
-      encode_context_ptr->rc_cfg.under_shoot_pct = scs_ptr->static_config.under_shoot_pct;
-      encode_context_ptr->rc_cfg.cq_level = quantizer_to_qindex[scs_ptr->static_config.qp];
-      encode_context_ptr->rc_cfg.maximum_buffer_size_ms   = is_vbr ? 240000 : 6000;//cfg->rc_buf_sz;
-      encode_context_ptr->rc_cfg.starting_buffer_level_ms = is_vbr ? 60000  : 4000;//cfg->rc_buf_initial_sz;
-      encode_context_ptr->rc_cfg.optimal_buffer_level_ms  = is_vbr ? 60000  : 5000;//cfg->rc_buf_optimal_sz;
-      encode_context_ptr->gf_cfg.lag_in_frames = 25;//hack scs_ptr->static_config.look_ahead_distance + 1;
-      encode_context_ptr->gf_cfg.gf_min_pyr_height = scs_ptr->static_config.hierarchical_levels;
-      encode_context_ptr->gf_cfg.gf_max_pyr_height = scs_ptr->static_config.hierarchical_levels;
-      encode_context_ptr->gf_cfg.min_gf_interval   = 1 << scs_ptr->static_config.hierarchical_levels;
-      encode_context_ptr->gf_cfg.max_gf_interval   = 1 << scs_ptr->static_config.hierarchical_levels;
-      encode_context_ptr->gf_cfg.enable_auto_arf   = 1;
-      encode_context_ptr->kf_cfg.sframe_dist   = 0; // not supported yet
-      encode_context_ptr->kf_cfg.sframe_mode   = 0; // not supported yet
-      encode_context_ptr->kf_cfg.auto_key      = 0;
-      encode_context_ptr->kf_cfg.key_freq_max  = scs_ptr->intra_period_length + 1;
-  }
+  init_two_pass_cfg(scs_ptr);
 
   stats = twopass->stats_buf_ctx->total_stats;
 
@@ -2369,6 +2385,120 @@ void svt_av1_init_second_pass(SequenceControlSet *scs_ptr) {
   twopass->rolling_arf_group_actual_bits = 1;
 }
 
+// Second pass fed with streamed first pass stats: only a window of future
+// stats is known, so the sequence wide totals used by
+// svt_av1_init_second_pass() are not available.
+void svt_av1_init_single_pass_lap(SequenceControlSet *scs_ptr) {
+  TWO_PASS *const twopass = &scs_ptr->twopass;
+  EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+
+  if (!twopass->stats_buf_ctx->stats_in_end) return;
+
+  init_two_pass_cfg(scs_ptr);
+  av1_new_framerate(scs_ptr, (double)scs_ptr->frame_rate / (1 << 16));
+
+  // This variable monitors how far behind the second ref update is lagging.
+  twopass->sr_update_lag = 1;
+
+  twopass->bits_left = 0;
+  twopass->modified_error_min = 0.0;
+  twopass->modified_error_max = 0.0;
+  twopass->modified_error_left = 0.0;
+
+  // Reset the vbr bits off target counters
+  encode_context_ptr->rc.vbr_bits_off_target = 0;
+  encode_context_ptr->rc.vbr_bits_off_target_fast = 0;
+  encode_context_ptr->rc.rate_error_estimate = 0;
+
+  // Static sequence monitor variables.
+  twopass->kf_zeromotion_pct = 100;
+  twopass->last_kfgroup_zeromotion_pct = 100;
+
+  // Initialize bits per macro_block estimate correction factor.
+  twopass->bpm_factor = 1.0;
+  // Initialize actual and target bits counters for ARF groups so that
+  // at the start we have a neutral bpm adjustment.
+  twopass->rolling_arf_group_target_bits = 1;
+  twopass->rolling_arf_group_actual_bits = 1;
+}
+
+// Grows the stats buffer of the streamed stats. The pointers of the two pass
+// state into the old buffer are re-derived by update_stats_in_pointers()
+// before the stats are read again.
+static EbErrorType grow_stats_in_buffer(EncodeContext *encode_context_ptr, size_t count) {
+  STATS_BUFFER_CTX *const ctx = &encode_context_ptr->stats_buf_context;
+  const size_t used = ctx->stats_in_end - ctx->stats_in_start;
+  const size_t capacity = (used + count) * 3 / 2;
+
+  EB_REALLOC_ARRAY(encode_context_ptr->frame_stats_buffer, capacity);
+  ctx->stats_in_start = encode_context_ptr->frame_stats_buffer;
+  ctx->stats_in_end = ctx->stats_in_start + used;
+  ctx->stats_in_buf_end = ctx->stats_in_start + capacity;
+  return EB_ErrorNone;
+}
+
+// Appends streamed first pass stats behind the ones not consumed yet. A count
+// of 0 marks the end of the first pass stats.
+EbErrorType svt_av1_push_first_pass_stats(EncodeContext *encode_context_ptr,
+                                          const FIRSTPASS_STATS *stats, size_t count) {
+  STATS_BUFFER_CTX *const ctx = &encode_context_ptr->stats_buf_context;
+  EbErrorType return_error = EB_ErrorNone;
+
+  eb_block_on_mutex(encode_context_ptr->stats_in_mutex);
+  if (!count) {
+    encode_context_ptr->stats_in_eos = EB_TRUE;
+  } else {
+    if (ctx->stats_in_end + count > ctx->stats_in_buf_end)
+      return_error = grow_stats_in_buffer(encode_context_ptr, count);
+    if (return_error == EB_ErrorNone) {
+      for (size_t i = 0; i < count; i++) {
+        ctx->stats_in_end[i] = stats[i];
+        svt_av1_accumulate_stats(ctx->total_stats, &stats[i]);
+      }
+      ctx->stats_in_end += count;
+    }
+  }
+  eb_release_mutex(encode_context_ptr->stats_in_mutex);
+  eb_post_semaphore(encode_context_ptr->stats_in_semaphore);
+  return return_error;
+}
+
+// Points the two pass state at the stats buffer, which a push may have
+// reallocated since the previous frame
+static void update_stats_in_pointers(SequenceControlSet *scs_ptr) {
+  EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+  TWO_PASS *const twopass = &scs_ptr->twopass;
+  const int size = get_stats_buf_size(encode_context_ptr->num_lap_buffers, MAX_LAG_BUFFERS);
+
+  if (twopass->frame_stats_arr[0] != encode_context_ptr->frame_stats_buffer) {
+    for (int i = 0; i < size; i++)
+      twopass->frame_stats_arr[i] = &encode_context_ptr->frame_stats_buffer[i];
+  }
+  twopass->stats_in = encode_context_ptr->stats_buf_context.stats_in_start;
+}
+
+// Blocks until the stats of the next frame and of the rc_twopass_stats_window
+// frames after it have been pushed, or the stats ended. The stats buffer stays
+// locked until svt_av1_release_first_pass_stats().
+void svt_av1_wait_first_pass_stats(SequenceControlSet *scs_ptr) {
+  EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+  STATS_BUFFER_CTX *const ctx = &encode_context_ptr->stats_buf_context;
+  const ptrdiff_t window = scs_ptr->static_config.rc_twopass_stats_window;
+
+  for (;;) {
+    eb_block_on_mutex(encode_context_ptr->stats_in_mutex);
+    if (ctx->stats_in_end - ctx->stats_in_start > window || encode_context_ptr->stats_in_eos)
+      break;
+    eb_release_mutex(encode_context_ptr->stats_in_mutex);
+    eb_block_on_semaphore(encode_context_ptr->stats_in_semaphore);
+  }
+  update_stats_in_pointers(scs_ptr);
+}
+
+void svt_av1_release_first_pass_stats(SequenceControlSet *scs_ptr) {
+  eb_release_mutex(scs_ptr->encode_context_ptr->stats_in_mutex);
+}
+
 int frame_is_kf_gf_arf(PictureParentControlSet *ppcs_ptr) {
   SequenceControlSet *scs_ptr = ppcs_ptr->scs_ptr;
   EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
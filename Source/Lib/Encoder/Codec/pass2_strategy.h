@@ -56,7 +56,15 @@ typedef struct {
 
 void svt_av1_init_second_pass(struct SequenceControlSet *scs_ptr);
 
-void av1_init_single_pass_lap(AV1_COMP *cpi);
+void svt_av1_init_single_pass_lap(struct SequenceControlSet *scs_ptr);
+
+struct EncodeContext;
+EbErrorType svt_av1_push_first_pass_stats(struct EncodeContext *encode_context_ptr,
+                                          const FIRSTPASS_STATS *stats, size_t count);
+
+void svt_av1_wait_first_pass_stats(struct SequenceControlSet *scs_ptr);
+
+void svt_av1_release_first_pass_stats(struct SequenceControlSet *scs_ptr);
 
 void svt_av1_get_second_pass_params(struct PictureParentControlSet *pcs_ptr);
 
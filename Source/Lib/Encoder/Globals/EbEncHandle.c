@@ -54,6 +54,8 @@
 #include "EbCdefProcess.h"
 #include "EbDlfProcess.h"
 #include "EbRateControlResults.h"
+#include "pass2_strategy.h"
+#include "EbAnalysisCache.h"
 #ifdef ARCH_X86
 #include <immintrin.h>
 #endif
@@ -364,32 +366,12 @@ int32_t set_parent_pcs(EbSvtAv1EncConfiguration*   config, uint32_t core_count,
         return -1;
     }
 }
-EbErrorType load_default_buffer_configuration_settings(
-    SequenceControlSet       *scs_ptr){
-    EbErrorType           return_error = EB_ErrorNone;
-    unsigned int lp_count   = get_num_processors();
-    unsigned int core_count = lp_count;
-#if defined(_WIN32) || defined(__linux__)
-    if (scs_ptr->static_config.target_socket != -1)
-        core_count /= num_groups;
-#endif
-    if (scs_ptr->static_config.logical_processors != 0)
-        core_count = scs_ptr->static_config.logical_processors < core_count ?
-            scs_ptr->static_config.logical_processors: core_count;
-
-#ifdef _WIN32
-    //Handle special case on Windows
-    //by default, on Windows an application is constrained to a single group
-    if (scs_ptr->static_config.target_socket == -1 &&
-        scs_ptr->static_config.logical_processors == 0)
-        core_count /= num_groups;
-
-    //Affininty can only be set by group on Windows.
-    //Run on both sockets if -lp is larger than logical processor per group.
-    if (scs_ptr->static_config.target_socket == -1 &&
-        scs_ptr->static_config.logical_processors > lp_count / num_groups)
-        core_count = lp_count;
-#endif
+// Pool sizes, segment counts and process counts for core_count cores. With
+// min_pools the pools are kept to the minimum that sustains the flow.
+static EbErrorType set_buffer_configuration(
+    SequenceControlSet       *scs_ptr,
+    uint32_t                  core_count,
+    EbBool                    min_pools){
     int32_t return_ppcs = set_parent_pcs(&scs_ptr->static_config,
         core_count, scs_ptr->input_resolution);
     if (return_ppcs == -1)
@@ -498,9 +480,8 @@ EbErrorType load_default_buffer_configuration_settings(
     scs_ptr->output_recon_buffer_fifo_init_count       = scs_ptr->reference_picture_buffer_init_count;
     scs_ptr->overlay_input_picture_buffer_init_count   = scs_ptr->static_config.enable_overlays ?
                                                                           (2 << scs_ptr->static_config.hierarchical_levels) + SCD_LAD : 1;
-    //Future frames window in Scene Change Detection (SCD) / TemporalFiltering
-    scs_ptr->scd_delay =
-        scs_ptr->static_config.tf_level || scs_ptr->static_config.scene_change_detection ? SCD_LAD : 0;
+    //Future frames window in TemporalFiltering, scene changes are detected by the scene lookahead
+    scs_ptr->scd_delay = scs_ptr->static_config.tf_level ? SCD_LAD : 0;
 
     // bistream buffer will be allocated at run time. app will free the buffer once written to file.
     scs_ptr->output_stream_buffer_fifo_init_count = PICTURE_DECISION_PA_REFERENCE_QUEUE_MAX_DEPTH;
@@ -582,7 +563,7 @@ EbErrorType load_default_buffer_configuration_settings(
         scs_ptr->me_pool_init_count = min_me;
     }
     else {
-        if (core_count == (SINGLE_CORE_COUNT << 1))
+        if (core_count == (SINGLE_CORE_COUNT << 1) || min_pools)
         {
             scs_ptr->input_buffer_fifo_init_count = min_input;
             scs_ptr->picture_control_set_pool_init_count = min_parent;
@@ -606,6 +587,13 @@ EbErrorType load_default_buffer_configuration_settings(
         }
     }
 
+    // Scene lookahead: its pictures only hold an input buffer until they get a parent PCS
+    scs_ptr->scene_lad = scs_ptr->static_config.scene_change_detection &&
+            scs_ptr->static_config.rate_control_mode == 0 ?
+        scs_ptr->static_config.scene_lookahead_distance : 0;
+    if (scs_ptr->scene_lad)
+        scs_ptr->input_buffer_fifo_init_count += scs_ptr->scene_lad + 1;
+
     //#====================== Inter process Fifos ======================
     scs_ptr->resource_coordination_fifo_init_count       = 300;
     scs_ptr->picture_analysis_fifo_init_count            = 300;
@@ -661,6 +649,182 @@ EbErrorType load_default_buffer_configuration_settings(
     }
 
     scs_ptr->total_process_init_count += 6; // single processes count
+
+    // PA segments: one picture is analysed by several PA threads, which is
+    // what keeps them busy when few pictures are in flight (low delay)
+    scs_ptr->pa_segment_row_count =
+        MIN(MIN(me_seg_h, scs_ptr->picture_analysis_process_init_count), PA_SEGMENTS_MAX_COUNT);
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * Memory budget
+ *********************************************************************/
+// Allowances for what the estimate does not count one by one: descriptors,
+// statistics and neighbor arrays of the pictures, per thread contexts other
+// than the mode decision ones, and the tables allocated once
+#define MEM_PICTURE_OVERHEAD (256 << 10)
+#define MEM_THREAD_OVERHEAD  (1 << 20)
+#define MEM_FIXED_OVERHEAD   (16 << 20)
+
+// Size of a padded picture buffer. chroma_x2 is twice the number of samples
+// per luma sample, 2 for a luma only buffer
+static uint64_t picture_buffer_size(uint32_t width, uint32_t height, uint32_t padding,
+    uint32_t chroma_x2, uint32_t sample_bytes) {
+    return (uint64_t)(width + 2 * padding) * (height + 2 * padding) * chroma_x2 / 2 * sample_bytes;
+}
+
+// Estimated footprint of the instance for the current buffer configuration.
+// It counts the picture pools and the mode decision contexts, which hold
+// nearly all of the memory; the measured usage is reported by
+// SVT_AV1_STREAM_INFO_MEMORY_USAGE.
+static uint64_t estimate_memory_footprint(SequenceControlSet *scs_ptr) {
+    static const uint32_t chroma_x2_table[] = {2, 3, 4, 6}; // 400, 420, 422, 444
+    EbSvtAv1EncConfiguration *config = &scs_ptr->static_config;
+    const uint32_t width = scs_ptr->max_input_luma_width;
+    const uint32_t height = scs_ptr->max_input_luma_height;
+    const uint32_t sb_size = config->super_block_size;
+    const uint64_t sb_area = (uint64_t)sb_size * sb_size;
+    const uint64_t sb_count = (uint64_t)((width + sb_size - 1) / sb_size) * ((height + sb_size - 1) / sb_size);
+    const uint64_t b64_count = (uint64_t)((width + 63) / 64) * ((height + 63) / 64);
+    const uint32_t chroma_x2 = chroma_x2_table[config->encoder_color_format];
+    const EbBool is_16bit = (EbBool)(config->encoder_bit_depth > EB_8BIT);
+    const uint32_t sample_bytes = is_16bit ? 2 : 1;
+    // 16 bit references keep an 8 bit copy
+    const uint32_t ref_bytes = (is_16bit || config->is_16bit_pipeline) ? 3 : 1;
+    const uint32_t md_bytes = config->enable_hbd_mode_decision ? 2 : 1;
+    const uint32_t block_count = sb_size == 128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
+
+    // Input pictures, with their 1/4 and 1/16 luma
+    const uint64_t input = picture_buffer_size(width, height, scs_ptr->left_padding, chroma_x2, sample_bytes) +
+        picture_buffer_size(width >> 1, height >> 1, scs_ptr->sb_sz >> 1, 2, 1) +
+        picture_buffer_size(width >> 2, height >> 2, scs_ptr->sb_sz >> 2, 2, 1) +
+        MEM_PICTURE_OVERHEAD;
+    // PA references, the filtered 1/4 luma replaces the decimated one while the
+    // decimated 1/16 luma is kept next to the filtered one
+    const uint32_t ds_count = scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED ? 2 : 1;
+    const uint64_t pa_ref = picture_buffer_size(width, height, scs_ptr->sb_sz + ME_FILTER_TAP, 2, 1) +
+        picture_buffer_size(width >> 1, height >> 1, scs_ptr->sb_sz >> 1, 2, 1) +
+        ds_count * picture_buffer_size(width >> 2, height >> 2, scs_ptr->sb_sz >> 2, 2, 1);
+    const uint64_t ref = picture_buffer_size(width, height, PAD_VALUE, chroma_x2, ref_bytes) +
+        (uint64_t)(width >> 3) * (height >> 3) * sizeof(MV_REF) + MEM_PICTURE_OVERHEAD;
+    // Parent PCS: per 64x64 statistics and open loop results, ME results
+    const uint64_t parent = ((uint64_t)width * height >> 2) + MEM_PICTURE_OVERHEAD;
+    const uint64_t me = b64_count * SQUARE_PU_COUNT *
+        (MAX_PA_ME_MV * sizeof(MvCandidate) + MAX_PA_ME_CAND * sizeof(MeCandidate) + 1);
+    // Child PCS: recon, bitstream, quantized coefficients and blocks of each
+    // SB, neighbor arrays
+    const uint64_t child = picture_buffer_size(width, height, PAD_VALUE, chroma_x2, ref_bytes) +
+        (is_16bit ? picture_buffer_size(width, height, scs_ptr->left_padding, chroma_x2, 2) : 0) +
+        EB_OUTPUTSTREAMBUFFERSIZE_MACRO(width * height) +
+        sb_count * (sb_area * chroma_x2 / 2 * sizeof(int32_t) +
+                    (sb_size == 128 ? 1024 : 256) * sizeof(BlkStruct)) +
+        (uint64_t)(width + height) * 2048 + MEM_PICTURE_OVERHEAD;
+    const uint64_t recon_out = config->recon_enabled ?
+        picture_buffer_size(width, height, 0, chroma_x2, sample_bytes) : 0;
+    // Mode decision context of an EncDec thread: the candidate buffers (luma
+    // and chroma, then chroma only), the NSQ blocks and their scratch buffers
+    const uint64_t md_context =
+        MAX_NFL_BUFF_Y * sb_area * 3 / 2 * (md_bytes + sizeof(int32_t)) +
+        (MAX_NFL_BUFF - MAX_NFL_BUFF_Y) * sb_area / 2 * (md_bytes + sizeof(int32_t)) +
+        (uint64_t)block_count * sizeof(BlkStruct) * 2 +
+        sb_area * 3 / 2 * (sizeof(int32_t) + 2 * md_bytes) * 8;
+
+    return MEM_FIXED_OVERHEAD +
+        scs_ptr->input_buffer_fifo_init_count * input +
+        (config->enable_overlays ? scs_ptr->overlay_input_picture_buffer_init_count * input : 0) +
+        scs_ptr->pa_reference_picture_buffer_init_count * pa_ref +
+        scs_ptr->reference_picture_buffer_init_count * ref +
+        scs_ptr->picture_control_set_pool_init_count * parent +
+        scs_ptr->me_pool_init_count * me +
+        scs_ptr->picture_control_set_pool_init_count_child * child +
+        scs_ptr->output_recon_buffer_fifo_init_count * recon_out +
+        scs_ptr->enc_dec_process_init_count * md_context +
+        scs_ptr->total_process_init_count * MEM_THREAD_OVERHEAD;
+}
+
+// Scales down the buffer configuration until its estimated footprint fits in
+// memory_budget_mb: pools to their minimum first, then the scene lookahead,
+// the number of threads and segments, and last the look ahead distance
+static EbErrorType fit_memory_budget(SequenceControlSet *scs_ptr, uint32_t core_count) {
+    EbSvtAv1EncConfiguration *config = &scs_ptr->static_config;
+    const uint64_t budget = (uint64_t)config->memory_budget_mb << 20;
+    const uint32_t mg_size = 1 << config->hierarchical_levels;
+    const uint32_t full_core_count = core_count;
+    const uint32_t full_lad = config->look_ahead_distance;
+    const uint64_t full_estimate = scs_ptr->memory_estimate;
+    EbBool min_pools = EB_FALSE;
+
+    while (scs_ptr->memory_estimate > budget) {
+        if (!min_pools)
+            min_pools = EB_TRUE;
+        else if (config->scene_lookahead_distance) {
+            // Scene change detection is only done by the scene lookahead
+            config->scene_lookahead_distance = 0;
+            config->scene_change_detection   = 0;
+        }
+        else if (core_count > SINGLE_CORE_COUNT)
+            core_count >>= 1;
+        // Other rate control modes need the look ahead to cover the intra period,
+        // and TPL runs with its own look ahead distance or none
+        else if (config->look_ahead_distance && config->rate_control_mode == 0)
+            config->look_ahead_distance =
+                (config->enable_tpl_la || config->look_ahead_distance <= mg_size) ? 0 :
+                config->look_ahead_distance - mg_size;
+        else {
+            SVT_ERROR("The encoder needs about %u MB, more than the memory budget of %u MB\n",
+                (uint32_t)((scs_ptr->memory_estimate + (1 << 20) - 1) >> 20), config->memory_budget_mb);
+            return EB_ErrorInsufficientResources;
+        }
+        EbErrorType return_error = set_buffer_configuration(scs_ptr, core_count, min_pools);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        scs_ptr->memory_estimate = estimate_memory_footprint(scs_ptr);
+    }
+    if (scs_ptr->memory_estimate != full_estimate)
+        SVT_WARN("Memory budget of %u MB: estimate reduced from %u MB to %u MB, cores %u -> %u, "
+            "look ahead distance %u -> %u\n",
+            config->memory_budget_mb, (uint32_t)(full_estimate >> 20),
+            (uint32_t)(scs_ptr->memory_estimate >> 20),
+            full_core_count, core_count, full_lad, config->look_ahead_distance);
+    return EB_ErrorNone;
+}
+
+EbErrorType load_default_buffer_configuration_settings(
+    SequenceControlSet       *scs_ptr){
+    EbErrorType           return_error = EB_ErrorNone;
+    unsigned int lp_count   = get_num_processors();
+    unsigned int core_count = lp_count;
+#if defined(_WIN32) || defined(__linux__)
+    if (scs_ptr->static_config.target_socket != -1)
+        core_count /= num_groups;
+#endif
+    if (scs_ptr->static_config.logical_processors != 0)
+        core_count = scs_ptr->static_config.logical_processors < core_count ?
+            scs_ptr->static_config.logical_processors: core_count;
+
+#ifdef _WIN32
+    //Handle special case on Windows
+    //by default, on Windows an application is constrained to a single group
+    if (scs_ptr->static_config.target_socket == -1 &&
+        scs_ptr->static_config.logical_processors == 0)
+        core_count /= num_groups;
+
+    //Affininty can only be set by group on Windows.
+    //Run on both sockets if -lp is larger than logical processor per group.
+    if (scs_ptr->static_config.target_socket == -1 &&
+        scs_ptr->static_config.logical_processors > lp_count / num_groups)
+        core_count = lp_count;
+#endif
+    return_error = set_buffer_configuration(scs_ptr, core_count, EB_FALSE);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    scs_ptr->memory_estimate = estimate_memory_footprint(scs_ptr);
+    if (scs_ptr->static_config.memory_budget_mb) {
+        return_error = fit_memory_budget(scs_ptr, core_count);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
     SVT_LOG("Number of logical cores available: %u\nNumber of PPCS %u\n", core_count, scs_ptr->picture_control_set_pool_init_count);
 
     /******************************************************************
@@ -811,6 +975,7 @@ static void eb_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 static void eb_enc_handle_dctor(EbPtr p)
 {
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&enc_handle_ptr->memory_counter);
 
     eb_enc_handle_stop_threads(enc_handle_ptr);
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -844,6 +1009,7 @@ static void eb_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->rest_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->entropy_coding_results_resource_ptr);
 
+    SvtAv1MemoryComponent prev_component = eb_memory_component_set(SVT_AV1_MEMORY_CONTEXTS);
     EB_DELETE(enc_handle_ptr->resource_coordination_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->motion_estimation_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->motion_estimation_process_init_count);
@@ -857,24 +1023,24 @@ static void eb_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->cdef_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->rest_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->entropy_coding_process_init_count);
-    EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->picture_decision_context_ptr);
     EB_DELETE(enc_handle_ptr->initial_rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->picture_manager_context_ptr);
     EB_DELETE(enc_handle_ptr->rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->packetization_context_ptr);
+    eb_memory_component_set(prev_component);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-
+    eb_memory_counter_attach(prev_counter);
 }
 
 /**********************************
 * Encoder Library Handle Constructor
 **********************************/
-static EbErrorType eb_enc_handle_ctor(
+static EbErrorType enc_handle_init(
     EbEncHandle *enc_handle_ptr,
     EbComponentType * ebHandlePtr)
 {
-    enc_handle_ptr->dctor = eb_enc_handle_dctor;
 
     init_thread_management_params();
 
@@ -895,6 +1061,19 @@ static EbErrorType eb_enc_handle_ctor(
     return EB_ErrorNone;
 }
 
+static EbErrorType eb_enc_handle_ctor(
+    EbEncHandle *enc_handle_ptr,
+    EbComponentType * ebHandlePtr)
+{
+    enc_handle_ptr->dctor = eb_enc_handle_dctor;
+
+    // Everything the instance allocates from here on is charged to it
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&enc_handle_ptr->memory_counter);
+    EbErrorType return_error = enc_handle_init(enc_handle_ptr, ebHandlePtr);
+    eb_memory_counter_attach(prev_counter);
+    return return_error;
+}
+
 EbErrorType eb_input_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr  object_init_data_ptr);
@@ -1152,14 +1331,8 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
 
 void init_fn_ptr(void);
 void eb_av1_init_wedge_masks(void);
-/**********************************
-* Initialize Encoder Library
-**********************************/
-EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+static EbErrorType enc_init(EbEncHandle *enc_handle_ptr)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbErrorType return_error = EB_ErrorNone;
     uint32_t instance_index;
     uint32_t process_index;
@@ -1751,9 +1924,36 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->recon_output_fifo_ptr  = eb_system_resource_get_producer_fifo(enc_handle_ptr->output_recon_buffer_resource_ptr_array[instance_index], 0);
     }
 
+    /************************************
+    * First pass stats buffer
+    ************************************/
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        // The streamed stats are looked ahead over the window, so it sizes the buffer
+        return_error = encode_context_create_stats_buffer(
+            enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr,
+            (int)enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.rc_twopass_stats_window);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
+    /************************************
+    * Analysis cache
+    ************************************/
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        SequenceControlSet *scs_ptr = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr;
+        if (scs_ptr->static_config.analysis_cache_mode != ANALYSIS_CACHE_OFF)
+            EB_NEW(
+                enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->analysis_cache,
+                analysis_cache_ctor,
+                scs_ptr,
+                scs_ptr->static_config.analysis_cache_path,
+                (AnalysisCacheMode)scs_ptr->static_config.analysis_cache_mode);
+    }
+
     /************************************
     * Contexts
     ************************************/
+    eb_memory_component_set(SVT_AV1_MEMORY_CONTEXTS);
 
     // Resource Coordination Context
     EB_NEW(
@@ -1931,6 +2131,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         rate_control_port_lookup(RATE_CONTROL_INPUT_PORT_PACKETIZATION, 0),
         enc_handle_ptr->scs_instance_array[0]->scs_ptr->source_based_operations_process_init_count +
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count);
+    eb_memory_component_set(SVT_AV1_MEMORY_OTHER);
 
     /************************************
     * Thread Handles
@@ -2018,6 +2219,23 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     return return_error;
 }
 
+/**********************************
+* Initialize Encoder Library
+**********************************/
+EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    // The threads created here inherit the memory counter
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&enc_handle_ptr->memory_counter);
+    SvtAv1MemoryComponent prev_component = eb_memory_component_set(SVT_AV1_MEMORY_OTHER);
+    EbErrorType return_error = enc_init(enc_handle_ptr);
+    eb_memory_component_set(prev_component);
+    eb_memory_counter_attach(prev_counter);
+    return return_error;
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -2318,7 +2536,11 @@ void copy_api_from_app(
     scs_ptr->max_temporal_layers = scs_ptr->static_config.hierarchical_levels;
     scs_ptr->static_config.use_qp_file = ((EbSvtAv1EncConfiguration*)config_struct)->use_qp_file;
     scs_ptr->static_config.rc_twopass_stats_in = ((EbSvtAv1EncConfiguration*)config_struct)->rc_twopass_stats_in;
+    scs_ptr->static_config.rc_twopass_stats_window = ((EbSvtAv1EncConfiguration*)config_struct)->rc_twopass_stats_window;
     scs_ptr->static_config.rc_firstpass_stats_out = ((EbSvtAv1EncConfiguration*)config_struct)->rc_firstpass_stats_out;
+    scs_ptr->static_config.rc_firstpass_analysis_only = ((EbSvtAv1EncConfiguration*)config_struct)->rc_firstpass_analysis_only;
+    scs_ptr->static_config.analysis_cache_path = ((EbSvtAv1EncConfiguration*)config_struct)->analysis_cache_path;
+    scs_ptr->static_config.analysis_cache_mode = ((EbSvtAv1EncConfiguration*)config_struct)->analysis_cache_mode;
     // Deblock Filter
     scs_ptr->static_config.disable_dlf_flag = ((EbSvtAv1EncConfiguration*)config_struct)->disable_dlf_flag;
 
@@ -2342,6 +2564,7 @@ void copy_api_from_app(
     scs_ptr->static_config.enable_redundant_blk         = ((EbSvtAv1EncConfiguration*)config_struct)->enable_redundant_blk;
     // spatial sse in full loop
     scs_ptr->static_config.spatial_sse_full_loop_level  = ((EbSvtAv1EncConfiguration*)config_struct)->spatial_sse_full_loop_level;
+    scs_ptr->static_config.enable_md_pred_cache         = ((EbSvtAv1EncConfiguration*)config_struct)->enable_md_pred_cache;
     // over boundry block mode
     scs_ptr->static_config.over_bndry_blk               = ((EbSvtAv1EncConfiguration*)config_struct)->over_bndry_blk;
     // new nearest comb injection
@@ -2431,6 +2654,7 @@ void copy_api_from_app(
     scs_ptr->static_config.scene_change_detection = ((EbSvtAv1EncConfiguration*)config_struct)->scene_change_detection;
     scs_ptr->static_config.rate_control_mode = ((EbSvtAv1EncConfiguration*)config_struct)->rate_control_mode;
     scs_ptr->static_config.look_ahead_distance = ((EbSvtAv1EncConfiguration*)config_struct)->look_ahead_distance;
+    scs_ptr->static_config.scene_lookahead_distance = ((EbSvtAv1EncConfiguration*)config_struct)->scene_lookahead_distance;
     scs_ptr->static_config.frame_rate = ((EbSvtAv1EncConfiguration*)config_struct)->frame_rate;
     scs_ptr->static_config.frame_rate_denominator = ((EbSvtAv1EncConfiguration*)config_struct)->frame_rate_denominator;
     scs_ptr->static_config.frame_rate_numerator = ((EbSvtAv1EncConfiguration*)config_struct)->frame_rate_numerator;
@@ -2499,6 +2723,7 @@ void copy_api_from_app(
         SVT_WARN("unpin 1 and ss %d is not a valid combination: unpin will be set to 0\n", scs_ptr->static_config.target_socket);
         scs_ptr->static_config.unpin = 0;
     }
+    scs_ptr->static_config.memory_budget_mb = ((EbSvtAv1EncConfiguration*)config_struct)->memory_budget_mb;
     scs_ptr->static_config.qp = ((EbSvtAv1EncConfiguration*)config_struct)->qp;
     scs_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)config_struct)->recon_enabled;
     scs_ptr->static_config.enable_tpl_la = ((EbSvtAv1EncConfiguration*)config_struct)->enable_tpl_la;
@@ -2778,6 +3003,12 @@ static EbErrorType verify_settings(
 
         return_error = EB_ErrorBadParameter;
     }
+    if (config->scene_lookahead_distance > MAX_SCENE_LAD) {
+        SVT_LOG("Error Instance %u: The scene lookahead distance must be [0 - %d] \n", channel_number + 1, MAX_SCENE_LAD);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->scene_lookahead_distance && !config->scene_change_detection)
+        SVT_LOG("SVT [Warning]: Instance %u: The scene lookahead is only used with scene change detection, ignored\n", channel_number + 1);
     if ((unsigned)config->tile_rows > 6 || (unsigned)config->tile_columns > 6) {
         SVT_LOG("Error Instance %u: Log2Tile rows/cols must be [0 - 6] \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
@@ -2791,8 +3022,17 @@ static EbErrorType verify_settings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->scene_change_detection) {
-        SVT_LOG("Error Instance %u: Scene change detection is currently not supported\n", channel_number + 1);
+    // Scene changes are only detected by the scene lookahead, the detection in picture decision is not supported
+    if (config->scene_change_detection > 1) {
+        SVT_LOG("Error Instance %u: Invalid SceneChangeDetection flag [0 - 1], your input: %u\n", channel_number + 1, config->scene_change_detection);
+        return_error = EB_ErrorBadParameter;
+    }
+    else if (config->scene_change_detection && !config->scene_lookahead_distance) {
+        SVT_LOG("Error Instance %u: Scene change detection requires a scene lookahead distance\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    else if (config->scene_change_detection && config->rate_control_mode) {
+        SVT_LOG("Error Instance %u: Scene change detection is only supported with CQP\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
     if (config->max_qp_allowed > MAX_QP_VALUE) {
@@ -3038,6 +3278,12 @@ static EbErrorType verify_settings(
         SVT_LOG("Error instance %u: Invalid spatial_sse_fl flag [0/1 or -1 for auto], your input: %d\n", channel_number + 1, config->spatial_sse_full_loop_level);
         return_error = EB_ErrorBadParameter;
     }
+
+    if (config->enable_md_pred_cache != 0 && config->enable_md_pred_cache != 1 && config->enable_md_pred_cache != -1) {
+        SVT_LOG("Error instance %u: Invalid enable_md_pred_cache flag [0/1 or -1 for auto], your input: %d\n", channel_number + 1, config->enable_md_pred_cache);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->over_bndry_blk != 0 && config->over_bndry_blk != 1 && config->over_bndry_blk != -1) {
       SVT_LOG("Error instance %u: Invalid over_bndry_blk flag [0/1 or -1 for auto], your input: %d\n", channel_number + 1, config->over_bndry_blk);
       return_error = EB_ErrorBadParameter;
@@ -3106,7 +3352,7 @@ static EbErrorType verify_settings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->superres_mode > 0 && ((config->rc_twopass_stats_in.sz || config->rc_firstpass_stats_out))){
+    if (config->superres_mode > 0 && ((config->rc_twopass_stats_in.sz || config->rc_twopass_stats_window || config->rc_firstpass_stats_out))){
         SVT_LOG("Error instance %u: superres is not supported for 2-pass\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
@@ -3126,7 +3372,32 @@ static EbErrorType verify_settings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->rc_twopass_stats_in.sz || config->rc_firstpass_stats_out) {
+    if (config->rc_twopass_stats_window && (config->rc_twopass_stats_in.sz || config->rc_firstpass_stats_out)) {
+        SVT_LOG("Error instance %u: rc_twopass_stats_window can not be combined with rc_twopass_stats_in or rc_firstpass_stats_out\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rc_twopass_stats_window > MAX_LAP_BUFFERS) {
+        SVT_LOG("Error instance %u: invalid rc_twopass_stats_window %u, should be in the range [%d - %d] \n", channel_number + 1, config->rc_twopass_stats_window, 0, MAX_LAP_BUFFERS);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rc_firstpass_analysis_only && !config->rc_firstpass_stats_out) {
+        SVT_LOG("Error instance %u: rc_firstpass_analysis_only requires rc_firstpass_stats_out\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->analysis_cache_mode > 2) {
+        SVT_LOG("Error instance %u: Invalid analysis_cache_mode [0 - 2], your input: %d\n", channel_number + 1, config->analysis_cache_mode);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->analysis_cache_mode && config->analysis_cache_path == NULL) {
+        SVT_LOG("Error instance %u: analysis_cache_mode requires analysis_cache_path\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rc_twopass_stats_in.sz || config->rc_twopass_stats_window || config->rc_firstpass_stats_out) {
         SVT_WARN("The 2-pass encoding support is a work-in-progress, it is only available for experimental and further development uses and should not be used for benchmarking until fully implemented.\n");
     }
     return return_error;
@@ -3159,9 +3430,14 @@ EbErrorType eb_svt_enc_init_parameter(
 
     config_ptr->qp = 50;
     config_ptr->use_qp_file = EB_FALSE;
+    config_ptr->rc_twopass_stats_window = 0;
+    config_ptr->rc_firstpass_analysis_only = EB_FALSE;
+    config_ptr->analysis_cache_path = NULL;
+    config_ptr->analysis_cache_mode = 0;
     config_ptr->scene_change_detection = 0;
     config_ptr->rate_control_mode = 0;
     config_ptr->look_ahead_distance = (uint32_t)~0;
+    config_ptr->scene_lookahead_distance = 0;
     config_ptr->enable_tpl_la = 1;
     config_ptr->target_bit_rate = 7000000;
     config_ptr->max_qp_allowed = 63;
@@ -3185,6 +3461,7 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->enable_mfmv = DEFAULT;
     config_ptr->enable_redundant_blk = DEFAULT;
     config_ptr->spatial_sse_full_loop_level = DEFAULT;
+    config_ptr->enable_md_pred_cache = DEFAULT;
     config_ptr->over_bndry_blk = DEFAULT;
     config_ptr->new_nearest_comb_inject = DEFAULT;
     config_ptr->nsq_table = DEFAULT;
@@ -3260,6 +3537,7 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->logical_processors = 0;
     config_ptr->unpin = 1;
     config_ptr->target_socket = -1;
+    config_ptr->memory_budget_mb = 0;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
 
@@ -3308,7 +3586,9 @@ static void print_lib_params(
         else
             SVT_LOG("Level %.1f\t", (float)(config->level / 10));
     }
-    if (config->rc_firstpass_stats_out)
+    if (config->rc_firstpass_analysis_only)
+        SVT_LOG("\nSVT [config]: Preset \t\t\t\t\t\t\t\t: Pass 1 (analysis only) ");
+    else if (config->rc_firstpass_stats_out)
         SVT_LOG("\nSVT [config]: Preset \t\t\t\t\t\t\t\t: Pass 1 ");
     else
         SVT_LOG("\nSVT [config]: Preset \t\t\t\t\t\t\t: %d ", config->enc_mode);
@@ -3373,14 +3653,10 @@ static void print_lib_params(
 
 * Set Parameter
 **********************************/
-EB_API EbErrorType svt_av1_enc_set_parameter(
-    EbComponentType              *svt_enc_component,
+static EbErrorType set_parameter(
+    EbEncHandle                  *enc_handle,
     EbSvtAv1EncConfiguration     *config_struct)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-
-    EbEncHandle        *enc_handle  = (EbEncHandle*)svt_enc_component->p_component_private;
     uint32_t              instance_index = 0;
 
     // Acquire Config Mutex
@@ -3429,6 +3705,19 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
 
     return return_error;
 }
+EB_API EbErrorType svt_av1_enc_set_parameter(
+    EbComponentType              *svt_enc_component,
+    EbSvtAv1EncConfiguration     *config_struct)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&enc_handle->memory_counter);
+    EbErrorType return_error = set_parameter(enc_handle, config_struct);
+    eb_memory_counter_attach(prev_counter);
+    return return_error;
+}
 EB_API EbErrorType svt_av1_enc_stream_header(
     EbComponentType           *svt_enc_component,
     EbBufferHeaderType        **output_stream_ptr)
@@ -4070,6 +4359,56 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_STREAM) {
+        EncodeContext*      context = enc_handle->scs_instance_array[0]->encode_context_ptr;
+        FirstPassStatsOut*  stats_out = &context->stats_out;
+        SvtAv1FixedBuf*     first_pass_stats = (SvtAv1FixedBuf*)info;
+        FIRSTPASS_STATS*    dst = (FIRSTPASS_STATS*)first_pass_stats->buf;
+        const size_t        max_count = first_pass_stats->sz / sizeof(FIRSTPASS_STATS);
+        size_t              count = 0;
+        if (!dst && max_count)
+            return EB_ErrorBadParameter;
+        eb_block_on_mutex(context->stat_file_mutex);
+        // Frames finish out of order, only hand out the contiguous run of finished ones
+        while (count < max_count && stats_out->streamed < stats_out->size &&
+               stats_out->ready[stats_out->streamed])
+            dst[count++] = stats_out->stat[stats_out->streamed++];
+        eb_release_mutex(context->stat_file_mutex);
+        first_pass_stats->sz = count * sizeof(FIRSTPASS_STATS);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_MEMORY_USAGE) {
+        SequenceControlSet* scs_ptr = enc_handle->scs_instance_array[0]->scs_ptr;
+        SvtAv1MemoryUsage*  usage = (SvtAv1MemoryUsage*)info;
+        if (!usage)
+            return EB_ErrorBadParameter;
+        eb_memory_counter_get_usage(&enc_handle->memory_counter, usage);
+        usage->budget = (uint64_t)scs_ptr->static_config.memory_budget_mb << 20;
+        usage->estimate = scs_ptr->memory_estimate;
+        return EB_ErrorNone;
+    }
     return EB_ErrorBadParameter;
 }
+
+/**********************************
+* svt_av1_enc_push_first_pass_stats feeds streamed first pass stats to the encoder
+**********************************/
+EB_API EbErrorType svt_av1_enc_push_first_pass_stats(EbComponentType *     svt_enc_component,
+                                                     const SvtAv1FixedBuf *stats)
+{
+    if (svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    SequenceControlSet *scs_ptr = enc_handle->scs_instance_array[0]->scs_ptr;
+    if (!scs_ptr->static_config.rc_twopass_stats_window)
+        return EB_ErrorBadParameter;
+    if (stats && stats->sz % sizeof(FIRSTPASS_STATS))
+        return EB_ErrorBadParameter;
+    const size_t count = (stats && stats->buf) ? stats->sz / sizeof(FIRSTPASS_STATS) : 0;
+    EbMemoryCounter *prev_counter = eb_memory_counter_attach(&enc_handle->memory_counter);
+    EbErrorType return_error = svt_av1_push_first_pass_stats(
+        scs_ptr->encode_context_ptr, (const FIRSTPASS_STATS*)(count ? stats->buf : NULL), count);
+    eb_memory_counter_attach(prev_counter);
+    return return_error;
+}
 // clang-format on
@@ -18,6 +18,7 @@
 #include "EbSystemResourceManager.h"
 #include "EbSequenceControlSet.h"
 #include "EbObject.h"
+#include "EbMalloc.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -132,6 +133,9 @@ struct _EbEncHandle {
     EbFifo *input_buffer_producer_fifo_ptr;
     EbFifo *output_stream_buffer_consumer_fifo_ptr;
     EbFifo *output_recon_buffer_consumer_fifo_ptr;
+
+    // Memory allocated by the instance and its threads
+    EbMemoryCounter memory_counter;
 };
 
 #endif // EbEncHandle_h
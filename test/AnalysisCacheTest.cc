@@ -0,0 +1,396 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file AnalysisCacheTest.cc
+ *
+ * @brief Unit test for the analysis cache:
+ * - analysis_cache_store_picture
+ * - analysis_cache_load_segment
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbAnalysisCache.h"
+#include "EbMotionEstimationLcuResults.h"
+#include "random.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+static const uint32_t pic_width = 200;
+static const uint32_t pic_height = 136;
+static const uint32_t sb_size = 64;
+static const uint32_t pic_width_in_sb = (pic_width + sb_size - 1) / sb_size;
+static const uint32_t pic_height_in_sb = (pic_height + sb_size - 1) / sb_size;
+static const uint32_t sb_count = pic_width_in_sb * pic_height_in_sb;
+static const uint32_t mb_count =
+    ((pic_width + 15) / 16) * ((pic_height + 15) / 16);
+static const uint32_t picture_count = 3;
+// Written as the ME distortion of the first SB of every picture, to find
+// the SB payloads in the file
+static const uint32_t sb_marker = 0xA5C3E1F7;
+
+/** The analysis results of one picture, as ME and OIS leave them */
+class AnalysisPicture {
+  public:
+    AnalysisPicture(SequenceControlSet *scs, uint64_t picture_number) {
+        memset(&pcs_, 0, sizeof(pcs_));
+        pcs_.scs_ptr = scs;
+        pcs_.picture_number = picture_number;
+        pcs_.aligned_width = pic_width;
+        pcs_.aligned_height = pic_height;
+        pcs_.max_number_of_pus_per_sb = SQUARE_PU_COUNT;
+        pcs_.slice_type = picture_number ? B_SLICE : I_SLICE;
+        pcs_.ref_list0_count_try = 2;
+        pcs_.ref_list1_count_try = 1;
+        pcs_.pa_me_data = &me_data_;
+        pcs_.rc_me_distortion = distortion_;
+        pcs_.ois_mb_results = ois_ptr_;
+
+        me_data_.me_results = sb_ptr_;
+        for (uint32_t sb = 0; sb < sb_count; sb++) {
+            MeSbResults *res = &sb_[sb];
+            memset(res, 0, sizeof(*res));
+            res->total_me_candidate_index = count_[sb];
+            res->me_mv_array = mv_[sb];
+            res->me_candidate_array = cand_[sb];
+            sb_ptr_[sb] = res;
+        }
+        for (uint32_t mb = 0; mb < mb_count; mb++)
+            ois_ptr_[mb] = &ois_[mb];
+        memset(distortion_, 0, sizeof(distortion_));
+        memset(count_, 0, sizeof(count_));
+        memset(mv_, 0, sizeof(mv_));
+        memset(cand_, 0, sizeof(cand_));
+        memset(ois_, 0, sizeof(ois_));
+    }
+
+    /** Fill random results that only refer to the searched references */
+    void fill_random(SVTRandom &rnd) {
+        const uint32_t mv_count[2] = {pcs_.ref_list0_count_try,
+                                      pcs_.ref_list1_count_try};
+        for (uint32_t sb = 0; sb < sb_count; sb++) {
+            distortion_[sb] = sb ? rnd.random() : sb_marker;
+            for (uint32_t i = 0; i < sizeof(sb_[sb].do_comp); i++)
+                (&sb_[sb].do_comp[0][0])[i] = rnd.random() & 1;
+            for (uint32_t pu = 0; pu < SQUARE_PU_COUNT; pu++) {
+                count_[sb][pu] = rnd.random() % (MAX_PA_ME_CAND + 1);
+                for (uint32_t i = 0; i < count_[sb][pu]; i++) {
+                    MeCandidate *cand = &cand_[sb][pu * MAX_PA_ME_CAND + i];
+                    cand->direction = rnd.random() % 3;
+                    cand->ref0_list = 0;
+                    cand->ref1_list = 1;
+                    cand->ref_idx_l0 = rnd.random() % mv_count[0];
+                    cand->ref_idx_l1 = rnd.random() % mv_count[1];
+                }
+                for (uint32_t i = 0; i < MAX_PA_ME_MV; i++) {
+                    // Only the MVs of the searched references are stored
+                    if ((i < 4 && i >= mv_count[0]) ||
+                        (i >= 4 && i - 4 >= mv_count[1]))
+                        continue;
+                    mv_[sb][pu * MAX_PA_ME_MV + i].x_mv = rnd.random();
+                    mv_[sb][pu * MAX_PA_ME_MV + i].y_mv = rnd.random();
+                }
+            }
+        }
+        for (uint32_t mb = 0; mb < mb_count; mb++) {
+            ois_[mb].intra_cost = rnd.random();
+            ois_[mb].intra_mode = rnd.random() % 13;
+        }
+        for (uint32_t li = 0; li < MAX_NUM_OF_REF_PIC_LIST; li++) {
+            for (uint32_t ri = 0; ri < REF_LIST_MAX_DEPTH; ri++) {
+                pcs_.is_global_motion[li][ri] = (EbBool)(rnd.random() & 1);
+                pcs_.global_motion_estimation[li][ri].wmtype =
+                    (TransformationType)(rnd.random() % TRANS_TYPES);
+                for (int i = 0; i < 6; i++)
+                    pcs_.global_motion_estimation[li][ri].wmmat[i] =
+                        rnd.random();
+            }
+        }
+    }
+
+    void expect_same(const AnalysisPicture &ref) const {
+        EXPECT_EQ(0, memcmp(ois_, ref.ois_, sizeof(ois_)));
+        EXPECT_EQ(0,
+                  memcmp(pcs_.is_global_motion,
+                         ref.pcs_.is_global_motion,
+                         sizeof(pcs_.is_global_motion)));
+        EXPECT_EQ(0,
+                  memcmp(pcs_.global_motion_estimation,
+                         ref.pcs_.global_motion_estimation,
+                         sizeof(pcs_.global_motion_estimation)));
+        if (pcs_.slice_type == I_SLICE)
+            return;
+        EXPECT_EQ(0, memcmp(distortion_, ref.distortion_, sizeof(distortion_)));
+        EXPECT_EQ(0, memcmp(count_, ref.count_, sizeof(count_)));
+        EXPECT_EQ(0, memcmp(mv_, ref.mv_, sizeof(mv_)));
+        for (uint32_t sb = 0; sb < sb_count; sb++) {
+            EXPECT_EQ(0,
+                      memcmp(sb_[sb].do_comp,
+                             ref.sb_[sb].do_comp,
+                             sizeof(sb_[sb].do_comp)));
+            for (uint32_t pu = 0; pu < SQUARE_PU_COUNT; pu++) {
+                const size_t bytes = count_[sb][pu] * sizeof(MeCandidate);
+                EXPECT_EQ(0,
+                          memcmp(&cand_[sb][pu * MAX_PA_ME_CAND],
+                                 &ref.cand_[sb][pu * MAX_PA_ME_CAND],
+                                 bytes))
+                    << "sb " << sb << " pu " << pu;
+            }
+        }
+    }
+
+    PictureParentControlSet pcs_;
+
+  private:
+    MotionEstimationData me_data_;
+    MeSbResults sb_[sb_count];
+    MeSbResults *sb_ptr_[sb_count];
+    uint32_t distortion_[sb_count];
+    uint8_t count_[sb_count][SQUARE_PU_COUNT];
+    MvCandidate mv_[sb_count][SQUARE_PU_COUNT * MAX_PA_ME_MV];
+    MeCandidate cand_[sb_count][SQUARE_PU_COUNT * MAX_PA_ME_CAND];
+    OisMbResults ois_[mb_count];
+    OisMbResults *ois_ptr_[mb_count];
+};
+
+class AnalysisCacheTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        path_ = testing::TempDir() + "svt_analysis_cache_test.bin";
+        scs_ = (SequenceControlSet *)calloc(1, sizeof(*scs_));
+        ASSERT_NE(nullptr, scs_);
+        scs_->max_input_luma_width = pic_width;
+        scs_->max_input_luma_height = pic_height;
+        scs_->sb_sz = sb_size;
+        scs_->seq_header.max_frame_width = pic_width;
+        scs_->seq_header.max_frame_height = pic_height;
+        scs_->static_config.look_ahead_distance = 16;
+        scs_->static_config.enable_tpl_la = 1;
+        SVTRandom rnd(0, 0x7fff);
+        for (uint64_t i = 0; i < picture_count; i++) {
+            pictures_.push_back(new AnalysisPicture(scs_, i));
+            pictures_.back()->fill_random(rnd);
+        }
+    }
+
+    void TearDown() override {
+        for (AnalysisPicture *pic : pictures_)
+            delete pic;
+        free(scs_);
+        remove(path_.c_str());
+    }
+
+    /** Write the pictures to the cache file, in reverse order as pictures
+     * complete ME out of order */
+    void write_cache() {
+        AnalysisCache cache;
+        memset(&cache, 0, sizeof(cache));
+        ASSERT_EQ(EB_ErrorNone,
+                  analysis_cache_ctor(
+                      &cache, scs_, path_.c_str(), ANALYSIS_CACHE_WRITE));
+        for (uint32_t i = picture_count; i > 0; i--)
+            ASSERT_EQ(
+                EB_ErrorNone,
+                analysis_cache_store_picture(&cache, &pictures_[i - 1]->pcs_));
+        cache.dctor(&cache);
+    }
+
+    EbErrorType open_cache(AnalysisCache *cache) {
+        memset(cache, 0, sizeof(*cache));
+        return analysis_cache_ctor(
+            cache, scs_, path_.c_str(), ANALYSIS_CACHE_READ);
+    }
+
+    /** Load a picture with one ME segment per SB row, the first one also
+     * loading the global motion */
+    bool load_picture(AnalysisCache *cache, AnalysisPicture *pic) {
+        for (uint32_t y = 0; y < pic_height_in_sb; y++) {
+            if (!analysis_cache_load_segment(cache,
+                                             &pic->pcs_,
+                                             (EbBool)(y == 0),
+                                             0,
+                                             pic_width_in_sb,
+                                             y,
+                                             y + 1))
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<uint8_t> read_file() {
+        std::vector<uint8_t> data;
+        FILE *f = fopen(path_.c_str(), "rb");
+        if (!f)
+            return data;
+        int c;
+        while ((c = fgetc(f)) != EOF)
+            data.push_back((uint8_t)c);
+        fclose(f);
+        return data;
+    }
+
+    void write_file(const std::vector<uint8_t> &data) {
+        FILE *f = fopen(path_.c_str(), "wb");
+        ASSERT_NE(nullptr, f);
+        ASSERT_EQ(data.size(), fwrite(data.data(), 1, data.size(), f));
+        fclose(f);
+    }
+
+    /** Offset of the first SB payload of a picture with ME results */
+    size_t find_sb_payload(const std::vector<uint8_t> &data) {
+        for (size_t i = 0; i + sizeof(sb_marker) <= data.size(); i++)
+            if (!memcmp(&data[i], &sb_marker, sizeof(sb_marker)))
+                return i;
+        return 0;
+    }
+
+    std::string path_;
+    SequenceControlSet *scs_;
+    std::vector<AnalysisPicture *> pictures_;
+};
+
+/**
+ * @brief Write the analysis of a few pictures and read it back
+ *
+ * Test strategy:
+ * Store pictures with random ME candidates, MVs, OIS results and global
+ * motion, close the cache, then load every picture per ME segment into a
+ * blank picture. Also load a picture that is not in the file.
+ *
+ * Expected result:
+ * Every loaded picture has the stored results, the missing picture is not
+ * loaded and does not reject the cache.
+ */
+TEST_F(AnalysisCacheTest, round_trip) {
+    write_cache();
+    AnalysisCache cache;
+    ASSERT_EQ(EB_ErrorNone, open_cache(&cache));
+    for (uint64_t i = 0; i < picture_count; i++) {
+        AnalysisPicture loaded(scs_, i);
+        ASSERT_TRUE(load_picture(&cache, &loaded)) << "picture " << i;
+        loaded.expect_same(*pictures_[i]);
+    }
+    AnalysisPicture missing(scs_, picture_count);
+    EXPECT_FALSE(load_picture(&cache, &missing));
+    AnalysisPicture overlay(scs_, 1);
+    overlay.pcs_.is_overlay = EB_TRUE;
+    EXPECT_FALSE(load_picture(&cache, &overlay));
+    EXPECT_FALSE(cache.rejected);
+    cache.dctor(&cache);
+}
+
+/**
+ * @brief A cache from other settings, another version or an incomplete
+ * file is not opened
+ */
+TEST_F(AnalysisCacheTest, reject_file) {
+    write_cache();
+    const std::vector<uint8_t> data = read_file();
+    ASSERT_GT(data.size(), sizeof(AnalysisCacheSignature));
+    AnalysisCache cache;
+
+    // Other encoder settings
+    scs_->static_config.enc_mode++;
+    EXPECT_EQ(EB_ErrorBadParameter, open_cache(&cache));
+    cache.dctor(&cache);
+    scs_->static_config.enc_mode--;
+
+    // Another version of the file format
+    std::vector<uint8_t> corrupted = data;
+    corrupted[offsetof(AnalysisCacheSignature, version)]++;
+    write_file(corrupted);
+    EXPECT_EQ(EB_ErrorBadParameter, open_cache(&cache));
+    cache.dctor(&cache);
+
+    // Not a cache file
+    corrupted = data;
+    corrupted[offsetof(AnalysisCacheSignature, magic)]++;
+    write_file(corrupted);
+    EXPECT_EQ(EB_ErrorBadParameter, open_cache(&cache));
+    cache.dctor(&cache);
+
+    // Truncated, the footer is missing
+    corrupted = data;
+    corrupted.resize(data.size() - 1);
+    write_file(corrupted);
+    EXPECT_EQ(EB_ErrorBadParameter, open_cache(&cache));
+    cache.dctor(&cache);
+
+    // The index does not end at the footer
+    corrupted = data;
+    corrupted.insert(corrupted.end() - sizeof(uint64_t) - 2 * sizeof(uint32_t),
+                     0);
+    write_file(corrupted);
+    EXPECT_EQ(EB_ErrorBadParameter, open_cache(&cache));
+    cache.dctor(&cache);
+
+    // The unmodified file opens
+    write_file(data);
+    EXPECT_EQ(EB_ErrorNone, open_cache(&cache));
+    cache.dctor(&cache);
+}
+
+/**
+ * @brief A record that does not match the picture rejects the cache
+ *
+ * Test strategy:
+ * Store the pictures, then corrupt the candidate count of the first PU of
+ * the last picture written, so that it is above the maximum, and load the
+ * pictures. Then load a picture with another reference count than the one
+ * stored.
+ *
+ * Expected result:
+ * The pictures before the corrupted record load, the corrupted one and all
+ * the pictures after it are not loaded.
+ */
+TEST_F(AnalysisCacheTest, reject_record) {
+    write_cache();
+    std::vector<uint8_t> data = read_file();
+    // The pictures are written in reverse order, picture 1 last but one
+    const size_t payload = find_sb_payload(data);
+    ASSERT_NE(0u, payload);
+    const size_t count_offset =
+        payload + sizeof(uint32_t) + sizeof(((MeSbResults *)0)->do_comp);
+    data[count_offset] = MAX_PA_ME_CAND + 1;
+    write_file(data);
+
+    AnalysisCache cache;
+    ASSERT_EQ(EB_ErrorNone, open_cache(&cache));
+    AnalysisPicture first(scs_, 0);
+    EXPECT_TRUE(load_picture(&cache, &first));
+    EXPECT_FALSE(cache.rejected);
+    // The marker is in the first record written with ME results, picture 2
+    AnalysisPicture corrupted(scs_, 2);
+    EXPECT_FALSE(load_picture(&cache, &corrupted));
+    EXPECT_TRUE(cache.rejected);
+    AnalysisPicture next(scs_, 1);
+    EXPECT_FALSE(load_picture(&cache, &next));
+    cache.dctor(&cache);
+
+    // Valid record, the picture searched another number of references
+    write_cache();
+    ASSERT_EQ(EB_ErrorNone, open_cache(&cache));
+    AnalysisPicture other_refs(scs_, 1);
+    other_refs.pcs_.ref_list0_count_try = 1;
+    EXPECT_FALSE(load_picture(&cache, &other_refs));
+    EXPECT_TRUE(cache.rejected);
+    cache.dctor(&cache);
+}
+
+}  // namespace
@@ -19,7 +19,9 @@
  ******************************************************************************/
 #include <math.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <random>
+#include <vector>
 #include "EbCabacContextModel.h"
 #if defined(CHAR_BIT)
 #undef CHAR_BIT  // defined in clang/9.1.0/include/limits.h
@@ -282,4 +284,112 @@ TEST(Entropy_BitstreamWriter, write_symbol_with_update) {
                   rnd(gen));
     }
 }
+// Random inverse CDF of nsyms symbols, followed by the adaptation counter
+static void generate_random_icdf(std::mt19937 &gen, int nsyms, AomCdfProb *icdf) {
+    std::uniform_int_distribution<int> dist(1, CDF_PROB_TOP - 1);
+    std::vector<int> cdf(nsyms - 1);
+    for (int i = 0; i < nsyms - 1; ++i)
+        cdf[i] = dist(gen);
+    std::sort(cdf.begin(), cdf.end());
+    for (int i = 0; i < nsyms - 1; ++i)
+        icdf[i] = AOM_ICDF(cdf[i]);
+    icdf[nsyms - 1] = AOM_ICDF(CDF_PROB_TOP);
+    icdf[nsyms] = 0;
+}
+
+/**
+ * @brief Unit test for the SSE2 CDF symbol search of the decoder, for the
+ * alphabets of 8 to 16 symbols it is used for
+ *
+ * Test strategy:
+ * Search random coded values in random CDFs and ranges with the SSE2 and
+ * the scalar search.
+ *
+ * Expected result:
+ * The symbols and their thresholds match.
+ */
+#ifdef ARCH_X86
+TEST(Entropy_BitstreamReader, find_symbol_sse2_match_c) {
+    std::mt19937 gen(deterministic_seeds);
+    std::uniform_int_distribution<unsigned> rng_dist(32768, 65535);
+    for (int nsyms = 8; nsyms <= 16; ++nsyms) {
+        AomCdfProb icdf[17];
+        for (int i = 0; i < 1000; ++i) {
+            generate_random_icdf(gen, nsyms, icdf);
+            const unsigned r = rng_dist(gen);
+            const unsigned c =
+                std::uniform_int_distribution<unsigned>(0, r - 1)(gen);
+            unsigned u_ref, v_ref, u, v;
+            const int ref =
+                od_ec_find_symbol_c(icdf, nsyms, r, c, &u_ref, &v_ref);
+            ASSERT_EQ(ref, od_ec_find_symbol_sse2(icdf, nsyms, r, c, &u, &v))
+                << "nsyms " << nsyms << " r " << r << " c " << c;
+            ASSERT_EQ(u_ref, u);
+            ASSERT_EQ(v_ref, v);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Unit test for writing and reading symbols of 8 to 16 symbol
+ * alphabets with random CDFs, with and without CDF update
+ *
+ * Test strategy:
+ * Write random symbols with random CDFs, read them back, and check the SSE2
+ * symbol search against the scalar one at every symbol read.
+ *
+ * Expected result:
+ * The symbols read out match the symbols written, and both searches agree.
+ */
+TEST(Entropy_BitstreamWriter, write_symbol_random_cdf) {
+    const int num_symbols = 2000;
+    std::mt19937 gen(deterministic_seeds);
+
+    for (int allow_update_cdf = 0; allow_update_cdf <= 1; ++allow_update_cdf) {
+        for (int nsyms = 8; nsyms <= 16; ++nsyms) {
+            AomCdfProb enc_cdf[17], dec_cdf[17];
+            std::vector<int> symbols(num_symbols);
+            std::vector<uint8_t> stream_buffer(num_symbols * 2 + 64);
+            AomWriter bw;
+
+            generate_random_icdf(gen, nsyms, enc_cdf);
+            memcpy(dec_cdf, enc_cdf, sizeof(enc_cdf));
+            // skewed towards the first symbols as coded CDFs are
+            std::geometric_distribution<int> sym_dist(0.25);
+            for (int i = 0; i < num_symbols; ++i)
+                symbols[i] = sym_dist(gen) % nsyms;
+
+            memset(&bw, 0, sizeof(bw));
+            bw.allow_update_cdf = allow_update_cdf;
+            aom_start_encode(&bw, stream_buffer.data());
+            for (int i = 0; i < num_symbols; ++i)
+                aom_write_symbol(&bw, symbols[i], enc_cdf, nsyms);
+            aom_stop_encode(&bw);
+            ASSERT_LE(bw.pos, stream_buffer.size());
+
+            SvtReader br;
+            svt_reader_init(&br, stream_buffer.data(), bw.pos);
+            br.allow_update_cdf = allow_update_cdf;
+            for (int i = 0; i < num_symbols; ++i) {
+#ifdef ARCH_X86
+                const unsigned r = br.ec.rng;
+                const unsigned c = (unsigned)(br.ec.dif >>
+                                              (OD_EC_DEC_WINDOW_SIZE - 16));
+                unsigned u_ref, v_ref, u, v;
+                ASSERT_EQ(
+                    od_ec_find_symbol_c(dec_cdf, nsyms, r, c, &u_ref, &v_ref),
+                    od_ec_find_symbol_sse2(dec_cdf, nsyms, r, c, &u, &v))
+                    << "nsyms " << nsyms << " symbol " << i;
+                ASSERT_EQ(u_ref, u);
+                ASSERT_EQ(v_ref, v);
+#endif
+                ASSERT_EQ(symbols[i],
+                          svt_read_symbol(&br, dec_cdf, nsyms, nullptr))
+                    << "nsyms " << nsyms << " symbol " << i
+                    << " allow_update_cdf " << allow_update_cdf;
+            }
+        }
+    }
+}
 }  // namespace
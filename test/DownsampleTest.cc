@@ -0,0 +1,121 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file DownsampleTest.cc
+ *
+ * @brief Unit test for the picture analysis downsampling functions:
+ * - decimation_2d_avx2
+ * - downsample_2d_avx2
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "random.h"
+#include "util.h"
+
+/**
+ * @brief Unit test for the downsampling functions:
+ * - decimation_2d_avx2
+ * - downsample_2d_avx2
+ *
+ * Test strategy:
+ * Verify the AVX2 kernels by comparing with the reference C implementation,
+ * fed with the same random picture of random area size, for each decimation
+ * step.
+ *
+ * Expected result:
+ * The decimated pictures are identical, and nothing is written past the
+ * decimated area.
+ */
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+typedef void (*DownsampleFunc)(uint8_t *input_samples, uint32_t input_stride,
+                               uint32_t input_area_width,
+                               uint32_t input_area_height,
+                               uint8_t *decim_samples, uint32_t decim_stride,
+                               uint32_t decim_step);
+
+typedef std::tuple<DownsampleFunc, DownsampleFunc, uint32_t> DownsampleParam;
+
+class DownsampleTest : public ::testing::TestWithParam<DownsampleParam> {
+  public:
+    DownsampleTest()
+        : func_ref_(TEST_GET_PARAM(0)),
+          func_tst_(TEST_GET_PARAM(1)),
+          decim_step_(TEST_GET_PARAM(2)) {
+    }
+
+    void run_match_test() {
+        SVTRandom rnd_pix(8, false);
+        SVTRandom rnd_width(1, (int)kMaxWidth);
+        SVTRandom rnd_height(1, (int)kMaxHeight);
+
+        for (int iter = 0; iter < 1000; iter++) {
+            const uint32_t width = rnd_width.random();
+            const uint32_t height = rnd_height.random();
+            for (uint32_t i = 0; i < kMaxWidth * kMaxHeight; i++)
+                input_[i] = rnd_pix.random();
+            memset(output_ref_, 0xA5, sizeof(output_ref_));
+            memset(output_tst_, 0xA5, sizeof(output_tst_));
+
+            func_ref_(input_,
+                      kMaxWidth,
+                      width,
+                      height,
+                      output_ref_,
+                      kMaxWidth,
+                      decim_step_);
+            func_tst_(input_,
+                      kMaxWidth,
+                      width,
+                      height,
+                      output_tst_,
+                      kMaxWidth,
+                      decim_step_);
+
+            ASSERT_EQ(0, memcmp(output_ref_, output_tst_, sizeof(output_ref_)))
+                << "width " << width << " height " << height << " step "
+                << decim_step_;
+        }
+    }
+
+  protected:
+    static const uint32_t kMaxWidth = 320;
+    static const uint32_t kMaxHeight = 192;
+
+    DownsampleFunc func_ref_;
+    DownsampleFunc func_tst_;
+    uint32_t decim_step_;
+    uint8_t input_[kMaxWidth * kMaxHeight];
+    uint8_t output_ref_[kMaxWidth * kMaxHeight];
+    uint8_t output_tst_[kMaxWidth * kMaxHeight];
+};
+
+TEST_P(DownsampleTest, MatchTest) {
+    run_match_test();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, DownsampleTest,
+    ::testing::Values(
+        DownsampleParam(decimation_2d_c, decimation_2d_avx2, 2),
+        DownsampleParam(decimation_2d_c, decimation_2d_avx2, 4),
+        DownsampleParam(decimation_2d_c, decimation_2d_avx2, 8),
+        DownsampleParam(downsample_2d_c, downsample_2d_avx2, 2),
+        DownsampleParam(downsample_2d_c, downsample_2d_avx2, 4),
+        DownsampleParam(downsample_2d_c, downsample_2d_avx2, 8)));
+
+}  // namespace
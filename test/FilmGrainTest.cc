@@ -10,6 +10,9 @@
  * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
  */
 #include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 // workaround to eliminate the compiling warning on linux
 // The macro will conflict with definition in gtest.h
@@ -27,6 +30,10 @@
 #include "acm_random.h"
 #include "noise_model.h"
 #include "aom_dsp_rtcd.h"
+#include "random.h"
+#include "EbTime.h"
+
+using svt_av1_test_tool::SVTRandom;
 
 static AomFilmGrain film_grain_test_vectors[3] = {
     /* Test 1 */
@@ -205,6 +212,7 @@ class AddFilmGrainTest : public ::testing::Test {
     static const int chroma_size = luma_size >> 2;
 
     void SetUp() override {
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
         luma_ = (uint8_t *)eb_aom_malloc(luma_size);
         cb_ = (uint8_t *)eb_aom_malloc(chroma_size);
         cr_ = (uint8_t *)eb_aom_malloc(chroma_size);
@@ -267,6 +275,279 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+/**
+ * @brief Unit test for eb_av1_add_film_grain_region
+ *
+ * Test strategy:
+ * Add the grain of each test vector to a picture of a gradient, then add it
+ * to a copy of a region of the picture held in its own buffers.
+ *
+ * Expected result:
+ * The region matches the same crop of the full picture: the grain of a
+ * region is the grain of the picture at its position.
+ */
+TEST_F(AddFilmGrainTest, RegionMatchTest) {
+    const int x0 = 38, y0 = 22, w = 50, h = 42;
+    std::vector<uint8_t> luma(w * h), cb(w * h / 4), cr(w * h / 4);
+    for (int i = 0; i < 3; ++i) {
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x)
+                luma_[y * kWidth + x] = (uint8_t)(x + 2 * y);
+        }
+        for (int y = 0; y < kHeight / 2; ++y) {
+            for (int x = 0; x < kWidth / 2; ++x) {
+                cb_[y * kWidth / 2 + x] = (uint8_t)(128 + x - y);
+                cr_[y * kWidth / 2 + x] = (uint8_t)(64 + 2 * x);
+            }
+        }
+        for (int y = 0; y < h; ++y)
+            memcpy(&luma[y * w], luma_ + (y0 + y) * kWidth + x0, w);
+        for (int y = 0; y < h / 2; ++y) {
+            const int offset = (y0 / 2 + y) * kWidth / 2 + x0 / 2;
+            memcpy(&cb[y * w / 2], cb_ + offset, w / 2);
+            memcpy(&cr[y * w / 2], cr_ + offset, w / 2);
+        }
+
+        eb_av1_add_film_grain_run(film_grain_test_vectors + i,
+                                  luma_,
+                                  cb_,
+                                  cr_,
+                                  kHeight,
+                                  kWidth,
+                                  kWidth,     /* luma stride */
+                                  kWidth / 2, /* chroma stride */
+                                  0,
+                                  1,
+                                  1);
+        eb_av1_add_film_grain_region(film_grain_test_vectors + i,
+                                     luma.data(),
+                                     cb.data(),
+                                     cr.data(),
+                                     kHeight,
+                                     kWidth,
+                                     w,     /* luma stride */
+                                     w / 2, /* chroma stride */
+                                     0,
+                                     1,
+                                     1,
+                                     x0,
+                                     y0,
+                                     w,
+                                     h);
+
+        for (int y = 0; y < h; ++y)
+            ASSERT_EQ(0,
+                      memcmp(&luma[y * w], luma_ + (y0 + y) * kWidth + x0, w))
+                << "vector " << i << " luma row " << y;
+        for (int y = 0; y < h / 2; ++y) {
+            const int offset = (y0 / 2 + y) * kWidth / 2 + x0 / 2;
+            ASSERT_EQ(0, memcmp(&cb[y * w / 2], cb_ + offset, w / 2))
+                << "vector " << i << " cb row " << y;
+            ASSERT_EQ(0, memcmp(&cr[y * w / 2], cr_ + offset, w / 2))
+                << "vector " << i << " cr row " << y;
+        }
+    }
+}
+
+/**
+ * @brief Unit test for the film grain blending kernels:
+ * eb_av1_add_luma_noise_avx2, eb_av1_add_luma_noise_hbd_avx2,
+ * eb_av1_add_chroma_noise_avx2 and eb_av1_add_chroma_noise_hbd_avx2
+ *
+ * Test strategy:
+ * Feed random pixels, grain, scaling tables and blending parameters with
+ * random block sizes and subsampling, and check the output of the AVX2
+ * kernels matches the C kernels bit-exactly.
+ *
+ * Test parameter:
+ * bit depth: 8, 10, 12
+ */
+class FilmGrainNoiseTest : public ::testing::TestWithParam<int> {
+  public:
+    static const int kMaxSize = 128;
+    static const int kStride = kMaxSize + 8;
+
+    FilmGrainNoiseTest()
+        : bd_(GetParam()),
+          rnd_pix_(0, (1 << GetParam()) - 1),
+          rnd_grain_(-2048, 2047),
+          rnd_lut_(0, 255) {
+    }
+
+  protected:
+    void prepare_data() {
+        for (int i = 0; i < 256; i++)
+            lut_[i] = rnd_lut_.random();
+        for (int i = 0; i < kStride * kMaxSize; i++) {
+            grain_[i] = rnd_grain_.random();
+            luma_[i] = rnd_pix_.random();
+            chroma_ref_[i] = chroma_tst_[i] = rnd_pix_.random();
+        }
+    }
+
+    void run_luma(int width, int height, int shift, int min, int max,
+                  bool ref) {
+        uint16_t *dst = ref ? chroma_ref_ : chroma_tst_;
+        if (bd_ == 8) {
+            uint8_t *dst8 = (uint8_t *)dst;
+            (ref ? eb_av1_add_luma_noise_c : eb_av1_add_luma_noise_avx2)(
+                lut_, dst8, kStride, grain_, kStride, width, height, shift,
+                min, max);
+        } else {
+            (ref ? eb_av1_add_luma_noise_hbd_c
+                 : eb_av1_add_luma_noise_hbd_avx2)(lut_,
+                                                   dst,
+                                                   kStride,
+                                                   grain_,
+                                                   kStride,
+                                                   width,
+                                                   height,
+                                                   shift,
+                                                   min,
+                                                   max,
+                                                   bd_);
+        }
+    }
+
+    void run_chroma(int width, int height, int shift, int min, int max,
+                    int mult, int luma_mult, int offset, int sub_y, int sub_x,
+                    bool ref) {
+        uint16_t *dst = ref ? chroma_ref_ : chroma_tst_;
+        if (bd_ == 8) {
+            uint8_t luma8[kStride * kMaxSize];
+            for (int i = 0; i < kStride * kMaxSize; i++)
+                luma8[i] = (uint8_t)luma_[i];
+            (ref ? eb_av1_add_chroma_noise_c : eb_av1_add_chroma_noise_avx2)(
+                lut_, (uint8_t *)dst, kStride, luma8, kStride, grain_,
+                kStride, width, height, mult, luma_mult, offset, shift, min,
+                max, sub_y, sub_x);
+        } else {
+            (ref ? eb_av1_add_chroma_noise_hbd_c
+                 : eb_av1_add_chroma_noise_hbd_avx2)(lut_,
+                                                     dst,
+                                                     kStride,
+                                                     luma_,
+                                                     kStride,
+                                                     grain_,
+                                                     kStride,
+                                                     width,
+                                                     height,
+                                                     mult,
+                                                     luma_mult,
+                                                     offset,
+                                                     shift,
+                                                     min,
+                                                     max,
+                                                     sub_y,
+                                                     sub_x,
+                                                     bd_);
+        }
+    }
+
+    void check_output(int width, int height) {
+        const int bytes = bd_ == 8 ? 1 : 2;
+        for (int i = 0; i < height; i++)
+            ASSERT_EQ(memcmp((uint8_t *)chroma_ref_ + i * kStride * bytes,
+                             (uint8_t *)chroma_tst_ + i * kStride * bytes,
+                             width * bytes),
+                      0)
+                << "row " << i << " width " << width << " height " << height;
+    }
+
+    void run_match_test() {
+        SVTRandom rnd_size(1, kMaxSize / 2);
+        SVTRandom rnd_shift(8, 11);
+        SVTRandom rnd_mult(-128, 127);
+        SVTRandom rnd_offset(-256, 255);
+        SVTRandom rnd_bool(0, 1);
+        for (int iter = 0; iter < 200; iter++) {
+            prepare_data();
+            const int width = rnd_size.random();
+            const int height = rnd_size.random();
+            const int shift = rnd_shift.random();
+            const int restricted = rnd_bool.random();
+            const int min = restricted ? 16 << (bd_ - 8) : 0;
+            const int max =
+                restricted ? 235 << (bd_ - 8) : (256 << (bd_ - 8)) - 1;
+            run_luma(width << 1, height << 1, shift, min, max, true);
+            run_luma(width << 1, height << 1, shift, min, max, false);
+            check_output(width << 1, height << 1);
+
+            const int sub_x = rnd_bool.random();
+            const int sub_y = rnd_bool.random();
+            const int mult = rnd_mult.random();
+            const int luma_mult = rnd_mult.random();
+            const int offset = rnd_offset.random() << (bd_ - 8);
+            run_chroma(width, height, shift, min, max, mult, luma_mult,
+                       offset, sub_y, sub_x, true);
+            run_chroma(width, height, shift, min, max, mult, luma_mult,
+                       offset, sub_y, sub_x, false);
+            check_output(width, height);
+        }
+    }
+
+    void run_speed_test() {
+        const int num_loop = 10000;
+        double time_c, time_o;
+        uint64_t start_time_seconds, start_time_useconds;
+        uint64_t middle_time_seconds, middle_time_useconds;
+        uint64_t finish_time_seconds, finish_time_useconds;
+
+        prepare_data();
+        eb_start_time(&start_time_seconds, &start_time_useconds);
+        for (int i = 0; i < num_loop; i++) {
+            run_luma(kMaxSize, kMaxSize / 2, 11, 0, (1 << bd_) - 1, true);
+            run_chroma(kMaxSize / 2, kMaxSize / 4, 11, 0, (1 << bd_) - 1,
+                       -9, 64, 0, 1, 1, true);
+        }
+        eb_start_time(&middle_time_seconds, &middle_time_useconds);
+        for (int i = 0; i < num_loop; i++) {
+            run_luma(kMaxSize, kMaxSize / 2, 11, 0, (1 << bd_) - 1, false);
+            run_chroma(kMaxSize / 2, kMaxSize / 4, 11, 0, (1 << bd_) - 1,
+                       -9, 64, 0, 1, 1, false);
+        }
+        eb_start_time(&finish_time_seconds, &finish_time_useconds);
+
+        eb_compute_overall_elapsed_time_ms(start_time_seconds,
+                                           start_time_useconds,
+                                           middle_time_seconds,
+                                           middle_time_useconds,
+                                           &time_c);
+        eb_compute_overall_elapsed_time_ms(middle_time_seconds,
+                                           middle_time_useconds,
+                                           finish_time_seconds,
+                                           finish_time_useconds,
+                                           &time_o);
+
+        printf("Average Nanoseconds per Function Call (bd %d)\n", bd_);
+        printf("    add_noise_c()   : %6.2f\n", 1000000 * time_c / num_loop);
+        printf("    add_noise_opt() : %6.2f   (Comparison: %5.2fx)\n",
+               1000000 * time_o / num_loop,
+               time_c / time_o);
+    }
+
+    int bd_;
+    SVTRandom rnd_pix_;
+    SVTRandom rnd_grain_;
+    SVTRandom rnd_lut_;
+    int32_t lut_[256];
+    int32_t grain_[kStride * kMaxSize];
+    uint16_t luma_[kStride * kMaxSize];
+    uint16_t chroma_ref_[kStride * kMaxSize];
+    uint16_t chroma_tst_[kStride * kMaxSize];
+};
+
+TEST_P(FilmGrainNoiseTest, MatchTest) {
+    run_match_test();
+}
+
+TEST_P(FilmGrainNoiseTest, DISABLED_SpeedTest) {
+    run_speed_test();
+}
+
+INSTANTIATE_TEST_CASE_P(FilmGrain, FilmGrainNoiseTest,
+                        ::testing::Values(8, 10, 12));
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
@@ -422,6 +703,14 @@ class DenoiseModelRunTest : public ::testing::Test {
             eb_aom_ifft8x8_float = eb_aom_ifft8x8_float_avx2;
             eb_aom_ifft2x2_float = eb_aom_ifft2x2_float_c;
             eb_aom_ifft4x4_float = eb_aom_ifft4x4_float_sse2;
+
+            eb_aom_noise_model_add_observation =
+                eb_aom_noise_model_add_observation_avx2;
+            eb_aom_flat_block_remove_plane =
+                eb_aom_flat_block_remove_plane_avx2;
+            eb_aom_wiener_window_block = eb_aom_wiener_window_block_avx2;
+            eb_aom_wiener_accumulate_block =
+                eb_aom_wiener_accumulate_block_avx2;
         }
     }
 
@@ -469,3 +758,164 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+// Denoises the block rows of a pass on several threads at once, the way the
+// segments of a picture share them in picture analysis
+static int32_t run_pass_threaded(void *priv, const AomWienerPass *pass) {
+    const int num_threads = *(const int *)priv;
+    std::atomic<int32_t> next_row(0), success(1);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&]() {
+            for (int32_t row = next_row++; row < pass->num_rows;
+                 row = next_row++) {
+                if (!eb_aom_wiener_denoise_rows(pass, row, row + 1))
+                    success = 0;
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+    return success;
+}
+
+// The denoised picture and the film grain have to be the same whichever
+// threads denoise the block rows of the Wiener passes
+TEST_F(DenoiseModelRunTest, ThreadedWienerPassMatch) {
+    const int luma_size = width_ * height_;
+    const int chroma_size = luma_size >> (subsampling_x_ + subsampling_y_);
+    int num_threads = 3;
+
+    run_test();
+    check_filmgrain();
+    std::vector<uint8_t> ref_y(data_ptr_[0], data_ptr_[0] + luma_size);
+    std::vector<uint8_t> ref_cb(data_ptr_[1], data_ptr_[1] + chroma_size);
+    std::vector<uint8_t> ref_cr(data_ptr_[2], data_ptr_[2] + chroma_size);
+
+    random_.Reset(100171);
+    memset(&output_film_grain, 0, sizeof(output_film_grain));
+    noise_model.run_wiener_pass = run_pass_threaded;
+    noise_model.run_wiener_pass_priv = &num_threads;
+    run_test();
+    check_filmgrain();
+    EXPECT_EQ(memcmp(ref_y.data(), data_ptr_[0], luma_size), 0);
+    EXPECT_EQ(memcmp(ref_cb.data(), data_ptr_[1], chroma_size), 0);
+    EXPECT_EQ(memcmp(ref_cr.data(), data_ptr_[2], chroma_size), 0);
+}
+
+// Match test of the accumulation of the noise model observations, the
+// equation system has to be bit exact between C and AVX2
+TEST(NoiseModelAddObservationTest, MatchTest) {
+    const int max_n = 25;  // lag 3 with the luma coefficient
+    SVTRandom rnd_pix(-255, 255);
+    SVTRandom rnd_n(1, max_n);
+    double A_ref[max_n * max_n], A_tst[max_n * max_n];
+    double b_ref[max_n], b_tst[max_n];
+    double buffer[max_n];
+
+    for (int iter = 0; iter < 100; ++iter) {
+        const int n = rnd_n.random();
+        memset(A_ref, 0, sizeof(A_ref));
+        memset(b_ref, 0, sizeof(b_ref));
+        memset(A_tst, 0, sizeof(A_tst));
+        memset(b_tst, 0, sizeof(b_tst));
+        for (int obs = 0; obs < 64; ++obs) {
+            for (int i = 0; i < n; ++i) buffer[i] = rnd_pix.random();
+            const double val = rnd_pix.random();
+            eb_aom_noise_model_add_observation_c(
+                A_ref, b_ref, buffer, val, n, 255.0);
+            eb_aom_noise_model_add_observation_avx2(
+                A_tst, b_tst, buffer, val, n, 255.0);
+        }
+        ASSERT_EQ(memcmp(A_ref, A_tst, sizeof(A_ref)), 0) << "n " << n;
+        ASSERT_EQ(memcmp(b_ref, b_tst, sizeof(b_ref)), 0) << "n " << n;
+    }
+}
+
+// Match test of the plane removal of the flat block finder, the block and the
+// plane have to be bit exact between C and AVX2, odd sizes test the tails
+TEST(FlatBlockRemovePlaneTest, MatchTest) {
+    const int block_sizes[] = {3, 5, 16, 32};
+    SVTRandom rnd_pix(0, 1023);
+
+    for (int block_size : block_sizes) {
+        const int n = block_size * block_size;
+        const size_t bytes = n * sizeof(double);
+        AomFlatBlockFinder finder;
+        ASSERT_EQ(eb_aom_flat_block_finder_init(&finder, block_size, 10, 1), 1);
+        std::vector<double> block_ref(n), block_tst(n);
+        std::vector<double> plane_ref(n), plane_tst(n);
+        for (int iter = 0; iter < 20; ++iter) {
+            for (int i = 0; i < n; ++i)
+                block_ref[i] = block_tst[i] = rnd_pix.random();
+            eb_aom_flat_block_remove_plane_c(block_ref.data(),
+                                             plane_ref.data(),
+                                             finder.A,
+                                             finder.at_a_inv,
+                                             finder.normalization,
+                                             n);
+            eb_aom_flat_block_remove_plane_avx2(block_tst.data(),
+                                                plane_tst.data(),
+                                                finder.A,
+                                                finder.at_a_inv,
+                                                finder.normalization,
+                                                n);
+            ASSERT_EQ(memcmp(block_ref.data(), block_tst.data(), bytes), 0)
+                << "block_size " << block_size;
+            ASSERT_EQ(memcmp(plane_ref.data(), plane_tst.data(), bytes), 0)
+                << "block_size " << block_size;
+        }
+        eb_aom_flat_block_finder_free(&finder);
+    }
+}
+
+// Match test of the windowing of a block before and after its Wiener filtering
+TEST(WienerBlockTest, MatchTest) {
+    const int block_sizes[] = {2, 5, 8, 16, 32};
+    const int result_stride = 40;
+    SVTRandom rnd_pix(-1023, 1023);
+    SVTRandom rnd_win(0, 1 << 16);
+
+    for (int block_size : block_sizes) {
+        const int n = block_size * block_size;
+        const size_t bytes = n * sizeof(float);
+        std::vector<double> block_d(n), plane_d(n);
+        std::vector<float> window(n), block_ref(n), block_tst(n);
+        std::vector<float> result_ref(block_size * result_stride);
+        for (int iter = 0; iter < 20; ++iter) {
+            for (int i = 0; i < n; ++i) {
+                block_d[i] = rnd_pix.random() / 1023.0;
+                plane_d[i] = rnd_pix.random() / 1023.0;
+                window[i] = rnd_win.random() / (float)(1 << 16);
+            }
+            for (auto &r : result_ref)
+                r = rnd_pix.random() / 1023.0f;
+            std::vector<float> result_tst(result_ref);
+
+            eb_aom_wiener_window_block_c(
+                block_d.data(), window.data(), block_ref.data(), n);
+            eb_aom_wiener_window_block_avx2(
+                block_d.data(), window.data(), block_tst.data(), n);
+            ASSERT_EQ(memcmp(block_ref.data(), block_tst.data(), bytes), 0)
+                << "block_size " << block_size;
+
+            eb_aom_wiener_accumulate_block_c(block_ref.data(),
+                                             plane_d.data(),
+                                             window.data(),
+                                             result_ref.data(),
+                                             result_stride,
+                                             block_size);
+            eb_aom_wiener_accumulate_block_avx2(block_ref.data(),
+                                                plane_d.data(),
+                                                window.data(),
+                                                result_tst.data(),
+                                                result_stride,
+                                                block_size);
+            ASSERT_EQ(memcmp(result_ref.data(),
+                             result_tst.data(),
+                             result_ref.size() * sizeof(float)),
+                      0)
+                << "block_size " << block_size;
+        }
+    }
+}
@@ -0,0 +1,176 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file FirstPassAnalysisTest.cc
+ *
+ * @brief Unit test of the analysis-only first pass
+ * (rc_firstpass_analysis_only), against the first pass stats of the full
+ * first pass
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbSvtAv1Enc.h"
+#include "EbPictureControlSet.h"
+
+namespace {
+
+static const uint32_t stream_width = 192;
+static const uint32_t stream_height = 128;
+static const uint32_t stream_frames = 24;
+
+/** Sample of a fixed random texture */
+static uint8_t texture(uint32_t x, uint32_t y, uint32_t seed) {
+    uint32_t h = (x * 73856093u) ^ (y * 19349663u) ^ (seed * 83492791u);
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return (uint8_t)(h & 0xff);
+}
+
+/** Fill a texture panning across the picture, replaced by another one half
+ * way */
+static void fill_frame(EbSvtIOFormat *frame, uint32_t index) {
+    const uint32_t seed = index < stream_frames / 2 ? 1 : 2;
+    for (uint32_t y = 0; y < frame->height; y++) {
+        for (uint32_t x = 0; x < frame->width; x++)
+            frame->luma[y * frame->y_stride + x] =
+                (uint8_t)((texture((x + 2 * index) / 4, (y + index) / 4, seed) +
+                           texture(x + 2 * index, y + index, seed)) /
+                          2);
+    }
+    for (uint32_t y = 0; y < frame->height / 2; y++) {
+        for (uint32_t x = 0; x < frame->width / 2; x++) {
+            frame->cb[y * frame->cb_stride + x] = (uint8_t)(128 + x - y);
+            frame->cr[y * frame->cr_stride + x] = (uint8_t)(96 + x + index);
+        }
+    }
+}
+
+/** Run the first pass over the stream, returns the stats of every frame
+ * followed by their total */
+static std::vector<FIRSTPASS_STATS> first_pass(EbBool analysis_only) {
+    std::vector<FIRSTPASS_STATS> stats;
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration params;
+    memset(&params, 0, sizeof(params));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&handle, nullptr, &params));
+    if (!handle)
+        return stats;
+    params.source_width = stream_width;
+    params.source_height = stream_height;
+    params.enc_mode = MAX_ENC_PRESET;
+    params.rate_control_mode = 0;
+    params.rc_firstpass_stats_out = EB_TRUE;
+    params.rc_firstpass_analysis_only = analysis_only;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(handle, &params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(handle));
+
+    std::vector<uint8_t> yuv(stream_width * stream_height * 3 / 2);
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = yuv.data();
+    frame.cb = frame.luma + stream_width * stream_height;
+    frame.cr = frame.cb + stream_width * stream_height / 4;
+    frame.y_stride = stream_width;
+    frame.cb_stride = stream_width / 2;
+    frame.cr_stride = stream_width / 2;
+    frame.width = stream_width;
+    frame.height = stream_height;
+    frame.color_fmt = EB_YUV420;
+    frame.bit_depth = EB_EIGHT_BIT;
+
+    bool eos = false;
+    for (uint32_t i = 0; i <= stream_frames && !eos; i++) {
+        EbBufferHeaderType in_buf;
+        memset(&in_buf, 0, sizeof(in_buf));
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        if (i < stream_frames) {
+            fill_frame(&frame, i);
+            in_buf.size = sizeof(in_buf);
+            in_buf.p_buffer = (uint8_t *)&frame;
+            in_buf.n_filled_len = (uint32_t)yuv.size();
+            in_buf.pts = i;
+        } else
+            in_buf.flags = EB_BUFFERFLAG_EOS;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle, &in_buf));
+
+        const uint8_t pic_send_done = i == stream_frames;
+        EbBufferHeaderType *out = nullptr;
+        while (!eos && svt_av1_enc_get_packet(handle, &out, pic_send_done) ==
+                           EB_ErrorNone) {
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            svt_av1_enc_release_out_buffer(&out);
+        }
+    }
+    EXPECT_TRUE(eos);
+
+    SvtAv1FixedBuf out_stats;
+    memset(&out_stats, 0, sizeof(out_stats));
+    EXPECT_EQ(
+        EB_ErrorNone,
+        svt_av1_enc_get_stream_info(
+            handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &out_stats));
+    EXPECT_EQ(0u, out_stats.sz % sizeof(FIRSTPASS_STATS));
+    const FIRSTPASS_STATS *frame_stats = (FIRSTPASS_STATS *)out_stats.buf;
+    stats.assign(frame_stats,
+                 frame_stats + out_stats.sz / sizeof(FIRSTPASS_STATS));
+    svt_av1_enc_deinit(handle);
+    svt_av1_enc_deinit_handle(handle);
+    return stats;
+}
+
+/**
+ * @brief The analysis-only first pass estimates the stats of the full first
+ * pass
+ *
+ * Test strategy:
+ * Run the full first pass and the analysis-only first pass over a stream of
+ * a panning texture with a scene change half way, and compare the stats of
+ * each frame and their total.
+ *
+ * Expected result:
+ * The stats describing the frames and the source (frame index, count,
+ * duration, wavelet energy) are identical. The errors and the inter
+ * percentage, which come from the pre-analysis and the ME instead of the
+ * first pass mode decision, stay within a tolerance of the full first pass.
+ */
+TEST(FirstPassAnalysisTest, stats_match_full_first_pass) {
+    const std::vector<FIRSTPASS_STATS> full = first_pass(EB_FALSE);
+    const std::vector<FIRSTPASS_STATS> fast = first_pass(EB_TRUE);
+    ASSERT_EQ(stream_frames + 1, full.size());
+    ASSERT_EQ(full.size(), fast.size());
+
+    for (uint32_t i = 0; i <= stream_frames; i++) {
+        const double tolerance = i < stream_frames ? 0.25 : 0.15;
+        EXPECT_EQ(full[i].frame, fast[i].frame) << "frame " << i;
+        EXPECT_EQ(full[i].count, fast[i].count) << "frame " << i;
+        EXPECT_EQ(full[i].duration, fast[i].duration) << "frame " << i;
+        EXPECT_EQ(full[i].frame_avg_wavelet_energy,
+                  fast[i].frame_avg_wavelet_energy)
+            << "frame " << i;
+        EXPECT_NEAR(full[i].pcnt_inter, fast[i].pcnt_inter,
+                    0.15 * full[i].count)
+            << "frame " << i;
+        EXPECT_NEAR(full[i].intra_error, fast[i].intra_error,
+                    tolerance * full[i].intra_error)
+            << "frame " << i;
+        EXPECT_NEAR(full[i].coded_error, fast[i].coded_error,
+                    tolerance * full[i].coded_error)
+            << "frame " << i;
+    }
+}
+
+}  // namespace
@@ -0,0 +1,374 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file MdPredCacheTest.cc
+ *
+ * @brief Unit test of the MD inter prediction cache:
+ * - md_pred_cache_candidate_eligible
+ * - md_pred_cache_set_key
+ * - md_pred_cache_fetch
+ * - md_pred_cache_store
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbModeDecisionProcess.h"
+#include "EbEncInterPrediction.h"
+#include "common_dsp_rtcd.h"
+
+namespace {
+
+static const uint16_t sb_size = 64;
+// The SB of the blocks in the picture, block positions are relative to it
+static const uint16_t sb_origin_x = 128;
+static const uint16_t sb_origin_y = 64;
+
+/** Block of the SB, with its 4:2:0 chroma */
+static BlockGeom block(uint8_t origin_x, uint8_t origin_y, uint8_t bwidth,
+                       uint8_t bheight) {
+    BlockGeom geom;
+    memset(&geom, 0, sizeof(geom));
+    geom.origin_x = origin_x;
+    geom.origin_y = origin_y;
+    geom.bwidth = bwidth;
+    geom.bheight = bheight;
+    geom.bwidth_uv = bwidth >> 1;
+    geom.bheight_uv = bheight >> 1;
+    geom.has_uv = 1;
+    return geom;
+}
+
+/** An 8-bit prediction buffer of the size of an SB */
+class Prediction {
+  public:
+    Prediction()
+        : luma_(sb_size * sb_size, 0),
+          cb_(sb_size * sb_size / 4, 0),
+          cr_(sb_size * sb_size / 4, 0) {
+        memset(&desc_, 0, sizeof(desc_));
+        desc_.buffer_y = luma_.data();
+        desc_.buffer_cb = cb_.data();
+        desc_.buffer_cr = cr_.data();
+        desc_.stride_y = sb_size;
+        desc_.stride_cb = sb_size / 2;
+        desc_.stride_cr = sb_size / 2;
+        desc_.width = sb_size;
+        desc_.height = sb_size;
+        desc_.bit_depth = EB_8BIT;
+        desc_.color_format = EB_YUV420;
+    }
+
+    /** Fill the whole buffer with a pattern depending on the seed */
+    void fill(uint8_t seed) {
+        for (size_t i = 0; i < luma_.size(); i++)
+            luma_[i] = (uint8_t)(i * 7 + seed);
+        for (size_t i = 0; i < cb_.size(); i++) {
+            cb_[i] = (uint8_t)(i * 3 + seed);
+            cr_[i] = (uint8_t)(i * 5 + seed);
+        }
+    }
+
+    /** Returns true when the block of the SB matches the one of another
+     * buffer, the chroma too when asked */
+    bool same_block(const Prediction &other, const BlockGeom &geom,
+                    bool chroma) const {
+        for (int y = 0; y < geom.bheight; y++) {
+            for (int x = 0; x < geom.bwidth; x++) {
+                const int pos =
+                    (geom.origin_y + y) * sb_size + geom.origin_x + x;
+                if (luma_[pos] != other.luma_[pos])
+                    return false;
+            }
+        }
+        if (!chroma)
+            return true;
+        const int stride = sb_size / 2;
+        for (int y = 0; y < geom.bheight_uv; y++) {
+            for (int x = 0; x < geom.bwidth_uv; x++) {
+                const int pos =
+                    (geom.origin_y / 2 + y) * stride + geom.origin_x / 2 + x;
+                if (cb_[pos] != other.cb_[pos] || cr_[pos] != other.cr_[pos])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    EbPictureBufferDesc desc_;
+
+  private:
+    std::vector<uint8_t> luma_;
+    std::vector<uint8_t> cb_;
+    std::vector<uint8_t> cr_;
+};
+
+class MdPredCacheTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
+        context_ = (ModeDecisionContext *)calloc(1, sizeof(*context_));
+        ASSERT_NE(nullptr, context_);
+        // Room for 4 16x16 blocks with chroma
+        set_pool_size(4 * 16 * 16 * 3 / 2);
+
+        memset(&candidate_, 0, sizeof(candidate_));
+        candidate_.motion_mode = SIMPLE_TRANSLATION;
+        candidate_.ref_frame_type = LAST_FRAME;
+        candidate_.ref_frame_index_l0 = 0;
+        candidate_.ref_frame_index_l1 = -1;
+        candidate_.interp_filters = 0;
+        candidate_.interinter_comp.type = COMPOUND_AVERAGE;
+        memset(&mv_unit_, 0, sizeof(mv_unit_));
+        mv_unit_.pred_direction = UNI_PRED_LIST_0;
+        mv_unit_.mv[REF_LIST_0].x = 13;
+        mv_unit_.mv[REF_LIST_0].y = -6;
+    }
+
+    void TearDown() override {
+        free(context_->pred_cache_pool);
+        free(context_);
+    }
+
+    void set_pool_size(uint32_t size) {
+        free(context_->pred_cache_pool);
+        context_->pred_cache_pool = (uint8_t *)malloc(size);
+        context_->pred_cache_pool_size = size;
+        md_pred_cache_reset(context_);
+    }
+
+    MdPredCacheEntry key(const BlockGeom &geom) {
+        MdPredCacheEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        md_pred_cache_set_key(&entry,
+                              &candidate_,
+                              &mv_unit_,
+                              0,
+                              sb_origin_x + geom.origin_x,
+                              sb_origin_y + geom.origin_y,
+                              &geom);
+        return entry;
+    }
+
+    /** Keep the prediction of the block from a buffer filled with a seed */
+    void store(const BlockGeom &geom, bool chroma, uint8_t seed) {
+        stored_.fill(seed);
+        context_->blk_geom = &geom;
+        const MdPredCacheEntry entry = key(geom);
+        md_pred_cache_store(
+            context_, &entry, (EbBool)chroma, &stored_.desc_);
+    }
+
+    /** Fetch the prediction of the block in a cleared buffer */
+    bool fetch(const BlockGeom &geom, bool chroma) {
+        fetched_.fill(0);
+        context_->blk_geom = &geom;
+        const MdPredCacheEntry entry = key(geom);
+        return md_pred_cache_fetch(
+                   context_, &entry, (EbBool)chroma, &fetched_.desc_) ==
+               EB_TRUE;
+    }
+
+    bool eligible(const BlockGeom &geom) {
+        return md_pred_cache_candidate_eligible(
+                   &candidate_, &mv_unit_, &geom) == EB_TRUE;
+    }
+
+    ModeDecisionContext *context_;
+    ModeDecisionCandidate candidate_;
+    MvUnit mv_unit_;
+    Prediction stored_;
+    Prediction fetched_;
+};
+
+/**
+ * @brief A block is served by a cached prediction of the same key covering
+ * it
+ *
+ * Test strategy:
+ * Store the prediction of a block, then fetch it for the same block, for
+ * square and rectangular blocks inside it and for a block crossing its
+ * edge.
+ *
+ * Expected result:
+ * The blocks inside the cached one hit and get their part of the cached
+ * prediction, luma and chroma. The chroma of blocks with a chroma side of 4
+ * is only served by the same block, the block crossing the edge misses.
+ */
+TEST_F(MdPredCacheTest, hit_covered_blocks) {
+    EXPECT_FALSE(fetch(block(16, 16, 32, 32), true));
+
+    const BlockGeom cached = block(16, 16, 32, 32);
+    store(cached, true, 11);
+    EXPECT_TRUE(fetch(cached, true));
+    EXPECT_TRUE(fetched_.same_block(stored_, cached, true));
+
+    const BlockGeom square = block(32, 16, 16, 16);
+    EXPECT_TRUE(fetch(square, true));
+    EXPECT_TRUE(fetched_.same_block(stored_, square, true));
+
+    const BlockGeom flat = block(16, 40, 32, 8);
+    EXPECT_TRUE(fetch(flat, false));
+    EXPECT_TRUE(fetched_.same_block(stored_, flat, false));
+    EXPECT_FALSE(fetch(flat, true));
+
+    EXPECT_FALSE(fetch(block(8, 16, 16, 16), false));
+    EXPECT_FALSE(fetch(block(40, 40, 16, 16), false));
+}
+
+/**
+ * @brief The chroma of a block is only served by a prediction cached with
+ * its chroma
+ */
+TEST_F(MdPredCacheTest, miss_without_chroma) {
+    const BlockGeom geom = block(0, 0, 16, 16);
+    store(geom, false, 5);
+    EXPECT_FALSE(fetch(geom, true));
+    EXPECT_TRUE(fetch(geom, false));
+    EXPECT_TRUE(fetched_.same_block(stored_, geom, false));
+}
+
+/**
+ * @brief Predictions of other MVs, references, filters or compound settings
+ * are not shared
+ *
+ * Test strategy:
+ * Store a bi-prediction of a block, then change each field of the key in
+ * turn and fetch the block.
+ *
+ * Expected result:
+ * Every changed key misses, the original key still hits.
+ */
+TEST_F(MdPredCacheTest, miss_on_key_collision) {
+    const BlockGeom geom = block(16, 0, 16, 16);
+    mv_unit_.pred_direction = BI_PRED;
+    mv_unit_.mv[REF_LIST_1].x = -20;
+    mv_unit_.mv[REF_LIST_1].y = 4;
+    candidate_.ref_frame_type = LAST_BWD_FRAME;
+    candidate_.ref_frame_index_l1 = 0;
+    candidate_.compound_idx = 1;
+    store(geom, true, 23);
+    const ModeDecisionCandidate candidate = candidate_;
+    const MvUnit mv_unit = mv_unit_;
+
+    mv_unit_.mv[REF_LIST_0].x++;
+    EXPECT_FALSE(fetch(geom, true)) << "MV x of list 0";
+    mv_unit_ = mv_unit;
+    mv_unit_.mv[REF_LIST_0].y--;
+    EXPECT_FALSE(fetch(geom, true)) << "MV y of list 0";
+    mv_unit_ = mv_unit;
+    mv_unit_.mv[REF_LIST_1].x += 8;
+    EXPECT_FALSE(fetch(geom, true)) << "MV x of list 1";
+    mv_unit_ = mv_unit;
+    mv_unit_.pred_direction = UNI_PRED_LIST_0;
+    EXPECT_FALSE(fetch(geom, true)) << "prediction direction";
+    mv_unit_ = mv_unit;
+
+    candidate_.ref_frame_index_l0 = 1;
+    EXPECT_FALSE(fetch(geom, true)) << "reference index of list 0";
+    candidate_ = candidate;
+    candidate_.ref_frame_index_l1 = 2;
+    EXPECT_FALSE(fetch(geom, true)) << "reference index of list 1";
+    candidate_ = candidate;
+    candidate_.ref_frame_type = LAST_ALT_FRAME;
+    EXPECT_FALSE(fetch(geom, true)) << "reference frame type";
+    candidate_ = candidate;
+    candidate_.interp_filters = 1;
+    EXPECT_FALSE(fetch(geom, true)) << "interpolation filters";
+    candidate_ = candidate;
+    candidate_.compound_idx = 0;
+    EXPECT_FALSE(fetch(geom, true)) << "compound index";
+    candidate_ = candidate;
+
+    EXPECT_TRUE(fetch(geom, true));
+    EXPECT_TRUE(fetched_.same_block(stored_, geom, true));
+}
+
+/**
+ * @brief The unused list of a uni-prediction is not part of the key
+ */
+TEST_F(MdPredCacheTest, uni_pred_ignores_other_list) {
+    const BlockGeom geom = block(0, 32, 16, 16);
+    store(geom, true, 31);
+    mv_unit_.mv[REF_LIST_1].x = 100;
+    candidate_.ref_frame_index_l1 = 3;
+    EXPECT_TRUE(fetch(geom, true));
+}
+
+/**
+ * @brief Only translational predictions without masks or inter-intra,
+ * larger than 4, are cached
+ */
+TEST_F(MdPredCacheTest, candidate_eligible) {
+    const BlockGeom geom = block(0, 0, 16, 16);
+    EXPECT_TRUE(eligible(geom));
+
+    candidate_.motion_mode = OBMC_CAUSAL;
+    EXPECT_FALSE(eligible(geom));
+    candidate_.motion_mode = WARPED_CAUSAL;
+    EXPECT_FALSE(eligible(geom));
+    candidate_.motion_mode = SIMPLE_TRANSLATION;
+
+    candidate_.is_interintra_used = 1;
+    EXPECT_FALSE(eligible(geom));
+    candidate_.is_interintra_used = 0;
+
+    const BlockGeom narrow = block(0, 0, 4, 16);
+    EXPECT_FALSE(eligible(narrow));
+    const BlockGeom flat = block(0, 0, 16, 4);
+    EXPECT_FALSE(eligible(flat));
+
+    // The compound type only matters to bi-predictions
+    candidate_.interinter_comp.type = COMPOUND_WEDGE;
+    EXPECT_TRUE(eligible(geom));
+    mv_unit_.pred_direction = BI_PRED;
+    EXPECT_FALSE(eligible(geom));
+    candidate_.interinter_comp.type = COMPOUND_DIFFWTD;
+    EXPECT_FALSE(eligible(geom));
+    candidate_.interinter_comp.type = COMPOUND_AVERAGE;
+    EXPECT_TRUE(eligible(geom));
+}
+
+/**
+ * @brief Predictions overwritten in the pool are no longer served
+ *
+ * Test strategy:
+ * Store one more block than the pool holds, each with its own MV, then
+ * fetch them all.
+ *
+ * Expected result:
+ * The first block, whose prediction was overwritten, misses. The others hit
+ * with their own prediction. After a reset every block misses.
+ */
+TEST_F(MdPredCacheTest, evict_overwritten) {
+    const BlockGeom geom = block(0, 0, 16, 16);
+    for (int i = 0; i < 5; i++) {
+        mv_unit_.mv[REF_LIST_0].x = (int16_t)(i * 4);
+        store(geom, true, (uint8_t)(i * 40));
+    }
+    mv_unit_.mv[REF_LIST_0].x = 0;
+    EXPECT_FALSE(fetch(geom, true));
+    for (int i = 1; i < 5; i++) {
+        mv_unit_.mv[REF_LIST_0].x = (int16_t)(i * 4);
+        ASSERT_TRUE(fetch(geom, true)) << "block " << i;
+        stored_.fill((uint8_t)(i * 40));
+        EXPECT_TRUE(fetched_.same_block(stored_, geom, true))
+            << "block " << i;
+    }
+
+    md_pred_cache_reset(context_);
+    EXPECT_FALSE(fetch(geom, true));
+}
+
+}  // namespace
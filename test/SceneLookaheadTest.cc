@@ -0,0 +1,263 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SceneLookaheadTest.cc
+ *
+ * @brief Unit test for the scene lookahead:
+ * - scene_lookahead_get_input
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbSceneLookahead.h"
+#include "EbPictureBufferDesc.h"
+#include "EbSystemResourceManager.h"
+#include "common_dsp_rtcd.h"
+
+namespace {
+
+static const uint16_t pic_width = 512;
+static const uint16_t pic_height = 256;
+static const uint16_t pic_padding = 8;
+static const uint32_t max_pictures = 64;
+
+enum PictureContent { SCENE_A, SCENE_B, FLASH };
+
+static EbErrorType input_buffer_creator(EbPtr *object_dbl_ptr,
+                                        EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(EbBufferHeaderType));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void input_buffer_destroyer(EbPtr p) {
+    free(p);
+}
+
+/** A padded 4:2:0 input picture */
+class InputPicture {
+  public:
+    InputPicture(PictureContent content, uint32_t index)
+        : stride_(pic_width + 2 * pic_padding),
+          luma_(stride_ * (pic_height + 2 * pic_padding), 0),
+          cb_(luma_.size() / 4, 0),
+          cr_(luma_.size() / 4, 0) {
+        memset(&desc_, 0, sizeof(desc_));
+        desc_.buffer_y = luma_.data();
+        desc_.buffer_cb = cb_.data();
+        desc_.buffer_cr = cr_.data();
+        desc_.stride_y = stride_;
+        desc_.stride_cb = stride_ / 2;
+        desc_.stride_cr = stride_ / 2;
+        desc_.origin_x = pic_padding;
+        desc_.origin_y = pic_padding;
+        desc_.width = pic_width;
+        desc_.height = pic_height;
+        desc_.max_width = pic_width;
+        desc_.max_height = pic_height;
+        desc_.bit_depth = EB_8BIT;
+        desc_.color_format = EB_YUV420;
+
+        // Moving gradients, whose histogram hardly changes from a picture to
+        // the next one, the flash is scene A brightened
+        uint8_t *y = luma_.data() + pic_padding * stride_ + pic_padding;
+        for (uint32_t row = 0; row < pic_height; row++) {
+            for (uint32_t col = 0; col < pic_width; col++) {
+                const uint32_t a = (col / 4 + row / 8 + 2 * index) & 0x7f;
+                const uint32_t b = (col / 2 + row + 3 * index) & 0x7f;
+                y[row * stride_ + col] =
+                    (uint8_t)(content == SCENE_B ? 128 + b
+                                                 : content == FLASH ? a + 110 : a);
+            }
+        }
+        const uint32_t c_stride = stride_ / 2;
+        const uint32_t c_origin = pic_padding / 2 * c_stride + pic_padding / 2;
+        for (uint32_t row = 0; row < pic_height / 2u; row++) {
+            for (uint32_t col = 0; col < pic_width / 2u; col++) {
+                const uint32_t v = (col + row + index) & 15;
+                cb_[c_origin + row * c_stride + col] =
+                    (uint8_t)(content == SCENE_B ? 40 + v : 100 + v);
+                cr_[c_origin + row * c_stride + col] =
+                    (uint8_t)(content == SCENE_B ? 200 - v : 120 + v);
+            }
+        }
+    }
+
+    EbPictureBufferDesc desc_;
+
+  private:
+    uint32_t stride_;
+    std::vector<uint8_t> luma_;
+    std::vector<uint8_t> cb_;
+    std::vector<uint8_t> cr_;
+};
+
+class SceneLookaheadTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
+        memset(&lookahead_, 0, sizeof(lookahead_));
+        memset(&resource_, 0, sizeof(resource_));
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_system_resource_ctor(&resource_,
+                                          max_pictures,
+                                          1,
+                                          1,
+                                          input_buffer_creator,
+                                          nullptr,
+                                          input_buffer_destroyer));
+        producer_fifo_ = eb_system_resource_get_producer_fifo(&resource_, 0);
+        consumer_fifo_ = eb_system_resource_get_consumer_fifo(&resource_, 0);
+    }
+
+    void TearDown() override {
+        for (InputPicture *pic : pictures_)
+            delete pic;
+        if (lookahead_.dctor)
+            lookahead_.dctor(&lookahead_);
+        resource_.dctor(&resource_);
+    }
+
+    void create_lookahead(uint32_t distance) {
+        ASSERT_EQ(EB_ErrorNone, scene_lookahead_ctor(&lookahead_, distance));
+    }
+
+    /** Queue the pictures in the input buffer fifo, then the end of
+     * sequence */
+    void send(const std::vector<PictureContent> &contents) {
+        for (uint32_t i = 0; i <= contents.size(); i++) {
+            EbObjectWrapper *wrapper;
+            ASSERT_EQ(EB_ErrorNone,
+                      eb_get_empty_object(producer_fifo_, &wrapper));
+            EbBufferHeaderType *header =
+                (EbBufferHeaderType *)wrapper->object_ptr;
+            memset(header, 0, sizeof(*header));
+            header->pts = i;
+            if (i < contents.size()) {
+                pictures_.push_back(new InputPicture(contents[i], i));
+                header->p_buffer = (uint8_t *)&pictures_.back()->desc_;
+            } else
+                header->flags = EB_BUFFERFLAG_EOS;
+            eb_post_full_object(wrapper);
+        }
+    }
+
+    /** Take every picture out of the lookahead, in input order */
+    void receive(uint32_t count, std::vector<EbBool> &scene_change,
+                 std::vector<uint32_t> &frames_to_scene_change) {
+        for (uint32_t i = 0; i <= count; i++) {
+            EbObjectWrapper *wrapper = nullptr;
+            EbBool change = EB_TRUE;
+            uint32_t frames = ~0u;
+            ASSERT_EQ(EB_ErrorNone,
+                      scene_lookahead_get_input(&lookahead_,
+                                                consumer_fifo_,
+                                                &wrapper,
+                                                &change,
+                                                &frames));
+            ASSERT_NE(nullptr, wrapper);
+            const EbBufferHeaderType *header =
+                (EbBufferHeaderType *)wrapper->object_ptr;
+            EXPECT_EQ((int64_t)i, header->pts);
+            if (i == count) {
+                EXPECT_TRUE(header->flags & EB_BUFFERFLAG_EOS);
+                break;
+            }
+            scene_change.push_back(change);
+            frames_to_scene_change.push_back(frames);
+        }
+    }
+
+    EbSystemResource resource_;
+    EbFifo *producer_fifo_;
+    EbFifo *consumer_fifo_;
+    SceneLookahead lookahead_;
+    std::vector<InputPicture *> pictures_;
+};
+
+/**
+ * @brief Detect a scene cut ahead of the pictures before it
+ *
+ * Test strategy:
+ * Send pictures of a moving gradient with a cut to another one, through a
+ * lookahead of a few pictures, and take them back out.
+ *
+ * Expected result:
+ * The pictures come out in input order followed by the end of sequence.
+ * Only the first picture of the second scene is a scene change, and the
+ * pictures before it within the lookahead know their distance to it.
+ */
+TEST_F(SceneLookaheadTest, scene_cut) {
+    const uint32_t distance = 6, count = 24, cut = 14;
+    std::vector<PictureContent> contents(count, SCENE_A);
+    for (uint32_t i = cut; i < count; i++)
+        contents[i] = SCENE_B;
+    create_lookahead(distance);
+    send(contents);
+
+    std::vector<EbBool> scene_change;
+    std::vector<uint32_t> frames_to_scene_change;
+    receive(count, scene_change, frames_to_scene_change);
+    ASSERT_EQ(count, scene_change.size());
+    for (uint32_t i = 0; i < count; i++) {
+        EXPECT_EQ(i == cut, scene_change[i] == EB_TRUE) << "picture " << i;
+        // The decision of the newest picture waits for its future picture
+        const uint32_t expected =
+            i < cut && cut - i < distance ? cut - i : 0;
+        EXPECT_EQ(expected, frames_to_scene_change[i]) << "picture " << i;
+    }
+}
+
+/**
+ * @brief A flash or a steady scene is not a scene change
+ */
+TEST_F(SceneLookaheadTest, flash_is_not_a_scene_change) {
+    const uint32_t count = 16, flash = 7;
+    std::vector<PictureContent> contents(count, SCENE_A);
+    contents[flash] = FLASH;
+    create_lookahead(4);
+    send(contents);
+
+    std::vector<EbBool> scene_change;
+    std::vector<uint32_t> frames_to_scene_change;
+    receive(count, scene_change, frames_to_scene_change);
+    ASSERT_EQ(count, scene_change.size());
+    for (uint32_t i = 0; i < count; i++) {
+        EXPECT_FALSE(scene_change[i]) << "picture " << i;
+        EXPECT_EQ(0u, frames_to_scene_change[i]) << "picture " << i;
+    }
+}
+
+/**
+ * @brief A lookahead waiting for pictures returns when the input fifo shuts
+ * down
+ */
+TEST_F(SceneLookaheadTest, shutdown) {
+    create_lookahead(4);
+    send(std::vector<PictureContent>(2, SCENE_A));
+    std::vector<EbBool> scene_change;
+    std::vector<uint32_t> frames_to_scene_change;
+    receive(2, scene_change, frames_to_scene_change);
+
+    eb_shutdown_process(&resource_);
+    EbObjectWrapper *wrapper = nullptr;
+    EbBool change;
+    uint32_t frames;
+    EXPECT_EQ(EB_NoErrorFifoShutdown,
+              scene_lookahead_get_input(
+                  &lookahead_, consumer_fifo_, &wrapper, &change, &frames));
+}
+
+}  // namespace
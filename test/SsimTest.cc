@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SsimTest.cc
+ *
+ * @brief Unit test of the SSIM 8x8 statistics kernels:
+ * - aom_ssim_parms_8x8_avx2
+ * - aom_highbd_ssim_parms_8x8_avx2
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "random.h"
+#include "util.h"
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+typedef void (*SsimParmsFunc)(const uint8_t *s, int sp, const uint8_t *r, int rp,
+                              uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
+                              uint32_t *sum_sq_r, uint32_t *sum_sxr);
+typedef void (*HbdSsimParmsFunc)(const uint8_t *s, int sp, const uint8_t *sinc, int spinc,
+                                 const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r,
+                                 uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+
+static const int kStride = 24;
+static const int kBufSize = kStride * 8;
+static const int kIterations = 1000;
+
+class SsimParmsTest : public ::testing::TestWithParam<SsimParmsFunc> {
+  protected:
+    void run_test(int pattern) {
+        SVTRandom rnd(0, 255);
+        uint8_t src[kBufSize], rec[kBufSize];
+
+        for (int iter = 0; iter < kIterations; ++iter) {
+            for (int i = 0; i < kBufSize; ++i) {
+                src[i] = pattern == 0 ? rnd.random() : (pattern == 1 ? 255 : 0);
+                rec[i] = pattern == 0 ? rnd.random() : (pattern == 1 ? 0 : 255);
+            }
+            // Odd offsets exercise unaligned loads.
+            const int offset = iter % (kStride - 8);
+            uint32_t ref[5] = {0}, tst[5] = {0};
+            aom_ssim_parms_8x8_c(src + offset, kStride, rec + offset, kStride,
+                                 &ref[0], &ref[1], &ref[2], &ref[3], &ref[4]);
+            GetParam()(src + offset, kStride, rec + offset, kStride,
+                       &tst[0], &tst[1], &tst[2], &tst[3], &tst[4]);
+            for (int i = 0; i < 5; ++i)
+                ASSERT_EQ(ref[i], tst[i]) << "statistic " << i << " iter " << iter;
+        }
+    }
+};
+
+TEST_P(SsimParmsTest, MatchesC) {
+    run_test(0);
+    run_test(1);
+    run_test(2);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, SsimParmsTest,
+                        ::testing::Values(aom_ssim_parms_8x8_avx2));
+
+class HbdSsimParmsTest : public ::testing::TestWithParam<HbdSsimParmsFunc> {
+  protected:
+    void run_test(int pattern) {
+        SVTRandom rnd8(0, 255);
+        SVTRandom rnd10(0, 1023);
+        uint8_t src[kBufSize], src_inc[kBufSize];
+        uint16_t rec[kBufSize];
+
+        for (int iter = 0; iter < kIterations; ++iter) {
+            for (int i = 0; i < kBufSize; ++i) {
+                src[i] = pattern == 0 ? rnd8.random() : (pattern == 1 ? 255 : 0);
+                src_inc[i] = pattern == 0 ? rnd8.random() : (pattern == 1 ? 255 : 0);
+                rec[i] = pattern == 0 ? rnd10.random() : (pattern == 1 ? 0 : 1023);
+            }
+            const int offset = iter % (kStride - 8);
+            uint32_t ref[5] = {0}, tst[5] = {0};
+            aom_highbd_ssim_parms_8x8_c(src + offset, kStride, src_inc + offset,
+                                        kStride, rec + offset, kStride, &ref[0],
+                                        &ref[1], &ref[2], &ref[3], &ref[4]);
+            GetParam()(src + offset, kStride, src_inc + offset, kStride,
+                       rec + offset, kStride, &tst[0], &tst[1], &tst[2],
+                       &tst[3], &tst[4]);
+            for (int i = 0; i < 5; ++i)
+                ASSERT_EQ(ref[i], tst[i]) << "statistic " << i << " iter " << iter;
+        }
+    }
+};
+
+TEST_P(HbdSsimParmsTest, MatchesC) {
+    run_test(0);
+    run_test(1);
+    run_test(2);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, HbdSsimParmsTest,
+                        ::testing::Values(aom_highbd_ssim_parms_8x8_avx2));
+
+}  // namespace
@@ -0,0 +1,345 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1DecApiTest.cc
+ *
+ * @brief SVT-AV1 decoder api test, decode a short stream produced by the
+ * encoder library with different decoder setups
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+typedef std::vector<uint8_t> DataUnit;
+typedef std::vector<DataUnit> DataUnits;
+
+static const uint32_t stream_width = 192;
+static const uint32_t stream_height = 128;
+static const uint32_t stream_frames = 12;
+
+/** Fill a moving gradient so that the inter frames carry motion vectors */
+static void fill_frame(EbSvtIOFormat *frame, uint32_t index) {
+    for (uint32_t y = 0; y < frame->height; y++) {
+        for (uint32_t x = 0; x < frame->width; x++)
+            frame->luma[y * frame->y_stride + x] =
+                (uint8_t)((x + 2 * index) * 3 + (y + index) * 2);
+    }
+    for (uint32_t y = 0; y < frame->height / 2; y++) {
+        for (uint32_t x = 0; x < frame->width / 2; x++) {
+            frame->cb[y * frame->cb_stride + x] = (uint8_t)(128 + x - y);
+            frame->cr[y * frame->cr_stride + x] = (uint8_t)(96 + x + index);
+        }
+    }
+}
+
+static void collect_packets(EbComponentType *enc_handle, uint8_t pic_send_done,
+                            DataUnits &units, bool &eos) {
+    EbBufferHeaderType *enc_out = nullptr;
+    while (!eos && svt_av1_enc_get_packet(enc_handle, &enc_out, pic_send_done) ==
+                       EB_ErrorNone) {
+        if (enc_out->n_filled_len)
+            units.push_back(DataUnit(enc_out->p_buffer,
+                                     enc_out->p_buffer + enc_out->n_filled_len));
+        eos = (enc_out->flags & EB_BUFFERFLAG_EOS) != 0;
+        svt_av1_enc_release_out_buffer(&enc_out);
+    }
+}
+
+/** Encode stream_frames frames with the encoder library, one data unit per
+ * packet */
+static void encode_stream(DataUnits &units) {
+    EbComponentType *enc_handle = nullptr;
+    EbSvtAv1EncConfiguration enc_params;
+
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&enc_handle, nullptr, &enc_params));
+    enc_params.source_width = stream_width;
+    enc_params.source_height = stream_height;
+    enc_params.enable_mfmv = 1;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(enc_handle, &enc_params));
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(enc_handle));
+
+    std::vector<uint8_t> yuv(stream_width * stream_height * 3 / 2);
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = yuv.data();
+    frame.cb = frame.luma + stream_width * stream_height;
+    frame.cr = frame.cb + stream_width * stream_height / 4;
+    frame.y_stride = stream_width;
+    frame.cb_stride = stream_width / 2;
+    frame.cr_stride = stream_width / 2;
+    frame.width = stream_width;
+    frame.height = stream_height;
+    frame.color_fmt = EB_YUV420;
+    frame.bit_depth = EB_EIGHT_BIT;
+
+    bool eos = false;
+    for (uint32_t i = 0; i < stream_frames; i++) {
+        EbBufferHeaderType in_buf;
+        memset(&in_buf, 0, sizeof(in_buf));
+        fill_frame(&frame, i);
+        in_buf.size = sizeof(in_buf);
+        in_buf.p_buffer = (uint8_t *)&frame;
+        in_buf.n_filled_len = (uint32_t)yuv.size();
+        in_buf.pts = i;
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(enc_handle, &in_buf));
+        collect_packets(enc_handle, 0, units, eos);
+    }
+    EbBufferHeaderType eos_buf;
+    memset(&eos_buf, 0, sizeof(eos_buf));
+    eos_buf.flags = EB_BUFFERFLAG_EOS;
+    eos_buf.pic_type = EB_AV1_INVALID_PICTURE;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(enc_handle, &eos_buf));
+    collect_packets(enc_handle, 1, units, eos);
+
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(enc_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(enc_handle));
+    ASSERT_TRUE(eos) << "encoder did not signal the end of the stream";
+}
+
+/** Output picture with malloc'ed planes, as the asynchronous mode requires */
+class DecOutput {
+  public:
+    DecOutput() {
+        memset(&img_, 0, sizeof(img_));
+        img_.luma = (uint8_t *)malloc(stream_width * stream_height);
+        img_.cb = (uint8_t *)malloc(stream_width * stream_height / 4);
+        img_.cr = (uint8_t *)malloc(stream_width * stream_height / 4);
+        img_.y_stride = stream_width;
+        img_.cb_stride = stream_width / 2;
+        img_.cr_stride = stream_width / 2;
+        img_.width = stream_width;
+        img_.height = stream_height;
+        img_.color_fmt = EB_YUV420;
+        img_.bit_depth = EB_EIGHT_BIT;
+        memset(&buf_, 0, sizeof(buf_));
+        buf_.p_buffer = (uint8_t *)&img_;
+    }
+    ~DecOutput() {
+        free(img_.luma);
+        free(img_.cb);
+        free(img_.cr);
+    }
+
+    EbErrorType get(EbComponentType *dec_handle) {
+        return svt_av1_dec_get_picture(
+            dec_handle, &buf_, &stream_info_, &frame_info_);
+    }
+    /** Copy of the luma plane of the last returned picture */
+    DataUnit luma() const {
+        DataUnit plane;
+        for (uint32_t y = 0; y < stream_height; y++)
+            plane.insert(plane.end(),
+                         img_.luma + y * img_.y_stride,
+                         img_.luma + y * img_.y_stride + stream_width);
+        return plane;
+    }
+
+  private:
+    EbSvtIOFormat img_;
+    EbBufferHeaderType buf_;
+    EbAV1StreamInfo stream_info_;
+    EbAV1FrameInfo frame_info_;
+};
+
+/** Decode the data units and return the first error reported by the
+ * decoder, the decoded luma planes are appended to pictures */
+static EbErrorType decode_stream(const DataUnits &units, uint32_t threads,
+                                 uint32_t input_queue_depth,
+                                 std::vector<DataUnit> &pictures) {
+    EbComponentType *dec_handle = nullptr;
+    EbSvtAv1DecConfiguration dec_params;
+    EbErrorType error = EB_ErrorNone;
+    DecOutput out;
+
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_dec_init_handle(&dec_handle, nullptr, &dec_params));
+    if (dec_handle == nullptr)
+        return EB_ErrorInsufficientResources;
+    dec_params.max_picture_width = stream_width;
+    dec_params.max_picture_height = stream_height;
+    dec_params.threads = threads;
+    dec_params.input_queue_depth = input_queue_depth;
+    dec_params.output_queue_depth = 2;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_set_parameter(dec_handle, &dec_params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_init(dec_handle));
+
+    EbErrorType pic_error = EB_ErrorNone;
+    for (size_t i = 0; i < units.size() && error == EB_ErrorNone; i++) {
+        EbErrorType send_error;
+        while ((send_error = svt_av1_dec_frame(dec_handle,
+                                               units[i].data(),
+                                               units[i].size(),
+                                               0)) == EB_DecInputQueueFull) {
+            if (out.get(dec_handle) == EB_ErrorNone)
+                pictures.push_back(out.luma());
+        }
+        error = send_error;
+        while ((pic_error = out.get(dec_handle)) == EB_ErrorNone) {
+            pictures.push_back(out.luma());
+            if (!input_queue_depth)
+                break;
+        }
+        if (pic_error != EB_ErrorNone && pic_error != EB_DecNoOutputPicture &&
+            error == EB_ErrorNone)
+            error = pic_error;
+    }
+    if (input_queue_depth) {
+        EbErrorType eos_error = svt_av1_dec_frame(dec_handle, nullptr, 0, 0);
+        if (error == EB_ErrorNone)
+            error = eos_error;
+        while ((pic_error = out.get(dec_handle)) == EB_ErrorNone)
+            pictures.push_back(out.luma());
+        if (pic_error != EB_DecNoOutputPicture && error == EB_ErrorNone)
+            error = pic_error;
+        /* The error stays reported once the queue is drained */
+        if (error != EB_ErrorNone) {
+            EXPECT_EQ(error, out.get(dec_handle));
+        }
+    }
+
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_deinit(dec_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_deinit_handle(dec_handle));
+    return error;
+}
+
+class DecApiTest : public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        units_ = new DataUnits;
+        encode_stream(*units_);
+    }
+    static void TearDownTestCase() {
+        delete units_;
+        units_ = nullptr;
+    }
+
+    static DataUnits *units_;
+};
+
+DataUnits *DecApiTest::units_ = nullptr;
+
+/** @brief close_mt is a api test case
+ * DecApiTest.close_mt checks that the decoder can be closed with three or
+ * more threads, after a stream using motion field projection
+ *
+ * Test strategy: <br>
+ * Decode the stream with 1, 3 and 4 threads, then close the decoder.
+ *
+ * Expected result: <br>
+ * svt_av1_dec_deinit returns, and the pictures match the single threaded
+ * decode.
+ *
+ * Test coverage:
+ * svt_av1_dec_deinit with threads >= 3.
+ */
+TEST_F(DecApiTest, close_mt) {
+    ASSERT_FALSE(units_->empty());
+    std::vector<DataUnit> ref_pictures;
+    ASSERT_EQ(EB_ErrorNone, decode_stream(*units_, 1, 0, ref_pictures));
+    ASSERT_EQ(stream_frames, ref_pictures.size());
+
+    for (uint32_t threads = 3; threads <= 4; threads++) {
+        std::vector<DataUnit> pictures;
+        ASSERT_EQ(EB_ErrorNone, decode_stream(*units_, threads, 0, pictures))
+            << "threads " << threads;
+        EXPECT_TRUE(pictures == ref_pictures) << "threads " << threads;
+    }
+}
+
+/** @brief close_mt_no_frame checks that a multi threaded decoder which has
+ * not decoded any frame can be closed */
+TEST(DecApiMtTest, close_mt_no_frame) {
+    for (uint32_t threads = 2; threads <= 4; threads++) {
+        std::vector<DataUnit> pictures;
+        EXPECT_EQ(EB_ErrorNone,
+                  decode_stream(DataUnits(), threads, 0, pictures));
+        EXPECT_TRUE(pictures.empty());
+    }
+}
+
+/** @brief async_decode is a api test case
+ * DecApiTest.async_decode checks the asynchronous decode against the
+ * synchronous one
+ *
+ * Test strategy: <br>
+ * Decode the stream with an input queue, with 1 and 3 threads.
+ *
+ * Expected result: <br>
+ * All the pictures are returned in order and match the synchronous decode,
+ * the end of the stream and the drained queue report no error.
+ *
+ * Test coverage:
+ * svt_av1_dec_frame and svt_av1_dec_get_picture with input_queue_depth.
+ */
+TEST_F(DecApiTest, async_decode) {
+    std::vector<DataUnit> ref_pictures;
+    ASSERT_EQ(EB_ErrorNone, decode_stream(*units_, 1, 0, ref_pictures));
+
+    for (uint32_t threads = 1; threads <= 3; threads += 2) {
+        std::vector<DataUnit> pictures;
+        ASSERT_EQ(EB_ErrorNone, decode_stream(*units_, threads, 2, pictures))
+            << "threads " << threads;
+        EXPECT_TRUE(pictures == ref_pictures) << "threads " << threads;
+    }
+}
+
+/** @brief async_corrupt_stream is a api test case
+ * DecApiTest.async_corrupt_stream checks that the error of a queued decode
+ * reaches the application
+ *
+ * Test strategy: <br>
+ * Truncate the largest inter data unit and drop the following ones, then
+ * decode the stream with an input queue, with 1 and 3 threads.
+ *
+ * Expected result: <br>
+ * The pictures before the corrupt unit are returned, then the error is
+ * returned by the end of stream call or by svt_av1_dec_get_picture, and
+ * stays returned once the queue is drained.
+ *
+ * Test coverage:
+ * Error reporting of svt_av1_dec_frame and svt_av1_dec_get_picture with
+ * input_queue_depth.
+ */
+TEST_F(DecApiTest, async_corrupt_stream) {
+    std::vector<DataUnit> ref_pictures;
+    ASSERT_EQ(EB_ErrorNone, decode_stream(*units_, 1, 0, ref_pictures));
+
+    ASSERT_GT(units_->size(), 2u);
+    size_t corrupt = 1;
+    for (size_t i = 2; i < units_->size(); i++) {
+        if ((*units_)[i].size() > (*units_)[corrupt].size())
+            corrupt = i;
+    }
+    DataUnits units(units_->begin(), units_->begin() + corrupt + 1);
+    units.back().resize(units.back().size() / 2);
+
+    for (uint32_t threads = 1; threads <= 3; threads += 2) {
+        std::vector<DataUnit> pictures;
+        EXPECT_NE(EB_ErrorNone, decode_stream(units, threads, 2, pictures))
+            << "threads " << threads;
+        ASSERT_LE(pictures.size(), ref_pictures.size());
+        EXPECT_TRUE(std::equal(pictures.begin(), pictures.end(),
+                               ref_pictures.begin()))
+            << "threads " << threads;
+    }
+}
+
+}  // namespace
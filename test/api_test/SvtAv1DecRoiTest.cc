@@ -0,0 +1,257 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1DecRoiTest.cc
+ *
+ * @brief SVT-AV1 decoder region of interest test, decode a tiled stream
+ * produced by the encoder library with and without a region of interest
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+typedef std::vector<uint8_t> DataUnit;
+typedef std::vector<DataUnit> DataUnits;
+
+static const uint32_t stream_width = 512;
+static const uint32_t stream_height = 256;
+static const uint32_t stream_frames = 3;
+
+/** Region of interest across the boundary of the two middle tile columns */
+static const uint32_t roi_x = 201;
+static const uint32_t roi_y = 24;
+static const uint32_t roi_width = 96;
+static const uint32_t roi_height = 63;
+
+/** Sample of a fixed random texture */
+static uint8_t texture(uint32_t x, uint32_t y, uint32_t seed) {
+    uint32_t h = (x * 73856093u) ^ (y * 19349663u) ^ (seed * 83492791u);
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return (uint8_t)(h & 0xff);
+}
+
+/** Fill a different textured frame for each index, so that every in-loop
+ * filter has edges to work on */
+static void fill_frame(EbSvtIOFormat *frame, uint32_t index) {
+    for (uint32_t y = 0; y < frame->height; y++) {
+        for (uint32_t x = 0; x < frame->width; x++)
+            frame->luma[y * frame->y_stride + x] =
+                (uint8_t)((texture(x / 16, y / 16, index) +
+                           texture(x, y, index) / 4 + x / 2) /
+                          2);
+    }
+    for (uint32_t y = 0; y < frame->height / 2; y++) {
+        for (uint32_t x = 0; x < frame->width / 2; x++) {
+            frame->cb[y * frame->cb_stride + x] =
+                (uint8_t)(96 + texture(x / 8, y / 8, index + 7) / 4);
+            frame->cr[y * frame->cr_stride + x] =
+                (uint8_t)(128 - x / 4 + y / 2);
+        }
+    }
+}
+
+static void collect_packets(EbComponentType *enc_handle, uint8_t pic_send_done,
+                            DataUnits &units, bool &eos) {
+    EbBufferHeaderType *enc_out = nullptr;
+    while (!eos && svt_av1_enc_get_packet(enc_handle, &enc_out, pic_send_done) ==
+                       EB_ErrorNone) {
+        if (enc_out->n_filled_len)
+            units.push_back(DataUnit(enc_out->p_buffer,
+                                     enc_out->p_buffer + enc_out->n_filled_len));
+        eos = (enc_out->flags & EB_BUFFERFLAG_EOS) != 0;
+        svt_av1_enc_release_out_buffer(&enc_out);
+    }
+}
+
+/** Encode an intra-only stream of 4x2 tiles with loop restoration and film
+ * grain, one data unit per packet. Intra-only keeps the region exact, as no
+ * motion reaches it from the tiles that are not reconstructed. */
+static void encode_stream(DataUnits &units) {
+    EbComponentType *enc_handle = nullptr;
+    EbSvtAv1EncConfiguration enc_params;
+    memset(&enc_params, 0, sizeof(enc_params));
+
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&enc_handle, nullptr, &enc_params));
+    enc_params.source_width = stream_width;
+    enc_params.source_height = stream_height;
+    enc_params.enc_mode = MAX_ENC_PRESET;
+    enc_params.intra_period_length = 0;
+    enc_params.tile_columns = 2;
+    enc_params.tile_rows = 1;
+    enc_params.enable_restoration_filtering = 1;
+    enc_params.film_grain_denoise_strength = 10;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(enc_handle, &enc_params));
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(enc_handle));
+
+    std::vector<uint8_t> yuv(stream_width * stream_height * 3 / 2);
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = yuv.data();
+    frame.cb = frame.luma + stream_width * stream_height;
+    frame.cr = frame.cb + stream_width * stream_height / 4;
+    frame.y_stride = stream_width;
+    frame.cb_stride = stream_width / 2;
+    frame.cr_stride = stream_width / 2;
+    frame.width = stream_width;
+    frame.height = stream_height;
+    frame.color_fmt = EB_YUV420;
+    frame.bit_depth = EB_EIGHT_BIT;
+
+    bool eos = false;
+    for (uint32_t i = 0; i < stream_frames; i++) {
+        EbBufferHeaderType in_buf;
+        memset(&in_buf, 0, sizeof(in_buf));
+        fill_frame(&frame, i);
+        in_buf.size = sizeof(in_buf);
+        in_buf.p_buffer = (uint8_t *)&frame;
+        in_buf.n_filled_len = (uint32_t)yuv.size();
+        in_buf.pts = i;
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(enc_handle, &in_buf));
+        collect_packets(enc_handle, 0, units, eos);
+    }
+    EbBufferHeaderType eos_buf;
+    memset(&eos_buf, 0, sizeof(eos_buf));
+    eos_buf.flags = EB_BUFFERFLAG_EOS;
+    eos_buf.pic_type = EB_AV1_INVALID_PICTURE;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(enc_handle, &eos_buf));
+    collect_packets(enc_handle, 1, units, eos);
+
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(enc_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(enc_handle));
+    ASSERT_TRUE(eos) << "encoder did not signal the end of the stream";
+}
+
+/** The three planes of a decoded picture, cropped to a luma rectangle
+ * aligned to the chroma grid */
+static DataUnit crop_picture(const EbSvtIOFormat &img, uint32_t x, uint32_t y,
+                             uint32_t width, uint32_t height) {
+    DataUnit planes;
+    for (uint32_t j = 0; j < height; j++) {
+        const uint8_t *row = img.luma + (y + j) * img.y_stride + x;
+        planes.insert(planes.end(), row, row + width);
+    }
+    const uint8_t *chroma[2] = {img.cb, img.cr};
+    const uint32_t chroma_stride[2] = {img.cb_stride, img.cr_stride};
+    for (int plane = 0; plane < 2; plane++) {
+        for (uint32_t j = 0; j < (height + 1) / 2; j++) {
+            const uint8_t *row =
+                chroma[plane] + (y / 2 + j) * chroma_stride[plane] + x / 2;
+            planes.insert(planes.end(), row, row + (width + 1) / 2);
+        }
+    }
+    return planes;
+}
+
+/** Decode the data units, in full or with the region of interest, and
+ * return the pictures cropped to the region */
+static void decode_stream(const DataUnits &units, uint32_t threads, bool roi,
+                          std::vector<DataUnit> &pictures) {
+    EbComponentType *dec_handle = nullptr;
+    EbSvtAv1DecConfiguration dec_params;
+
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_dec_init_handle(&dec_handle, nullptr, &dec_params));
+    dec_params.max_picture_width = stream_width;
+    dec_params.max_picture_height = stream_height;
+    dec_params.threads = threads;
+    if (roi) {
+        dec_params.roi_x = roi_x;
+        dec_params.roi_y = roi_y;
+        dec_params.roi_width = roi_width;
+        dec_params.roi_height = roi_height;
+    }
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_set_parameter(dec_handle, &dec_params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_init(dec_handle));
+
+    /* The decoder allocates the planes to the size of the output */
+    EbSvtIOFormat img;
+    memset(&img, 0, sizeof(img));
+    img.color_fmt = EB_YUV420;
+    img.bit_depth = EB_EIGHT_BIT;
+    EbBufferHeaderType buf;
+    memset(&buf, 0, sizeof(buf));
+    buf.p_buffer = (uint8_t *)&img;
+    EbAV1StreamInfo stream_info;
+    EbAV1FrameInfo frame_info;
+
+    /* The region is output from its even luma position */
+    const uint32_t x = roi_x & ~1u, y = roi_y & ~1u;
+    const uint32_t width = roi_x + roi_width - x;
+    const uint32_t height = roi_y + roi_height - y;
+    for (size_t i = 0; i < units.size(); i++) {
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_dec_frame(
+                      dec_handle, units[i].data(), units[i].size(), 0));
+        if (svt_av1_dec_get_picture(
+                dec_handle, &buf, &stream_info, &frame_info) != EB_ErrorNone)
+            continue;
+        if (roi) {
+            EXPECT_EQ(width, img.width);
+            EXPECT_EQ(height, img.height);
+            pictures.push_back(crop_picture(img, 0, 0, width, height));
+        } else
+            pictures.push_back(crop_picture(img, x, y, width, height));
+    }
+
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_deinit(dec_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_deinit_handle(dec_handle));
+    free(img.luma);
+    free(img.cb);
+    free(img.cr);
+}
+
+/** @brief matches_full_decode is a api test case
+ * DecRoiTest.matches_full_decode checks the region of interest decode
+ * against the same crop of the full decode
+ *
+ * Test strategy: <br>
+ * Encode an intra-only stream of 4x2 tiles with loop restoration and film
+ * grain. Decode it in full and with an odd sized region of interest across
+ * a tile column boundary, with 1 and 3 threads.
+ *
+ * Expected result: <br>
+ * All the pictures are output, and the three planes of the region of
+ * interest decode match the crop of the full decode: deblocking, CDEF, loop
+ * restoration and film grain are exact inside the region.
+ *
+ * Test coverage:
+ * roi_x, roi_y, roi_width and roi_height of the decoder configuration.
+ */
+TEST(DecRoiTest, matches_full_decode) {
+    DataUnits units;
+    encode_stream(units);
+    ASSERT_FALSE(units.empty());
+
+    for (uint32_t threads = 1; threads <= 3; threads += 2) {
+        std::vector<DataUnit> ref_pictures, pictures;
+        decode_stream(units, threads, false, ref_pictures);
+        decode_stream(units, threads, true, pictures);
+        ASSERT_EQ(stream_frames, ref_pictures.size()) << "threads " << threads;
+        ASSERT_EQ(ref_pictures.size(), pictures.size())
+            << "threads " << threads;
+        for (uint32_t i = 0; i < stream_frames; i++)
+            EXPECT_TRUE(pictures[i] == ref_pictures[i])
+                << "threads " << threads << " frame " << i;
+    }
+}
+
+}  // namespace
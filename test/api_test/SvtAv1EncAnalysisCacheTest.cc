@@ -0,0 +1,145 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1EncAnalysisCacheTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, re-encode a source from the analysis cache
+ * written by a first encode
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+static const uint32_t stream_width = 192;
+static const uint32_t stream_height = 128;
+static const uint32_t stream_frames = 24;
+
+/** Fill a moving gradient with a scene change half way */
+static void fill_frame(EbSvtIOFormat *frame, uint32_t index) {
+    const uint32_t scene = index < stream_frames / 2 ? 3 : 7;
+    for (uint32_t y = 0; y < frame->height; y++) {
+        for (uint32_t x = 0; x < frame->width; x++)
+            frame->luma[y * frame->y_stride + x] =
+                (uint8_t)((x + 3 * index) * scene + (y + index) * 2);
+    }
+    for (uint32_t y = 0; y < frame->height / 2; y++) {
+        for (uint32_t x = 0; x < frame->width / 2; x++) {
+            frame->cb[y * frame->cb_stride + x] = (uint8_t)(128 + x - y);
+            frame->cr[y * frame->cr_stride + x] = (uint8_t)(96 + x + index);
+        }
+    }
+}
+
+/** Encode the stream at a QP with the analysis cache in a mode, returns the
+ * bitstream */
+static std::vector<uint8_t> encode(uint32_t qp, uint8_t cache_mode,
+                                   const std::string &cache_path) {
+    std::vector<uint8_t> bitstream;
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration params;
+    memset(&params, 0, sizeof(params));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&handle, nullptr, &params));
+    if (!handle)
+        return bitstream;
+    params.source_width = stream_width;
+    params.source_height = stream_height;
+    params.enc_mode = MAX_ENC_PRESET;
+    params.rate_control_mode = 0;
+    params.qp = qp;
+    params.analysis_cache_mode = cache_mode;
+    params.analysis_cache_path = cache_mode ? cache_path.c_str() : nullptr;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(handle, &params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(handle));
+
+    std::vector<uint8_t> yuv(stream_width * stream_height * 3 / 2);
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = yuv.data();
+    frame.cb = frame.luma + stream_width * stream_height;
+    frame.cr = frame.cb + stream_width * stream_height / 4;
+    frame.y_stride = stream_width;
+    frame.cb_stride = stream_width / 2;
+    frame.cr_stride = stream_width / 2;
+    frame.width = stream_width;
+    frame.height = stream_height;
+    frame.color_fmt = EB_YUV420;
+    frame.bit_depth = EB_EIGHT_BIT;
+
+    bool eos = false;
+    for (uint32_t i = 0; i <= stream_frames && !eos; i++) {
+        EbBufferHeaderType in_buf;
+        memset(&in_buf, 0, sizeof(in_buf));
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        if (i < stream_frames) {
+            fill_frame(&frame, i);
+            in_buf.size = sizeof(in_buf);
+            in_buf.p_buffer = (uint8_t *)&frame;
+            in_buf.n_filled_len = (uint32_t)yuv.size();
+            in_buf.pts = i;
+        } else
+            in_buf.flags = EB_BUFFERFLAG_EOS;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle, &in_buf));
+
+        const uint8_t pic_send_done = i == stream_frames;
+        EbBufferHeaderType *out = nullptr;
+        while (!eos && svt_av1_enc_get_packet(handle, &out, pic_send_done) ==
+                           EB_ErrorNone) {
+            bitstream.insert(bitstream.end(),
+                             out->p_buffer,
+                             out->p_buffer + out->n_filled_len);
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            svt_av1_enc_release_out_buffer(&out);
+        }
+    }
+    EXPECT_TRUE(eos);
+    svt_av1_enc_deinit(handle);
+    svt_av1_enc_deinit_handle(handle);
+    return bitstream;
+}
+
+/**
+ * @brief Re-encode a source from its analysis cache
+ *
+ * Test strategy:
+ * Encode the stream while writing the analysis cache, then encode it again
+ * reading the cache, at the same QP and at another QP of the same temporal
+ * filter QP class. Encode both QPs without the cache as reference.
+ *
+ * Expected result:
+ * The analysis does not depend on the QP, so the encodes from the cache are
+ * bit identical to the ones that ran the analysis.
+ */
+TEST(EncApiTest, analysis_cache_reencode) {
+    const std::string path =
+        testing::TempDir() + "svt_analysis_cache_reencode.bin";
+
+    const std::vector<uint8_t> written = encode(40, 1, path);
+    ASSERT_FALSE(written.empty());
+    EXPECT_EQ(written, encode(40, 0, path));
+    EXPECT_EQ(written, encode(40, 2, path));
+
+    const std::vector<uint8_t> reference = encode(50, 0, path);
+    ASSERT_FALSE(reference.empty());
+    EXPECT_NE(written, reference);
+    EXPECT_EQ(reference, encode(50, 2, path));
+
+    remove(path.c_str());
+}
+
+}  // namespace
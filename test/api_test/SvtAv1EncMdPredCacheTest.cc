@@ -0,0 +1,151 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1EncMdPredCacheTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, the MD inter prediction cache does not
+ * change the output
+ *
+ ******************************************************************************/
+#include <string.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+static const uint32_t stream_width = 192;
+static const uint32_t stream_height = 128;
+static const uint32_t stream_frames = 24;
+
+/** Fill a moving gradient with a scene change half way, 16-bit samples are
+ * scaled to 10 bits */
+static void fill_frame(EbSvtIOFormat *frame, uint32_t index, bool is16bit) {
+    const uint32_t scene = index < stream_frames / 2 ? 3 : 7;
+    for (uint32_t y = 0; y < frame->height; y++) {
+        for (uint32_t x = 0; x < frame->width; x++) {
+            const uint32_t v =
+                ((x + 3 * index) * scene + (y + index) * 2 + x * y % 5) & 0xff;
+            if (is16bit)
+                ((uint16_t *)frame->luma)[y * frame->y_stride + x] =
+                    (uint16_t)(v << 2 | (x & 3));
+            else
+                frame->luma[y * frame->y_stride + x] = (uint8_t)v;
+        }
+    }
+    for (uint32_t y = 0; y < frame->height / 2; y++) {
+        for (uint32_t x = 0; x < frame->width / 2; x++) {
+            const uint32_t cb = (128 + x - y) & 0xff;
+            const uint32_t cr = (96 + x + index) & 0xff;
+            if (is16bit) {
+                ((uint16_t *)frame->cb)[y * frame->cb_stride + x] =
+                    (uint16_t)(cb << 2);
+                ((uint16_t *)frame->cr)[y * frame->cr_stride + x] =
+                    (uint16_t)(cr << 2);
+            } else {
+                frame->cb[y * frame->cb_stride + x] = (uint8_t)cb;
+                frame->cr[y * frame->cr_stride + x] = (uint8_t)cr;
+            }
+        }
+    }
+}
+
+/** Encode the stream with the MD prediction cache on or off, returns the
+ * bitstream */
+static std::vector<uint8_t> encode(uint32_t bit_depth, int md_pred_cache) {
+    std::vector<uint8_t> bitstream;
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration params;
+    memset(&params, 0, sizeof(params));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&handle, nullptr, &params));
+    if (!handle)
+        return bitstream;
+    params.source_width = stream_width;
+    params.source_height = stream_height;
+    params.encoder_bit_depth = bit_depth;
+    params.enc_mode = MAX_ENC_PRESET;
+    params.rate_control_mode = 0;
+    params.qp = 30;
+    params.enable_md_pred_cache = md_pred_cache;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(handle, &params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(handle));
+
+    const bool is16bit = bit_depth > 8;
+    const size_t luma_size = stream_width * stream_height << is16bit;
+    std::vector<uint8_t> yuv(luma_size * 3 / 2);
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = yuv.data();
+    frame.cb = frame.luma + luma_size;
+    frame.cr = frame.cb + luma_size / 4;
+    frame.y_stride = stream_width;
+    frame.cb_stride = stream_width / 2;
+    frame.cr_stride = stream_width / 2;
+    frame.width = stream_width;
+    frame.height = stream_height;
+    frame.color_fmt = EB_YUV420;
+    frame.bit_depth = is16bit ? EB_TEN_BIT : EB_EIGHT_BIT;
+
+    bool eos = false;
+    for (uint32_t i = 0; i <= stream_frames && !eos; i++) {
+        EbBufferHeaderType in_buf;
+        memset(&in_buf, 0, sizeof(in_buf));
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        if (i < stream_frames) {
+            fill_frame(&frame, i, is16bit);
+            in_buf.size = sizeof(in_buf);
+            in_buf.p_buffer = (uint8_t *)&frame;
+            in_buf.n_filled_len = (uint32_t)yuv.size();
+            in_buf.pts = i;
+        } else
+            in_buf.flags = EB_BUFFERFLAG_EOS;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle, &in_buf));
+
+        const uint8_t pic_send_done = i == stream_frames;
+        EbBufferHeaderType *out = nullptr;
+        while (!eos && svt_av1_enc_get_packet(handle, &out, pic_send_done) ==
+                           EB_ErrorNone) {
+            bitstream.insert(bitstream.end(),
+                             out->p_buffer,
+                             out->p_buffer + out->n_filled_len);
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            svt_av1_enc_release_out_buffer(&out);
+        }
+    }
+    EXPECT_TRUE(eos);
+    svt_av1_enc_deinit(handle);
+    svt_av1_enc_deinit_handle(handle);
+    return bitstream;
+}
+
+/**
+ * @brief The MD inter prediction cache does not change the output
+ *
+ * Test strategy:
+ * Encode a stream with motion and a scene change with the MD prediction
+ * cache on, off and left to its default, in 8 bit and in 10 bit.
+ *
+ * Expected result:
+ * The bitstreams are identical, as the cached predictions are the ones MD
+ * would compute again.
+ */
+TEST(EncApiTest, md_pred_cache_bit_exact) {
+    for (uint32_t bit_depth = 8; bit_depth <= 10; bit_depth += 2) {
+        const std::vector<uint8_t> off = encode(bit_depth, 0);
+        ASSERT_FALSE(off.empty()) << "bit depth " << bit_depth;
+        EXPECT_EQ(off, encode(bit_depth, 1)) << "bit depth " << bit_depth;
+        EXPECT_EQ(off, encode(bit_depth, -1)) << "bit depth " << bit_depth;
+    }
+}
+
+}  // namespace
@@ -0,0 +1,175 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1EncSceneChangeTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, scene changes found by the scene lookahead
+ * start a new intra period
+ *
+ ******************************************************************************/
+#include <string.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+static const uint32_t stream_width = 512;
+static const uint32_t stream_height = 256;
+static const uint32_t stream_frames = 32;
+static const uint32_t scene_cut = 21;
+
+/** Fill a moving gradient, replaced by another one at the scene cut */
+static void fill_frame(EbSvtIOFormat *frame, uint32_t index) {
+    const bool second_scene = index >= scene_cut;
+    for (uint32_t y = 0; y < frame->height; y++) {
+        for (uint32_t x = 0; x < frame->width; x++) {
+            frame->luma[y * frame->y_stride + x] =
+                second_scene ? (uint8_t)(128 + ((x / 2 + y + 3 * index) & 0x7f))
+                             : (uint8_t)((x / 4 + y / 8 + 2 * index) & 0x7f);
+        }
+    }
+    for (uint32_t y = 0; y < frame->height / 2; y++) {
+        for (uint32_t x = 0; x < frame->width / 2; x++) {
+            const uint32_t v = (x + y + index) & 15;
+            frame->cb[y * frame->cb_stride + x] =
+                (uint8_t)(second_scene ? 40 + v : 100 + v);
+            frame->cr[y * frame->cr_stride + x] =
+                (uint8_t)(second_scene ? 200 - v : 120 + v);
+        }
+    }
+}
+
+/** Encode the stream, returns the pts of the intra pictures */
+static std::vector<int64_t> encode_intra_pts(uint32_t scene_change_detection) {
+    std::vector<int64_t> intra_pts;
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration params;
+    memset(&params, 0, sizeof(params));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&handle, nullptr, &params));
+    if (!handle)
+        return intra_pts;
+    params.source_width = stream_width;
+    params.source_height = stream_height;
+    params.enc_mode = MAX_ENC_PRESET;
+    params.rate_control_mode = 0;
+    params.intra_period_length = 63;
+    params.intra_refresh_type = 1;  // CRA
+    params.scene_change_detection = scene_change_detection;
+    params.scene_lookahead_distance = scene_change_detection ? 16 : 0;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(handle, &params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(handle));
+
+    std::vector<uint8_t> yuv(stream_width * stream_height * 3 / 2);
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = yuv.data();
+    frame.cb = frame.luma + stream_width * stream_height;
+    frame.cr = frame.cb + stream_width * stream_height / 4;
+    frame.y_stride = stream_width;
+    frame.cb_stride = stream_width / 2;
+    frame.cr_stride = stream_width / 2;
+    frame.width = stream_width;
+    frame.height = stream_height;
+    frame.color_fmt = EB_YUV420;
+    frame.bit_depth = EB_EIGHT_BIT;
+
+    bool eos = false;
+    for (uint32_t i = 0; i <= stream_frames && !eos; i++) {
+        EbBufferHeaderType in_buf;
+        memset(&in_buf, 0, sizeof(in_buf));
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        if (i < stream_frames) {
+            fill_frame(&frame, i);
+            in_buf.size = sizeof(in_buf);
+            in_buf.p_buffer = (uint8_t *)&frame;
+            in_buf.n_filled_len = (uint32_t)yuv.size();
+            in_buf.pts = i;
+        } else
+            in_buf.flags = EB_BUFFERFLAG_EOS;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle, &in_buf));
+
+        const uint8_t pic_send_done = i == stream_frames;
+        EbBufferHeaderType *out = nullptr;
+        while (!eos && svt_av1_enc_get_packet(handle, &out, pic_send_done) ==
+                           EB_ErrorNone) {
+            if (out->pic_type == EB_AV1_KEY_PICTURE ||
+                out->pic_type == EB_AV1_INTRA_ONLY_PICTURE)
+                intra_pts.push_back(out->pts);
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            svt_av1_enc_release_out_buffer(&out);
+        }
+    }
+    EXPECT_TRUE(eos);
+    svt_av1_enc_deinit(handle);
+    svt_av1_enc_deinit_handle(handle);
+    return intra_pts;
+}
+
+/**
+ * @brief Scene changes found by the scene lookahead are coded as CRAs
+ *
+ * Test strategy:
+ * Encode a stream with a scene cut in the middle of a mini GOP, with an
+ * intra period longer than the stream, with and without scene change
+ * detection.
+ *
+ * Expected result:
+ * Without scene change detection only the first picture is intra coded,
+ * with it the first picture of the new scene is intra coded too.
+ */
+TEST(EncApiTest, scene_change_cra) {
+    EXPECT_EQ(std::vector<int64_t>({0}), encode_intra_pts(0));
+    EXPECT_EQ(std::vector<int64_t>({0, scene_cut}), encode_intra_pts(1));
+}
+
+/** Set the scene change settings on a new encoder, returns the result */
+static EbErrorType set_scene_change(uint32_t scene_change_detection,
+                                    uint32_t scene_lookahead_distance,
+                                    uint32_t rate_control_mode) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration params;
+    memset(&params, 0, sizeof(params));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&handle, nullptr, &params));
+    if (!handle)
+        return EB_ErrorInsufficientResources;
+    params.source_width = stream_width;
+    params.source_height = stream_height;
+    params.scene_change_detection = scene_change_detection;
+    params.scene_lookahead_distance = scene_lookahead_distance;
+    params.rate_control_mode = rate_control_mode;
+    const EbErrorType ret = svt_av1_enc_set_parameter(handle, &params);
+    svt_av1_enc_deinit_handle(handle);
+    return ret;
+}
+
+/**
+ * @brief Scene change detection is only done by the scene lookahead, in CQP
+ *
+ * Test strategy:
+ * Set scene change detection without a scene lookahead distance, with a
+ * rate control mode other than CQP, and in CQP with a distance.
+ *
+ * Expected result:
+ * Only scene change detection in CQP with a scene lookahead distance is
+ * accepted.
+ */
+TEST(EncApiTest, scene_change_detection_settings) {
+    EXPECT_EQ(EB_ErrorBadParameter, set_scene_change(1, 0, 0));
+    EXPECT_EQ(EB_ErrorBadParameter, set_scene_change(1, 16, 1));
+    EXPECT_EQ(EB_ErrorNone, set_scene_change(1, 16, 0));
+    EXPECT_EQ(EB_ErrorNone, set_scene_change(0, 0, 0));
+}
+
+}  // namespace
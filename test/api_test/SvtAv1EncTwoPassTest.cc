@@ -0,0 +1,302 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1EncTwoPassTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, stream the first pass stats of one encoder
+ * into a second encoder over a sliding window while both are encoding
+ *
+ ******************************************************************************/
+#include <string.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+static const uint32_t stream_width = 192;
+static const uint32_t stream_height = 128;
+static const uint32_t stream_frames = 40;
+static const uint32_t stats_window = 8;
+// Large enough for the stats of every frame of the stream
+static const size_t stats_chunk_size = 64 * 1024;
+// Upper bound of the stats size of one frame
+static const size_t max_stats_size = 4096;
+
+/** Fill a moving gradient with a scene change half way */
+static void fill_frame(EbSvtIOFormat *frame, uint32_t index) {
+    const uint32_t scene = index < stream_frames / 2 ? 3 : 7;
+    for (uint32_t y = 0; y < frame->height; y++) {
+        for (uint32_t x = 0; x < frame->width; x++)
+            frame->luma[y * frame->y_stride + x] =
+                (uint8_t)((x + 2 * index) * scene + (y + index) * 2);
+    }
+    for (uint32_t y = 0; y < frame->height / 2; y++) {
+        for (uint32_t x = 0; x < frame->width / 2; x++) {
+            frame->cb[y * frame->cb_stride + x] = (uint8_t)(128 + x - y);
+            frame->cr[y * frame->cr_stride + x] = (uint8_t)(96 + x + index);
+        }
+    }
+}
+
+class EncInstance {
+  public:
+    EncInstance() : handle_(nullptr), eos_(false), frames_(0) {
+        memset(&params_, 0, sizeof(params_));
+    }
+    ~EncInstance() {
+        if (handle_) {
+            svt_av1_enc_deinit(handle_);
+            svt_av1_enc_deinit_handle(handle_);
+        }
+    }
+
+    EbSvtAv1EncConfiguration *init_handle() {
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_init_handle(&handle_, nullptr, &params_));
+        params_.source_width = stream_width;
+        params_.source_height = stream_height;
+        return &params_;
+    }
+
+    EbErrorType init() {
+        EbErrorType err = svt_av1_enc_set_parameter(handle_, &params_);
+        if (err != EB_ErrorNone)
+            return err;
+        return svt_av1_enc_init(handle_);
+    }
+
+    void send_frame(uint32_t index) {
+        std::vector<uint8_t> yuv(stream_width * stream_height * 3 / 2);
+        EbSvtIOFormat frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.luma = yuv.data();
+        frame.cb = frame.luma + stream_width * stream_height;
+        frame.cr = frame.cb + stream_width * stream_height / 4;
+        frame.y_stride = stream_width;
+        frame.cb_stride = stream_width / 2;
+        frame.cr_stride = stream_width / 2;
+        frame.width = stream_width;
+        frame.height = stream_height;
+        frame.color_fmt = EB_YUV420;
+        frame.bit_depth = EB_EIGHT_BIT;
+        fill_frame(&frame, index);
+
+        EbBufferHeaderType in_buf;
+        memset(&in_buf, 0, sizeof(in_buf));
+        in_buf.size = sizeof(in_buf);
+        in_buf.p_buffer = (uint8_t *)&frame;
+        in_buf.n_filled_len = (uint32_t)yuv.size();
+        in_buf.pts = index;
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle_, &in_buf));
+        collect_packets(0);
+    }
+
+    void send_eos() {
+        EbBufferHeaderType eos_buf;
+        memset(&eos_buf, 0, sizeof(eos_buf));
+        eos_buf.flags = EB_BUFFERFLAG_EOS;
+        eos_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle_, &eos_buf));
+        collect_packets(1);
+    }
+
+    /** Stats of the first pass frames finished since the previous call, at
+     * most max_size bytes of them */
+    size_t stream_stats(std::vector<uint8_t> &chunk,
+                        size_t max_size = stats_chunk_size) {
+        SvtAv1FixedBuf stats;
+        chunk.resize(max_size);
+        stats.buf = chunk.data();
+        stats.sz = chunk.size();
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_get_stream_info(
+                      handle_, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_STREAM, &stats));
+        chunk.resize((size_t)stats.sz);
+        return chunk.size();
+    }
+
+    EbErrorType push_stats(const std::vector<uint8_t> &chunk) {
+        SvtAv1FixedBuf stats;
+        stats.buf = (void *)chunk.data();
+        stats.sz = chunk.size();
+        return svt_av1_enc_push_first_pass_stats(handle_, &stats);
+    }
+
+    EbComponentType *handle_;
+    EbSvtAv1EncConfiguration params_;
+    bool eos_;
+    uint32_t frames_;
+
+  private:
+    void collect_packets(uint8_t pic_send_done) {
+        EbBufferHeaderType *out = nullptr;
+        while (!eos_ &&
+               svt_av1_enc_get_packet(handle_, &out, pic_send_done) ==
+                   EB_ErrorNone) {
+            if (out->n_filled_len)
+                frames_++;
+            eos_ = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            svt_av1_enc_release_out_buffer(&out);
+        }
+    }
+};
+
+/**
+ * @brief Stream the first pass stats into a second pass encoder while the
+ * first pass is running.
+ *
+ * Test strategy:
+ * The first pass encoder hands out its stats with
+ * SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_STREAM after every picture, they are
+ * pushed to a second pass encoder configured with rc_twopass_stats_window.
+ * A picture is only sent to the second pass once the stats of the window
+ * after it have been pushed, so its rate control never sees the whole file.
+ *
+ * Expected result:
+ * Both encoders complete the stream, the stats streamed out cover every frame
+ * exactly once, and the second pass rejects a misaligned push.
+ */
+TEST(EncApiTest, two_pass_stats_window) {
+    EncInstance first_pass, second_pass;
+
+    EbSvtAv1EncConfiguration *params = first_pass.init_handle();
+    params->enc_mode = MAX_ENC_PRESET;
+    params->look_ahead_distance = 1;
+    params->enable_tpl_la = 0;
+    params->rate_control_mode = 0;
+    params->rc_firstpass_stats_out = EB_TRUE;
+    ASSERT_EQ(EB_ErrorNone, first_pass.init());
+
+    params = second_pass.init_handle();
+    params->rate_control_mode = 1;
+    params->target_bit_rate = 200000;
+    params->rc_twopass_stats_window = stats_window;
+    ASSERT_EQ(EB_ErrorNone, second_pass.init());
+
+    std::vector<uint8_t> chunk;
+    size_t stats_size = 0, streamed = 0;
+    uint32_t second_pass_sent = 0;
+    for (uint32_t i = 0; i < stream_frames; i++) {
+        first_pass.send_frame(i);
+        // The stats of a frame are opaque to the application, a buffer too
+        // small for one frame returns nothing, so grow it to learn the size
+        for (size_t size = 1; !stats_size && size <= max_stats_size; size++)
+            stats_size = first_pass.stream_stats(chunk, size);
+        if (stats_size && !streamed)
+            ASSERT_EQ(EB_ErrorNone, second_pass.push_stats(chunk));
+        else if (first_pass.stream_stats(chunk))
+            ASSERT_EQ(EB_ErrorNone, second_pass.push_stats(chunk));
+        else
+            continue;
+        streamed += chunk.size();
+        // Keep the second pass one window behind the first one
+        while (second_pass_sent + stats_window < streamed / stats_size)
+            second_pass.send_frame(second_pass_sent++);
+    }
+    first_pass.send_eos();
+    ASSERT_TRUE(first_pass.eos_);
+    while (first_pass.stream_stats(chunk)) {
+        ASSERT_EQ(EB_ErrorNone, second_pass.push_stats(chunk));
+        streamed += chunk.size();
+    }
+    ASSERT_NE(0u, stats_size);
+
+    // The stats out carry the totals behind the frames, which are not streamed
+    SvtAv1FixedBuf stats_out;
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_get_stream_info(first_pass.handle_,
+                                          SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT,
+                                          &stats_out));
+    EXPECT_EQ(streamed + stats_size, stats_out.sz);
+    EXPECT_EQ(stream_frames * stats_size, streamed);
+
+    // A partial frame of stats is rejected, then the end of the stats
+    chunk.assign(stats_size - 1, 0);
+    EXPECT_EQ(EB_ErrorBadParameter, second_pass.push_stats(chunk));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_push_first_pass_stats(second_pass.handle_, nullptr));
+
+    while (second_pass_sent < stream_frames)
+        second_pass.send_frame(second_pass_sent++);
+    second_pass.send_eos();
+    EXPECT_TRUE(second_pass.eos_);
+    EXPECT_GE(second_pass.frames_, stream_frames);
+}
+
+/**
+ * @brief Push the stats of the whole stream at once to a second pass
+ * encoder with a short window.
+ *
+ * Test strategy:
+ * Run the first pass over the whole stream, then push all its stats in one
+ * chunk to a second pass encoder whose stats buffer is sized for
+ * rc_twopass_stats_window frames, so that the push grows the buffer. The
+ * second pass then encodes the stream.
+ *
+ * Expected result:
+ * The push is accepted and the second pass completes the stream.
+ */
+TEST(EncApiTest, two_pass_stats_buffer_grow) {
+    EncInstance first_pass, second_pass;
+
+    EbSvtAv1EncConfiguration *params = first_pass.init_handle();
+    params->enc_mode = MAX_ENC_PRESET;
+    params->look_ahead_distance = 1;
+    params->enable_tpl_la = 0;
+    params->rate_control_mode = 0;
+    params->rc_firstpass_stats_out = EB_TRUE;
+    ASSERT_EQ(EB_ErrorNone, first_pass.init());
+
+    params = second_pass.init_handle();
+    params->rate_control_mode = 1;
+    params->target_bit_rate = 200000;
+    params->rc_twopass_stats_window = stats_window;
+    ASSERT_EQ(EB_ErrorNone, second_pass.init());
+
+    for (uint32_t i = 0; i < stream_frames; i++)
+        first_pass.send_frame(i);
+    first_pass.send_eos();
+    ASSERT_TRUE(first_pass.eos_);
+
+    std::vector<uint8_t> stats, chunk;
+    while (first_pass.stream_stats(chunk))
+        stats.insert(stats.end(), chunk.begin(), chunk.end());
+    ASSERT_EQ(0u, stats.size() % stream_frames);
+    ASSERT_GT(stream_frames, stats_window + 1);
+    EXPECT_EQ(EB_ErrorNone, second_pass.push_stats(stats));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_push_first_pass_stats(second_pass.handle_, nullptr));
+
+    for (uint32_t i = 0; i < stream_frames; i++)
+        second_pass.send_frame(i);
+    second_pass.send_eos();
+    EXPECT_TRUE(second_pass.eos_);
+    EXPECT_GE(second_pass.frames_, stream_frames);
+}
+
+/**
+ * @brief The first pass stats can only be pushed to an encoder set up for
+ * streamed stats
+ */
+TEST(EncApiTest, two_pass_stats_push_without_window) {
+    EncInstance enc;
+    enc.init_handle();
+    ASSERT_EQ(EB_ErrorNone, enc.init());
+    std::vector<uint8_t> chunk(64, 0);
+    EXPECT_EQ(EB_ErrorBadParameter, enc.push_stats(chunk));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_push_first_pass_stats(nullptr, nullptr));
+}
+
+}  // namespace
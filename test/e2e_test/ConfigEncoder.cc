@@ -21,6 +21,13 @@ void set_enc_config(void *config_ptr, const char *name, const char *value) {
     set_config_value(config, name, value);
 }
 
+void set_enc_first_pass(void *config_ptr) {
+    EbConfig *config = (EbConfig *)config_ptr;
+    // Without a stats file, the first pass of the combined passes only
+    // outputs the stats to memory
+    set_two_passes_stats(config, ENCODE_FIRST_PASS, NULL, 0);
+}
+
 void *create_enc_config() {
     EbConfig *config = (EbConfig *)malloc(sizeof(EbConfig));
     assert(config != NULL);
@@ -16,6 +16,7 @@
 void *create_enc_config();
 void release_enc_config(void *config_ptr);
 void set_enc_config(void *config, const char *name, const char *value);
+void set_enc_first_pass(void *config_ptr);
 int copy_enc_param(EbSvtAv1EncConfiguration *dst_enc_config, void *config_ptr);
 std::string get_enc_token(const char* name);
 
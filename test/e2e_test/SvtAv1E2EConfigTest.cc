@@ -0,0 +1,72 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1E2EConfigTest.cc
+ *
+ * @brief Test of the encoder app options, from the app configuration to the
+ * encoder parameters
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <string>
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+#include "ConfigEncoder.h"
+
+namespace {
+
+/** Copy the app configuration into zeroed encoder parameters */
+static EbSvtAv1EncConfiguration get_enc_params(void *config) {
+    EbSvtAv1EncConfiguration params;
+    memset(&params, 0, sizeof(params));
+    copy_enc_param(&params, config);
+    return params;
+}
+
+/**
+ * @brief --fast-first-pass selects the analysis-only first pass
+ *
+ * Test strategy:
+ * Set the FastFirstPass option of the app configuration, whose command line
+ * token is --fast-first-pass, on a single pass and on the first of the
+ * combined passes, and copy the configuration into the encoder parameters.
+ *
+ * Expected result:
+ * rc_firstpass_analysis_only is only set for a first pass with the option
+ * on, it is off by default.
+ */
+TEST(EncConfigTest, fast_first_pass) {
+    EXPECT_EQ(std::string("--fast-first-pass"),
+              get_enc_token("FastFirstPass"));
+
+    void *config = create_enc_config();
+    EXPECT_FALSE(get_enc_params(config).rc_firstpass_analysis_only);
+    set_enc_config(config, "FastFirstPass", "1");
+    EXPECT_FALSE(get_enc_params(config).rc_firstpass_analysis_only);
+    set_enc_first_pass(config);
+    EbSvtAv1EncConfiguration params = get_enc_params(config);
+    EXPECT_TRUE(params.rc_firstpass_stats_out);
+    EXPECT_TRUE(params.rc_firstpass_analysis_only);
+    set_enc_config(config, "FastFirstPass", "0");
+    EXPECT_FALSE(get_enc_params(config).rc_firstpass_analysis_only);
+    release_enc_config(config);
+
+    config = create_enc_config();
+    set_enc_first_pass(config);
+    params = get_enc_params(config);
+    EXPECT_TRUE(params.rc_firstpass_stats_out);
+    EXPECT_FALSE(params.rc_firstpass_analysis_only);
+    release_enc_config(config);
+}
+
+}  // namespace